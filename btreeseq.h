@@ -0,0 +1,804 @@
+#ifndef BTREESEQ_H
+#define BTREESEQ_H
+
+#include "generics.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @file btreeseq.h
+ * @brief Order-statistics B+tree sequence (`bts_*`).
+ *
+ * A BTSeq is a sequence of (data, len) payloads, like a list, but insert,
+ * delete and lookup by index cost O(log n) instead of O(n). The payloads
+ * live in leaves of a few cache lines holding BTS_LEAF_CAP entries each;
+ * the leaves are chained in sequence order so a cursor walks the whole
+ * sequence in O(1) amortized steps. Internal nodes keep the number of
+ * elements under each child, and lookups descend by subtracting those
+ * counts instead of comparing keys.
+ *
+ * Appending at the end starts a new leaf instead of splitting a full one in
+ * half, so sequences built by push_back and by bts_from_ptr_array() end up
+ * with full leaves. Leaves and internal nodes that fall below half full after a delete
+ * borrow from or merge with a neighbour.
+ *
+ * The sequence owns its payloads and frees them through its allocator.
+ */
+
+/**
+ * @def BTS_LEAF_LINES
+ * @brief Size of a leaf in 64-byte cache lines (at least 2).
+ *
+ * An entry is a pointer and a length, so a single line only holds two or
+ * three of them; the default of 4 lines gives 14 entries per leaf on 64-bit
+ * targets.
+ */
+#ifndef BTS_LEAF_LINES
+#define BTS_LEAF_LINES 4
+#endif
+
+/**
+ * @def BTS_FANOUT
+ * @brief Maximum number of children of an internal node (at least 4).
+ */
+#ifndef BTS_FANOUT
+#define BTS_FANOUT 16
+#endif
+
+/** @brief Number of entries in a leaf. */
+#define BTS_LEAF_CAP                                                           \
+  ((BTS_LEAF_LINES * 64 - 2 * sizeof(void *) - sizeof(size_t)) /             \
+   (sizeof(void *) + sizeof(size_t)))
+
+/** @brief Deepest tree the fixed-size descent paths can hold. */
+#define BTS_MAX_HEIGHT 48
+
+/**
+ * @struct BTSLeaf
+ * @brief Leaf holding up to BTS_LEAF_CAP consecutive elements.
+ */
+typedef struct BTSLeaf {
+    size_t count;               /**< Entries in use */
+    struct BTSLeaf *next;       /**< Following leaf in sequence order */
+    struct BTSLeaf *prev;       /**< Preceding leaf in sequence order */
+    void *data[BTS_LEAF_CAP];   /**< Payloads */
+    size_t len[BTS_LEAF_CAP];   /**< Payload lengths */
+} BTSLeaf;
+
+/**
+ * @struct BTSInner
+ * @brief Internal node with the element count of every child.
+ */
+typedef struct BTSInner {
+    size_t count;              /**< Children in use */
+    size_t sizes[BTS_FANOUT];  /**< Elements under each child */
+    void *child[BTS_FANOUT];   /**< BTSLeaf at height 1, BTSInner above */
+} BTSInner;
+
+/**
+ * @struct BTSeq
+ * @brief Handle of a B+tree sequence.
+ */
+typedef struct BTSeq {
+    void *root;                /**< BTSLeaf if height is 0, NULL when empty */
+    size_t height;             /**< Internal levels above the leaves */
+    size_t size;               /**< Number of elements */
+    BTSLeaf *first;            /**< First leaf */
+    BTSLeaf *last;             /**< Last leaf */
+    const CDSAllocator *alloc; /**< Allocator for nodes and payloads */
+} BTSeq;
+
+/**
+ * @struct BTSCursor
+ * @brief Position in a sequence; moving to a neighbour is O(1) amortized.
+ * @note Any insert or delete invalidates the cursors of the sequence.
+ */
+typedef struct BTSCursor {
+    BTSLeaf *leaf; /**< Current leaf, NULL past the end */
+    size_t pos;    /**< Entry within the leaf */
+    size_t index;  /**< Index in the sequence */
+} BTSCursor;
+
+/**
+ * @brief Initializes an empty sequence.
+ * @param alloc Allocator for nodes and payloads, NULL for the default one.
+ */
+static inline void bts_init(BTSeq *seq, const CDSAllocator *alloc) {
+  memset(seq, 0, sizeof(*seq));
+  seq->alloc = alloc ? alloc : cds_default_allocator();
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+static inline size_t bts_size(const BTSeq *seq) { return seq->size; }
+
+static inline size_t bts_node_count(const void *node, size_t height) {
+  return height ? ((const BTSInner *)node)->count
+                : ((const BTSLeaf *)node)->count;
+}
+
+static inline size_t bts_node_cap(size_t height) {
+  return height ? BTS_FANOUT : BTS_LEAF_CAP;
+}
+
+static inline size_t bts_inner_total(const BTSInner *n) {
+  size_t total = 0;
+  for (size_t i = 0; i < n->count; i++)
+    total += n->sizes[i];
+  return total;
+}
+
+// number of elements under a node
+static inline size_t bts_node_size(const void *node, size_t height) {
+  return height ? bts_inner_total((const BTSInner *)node)
+                : ((const BTSLeaf *)node)->count;
+}
+
+static inline void bts_inner_insert_child(BTSInner *p, size_t at, void *child,
+                                          size_t size) {
+  memmove(&p->child[at + 1], &p->child[at], (p->count - at) * sizeof(void *));
+  memmove(&p->sizes[at + 1], &p->sizes[at], (p->count - at) * sizeof(size_t));
+  p->child[at] = child;
+  p->sizes[at] = size;
+  p->count++;
+}
+
+static inline void bts_inner_remove_child(BTSInner *p, size_t at) {
+  memmove(&p->child[at], &p->child[at + 1],
+          (p->count - at - 1) * sizeof(void *));
+  memmove(&p->sizes[at], &p->sizes[at + 1],
+          (p->count - at - 1) * sizeof(size_t));
+  p->count--;
+}
+
+// moves n entries of a node (leaf or internal) from src[from] to dst[to];
+// dst must have room and its entries from `to` on are shifted right
+static inline void bts_move_entries(void *dst, size_t to, void *src,
+                                    size_t from, size_t n, size_t height) {
+  if (height) {
+    BTSInner *d = (BTSInner *)dst, *s = (BTSInner *)src;
+    memmove(&d->child[to + n], &d->child[to], (d->count - to) * sizeof(void *));
+    memmove(&d->sizes[to + n], &d->sizes[to], (d->count - to) * sizeof(size_t));
+    memcpy(&d->child[to], &s->child[from], n * sizeof(void *));
+    memcpy(&d->sizes[to], &s->sizes[from], n * sizeof(size_t));
+    memmove(&s->child[from], &s->child[from + n],
+            (s->count - from - n) * sizeof(void *));
+    memmove(&s->sizes[from], &s->sizes[from + n],
+            (s->count - from - n) * sizeof(size_t));
+    d->count += n;
+    s->count -= n;
+  } else {
+    BTSLeaf *d = (BTSLeaf *)dst, *s = (BTSLeaf *)src;
+    memmove(&d->data[to + n], &d->data[to], (d->count - to) * sizeof(void *));
+    memmove(&d->len[to + n], &d->len[to], (d->count - to) * sizeof(size_t));
+    memcpy(&d->data[to], &s->data[from], n * sizeof(void *));
+    memcpy(&d->len[to], &s->len[from], n * sizeof(size_t));
+    memmove(&s->data[from], &s->data[from + n],
+            (s->count - from - n) * sizeof(void *));
+    memmove(&s->len[from], &s->len[from + n],
+            (s->count - from - n) * sizeof(size_t));
+    d->count += n;
+    s->count -= n;
+  }
+}
+
+static inline void *bts_node_new(BTSeq *seq, size_t height) {
+  void *n = cds_alloc(seq->alloc, height ? sizeof(BTSInner) : sizeof(BTSLeaf));
+  if (n != NULL)
+    memset(n, 0, height ? sizeof(BTSInner) : sizeof(BTSLeaf));
+  return n;
+}
+
+// splits the full child at parent->child[i], keeping `keep` entries on the
+// left; the parent must have room for one more child
+static inline CDSStatus bts_split_child(BTSeq *seq, BTSInner *parent,
+                                        size_t i, size_t height, size_t keep) {
+  void *left = parent->child[i];
+  void *right = bts_node_new(seq, height);
+  size_t count = bts_node_count(left, height);
+  size_t moved;
+  if (right == NULL)
+    return CDS_ERR_NO_MEMORY;
+  bts_move_entries(right, 0, left, keep, count - keep, height);
+  if (height == 0) {
+    BTSLeaf *l = (BTSLeaf *)left, *r = (BTSLeaf *)right;
+    r->prev = l;
+    r->next = l->next;
+    if (l->next)
+      l->next->prev = r;
+    else
+      seq->last = r;
+    l->next = r;
+  }
+  moved = bts_node_size(right, height);
+  parent->sizes[i] -= moved;
+  bts_inner_insert_child(parent, i + 1, right, moved);
+  return CDS_OK;
+}
+
+// entries a split of a full node keeps on the left: an append leaves a full
+// leaf behind and starts an empty one (an internal node hands its last child
+// over, since it cannot be left empty); other inserts split in half
+static inline size_t bts_split_point(size_t count, size_t height,
+                                     bool append) {
+  if (!append)
+    return count / 2;
+  return height ? count - 1 : count;
+}
+
+// inserts a payload; the pointer is only taken on CDS_OK
+static inline CDSStatus bts_insert_raw(BTSeq *seq, size_t idx, void *data,
+                                       size_t len) {
+  BTSInner *path[BTS_MAX_HEIGHT];
+  size_t slot[BTS_MAX_HEIGHT];
+  bool append = idx == seq->size;
+  void *node;
+  if (idx > seq->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  if (seq->root == NULL) {
+    BTSLeaf *leaf = (BTSLeaf *)bts_node_new(seq, 0);
+    if (leaf == NULL)
+      return CDS_ERR_NO_MEMORY;
+    seq->root = seq->first = seq->last = leaf;
+  }
+  // a full root is split first, growing the tree by one level
+  if (bts_node_count(seq->root, seq->height) == bts_node_cap(seq->height)) {
+    BTSInner *top;
+    size_t count = bts_node_count(seq->root, seq->height);
+    if (seq->height + 1 >= BTS_MAX_HEIGHT)
+      return CDS_ERR_NO_MEMORY;
+    top = (BTSInner *)bts_node_new(seq, 1);
+    if (top == NULL)
+      return CDS_ERR_NO_MEMORY;
+    top->count = 1;
+    top->child[0] = seq->root;
+    top->sizes[0] = seq->size;
+    if (bts_split_child(seq, top, 0, seq->height,
+                        bts_split_point(count, seq->height, append)) !=
+        CDS_OK) {
+      cds_free(seq->alloc, top);
+      return CDS_ERR_NO_MEMORY;
+    }
+    seq->root = top;
+    seq->height++;
+  }
+
+  // split full children on the way down so every split has room above it;
+  // a failed split leaves a valid tree behind. Appends always take the last
+  // child, which may be the empty leaf a split just started.
+  node = seq->root;
+  for (size_t h = seq->height; h > 0; h--) {
+    BTSInner *inner = (BTSInner *)node;
+    size_t i = 0;
+    while (i + 1 < inner->count &&
+           (idx > inner->sizes[i] || (append && idx == inner->sizes[i])))
+      idx -= inner->sizes[i++];
+    size_t count = bts_node_count(inner->child[i], h - 1);
+    if (count == bts_node_cap(h - 1)) {
+      if (bts_split_child(seq, inner, i, h - 1,
+                          bts_split_point(count, h - 1, append)) != CDS_OK)
+        return CDS_ERR_NO_MEMORY;
+      if (idx > inner->sizes[i] || (append && idx == inner->sizes[i]))
+        idx -= inner->sizes[i++];
+    }
+    path[h - 1] = inner;
+    slot[h - 1] = i;
+    node = inner->child[i];
+  }
+
+  BTSLeaf *leaf = (BTSLeaf *)node;
+  memmove(&leaf->data[idx + 1], &leaf->data[idx],
+          (leaf->count - idx) * sizeof(void *));
+  memmove(&leaf->len[idx + 1], &leaf->len[idx],
+          (leaf->count - idx) * sizeof(size_t));
+  leaf->data[idx] = data;
+  leaf->len[idx] = len;
+  leaf->count++;
+  for (size_t h = 0; h < seq->height; h++)
+    path[h]->sizes[slot[h]]++;
+  seq->size++;
+  return CDS_OK;
+}
+
+// fixes an underfull parent->child[i] by borrowing from or merging with a
+// neighbour
+static inline void bts_rebalance(BTSeq *seq, BTSInner *parent, size_t i,
+                                 size_t height) {
+  size_t cap = bts_node_cap(height);
+  size_t l = i > 0 ? i - 1 : i;
+  void *left = parent->child[l], *right = parent->child[l + 1];
+  size_t lc = bts_node_count(left, height), rc = bts_node_count(right, height);
+  if (lc + rc <= cap) {
+    bts_move_entries(left, lc, right, 0, rc, height);
+    parent->sizes[l] += parent->sizes[l + 1];
+    bts_inner_remove_child(parent, l + 1);
+    if (height == 0) {
+      BTSLeaf *r = (BTSLeaf *)right;
+      ((BTSLeaf *)left)->next = r->next;
+      if (r->next)
+        r->next->prev = (BTSLeaf *)left;
+      else
+        seq->last = (BTSLeaf *)left;
+    }
+    cds_free(seq->alloc, right);
+    return;
+  }
+  if (lc < rc) {
+    size_t n = (rc - lc) / 2;
+    size_t before = bts_node_size(right, height);
+    bts_move_entries(left, lc, right, 0, n, height);
+    size_t moved = before - bts_node_size(right, height);
+    parent->sizes[l] += moved;
+    parent->sizes[l + 1] -= moved;
+  } else {
+    size_t n = (lc - rc) / 2;
+    size_t before = bts_node_size(left, height);
+    bts_move_entries(right, 0, left, lc - n, n, height);
+    size_t moved = before - bts_node_size(left, height);
+    parent->sizes[l] -= moved;
+    parent->sizes[l + 1] += moved;
+  }
+}
+
+// removes the element at idx (< size) and hands out its payload
+static inline void bts_remove_raw(BTSeq *seq, size_t idx, void **data,
+                                  size_t *len) {
+  BTSInner *path[BTS_MAX_HEIGHT];
+  size_t slot[BTS_MAX_HEIGHT];
+  void *node = seq->root;
+  for (size_t h = seq->height; h > 0; h--) {
+    BTSInner *inner = (BTSInner *)node;
+    size_t i = 0;
+    while (idx >= inner->sizes[i])
+      idx -= inner->sizes[i++];
+    inner->sizes[i]--;
+    path[h - 1] = inner;
+    slot[h - 1] = i;
+    node = inner->child[i];
+  }
+  BTSLeaf *leaf = (BTSLeaf *)node;
+  *data = leaf->data[idx];
+  *len = leaf->len[idx];
+  memmove(&leaf->data[idx], &leaf->data[idx + 1],
+          (leaf->count - idx - 1) * sizeof(void *));
+  memmove(&leaf->len[idx], &leaf->len[idx + 1],
+          (leaf->count - idx - 1) * sizeof(size_t));
+  leaf->count--;
+  seq->size--;
+
+  for (size_t h = 0; h < seq->height; h++) {
+    BTSInner *parent = path[h];
+    if (bts_node_count(parent->child[slot[h]], h) < bts_node_cap(h) / 2 &&
+        parent->count > 1)
+      bts_rebalance(seq, parent, slot[h], h);
+  }
+  while (seq->height > 0 && ((BTSInner *)seq->root)->count == 1) {
+    void *only = ((BTSInner *)seq->root)->child[0];
+    cds_free(seq->alloc, seq->root);
+    seq->root = only;
+    seq->height--;
+  }
+  if (seq->height == 0 && ((BTSLeaf *)seq->root)->count == 0) {
+    cds_free(seq->alloc, seq->root);
+    seq->root = seq->first = seq->last = NULL;
+  }
+}
+
+static inline BTSLeaf *bts_locate(const BTSeq *seq, size_t idx, size_t *pos) {
+  const void *node = seq->root;
+  for (size_t h = seq->height; h > 0; h--) {
+    const BTSInner *inner = (const BTSInner *)node;
+    size_t i = 0;
+    while (idx >= inner->sizes[i])
+      idx -= inner->sizes[i++];
+    node = inner->child[i];
+  }
+  *pos = idx;
+  return (BTSLeaf *)node;
+}
+
+/**
+ * @brief Inserts data at an index using move semantics, in O(log n).
+ * @param data Pointer to the data pointer (ownership transferred on
+ * success; set to NULL).
+ * @param idx Position of the new element, 0..size.
+ * @return CDS_OK, CDS_ERR_NULL, CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY;
+ * on failure the data stays with the caller.
+ * @note The data must come from the sequence's allocator.
+ */
+static inline CDSStatus bts_insert_at_index_mv_data(BTSeq *seq, void **data,
+                                                    size_t dataLen,
+                                                    size_t idx) {
+  CDSStatus status;
+  if (seq == NULL || data == NULL)
+    return CDS_ERR_NULL;
+  status = bts_insert_raw(seq, idx, *data, dataLen);
+  if (status == CDS_OK)
+    *data = NULL;
+  return status;
+}
+
+/**
+ * @brief Inserts a deep copy of data at an index, in O(log n).
+ * @param idx Position of the new element, 0..size.
+ * @return CDS_OK, CDS_ERR_NULL, CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus bts_insert_at_index_deep_cp_data(BTSeq *seq,
+                                                         const void *data,
+                                                         size_t dataLen,
+                                                         size_t idx) {
+  void *copy = NULL;
+  CDSStatus status;
+  if (seq == NULL)
+    return CDS_ERR_NULL;
+  if (idx > seq->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  if (data != NULL && dataLen > 0) {
+    copy = cds_alloc(seq->alloc, dataLen);
+    if (copy == NULL)
+      return CDS_ERR_NO_MEMORY;
+    memcpy(copy, data, dataLen);
+  }
+  status = bts_insert_raw(seq, idx, copy, dataLen);
+  if (status != CDS_OK)
+    cds_free(seq->alloc, copy);
+  return status;
+}
+
+/**
+ * @brief Appends data using move semantics, in O(log n).
+ * @see bts_insert_at_index_mv_data()
+ */
+static inline CDSStatus bts_push_back_mv_data(BTSeq *seq, void **data,
+                                              size_t dataLen) {
+  return bts_insert_at_index_mv_data(seq, data, dataLen, seq->size);
+}
+
+/**
+ * @brief Appends a deep copy of data, in O(log n).
+ */
+static inline CDSStatus bts_push_back_cp_data_deep(BTSeq *seq,
+                                                   const void *data,
+                                                   size_t dataLen) {
+  return bts_insert_at_index_deep_cp_data(seq, data, dataLen, seq->size);
+}
+
+/**
+ * @brief Removes the element at an index and hands its payload to the
+ * caller, in O(log n).
+ * @param data Receives the payload (ownership transferred).
+ * @param dataLen Receives its length (may be NULL).
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus bts_take_at_index(BTSeq *seq, size_t idx, void **data,
+                                          size_t *dataLen) {
+  size_t len;
+  if (seq == NULL || data == NULL)
+    return CDS_ERR_NULL;
+  if (idx >= seq->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  bts_remove_raw(seq, idx, data, &len);
+  if (dataLen)
+    *dataLen = len;
+  return CDS_OK;
+}
+
+/**
+ * @brief Deletes the element at an index and frees its payload, in
+ * O(log n).
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus bts_delete_at_index(BTSeq *seq, size_t idx) {
+  void *data;
+  CDSStatus status = bts_take_at_index(seq, idx, &data, NULL);
+  if (status == CDS_OK)
+    cds_free(seq->alloc, data);
+  return status;
+}
+
+/**
+ * @brief Looks up the data at an index without printing, in O(log n).
+ * @param out Receives the data pointer, or NULL on failure.
+ * @param dataLen Receives the length (may be NULL).
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus bts_try_get_at_index(const BTSeq *seq, size_t idx,
+                                             void **out, size_t *dataLen) {
+  size_t pos;
+  BTSLeaf *leaf;
+  if (seq == NULL || out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  if (idx >= seq->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  leaf = bts_locate(seq, idx, &pos);
+  *out = leaf->data[pos];
+  if (dataLen)
+    *dataLen = leaf->len[pos];
+  return CDS_OK;
+}
+
+/**
+ * @brief Returns the data at an index, or NULL if out of bounds.
+ * @note Failures go through CDS_DIAGNOSTIC; use bts_try_get_at_index() on
+ * hot paths.
+ */
+static inline void *bts_get_at_index(const BTSeq *seq, size_t idx) {
+  void *data;
+  CDSStatus status = bts_try_get_at_index(seq, idx, &data, NULL);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Index out of bounds.\n");
+  return data;
+}
+
+// frees the internal nodes of a subtree; leaves go through the leaf chain
+static inline void bts_free_inner(BTSeq *seq, void *node, size_t height) {
+  BTSInner *inner = (BTSInner *)node;
+  if (height == 0)
+    return;
+  for (size_t i = 0; i < inner->count; i++)
+    bts_free_inner(seq, inner->child[i], height - 1);
+  cds_free(seq->alloc, inner);
+}
+
+/**
+ * @brief Frees every element and node. The sequence stays usable (empty).
+ */
+static inline void bts_free_list(BTSeq *seq) {
+  BTSLeaf *leaf = seq->first;
+  if (seq->root != NULL)
+    bts_free_inner(seq, seq->root, seq->height);
+  while (leaf != NULL) {
+    BTSLeaf *next = leaf->next;
+    for (size_t i = 0; i < leaf->count; i++)
+      cds_free(seq->alloc, leaf->data[i]);
+    cds_free(seq->alloc, leaf);
+    leaf = next;
+  }
+  seq->root = NULL;
+  seq->first = seq->last = NULL;
+  seq->size = seq->height = 0;
+}
+
+// replaces the `count` nodes of a level with their parents, spreading the
+// children evenly so every parent is at least half full; parents are taken
+// from the preallocated pool
+static inline void bts_build_level(void **nodes, size_t *sizes, size_t *count,
+                                   void ***pool) {
+  size_t parents = (*count + BTS_FANOUT - 1) / BTS_FANOUT;
+  size_t at = 0;
+  for (size_t p = 0; p < parents; p++) {
+    size_t take = *count / parents + (p < *count % parents ? 1 : 0);
+    BTSInner *inner = (BTSInner *)*(*pool)++;
+    size_t total = 0;
+    for (size_t k = 0; k < take; k++) {
+      inner->child[k] = nodes[at + k];
+      inner->sizes[k] = sizes[at + k];
+      total += sizes[at + k];
+    }
+    inner->count = take;
+    at += take;
+    nodes[p] = inner;
+    sizes[p] = total;
+  }
+  *count = parents;
+}
+
+/**
+ * @brief Appends payloads by moving the pointers of an array, in O(n) for
+ * an empty sequence.
+ *
+ * An empty sequence is built bottom-up with full leaves and evenly filled
+ * internal nodes; otherwise the payloads are appended one by one.
+ * @param data Payload pointers (ownership transferred); moved entries are set
+ * to NULL.
+ * @param lens Payload lengths.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NO_MEMORY; entries not moved stay
+ * with the caller.
+ * @note The payloads must come from the sequence's allocator.
+ */
+static inline CDSStatus bts_from_ptr_array(BTSeq *seq, void **data,
+                                           const size_t *lens, size_t count) {
+  size_t leaves, inners = 0, level, height = 0;
+  void **nodes, **pool, **next;
+  size_t *sizes;
+  BTSLeaf *prev = NULL;
+  if (seq == NULL || (count > 0 && (data == NULL || lens == NULL)))
+    return CDS_ERR_NULL;
+  if (seq->size > 0 || count == 0) {
+    for (size_t i = 0; i < count; i++) {
+      CDSStatus status =
+          bts_insert_at_index_mv_data(seq, &data[i], lens[i], seq->size);
+      if (status != CDS_OK)
+        return status;
+    }
+    return CDS_OK;
+  }
+
+  // allocate every node up front so the build itself cannot fail
+  leaves = (count + BTS_LEAF_CAP - 1) / BTS_LEAF_CAP;
+  for (level = leaves; level > 1; height++) {
+    level = (level + BTS_FANOUT - 1) / BTS_FANOUT;
+    inners += level;
+  }
+  if (height >= BTS_MAX_HEIGHT)
+    return CDS_ERR_NO_MEMORY;
+  nodes = (void **)cds_alloc(seq->alloc, (2 * leaves + inners) * sizeof(void *));
+  sizes = (size_t *)cds_alloc(seq->alloc, leaves * sizeof(size_t));
+  if (nodes == NULL || sizes == NULL) {
+    cds_free(seq->alloc, nodes);
+    cds_free(seq->alloc, sizes);
+    return CDS_ERR_NO_MEMORY;
+  }
+  pool = nodes + leaves;
+  for (size_t i = 0; i < leaves + inners; i++) {
+    pool[i] = bts_node_new(seq, i < leaves ? 0 : 1);
+    if (pool[i] == NULL) {
+      while (i-- > 0)
+        cds_free(seq->alloc, pool[i]);
+      cds_free(seq->alloc, nodes);
+      cds_free(seq->alloc, sizes);
+      return CDS_ERR_NO_MEMORY;
+    }
+  }
+
+  for (size_t l = 0, at = 0; l < leaves; l++) {
+    size_t take = count / leaves + (l < count % leaves ? 1 : 0);
+    BTSLeaf *leaf = (BTSLeaf *)pool[l];
+    memcpy(leaf->data, &data[at], take * sizeof(void *));
+    memcpy(leaf->len, &lens[at], take * sizeof(size_t));
+    leaf->count = take;
+    leaf->prev = prev;
+    if (prev)
+      prev->next = leaf;
+    else
+      seq->first = leaf;
+    prev = leaf;
+    nodes[l] = leaf;
+    sizes[l] = take;
+    at += take;
+  }
+  seq->last = prev;
+  next = pool + leaves;
+  for (level = leaves; level > 1;)
+    bts_build_level(nodes, sizes, &level, &next);
+  seq->root = nodes[0];
+  seq->height = height;
+  seq->size = count;
+  for (size_t i = 0; i < count; i++)
+    data[i] = NULL;
+  cds_free(seq->alloc, nodes);
+  cds_free(seq->alloc, sizes);
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends deep copies of `count` fixed-size elements stored `stride`
+ * bytes apart.
+ * @see bts_from_ptr_array()
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NO_MEMORY; elements appended
+ * before a failure stay in the sequence.
+ */
+static inline CDSStatus bts_from_array(BTSeq *seq, const void *src,
+                                       size_t stride, size_t count) {
+  void **copies;
+  size_t *lens;
+  CDSStatus status = CDS_OK;
+  if (seq == NULL || (count > 0 && src == NULL))
+    return CDS_ERR_NULL;
+  if (seq->size > 0) {
+    for (size_t i = 0; i < count && status == CDS_OK; i++)
+      status = bts_insert_at_index_deep_cp_data(
+          seq, (const unsigned char *)src + i * stride, stride, seq->size);
+    return status;
+  }
+  if (count == 0)
+    return CDS_OK;
+  copies = (void **)cds_alloc(seq->alloc, count * sizeof(void *));
+  lens = (size_t *)cds_alloc(seq->alloc, count * sizeof(size_t));
+  if (copies == NULL || lens == NULL) {
+    cds_free(seq->alloc, copies);
+    cds_free(seq->alloc, lens);
+    return CDS_ERR_NO_MEMORY;
+  }
+  for (size_t i = 0; i < count; i++) {
+    copies[i] = status == CDS_OK ? cds_alloc(seq->alloc, stride ? stride : 1)
+                                 : NULL;
+    lens[i] = stride;
+    if (copies[i] == NULL)
+      status = CDS_ERR_NO_MEMORY;
+    else
+      memcpy(copies[i], (const unsigned char *)src + i * stride, stride);
+  }
+  if (status == CDS_OK)
+    status = bts_from_ptr_array(seq, copies, lens, count);
+  if (status != CDS_OK) {
+    for (size_t i = 0; i < count; i++)
+      cds_free(seq->alloc, copies[i]);
+  }
+  cds_free(seq->alloc, copies);
+  cds_free(seq->alloc, lens);
+  return status;
+}
+
+/**
+ * @brief Places a cursor on the element at idx (past the end if idx >=
+ * size), in O(log n).
+ * @return true if there is an element at idx.
+ */
+static inline bool bts_cursor_seek(BTSCursor *cur, const BTSeq *seq,
+                                   size_t idx) {
+  cur->index = idx < seq->size ? idx : seq->size;
+  if (idx >= seq->size) {
+    cur->leaf = NULL;
+    cur->pos = 0;
+    return false;
+  }
+  cur->leaf = bts_locate(seq, idx, &cur->pos);
+  return true;
+}
+
+/**
+ * @brief Places a cursor on the first element.
+ */
+static inline void bts_cursor_init(BTSCursor *cur, const BTSeq *seq) {
+  cur->leaf = seq->first;
+  cur->pos = 0;
+  cur->index = 0;
+}
+
+/**
+ * @brief Returns true if the cursor is on an element (not past the end).
+ */
+static inline bool bts_cursor_valid(const BTSCursor *cur) {
+  return cur->leaf != NULL;
+}
+
+/**
+ * @brief Returns the data of the current element, or NULL past the end.
+ */
+static inline void *bts_cursor_get(const BTSCursor *cur) {
+  return cur->leaf ? cur->leaf->data[cur->pos] : NULL;
+}
+
+/**
+ * @brief Returns the length of the current element, or 0 past the end.
+ */
+static inline size_t bts_cursor_len(const BTSCursor *cur) {
+  return cur->leaf ? cur->leaf->len[cur->pos] : 0;
+}
+
+/**
+ * @brief Moves to the next element.
+ * @return true if the cursor moved, false if it was already past the end.
+ */
+static inline bool bts_cursor_next(BTSCursor *cur) {
+  if (cur->leaf == NULL)
+    return false;
+  cur->index++;
+  if (++cur->pos == cur->leaf->count) {
+    cur->leaf = cur->leaf->next;
+    cur->pos = 0;
+  }
+  return true;
+}
+
+/**
+ * @brief Moves to the previous element.
+ * @return true if the cursor moved, false on the first element or past the
+ * end.
+ */
+static inline bool bts_cursor_prev(BTSCursor *cur) {
+  if (cur->leaf == NULL || cur->index == 0)
+    return false;
+  cur->index--;
+  if (cur->pos-- == 0) {
+    cur->leaf = cur->leaf->prev;
+    cur->pos = cur->leaf->count - 1;
+  }
+  return true;
+}
+
+#endif // BTREESEQ_H
@@ -0,0 +1,733 @@
+#ifndef CDSCONTAINERS_HPP
+#define CDSCONTAINERS_HPP
+
+/**
+ * @file cdscontainers.hpp
+ * @brief Typed C++11 list templates: cds::slist, cds::dlist and cds::clist.
+ *
+ * The C headers store every payload behind a `void *` with a separate
+ * allocation and compare with memcmp. These templates store `T` inline in the
+ * node, construct it in place (emplace), move it with real move semantics and
+ * expose STL iterators, so `<algorithm>` works on them directly.
+ *
+ * Node links keep the C field names and order (`next`, then `previous` for
+ * the doubly linked list); only the `data`/`dataLen` pair is replaced by the
+ * inline value, which is what removes the extra payload allocation.
+ *
+ * Allocators follow the standard Allocator requirements and are rebound to
+ * the node type through std::allocator_traits.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace cds {
+
+namespace detail {
+
+/**
+ * @brief Allocates and constructs nodes through a rebound allocator.
+ */
+template <class NodeT, class Alloc> struct node_allocator {
+  using traits = typename std::allocator_traits<Alloc>::template rebind_traits<NodeT>;
+  using type = typename traits::allocator_type;
+
+  template <class... Args>
+  static NodeT *create(type &a, Args &&...args) {
+    NodeT *n = traits::allocate(a, 1);
+    try {
+      traits::construct(a, n, std::forward<Args>(args)...);
+    } catch (...) {
+      traits::deallocate(a, n, 1);
+      throw;
+    }
+    return n;
+  }
+
+  static void destroy(type &a, NodeT *n) {
+    traits::destroy(a, n);
+    traits::deallocate(a, n, 1);
+  }
+};
+
+template <class T> struct snode;
+
+template <class T> struct snode_base {
+  snode<T> *next;
+};
+
+template <class T> struct snode : snode_base<T> {
+  T value;
+  template <class... Args>
+  explicit snode(Args &&...args) : snode_base<T>(), value(std::forward<Args>(args)...) {}
+};
+
+template <class T> struct dnode_base {
+  dnode_base *next;
+  dnode_base *previous;
+};
+
+template <class T> struct dnode : dnode_base<T> {
+  T value;
+  template <class... Args>
+  explicit dnode(Args &&...args) : dnode_base<T>(), value(std::forward<Args>(args)...) {}
+};
+
+} // namespace detail
+
+/**
+ * @brief Singly linked list with O(1) push_front, push_back and pop_front.
+ */
+template <class T, class Alloc = std::allocator<T>> class slist {
+  using base = detail::snode_base<T>;
+  using node = detail::snode<T>;
+  using node_alloc = detail::node_allocator<node, Alloc>;
+
+public:
+  using value_type = T;
+  using allocator_type = Alloc;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+
+  template <bool Const> class basic_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename std::conditional<Const, const T *, T *>::type;
+    using reference = typename std::conditional<Const, const T &, T &>::type;
+
+    basic_iterator() : n_(nullptr) {}
+    template <bool C, class = typename std::enable_if<Const && !C>::type>
+    basic_iterator(const basic_iterator<C> &o) : n_(o.n_) {}
+
+    reference operator*() const { return static_cast<node *>(n_)->value; }
+    pointer operator->() const { return &static_cast<node *>(n_)->value; }
+    basic_iterator &operator++() {
+      n_ = n_->next;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator t = *this;
+      ++*this;
+      return t;
+    }
+    friend bool operator==(const basic_iterator &a, const basic_iterator &b) {
+      return a.n_ == b.n_;
+    }
+    friend bool operator!=(const basic_iterator &a, const basic_iterator &b) {
+      return a.n_ != b.n_;
+    }
+
+  private:
+    friend class slist;
+    template <bool> friend class basic_iterator;
+    explicit basic_iterator(base *n) : n_(n) {}
+    base *n_;
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  slist() : head_(), tail_(nullptr), size_(0) {}
+  explicit slist(const Alloc &a) : alloc_(a), head_(), tail_(nullptr), size_(0) {}
+  slist(std::initializer_list<T> il) : slist() {
+    for (const T &v : il)
+      push_back(v);
+  }
+  slist(const slist &o)
+      : alloc_(node_alloc::traits::select_on_container_copy_construction(o.alloc_)),
+        head_(), tail_(nullptr), size_(0) {
+    for (const T &v : o)
+      push_back(v);
+  }
+  slist(slist &&o) noexcept
+      : alloc_(std::move(o.alloc_)), head_(o.head_), tail_(o.tail_), size_(o.size_) {
+    o.head_.next = nullptr;
+    o.tail_ = nullptr;
+    o.size_ = 0;
+  }
+  ~slist() { clear(); }
+
+  slist &operator=(slist o) {
+    swap(o);
+    return *this;
+  }
+
+  void swap(slist &o) noexcept {
+    using std::swap;
+    swap(alloc_, o.alloc_);
+    swap(head_.next, o.head_.next);
+    swap(tail_, o.tail_);
+    swap(size_, o.size_);
+  }
+
+  /**
+   * @brief Position before the first element, for emplace_after/erase_after.
+   */
+  iterator before_begin() noexcept { return iterator(&head_); }
+  const_iterator before_begin() const noexcept {
+    return const_iterator(const_cast<base *>(&head_));
+  }
+  const_iterator cbefore_begin() const noexcept { return before_begin(); }
+  iterator begin() noexcept { return iterator(head_.next); }
+  iterator end() noexcept { return iterator(nullptr); }
+  const_iterator begin() const noexcept { return const_iterator(head_.next); }
+  const_iterator end() const noexcept { return const_iterator(nullptr); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  reference front() { return head_.next->value; }
+  const_reference front() const { return head_.next->value; }
+  reference back() { return tail_->value; }
+  const_reference back() const { return tail_->value; }
+
+  template <class... Args> reference emplace_front(Args &&...args) {
+    node *n = node_alloc::create(alloc_, std::forward<Args>(args)...);
+    n->next = head_.next;
+    head_.next = n;
+    if (tail_ == nullptr)
+      tail_ = n;
+    ++size_;
+    return n->value;
+  }
+
+  template <class... Args> reference emplace_back(Args &&...args) {
+    node *n = node_alloc::create(alloc_, std::forward<Args>(args)...);
+    if (tail_)
+      tail_->next = n;
+    else
+      head_.next = n;
+    tail_ = n;
+    ++size_;
+    return n->value;
+  }
+
+  /**
+   * @brief Constructs a value after pos; before_begin() inserts at the front.
+   * @pre pos is before_begin() or dereferenceable (not end()).
+   */
+  template <class... Args> iterator emplace_after(const_iterator pos, Args &&...args) {
+    assert(pos.n_ != nullptr && "emplace_after(end())");
+    node *n = node_alloc::create(alloc_, std::forward<Args>(args)...);
+    n->next = pos.n_->next;
+    pos.n_->next = n;
+    if (n->next == nullptr)
+      tail_ = n;
+    ++size_;
+    return iterator(n);
+  }
+
+  void push_front(const T &v) { emplace_front(v); }
+  void push_front(T &&v) { emplace_front(std::move(v)); }
+  void push_back(const T &v) { emplace_back(v); }
+  void push_back(T &&v) { emplace_back(std::move(v)); }
+  iterator insert_after(const_iterator pos, const T &v) { return emplace_after(pos, v); }
+  iterator insert_after(const_iterator pos, T &&v) { return emplace_after(pos, std::move(v)); }
+
+  void pop_front() {
+    node *n = head_.next;
+    head_.next = n->next;
+    if (head_.next == nullptr)
+      tail_ = nullptr;
+    node_alloc::destroy(alloc_, n);
+    --size_;
+  }
+
+  /**
+   * @brief Erases the element after pos and returns the one following it.
+   * @pre pos is before_begin() or an element that has a successor.
+   */
+  iterator erase_after(const_iterator pos) {
+    node *victim = pos.n_->next;
+    pos.n_->next = victim->next;
+    if (tail_ == victim)
+      tail_ = pos.n_ == &head_ ? nullptr : static_cast<node *>(pos.n_);
+    node_alloc::destroy(alloc_, victim);
+    --size_;
+    return iterator(pos.n_->next);
+  }
+
+  /**
+   * @brief Removes every element matching pred in a single pass.
+   * @return Number of removed elements.
+   */
+  template <class Pred> size_type remove_if(Pred pred) {
+    size_type removed = 0;
+    node **link = &head_.next;
+    node *last = nullptr;
+    while (*link) {
+      node *c = *link;
+      if (pred(c->value)) {
+        *link = c->next;
+        node_alloc::destroy(alloc_, c);
+        ++removed;
+      } else {
+        last = c;
+        link = &c->next;
+      }
+    }
+    tail_ = last;
+    size_ -= removed;
+    return removed;
+  }
+
+  void clear() noexcept {
+    while (head_.next) {
+      node *n = head_.next;
+      head_.next = n->next;
+      node_alloc::destroy(alloc_, n);
+    }
+    tail_ = nullptr;
+    size_ = 0;
+  }
+
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+private:
+  typename node_alloc::type alloc_;
+  base head_; // head_.next is the first node; &head_ is before_begin()
+  node *tail_;
+  size_type size_;
+};
+
+/**
+ * @brief Doubly linked list with bidirectional iterators.
+ *
+ * Uses a sentinel node, so end() is decrementable and every insert and
+ * erase is O(1) given an iterator.
+ */
+template <class T, class Alloc = std::allocator<T>> class dlist {
+  using base = detail::dnode_base<T>;
+  using node = detail::dnode<T>;
+  using node_alloc = detail::node_allocator<node, Alloc>;
+
+public:
+  using value_type = T;
+  using allocator_type = Alloc;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+
+  template <bool Const> class basic_iterator {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename std::conditional<Const, const T *, T *>::type;
+    using reference = typename std::conditional<Const, const T &, T &>::type;
+
+    basic_iterator() : n_(nullptr) {}
+    template <bool C, class = typename std::enable_if<Const && !C>::type>
+    basic_iterator(const basic_iterator<C> &o) : n_(o.n_) {}
+
+    reference operator*() const { return static_cast<node *>(n_)->value; }
+    pointer operator->() const { return &static_cast<node *>(n_)->value; }
+    basic_iterator &operator++() {
+      n_ = n_->next;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator t = *this;
+      ++*this;
+      return t;
+    }
+    basic_iterator &operator--() {
+      n_ = n_->previous;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      basic_iterator t = *this;
+      --*this;
+      return t;
+    }
+    friend bool operator==(const basic_iterator &a, const basic_iterator &b) {
+      return a.n_ == b.n_;
+    }
+    friend bool operator!=(const basic_iterator &a, const basic_iterator &b) {
+      return a.n_ != b.n_;
+    }
+
+  private:
+    friend class dlist;
+    template <bool> friend class basic_iterator;
+    explicit basic_iterator(base *n) : n_(n) {}
+    base *n_;
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  dlist() : size_(0) { reset(); }
+  explicit dlist(const Alloc &a) : alloc_(a), size_(0) { reset(); }
+  dlist(std::initializer_list<T> il) : dlist() {
+    for (const T &v : il)
+      push_back(v);
+  }
+  dlist(const dlist &o)
+      : alloc_(node_alloc::traits::select_on_container_copy_construction(o.alloc_)),
+        size_(0) {
+    reset();
+    for (const T &v : o)
+      push_back(v);
+  }
+  dlist(dlist &&o) noexcept : alloc_(std::move(o.alloc_)), size_(0) {
+    reset();
+    steal(o);
+  }
+  ~dlist() { clear(); }
+
+  dlist &operator=(dlist o) {
+    swap(o);
+    return *this;
+  }
+
+  void swap(dlist &o) noexcept {
+    using std::swap;
+    swap(alloc_, o.alloc_);
+    swap(sentinel_.next, o.sentinel_.next);
+    swap(sentinel_.previous, o.sentinel_.previous);
+    swap(size_, o.size_);
+    relink();
+    o.relink();
+  }
+
+  iterator begin() noexcept { return iterator(sentinel_.next); }
+  iterator end() noexcept { return iterator(&sentinel_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(sentinel_.next);
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(const_cast<base *>(&sentinel_));
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *std::prev(end()); }
+  const_reference back() const { return *std::prev(end()); }
+
+  /**
+   * @brief Constructs a value before pos.
+   */
+  template <class... Args> iterator emplace(const_iterator pos, Args &&...args) {
+    node *n = node_alloc::create(alloc_, std::forward<Args>(args)...);
+    base *at = pos.n_;
+    n->next = at;
+    n->previous = at->previous;
+    at->previous->next = n;
+    at->previous = n;
+    ++size_;
+    return iterator(n);
+  }
+
+  template <class... Args> reference emplace_front(Args &&...args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+  }
+  template <class... Args> reference emplace_back(Args &&...args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+
+  iterator insert(const_iterator pos, const T &v) { return emplace(pos, v); }
+  iterator insert(const_iterator pos, T &&v) { return emplace(pos, std::move(v)); }
+  void push_front(const T &v) { emplace_front(v); }
+  void push_front(T &&v) { emplace_front(std::move(v)); }
+  void push_back(const T &v) { emplace_back(v); }
+  void push_back(T &&v) { emplace_back(std::move(v)); }
+
+  /**
+   * @brief Erases the element at pos and returns the one following it.
+   */
+  iterator erase(const_iterator pos) {
+    base *n = pos.n_;
+    base *next = n->next;
+    n->previous->next = next;
+    next->previous = n->previous;
+    node_alloc::destroy(alloc_, static_cast<node *>(n));
+    --size_;
+    return iterator(next);
+  }
+
+  void pop_front() { erase(begin()); }
+  void pop_back() { erase(std::prev(end())); }
+
+  /**
+   * @brief Removes every element matching pred in a single pass.
+   * @return Number of removed elements.
+   */
+  template <class Pred> size_type remove_if(Pred pred) {
+    size_type removed = 0;
+    for (iterator it = begin(); it != end();) {
+      if (pred(*it)) {
+        it = erase(it);
+        ++removed;
+      } else {
+        ++it;
+      }
+    }
+    return removed;
+  }
+
+  void clear() noexcept {
+    base *c = sentinel_.next;
+    while (c != &sentinel_) {
+      base *next = c->next;
+      node_alloc::destroy(alloc_, static_cast<node *>(c));
+      c = next;
+    }
+    reset();
+    size_ = 0;
+  }
+
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+private:
+  void reset() { sentinel_.next = sentinel_.previous = &sentinel_; }
+
+  // points the end nodes back at our own sentinel after the links moved
+  void relink() noexcept {
+    if (size_ == 0) {
+      reset();
+      return;
+    }
+    sentinel_.next->previous = &sentinel_;
+    sentinel_.previous->next = &sentinel_;
+  }
+
+  // takes o's nodes; *this must be empty
+  void steal(dlist &o) {
+    if (o.empty())
+      return;
+    sentinel_.next = o.sentinel_.next;
+    sentinel_.previous = o.sentinel_.previous;
+    sentinel_.next->previous = &sentinel_;
+    sentinel_.previous->next = &sentinel_;
+    size_ = o.size_;
+    o.reset();
+    o.size_ = 0;
+  }
+
+  typename node_alloc::type alloc_;
+  base sentinel_;
+  size_type size_;
+};
+
+/**
+ * @brief Circular singly linked list.
+ *
+ * Only the tail is stored (tail->next is the head), so push_front,
+ * push_back, pop_front and rotate() are all O(1). Iteration visits every
+ * element once, starting at the head.
+ */
+template <class T, class Alloc = std::allocator<T>> class clist {
+  using node = detail::snode<T>;
+  using node_alloc = detail::node_allocator<node, Alloc>;
+
+public:
+  using value_type = T;
+  using allocator_type = Alloc;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+
+  template <bool Const> class basic_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename std::conditional<Const, const T *, T *>::type;
+    using reference = typename std::conditional<Const, const T &, T &>::type;
+
+    basic_iterator() : n_(nullptr), tail_(nullptr) {}
+    template <bool C, class = typename std::enable_if<Const && !C>::type>
+    basic_iterator(const basic_iterator<C> &o) : n_(o.n_), tail_(o.tail_) {}
+
+    reference operator*() const { return n_->value; }
+    pointer operator->() const { return &n_->value; }
+    basic_iterator &operator++() {
+      n_ = (n_ == tail_) ? nullptr : n_->next;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator t = *this;
+      ++*this;
+      return t;
+    }
+    friend bool operator==(const basic_iterator &a, const basic_iterator &b) {
+      return a.n_ == b.n_;
+    }
+    friend bool operator!=(const basic_iterator &a, const basic_iterator &b) {
+      return a.n_ != b.n_;
+    }
+
+  private:
+    friend class clist;
+    template <bool> friend class basic_iterator;
+    basic_iterator(node *n, node *tail) : n_(n), tail_(tail) {}
+    node *n_;
+    node *tail_;
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  clist() : tail_(nullptr), size_(0) {}
+  explicit clist(const Alloc &a) : alloc_(a), tail_(nullptr), size_(0) {}
+  clist(std::initializer_list<T> il) : clist() {
+    for (const T &v : il)
+      push_back(v);
+  }
+  clist(const clist &o)
+      : alloc_(node_alloc::traits::select_on_container_copy_construction(o.alloc_)),
+        tail_(nullptr), size_(0) {
+    for (const T &v : o)
+      push_back(v);
+  }
+  clist(clist &&o) noexcept
+      : alloc_(std::move(o.alloc_)), tail_(o.tail_), size_(o.size_) {
+    o.tail_ = nullptr;
+    o.size_ = 0;
+  }
+  ~clist() { clear(); }
+
+  clist &operator=(clist o) {
+    swap(o);
+    return *this;
+  }
+
+  void swap(clist &o) noexcept {
+    using std::swap;
+    swap(alloc_, o.alloc_);
+    swap(tail_, o.tail_);
+    swap(size_, o.size_);
+  }
+
+  iterator begin() noexcept { return iterator(tail_ ? tail_->next : nullptr, tail_); }
+  iterator end() noexcept { return iterator(nullptr, tail_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(tail_ ? tail_->next : nullptr, tail_);
+  }
+  const_iterator end() const noexcept { return const_iterator(nullptr, tail_); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  reference front() { return tail_->next->value; }
+  const_reference front() const { return tail_->next->value; }
+  reference back() { return tail_->value; }
+  const_reference back() const { return tail_->value; }
+
+  template <class... Args> reference emplace_front(Args &&...args) {
+    node *n = node_alloc::create(alloc_, std::forward<Args>(args)...);
+    if (tail_) {
+      n->next = tail_->next;
+      tail_->next = n;
+    } else {
+      n->next = n;
+      tail_ = n;
+    }
+    ++size_;
+    return n->value;
+  }
+
+  template <class... Args> reference emplace_back(Args &&...args) {
+    emplace_front(std::forward<Args>(args)...);
+    tail_ = tail_->next;
+    return tail_->value;
+  }
+
+  void push_front(const T &v) { emplace_front(v); }
+  void push_front(T &&v) { emplace_front(std::move(v)); }
+  void push_back(const T &v) { emplace_back(v); }
+  void push_back(T &&v) { emplace_back(std::move(v)); }
+
+  void pop_front() {
+    node *head = tail_->next;
+    if (head == tail_)
+      tail_ = nullptr;
+    else
+      tail_->next = head->next;
+    node_alloc::destroy(alloc_, head);
+    --size_;
+  }
+
+  /**
+   * @brief Moves the head to the back k times (O(k), O(1) for k == 1).
+   */
+  void rotate(size_type k = 1) noexcept {
+    if (size_ == 0)
+      return;
+    for (k %= size_; k > 0; --k)
+      tail_ = tail_->next;
+  }
+
+  /**
+   * @brief Removes every element matching pred in a single pass.
+   * @return Number of removed elements.
+   */
+  template <class Pred> size_type remove_if(Pred pred) {
+    size_type removed = 0;
+    if (tail_ == nullptr)
+      return 0;
+    node *prev = tail_;
+    for (size_type i = 0, n = size_; i < n; ++i) {
+      node *c = prev->next;
+      if (pred(c->value)) {
+        prev->next = c->next;
+        if (c == tail_)
+          tail_ = (prev == c) ? nullptr : prev;
+        node_alloc::destroy(alloc_, c);
+        ++removed;
+      } else {
+        prev = c;
+      }
+    }
+    size_ -= removed;
+    return removed;
+  }
+
+  void clear() noexcept {
+    while (size_ > 0)
+      pop_front();
+  }
+
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+private:
+  typename node_alloc::type alloc_;
+  node *tail_;
+  size_type size_;
+};
+
+template <class T, class A> void swap(slist<T, A> &a, slist<T, A> &b) noexcept { a.swap(b); }
+template <class T, class A> void swap(dlist<T, A> &a, dlist<T, A> &b) noexcept { a.swap(b); }
+template <class T, class A> void swap(clist<T, A> &a, clist<T, A> &b) noexcept { a.swap(b); }
+
+} // namespace cds
+
+#endif // CDSCONTAINERS_HPP
@@ -40,6 +40,20 @@ static inline Node *cl_iterate_to_index(Node **root, int idx) {
   return current;
 }
 
+/**
+ * @brief Allocator-aware variant of cl_create_node_cp().
+ *
+ * @param alloc Allocator used for the node.
+ */
+static inline Node *cl_create_node_cp_a(void *data, size_t dataSize, Node *next,
+                                        const CDSAllocator *alloc) {
+  Node *newNode = (Node *)cds_alloc(alloc, sizeof(Node));
+  newNode->data = data;
+  newNode->dataLen = dataSize;
+  newNode->next = next;
+  return newNode;
+}
+
 /**
  * @brief Create a new node by shallow copying data (pointer only).
  * 
@@ -49,8 +63,20 @@ static inline Node *cl_iterate_to_index(Node **root, int idx) {
  * @return Node* Newly allocated node.
  */
 static inline Node *cl_create_node_cp(void *data, size_t dataSize, Node *next) {
-  Node *newNode = (Node *)malloc(sizeof(Node));
-  newNode->data = data;
+  return cl_create_node_cp_a(data, dataSize, next, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_create_node_deep_cp().
+ *
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline Node *cl_create_node_deep_cp_a(void *data, size_t dataSize,
+                                             Node *next,
+                                             const CDSAllocator *alloc) {
+  Node *newNode = (Node *)cds_alloc(alloc, sizeof(Node));
+  newNode->data = cds_alloc(alloc, dataSize);
+  memmove(newNode->data, data, dataSize);
   newNode->dataLen = dataSize;
   newNode->next = next;
   return newNode;
@@ -66,9 +92,20 @@ static inline Node *cl_create_node_cp(void *data, size_t dataSize, Node *next) {
  */
 static inline Node *cl_create_node_deep_cp(void *data, size_t dataSize,
                                            Node *next) {
-  Node *newNode = (Node *)malloc(sizeof(Node));
-  newNode->data = malloc(dataSize);
-  memmove(newNode->data, data, dataSize);
+  return cl_create_node_deep_cp_a(data, dataSize, next,
+                                  cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_create_node_mv().
+ *
+ * @param alloc Allocator used for the node.
+ */
+static inline Node *cl_create_node_mv_a(void **data, size_t dataSize,
+                                        Node *next,
+                                        const CDSAllocator *alloc) {
+  Node *newNode = (Node *)cds_alloc(alloc, sizeof(Node));
+  newNode->data = move(data);
   newNode->dataLen = dataSize;
   newNode->next = next;
   return newNode;
@@ -84,11 +121,20 @@ static inline Node *cl_create_node_deep_cp(void *data, size_t dataSize,
  */
 static inline Node *cl_create_node_mv(void **data, size_t dataSize,
                                       Node *next) {
-  Node *newNode = (Node *)malloc(sizeof(Node));
-  newNode->data = move(data);
-  newNode->dataLen = dataSize;
-  newNode->next = next;
-  return newNode;
+  return cl_create_node_mv_a(data, dataSize, next, cds_default_allocator());
+}
+
+/**
+ * @brief Release a single node and its data through an allocator.
+ *
+ * @param node Node to release (may be NULL); must already be unlinked.
+ * @param alloc Allocator the node and its data were allocated with.
+ */
+static inline void cl_destroy_node_a(Node *node, const CDSAllocator *alloc) {
+  if (node == NULL)
+    return;
+  cds_free(alloc, node->data);
+  cds_free(alloc, node);
 }
 
 /**
@@ -126,15 +172,16 @@ static inline void cl_push_front_cp_node(Node **root, Node *toBePushed) {
 }
 
 /**
- * @brief Insert a deep copy of a node at the front of the circular linked list.
+ * @brief Allocator-aware variant of cl_push_front_deep_cp_node().
+ *
+ * @param alloc Allocator used for the copy.
  */
-static inline void cl_push_front_deep_cp_node(Node **root, Node *toBePushed) {
+static inline void cl_push_front_deep_cp_node_a(Node **root, Node *toBePushed,
+                                              const CDSAllocator *alloc) {
   if (!toBePushed)
     return;
-  Node *newNode = (Node *)malloc(sizeof(Node));
-  newNode->data = malloc(toBePushed->dataLen);
-  memmove(newNode->data, toBePushed->data, toBePushed->dataLen);
-  newNode->dataLen = toBePushed->dataLen;
+  Node *newNode = cl_create_node_deep_cp_a(toBePushed->data,
+                                           toBePushed->dataLen, NULL, alloc);
   if (!(*root)) {
     newNode->next = newNode;
     *root = newNode;
@@ -146,13 +193,42 @@ static inline void cl_push_front_deep_cp_node(Node **root, Node *toBePushed) {
   *root = newNode;
 }
 
+/**
+ * @brief Insert a deep copy of a node at the front of the circular linked list.
+ */
+static inline void cl_push_front_deep_cp_node(Node **root, Node *toBePushed) {
+  cl_push_front_deep_cp_node_a(root, toBePushed, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_push_front_mv_data().
+ *
+ * @param alloc Allocator used for the node.
+ */
+static inline void cl_push_front_mv_data_a(Node **root, void **data,
+                                         size_t dataSize,
+                                         const CDSAllocator *alloc) {
+  Node *newNode = cl_create_node_mv_a(data, dataSize, NULL, alloc);
+  cl_push_front_mv_node(root, &newNode);
+}
+
 /**
  * @brief Insert data at the front using move semantics.
  */
 static inline void cl_push_front_mv_data(Node **root, void **data,
                                          size_t dataSize) {
-  Node *newNode = cl_create_node_mv(data, dataSize, NULL);
-  cl_push_front_mv_node(root, &newNode);
+  cl_push_front_mv_data_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_push_front_cp_data().
+ *
+ * @param alloc Allocator used for the node.
+ */
+static inline void cl_push_front_cp_data_a(Node **root, void *data,
+                                         size_t dataSize,
+                                         const CDSAllocator *alloc) {
+  cl_push_front_cp_node(root, cl_create_node_cp_a(data, dataSize, NULL, alloc));
 }
 
 /**
@@ -160,7 +236,18 @@ static inline void cl_push_front_mv_data(Node **root, void **data,
  */
 static inline void cl_push_front_cp_data(Node **root, void *data,
                                          size_t dataSize) {
-  cl_push_front_cp_node(root, cl_create_node_cp(data, dataSize, NULL));
+  cl_push_front_cp_data_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_push_front_deep_cp_data().
+ *
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline void cl_push_front_deep_cp_data_a(Node **root, void *data,
+                                              size_t dataSize,
+                                              const CDSAllocator *alloc) {
+  cl_push_front_cp_node(root, cl_create_node_deep_cp_a(data, dataSize, NULL, alloc));
 }
 
 /**
@@ -168,8 +255,7 @@ static inline void cl_push_front_cp_data(Node **root, void *data,
  */
 static inline void cl_push_front_deep_cp_data(Node **root, void *data,
                                               size_t dataSize) {
-  cl_push_front_deep_cp_node(root,
-                             cl_create_node_deep_cp(data, dataSize, NULL));
+  cl_push_front_deep_cp_data_a(root, data, dataSize, cds_default_allocator());
 }
 
 /**
@@ -206,15 +292,16 @@ static inline void cl_push_back_cp_node(Node **root, Node *toBePushed) {
 }
 
 /**
- * @brief Insert a deep copy of a node at the back of the circular linked list.
+ * @brief Allocator-aware variant of cl_push_back_deep_cp_node().
+ *
+ * @param alloc Allocator used for the copy.
  */
-static inline void cl_push_back_deep_cp_node(Node **root, Node *toBePushed) {
+static inline void cl_push_back_deep_cp_node_a(Node **root, Node *toBePushed,
+                                              const CDSAllocator *alloc) {
   if (!toBePushed)
     return;
-  Node *newNode = (Node *)malloc(sizeof(Node));
-  newNode->data = malloc(toBePushed->dataLen);
-  memmove(newNode->data, toBePushed->data, toBePushed->dataLen);
-  newNode->dataLen = toBePushed->dataLen;
+  Node *newNode = cl_create_node_deep_cp_a(toBePushed->data,
+                                           toBePushed->dataLen, NULL, alloc);
   if (!(*root)) {
     newNode->next = newNode;
     *root = newNode;
@@ -225,13 +312,42 @@ static inline void cl_push_back_deep_cp_node(Node **root, Node *toBePushed) {
   last->next = newNode;
 }
 
+/**
+ * @brief Insert a deep copy of a node at the back of the circular linked list.
+ */
+static inline void cl_push_back_deep_cp_node(Node **root, Node *toBePushed) {
+  cl_push_back_deep_cp_node_a(root, toBePushed, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_push_back_mv_data().
+ *
+ * @param alloc Allocator used for the node.
+ */
+static inline void cl_push_back_mv_data_a(Node **root, void **data,
+                                         size_t dataSize,
+                                         const CDSAllocator *alloc) {
+  Node *newNode = cl_create_node_mv_a(data, dataSize, NULL, alloc);
+  cl_push_back_mv_node(root, &newNode);
+}
+
 /**
  * @brief Insert data at the back using move semantics.
  */
 static inline void cl_push_back_mv_data(Node **root, void **data,
                                         size_t dataSize) {
-  Node *newNode = cl_create_node_mv(data, dataSize, NULL);
-  cl_push_back_mv_node(root, &newNode);
+  cl_push_back_mv_data_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_push_back_cp_data().
+ *
+ * @param alloc Allocator used for the node.
+ */
+static inline void cl_push_back_cp_data_a(Node **root, void *data,
+                                         size_t dataSize,
+                                         const CDSAllocator *alloc) {
+  cl_push_back_cp_node(root, cl_create_node_cp_a(data, dataSize, NULL, alloc));
 }
 
 /**
@@ -239,7 +355,18 @@ static inline void cl_push_back_mv_data(Node **root, void **data,
  */
 static inline void cl_push_back_cp_data(Node **root, void *data,
                                         size_t dataSize) {
-  cl_push_back_cp_node(root, cl_create_node_cp(data, dataSize, NULL));
+  cl_push_back_cp_data_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_push_back_deep_cp_data().
+ *
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline void cl_push_back_deep_cp_data_a(Node **root, void *data,
+                                              size_t dataSize,
+                                              const CDSAllocator *alloc) {
+  cl_push_back_cp_node(root, cl_create_node_deep_cp_a(data, dataSize, NULL, alloc));
 }
 
 /**
@@ -247,7 +374,77 @@ static inline void cl_push_back_cp_data(Node **root, void *data,
  */
 static inline void cl_push_back_deep_cp_data(Node **root, void *data,
                                              size_t dataSize) {
-  cl_push_back_deep_cp_node(root, cl_create_node_deep_cp(data, dataSize, NULL));
+  cl_push_back_deep_cp_data_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Look up the node at a given index without printing or crashing.
+ *
+ * @param root Double pointer to the head node (*root may be NULL).
+ * @param idx Zero-based index.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus cl_try_get_at_index(Node **root, int idx, Node **out) {
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  if (root == NULL)
+    return CDS_ERR_NULL;
+  if (*root == NULL || idx < 0)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  *out = cl_iterate_to_index(root, idx);
+  return *out ? CDS_OK : CDS_ERR_OUT_OF_BOUNDS;
+}
+
+/**
+ * @brief Look up the data stored at a given index without printing or
+ * crashing.
+ *
+ * @param root Double pointer to the head node (*root may be NULL).
+ * @param idx Zero-based index.
+ * @param out Receives the data pointer, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus cl_try_get_data_by_index(Node **root, int idx,
+                                                 void **out) {
+  Node *n;
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  CDSStatus status = cl_try_get_at_index(root, idx, &n);
+  *out = n ? n->data : NULL;
+  return status;
+}
+
+/**
+ * @brief Look up the first node containing matching data without printing.
+ *
+ * @param root Double pointer to the head node (*root may be NULL).
+ * @param data Pointer to data to match.
+ * @param size Size of the data.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NOT_FOUND.
+ */
+static inline CDSStatus cl_try_get_by_value(Node **root, void *data,
+                                            size_t size, Node **out) {
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  if (root == NULL || data == NULL)
+    return CDS_ERR_NULL;
+  if (*root == NULL)
+    return CDS_ERR_NOT_FOUND;
+  CDS_PROF_BEGIN();
+  Node *current = *root;
+  do {
+    if (current->dataLen == size && memcmp(current->data, data, size) == 0) {
+      *out = current;
+      break;
+    }
+    current = current->next;
+  } while (current != *root);
+  CDS_PROF_END(LAT_CL_GET_BY_VALUE);
+  return *out ? CDS_OK : CDS_ERR_NOT_FOUND;
 }
 
 /**
@@ -259,34 +456,38 @@ static inline Node *cl_get_at_index(Node **root, int idx) {
 
 /**
  * @brief Get data stored at a given index.
+ *
+ * @note Failures go through CDS_DIAGNOSTIC; use cl_try_get_data_by_index()
+ * on hot paths.
  */
 static inline void *cl_get_data_by_index(Node **root, int idx) {
-  Node *nati = cl_iterate_to_index(root, idx);
-  return nati->data;
+  void *data;
+  CDSStatus status = cl_try_get_data_by_index(root, idx, &data);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Index out of bounds.\n");
+  return data;
 }
 
 /**
- * @brief Delete node at a given index.
+ * @brief Allocator-aware variant of cl_delete_at_index().
+ *
+ * @param alloc Allocator the list was built with.
  */
-static inline void cl_delete_at_index(Node **root, int idx) {
+static inline void cl_delete_at_index_a(Node **root, int idx,
+                                        const CDSAllocator *alloc) {
   if (!root || !*root) {
     return;
   }
   Node *last = cl_iterate_to_last_node(*root);
   if (idx == 0) {
     if (*root == last) {
-      if ((*root)->data != NULL)
-        free((*root)->data);
-      free(*root);
+      cl_destroy_node_a(*root, alloc);
       *root = NULL;
       return;
     }
     Node *n = (*root)->next;
     last->next = n;
-    if ((*root)->data != NULL) {
-      free((*root)->data);
-    }
-    free(*root);
+    cl_destroy_node_a(*root, alloc);
     *root = n;
     return;
   }
@@ -295,21 +496,24 @@ static inline void cl_delete_at_index(Node **root, int idx) {
     return;
   Node *nati = prevnati->next;
   Node *natinext = nati->next;
-  if (nati->data != NULL) {
-    free(nati->data);
-  }
-  free(nati);
+  cl_destroy_node_a(nati, alloc);
   prevnati->next = natinext;
 }
 
 /**
- * @brief Delete the first node containing matching data.
- * 
- * @param root Double pointer to head node.
- * @param data Pointer to data to match.
- * @param size Size of the data.
+ * @brief Delete node at a given index.
  */
-static inline void cl_delete_by_value(Node **root, void *data, size_t size) {
+static inline void cl_delete_at_index(Node **root, int idx) {
+  cl_delete_at_index_a(root, idx, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_delete_by_value().
+ *
+ * @param alloc Allocator the list was built with.
+ */
+static inline void cl_delete_by_value_a(Node **root, void *data, size_t size,
+                                        const CDSAllocator *alloc) {
   if (!root || !*root)
     return; 
 
@@ -320,9 +524,7 @@ static inline void cl_delete_by_value(Node **root, void *data, size_t size) {
       if (current == *root) {
         Node *last = cl_iterate_to_last_node(*root);
         if (*root == last) {
-          if (current->data)
-            free(current->data);
-          free(current);
+          cl_destroy_node_a(current, alloc);
           *root = NULL;
           return;
         }
@@ -332,9 +534,7 @@ static inline void cl_delete_by_value(Node **root, void *data, size_t size) {
         prev->next = current->next;
       }
 
-      if (current->data)
-        free(current->data);
-      free(current);
+      cl_destroy_node_a(current, alloc);
       return;
     }
 
@@ -343,6 +543,43 @@ static inline void cl_delete_by_value(Node **root, void *data, size_t size) {
   } while (current != *root);
 }
 
+/**
+ * @brief Delete the first node containing matching data.
+ * 
+ * @param root Double pointer to head node.
+ * @param data Pointer to data to match.
+ * @param size Size of the data.
+ */
+static inline void cl_delete_by_value(Node **root, void *data, size_t size) {
+  cl_delete_by_value_a(root, data, size, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_free_list().
+ *
+ * @param rootPtrPtr Double pointer to the root node of the circular linked list.
+ * @param alloc Allocator the list was built with.
+ */
+static inline void cl_free_list_a(Node **rootPtrPtr, const CDSAllocator *alloc) {
+  if (!rootPtrPtr || !*rootPtrPtr) return;
+  CDS_PROF_BEGIN();
+  Node *root = *rootPtrPtr;
+  Node *c = root->next;
+
+  // Free every node until we come back to the root
+  while (c != root) {
+    Node *next = c->next;
+    cl_destroy_node_a(c, alloc);
+    c = next;
+  }
+
+  // Finally free the root node
+  cl_destroy_node_a(root, alloc);
+
+  *rootPtrPtr = NULL;
+  CDS_PROF_END(LAT_CL_FREE_LIST);
+}
+
 /**
  * @brief Frees all nodes in a circular linked list and sets the root pointer to NULL.
  *
@@ -361,25 +598,932 @@ static inline void cl_delete_by_value(Node **root, void *data, size_t size) {
  * - Safe to call on an empty list (rootPtrPtr == NULL or *rootPtrPtr == NULL).
  */
 static inline void cl_free_list(Node **rootPtrPtr) {
-  if (!rootPtrPtr || !*rootPtrPtr) return;
+  cl_free_list_a(rootPtrPtr, cds_default_allocator());
+}
 
-  Node *root = *rootPtrPtr;
-  Node *c = root->next;
+/**
+ * @brief Allocator-aware variant of cl_remove_if().
+ *
+ * @param alloc Allocator the list was built with.
+ */
+static inline size_t cl_remove_if_a(Node **root, CDSPredicateFn pred,
+                                    void *ctx, CDSReleaseFn release,
+                                    void *releaseCtx, Node **removed,
+                                    const CDSAllocator *alloc) {
+  size_t count = 0;
+  Node *start = *root;
+  Node *c = start;
+  Node *keptHead = NULL, *keptTail = NULL;
+  Node *removedHead = NULL, *removedTail = NULL;
+  if (start == NULL) {
+    if (removed)
+      *removed = NULL;
+    return 0;
+  }
+  // walk the ring once as a linear chain and rebuild both rings
+  do {
+    Node *next = c->next;
+    if (!pred(c->data, c->dataLen, ctx)) {
+      if (keptTail)
+        keptTail->next = c;
+      else
+        keptHead = c;
+      keptTail = c;
+    } else {
+      count++;
+      if (removed) {
+        if (removedTail)
+          removedTail->next = c;
+        else
+          removedHead = c;
+        removedTail = c;
+      } else {
+        if (release)
+          release(c->data, c->dataLen, releaseCtx);
+        else
+          cds_free(alloc, c->data);
+        cds_free(alloc, c);
+      }
+    }
+    c = next;
+  } while (c != start);
+  if (keptTail)
+    keptTail->next = keptHead;
+  *root = keptHead;
+  if (removed) {
+    if (removedTail)
+      removedTail->next = removedHead;
+    *removed = removedHead;
+  }
+  return count;
+}
 
-  // Free every node until we come back to the root
-  while (c != root) {
+/**
+ * @brief Removes every node whose data matches a predicate, in one pass.
+ *
+ * @param root Double pointer to the head node.
+ * @param pred Predicate; nodes for which it returns true are removed.
+ * @param ctx Context passed to pred.
+ * @param release Called with each removed payload; NULL frees it with the
+ * allocator, CDS_KEEP_DATA leaves it to the caller.
+ * @param releaseCtx Context passed to release.
+ * @param removed If not NULL, receives the removed nodes as a separate
+ * circular list in their original order instead of freeing them (release is
+ * not called).
+ * @return Number of removed nodes.
+ */
+static inline size_t cl_remove_if(Node **root, CDSPredicateFn pred, void *ctx,
+                                  CDSReleaseFn release, void *releaseCtx,
+                                  Node **removed) {
+  return cl_remove_if_a(root, pred, ctx, release, releaseCtx, removed,
+                        cds_default_allocator());
+}
+
+/**
+ * @brief Stable n-way partition that relinks the existing nodes.
+ *
+ * Moves every node into outs[classify(...)] in one pass, keeping their
+ * relative order; every output is again a circular list. Nothing is
+ * allocated or copied.
+ *
+ * @param root Double pointer to the head node; set to NULL.
+ * @param classify Returns the output index of a payload; indices >= nOuts go
+ * to the last output.
+ * @param ctx Context passed to classify.
+ * @param outs Array of nOuts head pointers, overwritten with the results.
+ * @param nOuts Number of outputs (> 0).
+ */
+static inline void cl_partition_n(Node **root, CDSClassifyFn classify,
+                                  void *ctx, Node **outs, size_t nOuts) {
+  Node *start = *root;
+  Node *c = start;
+  for (size_t i = 0; i < nOuts; i++)
+    outs[i] = NULL;
+  if (start == NULL)
+    return;
+  // during the pass outs[i] is the tail of its ring
+  do {
     Node *next = c->next;
-    free(c->data);
-    free(c);
+    size_t k = classify(c->data, c->dataLen, ctx);
+    if (k >= nOuts)
+      k = nOuts - 1;
+    if (outs[k]) {
+      c->next = outs[k]->next;
+      outs[k]->next = c;
+    } else {
+      c->next = c;
+    }
+    outs[k] = c;
     c = next;
+  } while (c != start);
+  for (size_t i = 0; i < nOuts; i++)
+    if (outs[i])
+      outs[i] = outs[i]->next;
+  *root = NULL;
+}
+
+/**
+ * @brief Stable partition into matching and non-matching lists (zero-copy).
+ *
+ * @param root Double pointer to the head node; set to NULL.
+ * @param matching Receives the nodes for which pred returns true.
+ * @param rest Receives the other nodes.
+ */
+static inline void cl_partition(Node **root, CDSPredicateFn pred, void *ctx,
+                                Node **matching, Node **rest) {
+  CDSPredicateBinder b = {pred, ctx};
+  Node *outs[2];
+  cl_partition_n(root, cds_predicate_to_index, &b, outs, 2);
+  *matching = outs[0];
+  *rest = outs[1];
+}
+
+/**
+ * @brief Keeps only the nodes matching pred, relinking the others.
+ *
+ * @param root Double pointer to the head node; keeps the matches.
+ * @param rejected Receives the other nodes as a circular list.
+ */
+static inline void cl_filter(Node **root, CDSPredicateFn pred, void *ctx,
+                             Node **rejected) {
+  Node *matching;
+  cl_partition(root, pred, ctx, &matching, rejected);
+  *root = matching;
+}
+
+/**
+ * @brief Counts the nodes of a list.
+ *
+ * @param root Head node of the list (may be NULL).
+ * @return Number of nodes.
+ */
+static inline size_t cl_count(const Node *root) {
+  size_t n = 0;
+  const Node *c = root;
+  if (root == NULL)
+    return 0;
+  do {
+    n++;
+    c = c->next;
+  } while (c != root);
+  return n;
+}
+
+/**
+ * @brief Copies the payloads into a fixed-stride array in one pass.
+ *
+ * Starts at the head; each payload fills one stride-byte slot, shorter
+ * payloads are zero-padded and longer ones truncated.
+ *
+ * @param root Head node of the list.
+ * @param dst Destination of at least maxCount * stride bytes.
+ * @param stride Slot size in bytes.
+ * @param maxCount Number of slots in dst.
+ * @return Number of slots written.
+ */
+static inline size_t cl_to_array(const Node *root, void *dst, size_t stride,
+                                 size_t maxCount) {
+  size_t n = 0;
+  const Node *c = root;
+  if (root == NULL)
+    return 0;
+  do {
+    if (n == maxCount)
+      break;
+    cds_stride_put((unsigned char *)dst + n * stride, stride, c->data,
+                   c->dataLen);
+    n++;
+    c = c->next;
+  } while (c != root);
+  return n;
+}
+
+/**
+ * @brief Serializes the payloads in the length-prefixed packed format.
+ *
+ * @param root Head node of the list.
+ * @param dst Destination buffer, or NULL to only compute the size.
+ * @param dstSize Size of dst; the records from the first one that does not
+ * fit on are left out.
+ * @return Bytes needed for the whole list (see cds_packed_record_size()).
+ */
+static inline size_t cl_to_packed(const Node *root, void *dst,
+                                  size_t dstSize) {
+  size_t offset = 0;
+  const Node *c = root;
+  if (root == NULL)
+    return 0;
+  do {
+    cds_packed_put(dst, dstSize, &offset, c->data, c->dataLen);
+    c = c->next;
+  } while (c != root);
+  return offset;
+}
+
+/**
+ * @brief Collects the payload pointers without copying the payloads.
+ *
+ * @param root Head node of the list.
+ * @param data Receives up to maxCount payload pointers.
+ * @param sizes Receives the payload sizes (may be NULL).
+ * @param maxCount Number of entries in data (and sizes).
+ * @return Number of entries written.
+ */
+static inline size_t cl_to_ptr_array(const Node *root, void **data,
+                                     size_t *sizes, size_t maxCount) {
+  size_t n = 0;
+  const Node *c = root;
+  if (root == NULL)
+    return 0;
+  do {
+    if (n == maxCount)
+      break;
+    data[n] = c->data;
+    if (sizes)
+      sizes[n] = c->dataLen;
+    n++;
+    c = c->next;
+  } while (c != root);
+  return n;
+}
+
+/**
+ * @brief Allocator-aware variant of cl_to_array_alloc().
+ *
+ * @param alloc Allocator used for the array.
+ */
+static inline void *cl_to_array_alloc_a(const Node *root, size_t stride,
+                                        size_t *count,
+                                        const CDSAllocator *alloc) {
+  size_t n = cl_count(root);
+  void *dst;
+  *count = 0;
+  if (n == 0 || stride == 0)
+    return NULL;
+  dst = cds_alloc(alloc, n * stride);
+  if (dst != NULL)
+    *count = cl_to_array(root, dst, stride, n);
+  return dst;
+}
+
+/**
+ * @brief Allocates a fixed-stride array holding the payloads.
+ *
+ * Walks the list twice: cl_count() sizes the array, then cl_to_array()
+ * fills it. Call cl_to_array() directly when the count is already known.
+ * @param root Head node of the list.
+ * @param stride Slot size in bytes (see cl_to_array()).
+ * @param count Receives the number of slots.
+ * @return The array (release it with free()), or NULL if the list is empty
+ * or out of memory.
+ */
+static inline void *cl_to_array_alloc(const Node *root, size_t stride,
+                                      size_t *count) {
+  return cl_to_array_alloc_a(root, stride, count, cds_default_allocator());
+}
+
+// appends n behind *tail (or as the head) keeping the ring closed
+static inline void cl_link_after_tail(Node **root, Node **tail, Node *n) {
+  if (*tail) {
+    n->next = *root;
+    (*tail)->next = n;
+  } else {
+    n->next = n;
+    *root = n;
+  }
+  *tail = n;
+}
+
+static inline bool cl_link_deep_cp_a(Node **root, Node **tail,
+                                     const void *data, size_t dataSize,
+                                     const CDSAllocator *alloc) {
+  Node *n = (Node *)cds_alloc(alloc, sizeof(Node));
+  void *copy = cds_alloc(alloc, dataSize);
+  if (n == NULL || (copy == NULL && dataSize > 0)) {
+    cds_free(alloc, copy);
+    cds_free(alloc, n);
+    return false;
   }
+  if (dataSize > 0)
+    memcpy(copy, data, dataSize);
+  n->data = copy;
+  n->dataLen = dataSize;
+  cl_link_after_tail(root, tail, n);
+  return true;
+}
 
-  // Finally free the root node
-  free(root->data);
-  free(root);
+/**
+ * @brief Allocator-aware variant of cl_from_array().
+ *
+ * @param alloc Allocator used for the nodes and the copies.
+ */
+static inline CDSStatus cl_from_array_a(Node **root, const void *src,
+                                        size_t stride, size_t count,
+                                        const CDSAllocator *alloc) {
+  Node *tail = *root ? cl_iterate_to_last_node(*root) : NULL;
+  for (size_t i = 0; i < count; i++)
+    if (!cl_link_deep_cp_a(root, &tail,
+                           (const unsigned char *)src + i * stride, stride,
+                           alloc))
+      return CDS_ERR_NO_MEMORY;
+  return CDS_OK;
+}
 
-  *rootPtrPtr = NULL;
+/**
+ * @brief Appends count stride-byte records, each deep-copied into a node.
+ *
+ * The last node is found once and every node is linked in O(1).
+ *
+ * @param root Double pointer to the head node.
+ * @param src Array of count * stride bytes.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the records appended so far
+ * kept.
+ */
+static inline CDSStatus cl_from_array(Node **root, const void *src,
+                                      size_t stride, size_t count) {
+  return cl_from_array_a(root, src, stride, count, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_from_packed().
+ *
+ * @param alloc Allocator used for the nodes and the copies.
+ */
+static inline CDSStatus cl_from_packed_a(Node **root, const void *src,
+                                         size_t srcSize,
+                                         const CDSAllocator *alloc) {
+  Node *tail = *root ? cl_iterate_to_last_node(*root) : NULL;
+  size_t offset = 0;
+  const void *data;
+  size_t size;
+  while (cds_packed_get(src, srcSize, &offset, &data, &size))
+    if (!cl_link_deep_cp_a(root, &tail, data, size, alloc))
+      return CDS_ERR_NO_MEMORY;
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends the records of a packed buffer (see cl_to_packed()).
+ *
+ * @param root Double pointer to the head node.
+ * @param src Packed records; a truncated last record is ignored.
+ * @param srcSize Size of src in bytes.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the records appended so far
+ * kept.
+ */
+static inline CDSStatus cl_from_packed(Node **root, const void *src,
+                                       size_t srcSize) {
+  return cl_from_packed_a(root, src, srcSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of cl_from_ptr_array().
+ *
+ * @param alloc Allocator used for the nodes.
+ * @note The moved payloads must come from the same allocator.
+ */
+static inline CDSStatus cl_from_ptr_array_a(Node **root, void **data,
+                                            const size_t *sizes, size_t count,
+                                            const CDSAllocator *alloc) {
+  Node *tail = *root ? cl_iterate_to_last_node(*root) : NULL;
+  for (size_t i = 0; i < count; i++) {
+    Node *n = (Node *)cds_alloc(alloc, sizeof(Node));
+    if (n == NULL)
+      return CDS_ERR_NO_MEMORY;
+    n->data = move(&data[i]);
+    n->dataLen = sizes[i];
+    cl_link_after_tail(root, &tail, n);
+  }
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends payloads by moving the pointers of an array into new nodes.
+ *
+ * @param root Double pointer to the head node.
+ * @param data Payload pointers (ownership transferred); each moved entry is
+ * set to NULL.
+ * @param sizes Payload sizes.
+ * @param count Number of entries.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY; entries not moved stay with the
+ * caller.
+ */
+static inline CDSStatus cl_from_ptr_array(Node **root, void **data,
+                                          const size_t *sizes, size_t count) {
+  return cl_from_ptr_array_a(root, data, sizes, count,
+                             cds_default_allocator());
+}
+
+/**
+ * @struct CLCursor
+ * @brief Position in a circular linked list.
+ *
+ * The cursor remembers the node before the current one, so erase and
+ * insert-before are O(1). Only creating the cursor walks the list once.
+ * Moving past the last node wraps to the root and resets the index to 0.
+ */
+typedef struct CLCursor {
+    Node **root;               /**< Root of the list */
+    Node *prev;                /**< Node before the current one */
+    Node *node;                /**< Current node (NULL if the list is empty) */
+    size_t index;              /**< Index of the current node */
+    const CDSAllocator *alloc; /**< Allocator used by insert and erase */
+} CLCursor;
+
+/**
+ * @brief Allocator-aware variant of cl_cursor_init().
+ *
+ * @param alloc Allocator used by the cursor's insert and erase functions.
+ */
+static inline void cl_cursor_init_a(CLCursor *cur, Node **root,
+                                    const CDSAllocator *alloc) {
+  cur->root = root;
+  cur->node = *root;
+  cur->prev = *root ? cl_iterate_to_last_node(*root) : NULL;
+  cur->index = 0;
+  cur->alloc = alloc;
+}
+
+/**
+ * @brief Places a cursor on the root node (O(n) once to find the last node).
+ *
+ * @param cur Cursor to initialize.
+ * @param root Double pointer to the head node.
+ */
+static inline void cl_cursor_init(CLCursor *cur, Node **root) {
+  cl_cursor_init_a(cur, root, cds_default_allocator());
+}
+
+/**
+ * @brief Returns true if the cursor is on a node (the list is not empty).
+ */
+static inline bool cl_cursor_valid(const CLCursor *cur) {
+  return cur->node != NULL;
+}
+
+/**
+ * @brief Returns the data of the current node, or NULL for an empty list.
+ */
+static inline void *cl_cursor_get(const CLCursor *cur) {
+  return cur->node ? cur->node->data : NULL;
 }
 
+/**
+ * @brief Returns the data of the next node (wrapping) without moving.
+ */
+static inline void *cl_cursor_peek(const CLCursor *cur) {
+  return cur->node ? cur->node->next->data : NULL;
+}
+
+/**
+ * @brief Moves to the next node, wrapping from the last node to the root.
+ *
+ * @return false if the list is empty.
+ */
+static inline bool cl_cursor_next(CLCursor *cur) {
+  if (cur->node == NULL)
+    return false;
+  cur->prev = cur->node;
+  cur->node = cur->node->next;
+  cur->index = (cur->node == *cur->root) ? 0 : cur->index + 1;
+  return true;
+}
+
+/**
+ * @brief Moves the cursor to an absolute index.
+ *
+ * Always moves forward, wrapping through the root when idx is behind the
+ * cursor.
+ * @return true if there is a node at idx.
+ */
+static inline bool cl_cursor_seek(CLCursor *cur, size_t idx) {
+  if (cur->node == NULL)
+    return false;
+  if (idx < cur->index) {
+    while (cur->index != 0)
+      cl_cursor_next(cur);
+  }
+  while (cur->index < idx) {
+    cl_cursor_next(cur);
+    if (cur->index == 0)
+      return false; // wrapped: idx is out of range
+  }
+  return true;
+}
+
+/**
+ * @brief Deletes the current node and moves to the following one.
+ *
+ * @return true if a node was deleted.
+ */
+static inline bool cl_cursor_erase(CLCursor *cur) {
+  Node *victim = cur->node;
+  if (victim == NULL)
+    return false;
+  if (victim->next == victim) {
+    *cur->root = NULL;
+    cur->node = cur->prev = NULL;
+    cur->index = 0;
+  } else {
+    cur->prev->next = victim->next;
+    cur->node = victim->next;
+    if (victim == *cur->root)
+      *cur->root = victim->next;
+    if (cur->node == *cur->root)
+      cur->index = 0;
+  }
+  cl_destroy_node_a(victim, cur->alloc);
+  return true;
+}
+
+/**
+ * @brief Links a node before the current one.
+ *
+ * The new node takes the current node's index, so inserting before the root
+ * makes it the new root. In an empty list the cursor moves onto the node;
+ * otherwise it stays on the same node and its index grows by one.
+ */
+static inline void cl_cursor_insert_before_node(CLCursor *cur, Node *node) {
+  if (cur->node == NULL) {
+    node->next = node;
+    *cur->root = cur->node = cur->prev = node;
+    cur->index = 0;
+    return;
+  }
+  node->next = cur->node;
+  cur->prev->next = node;
+  if (cur->node == *cur->root)
+    *cur->root = node;
+  cur->prev = node;
+  cur->index++;
+}
+
+/**
+ * @brief Links a node after the current one.
+ *
+ * In an empty list the cursor moves onto the node.
+ */
+static inline void cl_cursor_insert_after_node(CLCursor *cur, Node *node) {
+  if (cur->node == NULL) {
+    cl_cursor_insert_before_node(cur, node);
+    return;
+  }
+  node->next = cur->node->next;
+  cur->node->next = node;
+  if (cur->prev == cur->node)
+    cur->prev = node; // single node list: the new node now precedes it
+}
+
+/**
+ * @brief Inserts data before the current node (move semantics).
+ */
+static inline void cl_cursor_insert_before_mv_data(CLCursor *cur, void **data,
+                                                   size_t dataSize) {
+  cl_cursor_insert_before_node(
+      cur, cl_create_node_mv_a(data, dataSize, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data before the current node (shallow copy).
+ */
+static inline void cl_cursor_insert_before_cp_data(CLCursor *cur, void *data,
+                                                   size_t dataSize) {
+  cl_cursor_insert_before_node(
+      cur, cl_create_node_cp_a(data, dataSize, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data before the current node (deep copy).
+ */
+static inline void cl_cursor_insert_before_deep_cp_data(CLCursor *cur,
+                                                        void *data,
+                                                        size_t dataSize) {
+  cl_cursor_insert_before_node(
+      cur, cl_create_node_deep_cp_a(data, dataSize, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data after the current node (move semantics).
+ */
+static inline void cl_cursor_insert_after_mv_data(CLCursor *cur, void **data,
+                                                  size_t dataSize) {
+  cl_cursor_insert_after_node(
+      cur, cl_create_node_mv_a(data, dataSize, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data after the current node (shallow copy).
+ */
+static inline void cl_cursor_insert_after_cp_data(CLCursor *cur, void *data,
+                                                  size_t dataSize) {
+  cl_cursor_insert_after_node(
+      cur, cl_create_node_cp_a(data, dataSize, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data after the current node (deep copy).
+ */
+static inline void cl_cursor_insert_after_deep_cp_data(CLCursor *cur,
+                                                       void *data,
+                                                       size_t dataSize) {
+  cl_cursor_insert_after_node(
+      cur, cl_create_node_deep_cp_a(data, dataSize, NULL, cur->alloc));
+}
+
+/**
+ * @struct CLRing
+ * @brief Tail-tracking handle of a circular list, for run queues.
+ *
+ * Only the tail is stored; tail->next is the head, which is also the
+ * "current" entry of a round-robin. Push at either end, rotate by one,
+ * advance and remove-current are O(1) without cl_iterate_to_last_node().
+ * The nodes are ordinary cl_ nodes: clr_adopt() and clr_release() convert
+ * from and to a root pointer.
+ */
+typedef struct CLRing {
+    Node *tail;                /**< Last node, NULL when empty */
+    size_t size;               /**< Number of nodes */
+    size_t served;             /**< Picks of the head so far (weighted mode) */
+    const CDSAllocator *alloc; /**< Allocator for nodes and payloads */
+} CLRing;
+
+/**
+ * @brief Initializes an empty ring.
+ *
+ * @param alloc Allocator for nodes and payloads, NULL for the default one.
+ */
+static inline void clr_init(CLRing *ring, const CDSAllocator *alloc) {
+  ring->tail = NULL;
+  ring->size = 0;
+  ring->served = 0;
+  ring->alloc = alloc ? alloc : cds_default_allocator();
+}
+
+/**
+ * @brief Takes over a root-based circular list (O(n) once to find the tail).
+ *
+ * @param root Double pointer to the head node; set to NULL.
+ */
+static inline void clr_adopt(CLRing *ring, Node **root) {
+  size_t n = 0;
+  Node *c = *root;
+  ring->tail = NULL;
+  ring->served = 0;
+  if (c) {
+    do {
+      ring->tail = c;
+      c = c->next;
+      n++;
+    } while (c != *root);
+  }
+  ring->size = n;
+  *root = NULL;
+}
+
+/**
+ * @brief Hands the nodes back as a root-based circular list.
+ *
+ * @return The head node (usable with the cl_ functions), ring left empty.
+ */
+static inline Node *clr_release(CLRing *ring) {
+  Node *head = ring->tail ? ring->tail->next : NULL;
+  ring->tail = NULL;
+  ring->size = 0;
+  ring->served = 0;
+  return head;
+}
+
+/**
+ * @brief Returns the number of nodes.
+ */
+static inline size_t clr_size(const CLRing *ring) { return ring->size; }
+
+/**
+ * @brief Returns the head (current) node, or NULL when empty.
+ */
+static inline Node *clr_head(const CLRing *ring) {
+  return ring->tail ? ring->tail->next : NULL;
+}
+
+/**
+ * @brief Returns the data of the head (current) node, or NULL when empty.
+ */
+static inline void *clr_front(const CLRing *ring) {
+  return ring->tail ? ring->tail->next->data : NULL;
+}
+
+/**
+ * @brief Returns the data of the tail node, or NULL when empty.
+ */
+static inline void *clr_back(const CLRing *ring) {
+  return ring->tail ? ring->tail->data : NULL;
+}
+
+/**
+ * @brief Links a node in front of the head in O(1).
+ */
+static inline void clr_push_front_node(CLRing *ring, Node *node) {
+  if (ring->tail) {
+    node->next = ring->tail->next;
+    ring->tail->next = node;
+  } else {
+    node->next = node;
+    ring->tail = node;
+  }
+  ring->size++;
+  ring->served = 0;
+}
+
+/**
+ * @brief Links a node after the tail in O(1).
+ */
+static inline void clr_push_back_node(CLRing *ring, Node *node) {
+  size_t served = ring->served;
+  bool wasEmpty = ring->tail == NULL;
+  clr_push_front_node(ring, node);
+  ring->tail = node;
+  if (!wasEmpty)
+    ring->served = served; // the head did not change
+}
+
+/**
+ * @brief Appends data (move semantics).
+ */
+static inline void clr_push_back_mv_data(CLRing *ring, void **data,
+                                         size_t dataSize) {
+  clr_push_back_node(ring, cl_create_node_mv_a(data, dataSize, NULL,
+                                               ring->alloc));
+}
+
+/**
+ * @brief Appends data (shallow copy; the ring frees it on removal).
+ */
+static inline void clr_push_back_cp_data(CLRing *ring, void *data,
+                                         size_t dataSize) {
+  clr_push_back_node(ring, cl_create_node_cp_a(data, dataSize, NULL,
+                                               ring->alloc));
+}
+
+/**
+ * @brief Appends data (deep copy).
+ */
+static inline void clr_push_back_deep_cp_data(CLRing *ring, void *data,
+                                              size_t dataSize) {
+  clr_push_back_node(ring, cl_create_node_deep_cp_a(data, dataSize, NULL,
+                                                    ring->alloc));
+}
+
+/**
+ * @brief Prepends data (move semantics).
+ */
+static inline void clr_push_front_mv_data(CLRing *ring, void **data,
+                                          size_t dataSize) {
+  clr_push_front_node(ring, cl_create_node_mv_a(data, dataSize, NULL,
+                                                ring->alloc));
+}
+
+/**
+ * @brief Prepends data (shallow copy; the ring frees it on removal).
+ */
+static inline void clr_push_front_cp_data(CLRing *ring, void *data,
+                                          size_t dataSize) {
+  clr_push_front_node(ring, cl_create_node_cp_a(data, dataSize, NULL,
+                                                ring->alloc));
+}
+
+/**
+ * @brief Prepends data (deep copy).
+ */
+static inline void clr_push_front_deep_cp_data(CLRing *ring, void *data,
+                                               size_t dataSize) {
+  clr_push_front_node(ring, cl_create_node_deep_cp_a(data, dataSize, NULL,
+                                                     ring->alloc));
+}
+
+/**
+ * @brief Moves the head to the back in O(1).
+ */
+static inline void clr_rotate(CLRing *ring) {
+  if (ring->tail)
+    ring->tail = ring->tail->next;
+  ring->served = 0;
+}
+
+/**
+ * @brief Moves the head to the back k times.
+ *
+ * Costs O(k mod size): a singly linked ring has to be walked to reach the
+ * new tail.
+ */
+static inline void clr_rotate_k(CLRing *ring, size_t k) {
+  if (ring->size == 0)
+    return;
+  for (k %= ring->size; k > 0; k--)
+    ring->tail = ring->tail->next;
+  ring->served = 0;
+}
+
+/**
+ * @brief Returns the head's data and moves the head to the back in O(1).
+ *
+ * Calling it repeatedly yields plain round-robin order.
+ * @return The data, or NULL when empty.
+ */
+static inline void *clr_advance(CLRing *ring) {
+  void *data;
+  if (ring->tail == NULL)
+    return NULL;
+  data = ring->tail->next->data;
+  clr_rotate(ring);
+  return data;
+}
+
+/**
+ * @brief Unlinks the head node in O(1) and returns it.
+ *
+ * @return The detached node (next set to NULL), or NULL when empty.
+ */
+static inline Node *clr_detach_front(CLRing *ring) {
+  Node *head;
+  if (ring->tail == NULL)
+    return NULL;
+  head = ring->tail->next;
+  if (head == ring->tail)
+    ring->tail = NULL;
+  else
+    ring->tail->next = head->next;
+  head->next = NULL;
+  ring->size--;
+  ring->served = 0;
+  return head;
+}
+
+/**
+ * @brief Removes the head and hands its data to the caller.
+ *
+ * @param dataSize Receives the size of the data (may be NULL).
+ * @return The data, or NULL when empty. Release it with the ring's allocator.
+ */
+static inline void *clr_pop_front(CLRing *ring, size_t *dataSize) {
+  Node *head = clr_detach_front(ring);
+  void *data;
+  if (head == NULL)
+    return NULL;
+  data = head->data;
+  if (dataSize)
+    *dataSize = head->dataLen;
+  cds_free(ring->alloc, head);
+  return data;
+}
+
+/**
+ * @brief Deletes the head (current) node and its data in O(1).
+ *
+ * @return false when empty.
+ */
+static inline bool clr_remove_current(CLRing *ring) {
+  Node *head = clr_detach_front(ring);
+  if (head == NULL)
+    return false;
+  cl_destroy_node_a(head, ring->alloc);
+  return true;
+}
+
+/**
+ * @brief Weight of an entry for clr_wrr_next().
+ */
+typedef size_t (*CLWeightFn)(const void *data, size_t dataLen, void *ctx);
+
+/**
+ * @brief Weighted round-robin pick.
+ *
+ * Returns the head's data until it has been picked `weight` times in a row,
+ * then rotates to the next entry. Entries of weight 0 are skipped. Each
+ * call is O(1) unless it has to skip zero-weight entries. Any push, rotate
+ * or removal restarts the count for the new head.
+ * @param weight Weight callback, evaluated for the head on each call.
+ * @param ctx Context passed to weight.
+ * @return The picked data, or NULL when the ring is empty or every weight is
+ * 0.
+ */
+static inline void *clr_wrr_next(CLRing *ring, CLWeightFn weight, void *ctx) {
+  for (size_t i = 0; i <= ring->size && ring->tail; i++) {
+    Node *head = ring->tail->next;
+    if (ring->served < weight(head->data, head->dataLen, ctx)) {
+      ring->served++;
+      return head->data;
+    }
+    clr_rotate(ring);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Frees every node and its data. The ring stays usable (empty).
+ */
+static inline void clr_free(CLRing *ring) {
+  while (clr_remove_current(ring))
+    ;
+}
 
 #endif // CIRCULARLINKEDLIST_H
@@ -0,0 +1,689 @@
+#ifndef CONCURRENTDOUBLELINKEDLIST_H
+#define CONCURRENTDOUBLELINKEDLIST_H
+
+#include "generics.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file concurrentdoublelinkedlist.h
+ * @brief Thread-safe doubly linked list (`cdl_*`).
+ *
+ * Implements a lazy list: every node carries its own mutex and a `marked`
+ * flag. Writers lock only the two or three nodes around the position they
+ * change (always left to right, so there is no deadlock) and then validate
+ * that nothing moved while they were locking. Readers never lock; they walk
+ * the `next` chain with acquire loads and skip marked nodes, so
+ * cdl_contains(), cdl_get_by_value() and friends are wait-free and operations
+ * in different regions of the list run in parallel.
+ *
+ * Unlinked nodes are not freed immediately because a reader may still be
+ * standing on them. Reclamation is epoch based: every thread gets its own
+ * reader record per list (found through a thread key, padded to a cache
+ * line), and every cdl_* call publishes the list epoch it runs in there
+ * with a plain store, so readers never write a shared line. A deleted node
+ * goes to the retired batch of its deleter's epoch. After a delete the
+ * writer scans the records and advances the epoch when every running call
+ * has caught up with it; the batch retired two epochs ago is freed at that
+ * moment. A list in continuous use thus keeps freeing nodes as long as no
+ * single call runs forever. cdl_reclaim() forces the remaining batches out
+ * and cdl_free_list() frees everything. Records of exited threads are
+ * reused by new threads.
+ *
+ * Nodes and data returned by the cdl_get_* functions stay valid only while
+ * the caller holds a section opened with cdl_enter() before the lookup.
+ */
+
+/**
+ * @struct CDLNode
+ * @brief Node of a concurrent doubly linked list.
+ */
+typedef struct CDLNode {
+    void *data;               /**< Pointer to stored data */
+    size_t dataSize;          /**< Size of the data in bytes */
+    struct CDLNode *next;     /**< Next node (atomic) */
+    struct CDLNode *previous; /**< Previous node (atomic) */
+    struct CDLNode *retired;  /**< Link on the retired chain */
+    pthread_mutex_t lock;     /**< Protects next/previous of this node */
+    int marked;               /**< Non-zero once logically deleted (atomic) */
+} CDLNode;
+
+/** @brief Cache line size used to keep reader records apart. */
+#ifndef CDL_CACHE_LINE
+#define CDL_CACHE_LINE 64
+#endif
+
+struct CDLList;
+
+/**
+ * @struct CDLReader
+ * @brief Per-thread reader record of one list.
+ */
+typedef struct CDLReader {
+    uint64_t state;           /**< epoch << 1 | 1 inside a section (atomic) */
+    unsigned nesting;         /**< Depth of nested cdl_enter() calls */
+    bool orphan;              /**< Its thread has exited (under reclaimLock) */
+    struct CDLList *list;     /**< List it belongs to */
+    struct CDLReader *next;   /**< Link in the list's reader chain */
+    char pad[CDL_CACHE_LINE]; /**< Keeps neighbours off the state line */
+} CDLReader;
+
+/**
+ * @struct CDLList
+ * @brief Handle of a concurrent doubly linked list.
+ */
+typedef struct CDLList {
+    CDLNode head;                /**< Head sentinel */
+    CDLNode tail;                /**< Tail sentinel */
+    size_t size;                 /**< Number of live nodes (atomic) */
+    char pad[CDL_CACHE_LINE];    /**< Keeps size writes off the epoch line */
+    uint64_t epoch;              /**< Grace-period counter (atomic) */
+    size_t anonymous;            /**< Calls running without a record (atomic) */
+    CDLReader *readers;          /**< Every reader record (atomic head) */
+    bool keyed;                  /**< readerKey was created */
+    pthread_key_t readerKey;     /**< Calling thread's CDLReader */
+    CDLNode *retired[3];         /**< Unlinked nodes per epoch mod 3 */
+    pthread_mutex_t reclaimLock; /**< Serializes advances and registration */
+    const CDSAllocator *alloc;   /**< Allocator for nodes and payloads */
+} CDLList;
+
+static inline CDLNode *cdl_load_next(CDLNode *node) {
+  return __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+}
+
+static inline bool cdl_is_marked(CDLNode *node) {
+  return __atomic_load_n(&node->marked, __ATOMIC_ACQUIRE) != 0;
+}
+
+static inline bool cdl_matches(CDLNode *node, void *data, size_t dataSize) {
+  return node->data && data && node->dataSize == dataSize &&
+         memcmp(node->data, data, dataSize) == 0;
+}
+
+/**
+ * @brief Initializes an empty list.
+ * @param list List handle.
+ * @param alloc Allocator for nodes and payloads, NULL for the default one.
+ */
+static inline void cdl_reader_exit(void *arg);
+
+static inline void cdl_init(CDLList *list, const CDSAllocator *alloc) {
+  memset(list, 0, sizeof(*list));
+  pthread_mutex_init(&list->head.lock, NULL);
+  pthread_mutex_init(&list->tail.lock, NULL);
+  pthread_mutex_init(&list->reclaimLock, NULL);
+  // without a key every call falls back to the shared anonymous counter
+  list->keyed = pthread_key_create(&list->readerKey, cdl_reader_exit) == 0;
+  list->head.next = &list->tail;
+  list->tail.previous = &list->head;
+  list->alloc = alloc ? alloc : cds_default_allocator();
+}
+
+/**
+ * @brief Returns the number of live nodes.
+ * @note The value may be stale as soon as it is returned.
+ */
+static inline size_t cdl_size(CDLList *list) {
+  return __atomic_load_n(&list->size, __ATOMIC_RELAXED);
+}
+
+static inline CDLNode *cdl_alloc_node(CDLList *list, void *data,
+                                      size_t dataSize) {
+  CDLNode *n = (CDLNode *)cds_alloc(list->alloc, sizeof(CDLNode));
+  n->data = data;
+  n->dataSize = dataSize;
+  n->next = NULL;
+  n->previous = NULL;
+  n->retired = NULL;
+  n->marked = 0;
+  pthread_mutex_init(&n->lock, NULL);
+  return n;
+}
+
+static inline void cdl_destroy_node(CDLList *list, CDLNode *n) {
+  pthread_mutex_destroy(&n->lock);
+  cds_free(list->alloc, n->data);
+  cds_free(list->alloc, n);
+}
+
+// token bit of a section counted in list->anonymous
+#define CDL_ANONYMOUS (UINT64_C(1) << 63)
+
+static inline void cdl_reader_exit(void *arg) {
+  CDLReader *r = (CDLReader *)arg;
+  pthread_mutex_lock(&r->list->reclaimLock);
+  r->orphan = true;
+  pthread_mutex_unlock(&r->list->reclaimLock);
+}
+
+// returns the calling thread's record, adopting an orphan or creating one
+static inline CDLReader *cdl_reader(CDLList *list) {
+  CDLReader *r;
+  if (!list->keyed)
+    return NULL;
+  r = (CDLReader *)pthread_getspecific(list->readerKey);
+  if (r != NULL)
+    return r;
+  pthread_mutex_lock(&list->reclaimLock);
+  for (r = list->readers; r != NULL && !r->orphan; r = r->next)
+    ;
+  if (r != NULL) {
+    r->orphan = false;
+  } else {
+    r = (CDLReader *)cds_alloc(list->alloc, sizeof(CDLReader));
+    if (r != NULL) {
+      memset(r, 0, sizeof(*r));
+      r->list = list;
+      r->next = list->readers;
+      __atomic_store_n(&list->readers, r, __ATOMIC_RELEASE);
+    }
+  }
+  pthread_mutex_unlock(&list->reclaimLock);
+  if (r != NULL)
+    pthread_setspecific(list->readerKey, r);
+  return r;
+}
+
+/**
+ * @brief Opens a read section: nodes seen inside it are not freed.
+ *
+ * Every cdl_* call opens its own section. Open one yourself to keep using
+ * a node or its data returned by cdl_get_by_value(), cdl_get_by_index() or
+ * cdl_get_at_index() after the call returns. Sections may nest.
+ * @return Token for cdl_exit().
+ */
+static inline uint64_t cdl_enter(CDLList *list) {
+  CDLReader *r = cdl_reader(list);
+  if (r == NULL) {
+    // no record (no memory or no key): hold every advance off instead
+    __atomic_add_fetch(&list->anonymous, 1, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&list->epoch, __ATOMIC_SEQ_CST) | CDL_ANONYMOUS;
+  }
+  if (r->nesting++ > 0)
+    return __atomic_load_n(&r->state, __ATOMIC_RELAXED) >> 1;
+  uint64_t e = __atomic_load_n(&list->epoch, __ATOMIC_RELAXED);
+  for (;;) {
+    // publish, then make sure no advance slipped past the announcement
+    __atomic_store_n(&r->state, e << 1 | 1, __ATOMIC_SEQ_CST);
+    uint64_t now = __atomic_load_n(&list->epoch, __ATOMIC_SEQ_CST);
+    if (now == e)
+      return e;
+    e = now;
+  }
+}
+
+/**
+ * @brief Closes a section opened by cdl_enter().
+ */
+static inline void cdl_exit(CDLList *list, uint64_t token) {
+  if (token & CDL_ANONYMOUS) {
+    __atomic_sub_fetch(&list->anonymous, 1, __ATOMIC_RELEASE);
+    return;
+  }
+  CDLReader *r = (CDLReader *)pthread_getspecific(list->readerKey);
+  if (--r->nesting == 0)
+    __atomic_store_n(&r->state, 0, __ATOMIC_RELEASE);
+}
+
+static inline void cdl_retire(CDLList *list, CDLNode *n, uint64_t token) {
+  CDLNode **batch = &list->retired[(token & ~CDL_ANONYMOUS) % 3];
+  CDLNode *old = __atomic_load_n(batch, __ATOMIC_RELAXED);
+  do {
+    n->retired = old;
+  } while (!__atomic_compare_exchange_n(batch, &old, n, true,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static inline void cdl_free_chain(CDLList *list, CDLNode *n);
+
+/**
+ * @brief Advances the epoch by one if every running call has reached it.
+ *
+ * Going from e to e + 1 requires that every open section announced e, so
+ * the sections of e - 1, and with them the deleters of e - 2, have ended;
+ * nothing can still reach the nodes retired in e - 2. That batch is freed.
+ * @return true if the epoch advanced.
+ */
+static inline bool cdl_advance(CDLList *list) {
+  if (pthread_mutex_trylock(&list->reclaimLock) != 0)
+    return false;
+  uint64_t e = __atomic_load_n(&list->epoch, __ATOMIC_SEQ_CST);
+  bool behind = __atomic_load_n(&list->anonymous, __ATOMIC_SEQ_CST) != 0;
+  for (CDLReader *r = list->readers; r != NULL && !behind; r = r->next) {
+    uint64_t st = __atomic_load_n(&r->state, __ATOMIC_SEQ_CST);
+    behind = (st & 1) && (st >> 1) != e;
+  }
+  if (behind) {
+    pthread_mutex_unlock(&list->reclaimLock);
+    return false;
+  }
+  // batch (e + 1) % 3 holds epoch e - 2; nobody can retire into it until
+  // the epoch below is published
+  CDLNode *expired =
+      __atomic_exchange_n(&list->retired[(e + 1) % 3], (CDLNode *)NULL,
+                          __ATOMIC_ACQUIRE);
+  __atomic_store_n(&list->epoch, e + 1, __ATOMIC_SEQ_CST);
+  pthread_mutex_unlock(&list->reclaimLock);
+  cdl_free_chain(list, expired);
+  return true;
+}
+
+/**
+ * @brief Links n between pred and succ if they are still adjacent and live.
+ * @return true on success, false if the caller has to retry.
+ */
+static inline bool cdl_link_between(CDLList *list, CDLNode *pred,
+                                    CDLNode *succ, CDLNode *n) {
+  bool ok;
+  pthread_mutex_lock(&pred->lock);
+  pthread_mutex_lock(&succ->lock);
+  ok = !cdl_is_marked(pred) && !cdl_is_marked(succ) && pred->next == succ;
+  if (ok) {
+    n->next = succ;
+    n->previous = pred;
+    __atomic_store_n(&pred->next, n, __ATOMIC_RELEASE);
+    __atomic_store_n(&succ->previous, n, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&list->size, 1, __ATOMIC_RELAXED);
+  }
+  pthread_mutex_unlock(&succ->lock);
+  pthread_mutex_unlock(&pred->lock);
+  return ok;
+}
+
+/**
+ * @brief Unlinks curr (which follows pred) if the neighbourhood is unchanged.
+ * @return 1 on success, 0 if curr was already deleted, -1 to retry.
+ */
+static inline int cdl_unlink(CDLList *list, CDLNode *pred, CDLNode *curr,
+                             uint64_t epoch) {
+  int res = -1;
+  pthread_mutex_lock(&pred->lock);
+  pthread_mutex_lock(&curr->lock);
+  if (cdl_is_marked(curr)) {
+    res = 0;
+  } else if (!cdl_is_marked(pred) && pred->next == curr) {
+    CDLNode *succ = curr->next;
+    pthread_mutex_lock(&succ->lock);
+    __atomic_store_n(&curr->marked, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&pred->next, succ, __ATOMIC_RELEASE);
+    __atomic_store_n(&succ->previous, pred, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&succ->lock);
+    __atomic_sub_fetch(&list->size, 1, __ATOMIC_RELAXED);
+    res = 1;
+  }
+  pthread_mutex_unlock(&curr->lock);
+  pthread_mutex_unlock(&pred->lock);
+  if (res == 1)
+    cdl_retire(list, curr, epoch);
+  return res;
+}
+
+static inline void cdl_push_front_node(CDLList *list, CDLNode *n) {
+  uint64_t token = cdl_enter(list);
+  for (;;) {
+    CDLNode *succ = cdl_load_next(&list->head);
+    if (cdl_link_between(list, &list->head, succ, n))
+      break;
+  }
+  cdl_exit(list, token);
+}
+
+static inline void cdl_push_back_node(CDLList *list, CDLNode *n) {
+  uint64_t token = cdl_enter(list);
+  for (;;) {
+    CDLNode *pred = __atomic_load_n(&list->tail.previous, __ATOMIC_ACQUIRE);
+    if (cdl_link_between(list, pred, &list->tail, n))
+      break;
+  }
+  cdl_exit(list, token);
+}
+
+/**
+ * @brief Walks to the live node at idx without taking any lock.
+ * @param list List handle.
+ * @param idx Zero-based index.
+ * @param pred Receives the live node before the result (or the head).
+ * @return The node at idx, or NULL if idx is out of bounds.
+ */
+static inline CDLNode *cdl_find_index(CDLList *list, size_t idx,
+                                      CDLNode **pred) {
+  CDLNode *p = &list->head;
+  CDLNode *c = cdl_load_next(p);
+  size_t i = 0;
+  while (c != &list->tail) {
+    if (!cdl_is_marked(c)) {
+      if (i == idx) {
+        if (pred)
+          *pred = p;
+        return c;
+      }
+      i++;
+      p = c;
+    }
+    c = cdl_load_next(c);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Walks to the first live node matching data without taking any lock.
+ */
+static inline CDLNode *cdl_find_value(CDLList *list, void *data,
+                                      size_t dataSize, CDLNode **pred) {
+  CDLNode *p = &list->head;
+  CDLNode *c = cdl_load_next(p);
+  while (c != &list->tail) {
+    if (!cdl_is_marked(c)) {
+      if (cdl_matches(c, data, dataSize)) {
+        if (pred)
+          *pred = p;
+        return c;
+      }
+      p = c;
+    }
+    c = cdl_load_next(c);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Appends data at the end of the list (move semantics).
+ * @param list List handle.
+ * @param data Pointer to the pointer of data (ownership transferred).
+ * @param dataSize Size of the data in bytes.
+ * @note The data must come from the list's allocator.
+ */
+static inline void cdl_push_back_mv_data(CDLList *list, void **data,
+                                         size_t dataSize) {
+  cdl_push_back_node(list, cdl_alloc_node(list, move(data), dataSize));
+}
+
+/**
+ * @brief Appends data at the end of the list (shallow copy).
+ * @note The list frees the data when the node is reclaimed.
+ */
+static inline void cdl_push_back_cp_data(CDLList *list, void *data,
+                                         size_t dataSize) {
+  cdl_push_back_node(list, cdl_alloc_node(list, data, dataSize));
+}
+
+static inline void *cdl_dup(CDLList *list, void *data, size_t dataSize) {
+  void *copy;
+  if (data == NULL || dataSize == 0)
+    return NULL;
+  copy = cds_alloc(list->alloc, dataSize);
+  memmove(copy, data, dataSize);
+  return copy;
+}
+
+/**
+ * @brief Appends data at the end of the list (deep copy).
+ */
+static inline void cdl_push_back_deep_cp_data(CDLList *list, void *data,
+                                              size_t dataSize) {
+  cdl_push_back_node(
+      list, cdl_alloc_node(list, cdl_dup(list, data, dataSize), dataSize));
+}
+
+/**
+ * @brief Prepends data at the beginning of the list (move semantics).
+ */
+static inline void cdl_push_front_mv_data(CDLList *list, void **data,
+                                          size_t dataSize) {
+  cdl_push_front_node(list, cdl_alloc_node(list, move(data), dataSize));
+}
+
+/**
+ * @brief Prepends data at the beginning of the list (shallow copy).
+ * @note The list frees the data when the node is reclaimed.
+ */
+static inline void cdl_push_front_cp_data(CDLList *list, void *data,
+                                          size_t dataSize) {
+  cdl_push_front_node(list, cdl_alloc_node(list, data, dataSize));
+}
+
+/**
+ * @brief Prepends data at the beginning of the list (deep copy).
+ */
+static inline void cdl_push_front_deep_cp_data(CDLList *list, void *data,
+                                               size_t dataSize) {
+  cdl_push_front_node(
+      list, cdl_alloc_node(list, cdl_dup(list, data, dataSize), dataSize));
+}
+
+/**
+ * @brief Inserts a node before the live node currently at idx.
+ * @return true if inserted, false if idx was out of bounds.
+ * @note On failure the node is left untouched and still owned by the caller.
+ */
+static inline bool cdl_insert_at_index_node(CDLList *list, CDLNode *n,
+                                            size_t idx) {
+  uint64_t token = cdl_enter(list);
+  bool ok;
+  for (;;) {
+    CDLNode *pred;
+    CDLNode *succ = cdl_find_index(list, idx, &pred);
+    if (succ == NULL) {
+      ok = false;
+      break;
+    }
+    if (cdl_link_between(list, pred, succ, n)) {
+      ok = true;
+      break;
+    }
+  }
+  cdl_exit(list, token);
+  return ok;
+}
+
+/**
+ * @brief Inserts new data at the specified index (move semantics).
+ * @param list List handle.
+ * @param data Pointer to the pointer of data (ownership transferred).
+ * @param dataSize Size of the data in bytes.
+ * @param idx Zero-based index where the data should be inserted.
+ * @return true if inserted; on false the data is left with the caller.
+ */
+static inline bool cdl_insert_at_index_mv_data(CDLList *list, void **data,
+                                               size_t dataSize, size_t idx) {
+  CDLNode *n = cdl_alloc_node(list, *data, dataSize);
+  if (!cdl_insert_at_index_node(list, n, idx)) {
+    n->data = NULL;
+    cdl_destroy_node(list, n);
+    return false;
+  }
+  *data = NULL;
+  return true;
+}
+
+/**
+ * @brief Inserts new data at the specified index (shallow copy).
+ * @return true if inserted, false if idx was out of bounds.
+ */
+static inline bool cdl_insert_at_index_cp_data(CDLList *list, void *data,
+                                               size_t dataSize, size_t idx) {
+  CDLNode *n = cdl_alloc_node(list, data, dataSize);
+  if (!cdl_insert_at_index_node(list, n, idx)) {
+    n->data = NULL;
+    cdl_destroy_node(list, n);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Inserts new data at the specified index (deep copy).
+ * @return true if inserted, false if idx was out of bounds.
+ */
+static inline bool cdl_insert_at_index_deep_cp_data(CDLList *list, void *data,
+                                                    size_t dataSize,
+                                                    size_t idx) {
+  CDLNode *n = cdl_alloc_node(list, cdl_dup(list, data, dataSize), dataSize);
+  if (!cdl_insert_at_index_node(list, n, idx)) {
+    cdl_destroy_node(list, n);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Deletes the live node at the specified index.
+ * @param list List handle.
+ * @param idx Zero-based index of the node to delete.
+ * @return true if a node was deleted.
+ */
+static inline bool cdl_delete_at_index(CDLList *list, size_t idx) {
+  uint64_t token = cdl_enter(list);
+  bool ok;
+  for (;;) {
+    CDLNode *pred;
+    CDLNode *curr = cdl_find_index(list, idx, &pred);
+    if (curr == NULL) {
+      ok = false;
+      break;
+    }
+    if (cdl_unlink(list, pred, curr, token) == 1) {
+      ok = true;
+      break;
+    }
+  }
+  cdl_exit(list, token);
+  if (ok)
+    cdl_advance(list);
+  return ok;
+}
+
+/**
+ * @brief Deletes the first live node whose data matches the given value.
+ * @return true if a node was deleted.
+ */
+static inline bool cdl_delete_by_value(CDLList *list, void *data,
+                                       size_t dataSize) {
+  uint64_t token = cdl_enter(list);
+  bool ok;
+  for (;;) {
+    CDLNode *pred;
+    CDLNode *curr = cdl_find_value(list, data, dataSize, &pred);
+    if (curr == NULL) {
+      ok = false;
+      break;
+    }
+    if (cdl_unlink(list, pred, curr, token) == 1) {
+      ok = true;
+      break;
+    }
+  }
+  cdl_exit(list, token);
+  if (ok)
+    cdl_advance(list);
+  return ok;
+}
+
+/**
+ * @brief Checks if a value exists in the list. Never blocks.
+ */
+static inline bool cdl_contains(CDLList *list, void *data, size_t dataSize) {
+  uint64_t token = cdl_enter(list);
+  bool found = cdl_find_value(list, data, dataSize, NULL) != NULL;
+  cdl_exit(list, token);
+  return found;
+}
+
+/**
+ * @brief Returns the first live node whose data matches the given value.
+ * @return Pointer to the node, or NULL if not found.
+ * @note If another thread may delete it, only use the node inside a
+ * cdl_enter() section opened before the call.
+ */
+static inline CDLNode *cdl_get_by_value(CDLList *list, void *data,
+                                        size_t dataSize) {
+  uint64_t token = cdl_enter(list);
+  CDLNode *n = cdl_find_value(list, data, dataSize, NULL);
+  cdl_exit(list, token);
+  return n;
+}
+
+/**
+ * @brief Returns the live node at the specified index. Never blocks.
+ * @return Pointer to the node, or NULL if out of bounds.
+ * @note Same lifetime rule as cdl_get_by_value().
+ */
+static inline CDLNode *cdl_get_by_index(CDLList *list, size_t idx) {
+  uint64_t token = cdl_enter(list);
+  CDLNode *n = cdl_find_index(list, idx, NULL);
+  cdl_exit(list, token);
+  return n;
+}
+
+/**
+ * @brief Returns the data at the specified index. Never blocks.
+ * @return Pointer to data or NULL if out of bounds.
+ * @note Same lifetime rule as cdl_get_by_value().
+ */
+static inline void *cdl_get_at_index(CDLList *list, size_t idx) {
+  CDLNode *n = cdl_get_by_index(list, idx);
+  return n ? n->data : NULL;
+}
+
+static inline void cdl_free_chain(CDLList *list, CDLNode *n) {
+  while (n != NULL) {
+    CDLNode *next = n->retired;
+    cdl_destroy_node(list, n);
+    n = next;
+  }
+}
+
+/**
+ * @brief Frees the retired nodes that are safe to free, without waiting.
+ *
+ * Deletes already reclaim as they go; this pushes the last batches out,
+ * e.g. once the list falls idle. With no other cdl_* call running it frees
+ * every retired node.
+ * @return Number of epochs advanced (0 to 3).
+ */
+static inline int cdl_reclaim(CDLList *list) {
+  int advanced = 0;
+  while (advanced < 3 && cdl_advance(list))
+    advanced++;
+  return advanced;
+}
+
+/**
+ * @brief Frees the entire list, including retired nodes.
+ * @note Not thread-safe; the list must be quiescent. The handle can be
+ * reused after another cdl_init().
+ */
+static inline void cdl_free_list(CDLList *list) {
+  CDLNode *c = list->head.next;
+  while (c != &list->tail) {
+    CDLNode *next = c->next;
+    cdl_destroy_node(list, c);
+    c = next;
+  }
+  for (int i = 0; i < 3; i++) {
+    cdl_free_chain(list, list->retired[i]);
+    list->retired[i] = NULL;
+  }
+  list->head.next = &list->tail;
+  list->tail.previous = &list->head;
+  list->size = 0;
+  if (list->keyed) {
+    pthread_setspecific(list->readerKey, NULL);
+    pthread_key_delete(list->readerKey);
+    list->keyed = false;
+  }
+  while (list->readers != NULL) {
+    CDLReader *next = list->readers->next;
+    cds_free(list->alloc, list->readers);
+    list->readers = next;
+  }
+  pthread_mutex_destroy(&list->head.lock);
+  pthread_mutex_destroy(&list->tail.lock);
+  pthread_mutex_destroy(&list->reclaimLock);
+}
+
+#endif // CONCURRENTDOUBLELINKEDLIST_H
@@ -56,17 +56,29 @@ static inline DLNode *dl_iterate_to_index(DLNode **root, int idx) {
   return current;
 }
 
+// links node in front of nati; shared by the insert_at_index functions so
+// that each records a single latency sample
+static inline void dl_link_before(DLNode **root, DLNode *nati, DLNode *node) {
+  node->previous = nati->previous;
+  node->next = nati;
+  if (nati->previous)
+    nati->previous->next = node;
+  else
+    *root = node;
+  nati->previous = node;
+}
+
 /**
- * @brief Creates a new node using move semantics for data ownership.
- * @param data Pointer to the pointer of data (ownership transferred).
- * @param dataSize Size of the data in bytes.
- * @param next Pointer to the next node.
- * @param previous Pointer to the previous node.
- * @return Pointer to the new node.
+ * @brief Allocator-aware variant of dl_create_node_mv().
+ * @param alloc Allocator used for the node.
+ * @note The moved data must come from the same allocator.
  */
-static inline DLNode *dl_create_node_mv(void **data, size_t dataSize,
-                                        DLNode *next, DLNode *previous) {
-  DLNode *newNode = (DLNode *)malloc(sizeof(DLNode));
+static inline DLNode *dl_create_node_mv_a(void **data, size_t dataSize,
+                                          DLNode *next, DLNode *previous,
+                                          const CDSAllocator *alloc) {
+  DLNode *newNode = (DLNode *)cds_alloc(alloc, sizeof(DLNode));
+  if (newNode == NULL)
+    return NULL;
   newNode->dataSize = dataSize;
   newNode->data = move(data);
   newNode->next = next;
@@ -81,17 +93,29 @@ static inline DLNode *dl_create_node_mv(void **data, size_t dataSize,
 }
 
 /**
- * @brief Creates a new node using shallow copy (pointer is not copied).
- * @param data Pointer to the data (not copied).
- * @param dataSize Size of the data.
+ * @brief Creates a new node using move semantics for data ownership.
+ * @param data Pointer to the pointer of data (ownership transferred).
+ * @param dataSize Size of the data in bytes.
  * @param next Pointer to the next node.
  * @param previous Pointer to the previous node.
- * @return Pointer to the new node.
- * @note Node does not own the data; do not free() it from Node.
+ * @return Pointer to the new node, or NULL if out of memory.
  */
-static inline DLNode *dl_create_node_cp(void *data, size_t dataSize,
+static inline DLNode *dl_create_node_mv(void **data, size_t dataSize,
                                         DLNode *next, DLNode *previous) {
-  DLNode *newNode = (DLNode *)malloc(sizeof(DLNode));
+  return dl_create_node_mv_a(data, dataSize, next, previous,
+                             cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_create_node_cp().
+ * @param alloc Allocator used for the node.
+ */
+static inline DLNode *dl_create_node_cp_a(void *data, size_t dataSize,
+                                          DLNode *next, DLNode *previous,
+                                          const CDSAllocator *alloc) {
+  DLNode *newNode = (DLNode *)cds_alloc(alloc, sizeof(DLNode));
+  if (newNode == NULL)
+    return NULL;
   newNode->dataSize = dataSize;
   newNode->data = data;
   newNode->next = next;
@@ -106,19 +130,37 @@ static inline DLNode *dl_create_node_cp(void *data, size_t dataSize,
 }
 
 /**
- * @brief Creates a new node with deep copy of the data.
- * @param data Pointer to the data to be copied.
+ * @brief Creates a new node using shallow copy (pointer is not copied).
+ * @param data Pointer to the data (not copied).
  * @param dataSize Size of the data.
  * @param next Pointer to the next node.
  * @param previous Pointer to the previous node.
- * @return Pointer to the new node.
+ * @return Pointer to the new node, or NULL if out of memory.
+ * @note Node does not own the data; do not free() it from Node.
  */
-static inline DLNode *dl_create_node_deep_cp(void *data, size_t dataSize,
-                                             DLNode *next, DLNode *previous) {
-  DLNode *newNode = (DLNode *)malloc(sizeof(DLNode));
+static inline DLNode *dl_create_node_cp(void *data, size_t dataSize,
+                                        DLNode *next, DLNode *previous) {
+  return dl_create_node_cp_a(data, dataSize, next, previous,
+                             cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_create_node_deep_cp().
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline DLNode *dl_create_node_deep_cp_a(void *data, size_t dataSize,
+                                               DLNode *next, DLNode *previous,
+                                               const CDSAllocator *alloc) {
+  DLNode *newNode = (DLNode *)cds_alloc(alloc, sizeof(DLNode));
+  if (newNode == NULL)
+    return NULL;
   newNode->dataSize = dataSize;
   if (data != NULL && dataSize > 0) {
-    newNode->data = malloc(dataSize);
+    newNode->data = cds_alloc(alloc, dataSize);
+    if (newNode->data == NULL) {
+      cds_free(alloc, newNode);
+      return NULL;
+    }
     memmove(newNode->data, data, dataSize);
   } else {
     newNode->data = NULL;
@@ -134,6 +176,33 @@ static inline DLNode *dl_create_node_deep_cp(void *data, size_t dataSize,
   return newNode;
 }
 
+/**
+ * @brief Creates a new node with deep copy of the data.
+ * @param data Pointer to the data to be copied.
+ * @param dataSize Size of the data.
+ * @param next Pointer to the next node.
+ * @param previous Pointer to the previous node.
+ * @return Pointer to the new node, or NULL if out of memory.
+ */
+static inline DLNode *dl_create_node_deep_cp(void *data, size_t dataSize,
+                                             DLNode *next, DLNode *previous) {
+  return dl_create_node_deep_cp_a(data, dataSize, next, previous,
+                                  cds_default_allocator());
+}
+
+/**
+ * @brief Releases a single node and its data through an allocator.
+ * @param node Node to release (may be NULL).
+ * @param alloc Allocator the node and its data were allocated with.
+ * @note The node must already be unlinked from its list.
+ */
+static inline void dl_destroy_node_a(DLNode *node, const CDSAllocator *alloc) {
+  if (node == NULL)
+    return;
+  cds_free(alloc, node->data);
+  cds_free(alloc, node);
+}
+
 /**
  * @brief Appends a node at the end of the list (move semantics).
  * @param root Pointer to the root node of the list.
@@ -165,19 +234,39 @@ static inline void dl_push_back_cp_node(DLNode **root, DLNode *newNode) {
 }
 
 /**
- * @brief Appends a node at the end of the list (deep copy of data).
- * @param root Pointer to the root node of the list.
- * @param newNode Node whose data is copied.
+ * @brief Allocator-aware variant of dl_push_back_deep_cp_node().
+ * @param alloc Allocator used for the copy.
  */
-static inline void dl_push_back_deep_cp_node(DLNode **root, DLNode *newNode) {
+static inline void dl_push_back_deep_cp_node_a(DLNode **root, DLNode *newNode,
+                                               const CDSAllocator *alloc) {
   if (*root == NULL) {
-    *root =
-        dl_create_node_deep_cp(newNode->data, newNode->dataSize, NULL, NULL);
+    *root = dl_create_node_deep_cp_a(newNode->data, newNode->dataSize, NULL,
+                                     NULL, alloc);
     return;
   }
   DLNode *current = dl_iterate_to_last_node(root);
-  current->next =
-      dl_create_node_deep_cp(newNode->data, newNode->dataSize, NULL, current);
+  current->next = dl_create_node_deep_cp_a(newNode->data, newNode->dataSize,
+                                           NULL, current, alloc);
+}
+
+/**
+ * @brief Appends a node at the end of the list (deep copy of data).
+ * @param root Pointer to the root node of the list.
+ * @param newNode Node whose data is copied.
+ */
+static inline void dl_push_back_deep_cp_node(DLNode **root, DLNode *newNode) {
+  dl_push_back_deep_cp_node_a(root, newNode, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_push_back_cp_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void dl_push_back_cp_data_a(DLNode **root, void *data,
+                                          size_t dataSize,
+                                          const CDSAllocator *alloc) {
+  dl_push_back_cp_node(root,
+                       dl_create_node_cp_a(data, dataSize, NULL, NULL, alloc));
 }
 
 /**
@@ -185,7 +274,18 @@ static inline void dl_push_back_deep_cp_node(DLNode **root, DLNode *newNode) {
  */
 static inline void dl_push_back_cp_data(DLNode **root, void *data,
                                         size_t dataSize) {
-  dl_push_back_cp_node(root, dl_create_node_cp(data, dataSize, NULL, NULL));
+  dl_push_back_cp_data_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_push_back_cp_data_deep().
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline void dl_push_back_cp_data_deep_a(DLNode **root, void *data,
+                                               size_t dataSize,
+                                               const CDSAllocator *alloc) {
+  dl_push_back_cp_node(
+      root, dl_create_node_deep_cp_a(data, dataSize, NULL, NULL, alloc));
 }
 
 /**
@@ -193,7 +293,18 @@ static inline void dl_push_back_cp_data(DLNode **root, void *data,
  */
 static inline void dl_push_back_cp_data_deep(DLNode **root, void *data,
                                         size_t dataSize) {
-  dl_push_back_cp_node(root, dl_create_node_deep_cp(data, dataSize, NULL, NULL));
+  dl_push_back_cp_data_deep_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_push_back_mv_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void dl_push_back_mv_data_a(DLNode **root, void **data,
+                                          size_t dataSize,
+                                          const CDSAllocator *alloc) {
+  DLNode *n = dl_create_node_mv_a(data, dataSize, NULL, NULL, alloc);
+  dl_push_back_mv_node(root, &n);
 }
 
 /**
@@ -201,8 +312,18 @@ static inline void dl_push_back_cp_data_deep(DLNode **root, void *data,
  */
 static inline void dl_push_back_mv_data(DLNode **root, void **data,
                                         size_t dataSize) {
-  DLNode *n = dl_create_node_mv(data, dataSize, NULL, NULL);
-  dl_push_back_mv_node(root, &n);
+  dl_push_back_mv_data_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_push_back_deep_cp_data().
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline void dl_push_back_deep_cp_data_a(DLNode **root, void *data,
+                                               size_t dataSize,
+                                               const CDSAllocator *alloc) {
+  dl_push_back_cp_node(
+      root, dl_create_node_deep_cp_a(data, dataSize, NULL, NULL, alloc));
 }
 
 /**
@@ -210,8 +331,7 @@ static inline void dl_push_back_mv_data(DLNode **root, void **data,
  */
 static inline void dl_push_back_deep_cp_data(DLNode **root, void *data,
                                              size_t dataSize) {
-  dl_push_back_deep_cp_node(root,
-                            dl_create_node_deep_cp(data, dataSize, NULL, NULL));
+  dl_push_back_deep_cp_data_a(root, data, dataSize, cds_default_allocator());
 }
 
 /**
@@ -231,21 +351,30 @@ static inline void dl_push_front_cp_node(DLNode **root, DLNode *newNode) {
 }
 
 /**
- * @brief Prepends a node at the beginning of the list (deep copy).
+ * @brief Allocator-aware variant of dl_push_front_deep_cp_node().
+ * @param alloc Allocator used for the copy.
  */
-static inline void dl_push_front_deep_cp_node(DLNode **root, DLNode *newNode) {
+static inline void dl_push_front_deep_cp_node_a(DLNode **root, DLNode *newNode,
+                                                const CDSAllocator *alloc) {
   if (*root == NULL) {
-    *root =
-        dl_create_node_deep_cp(newNode->data, newNode->dataSize, NULL, NULL);
+    *root = dl_create_node_deep_cp_a(newNode->data, newNode->dataSize, NULL,
+                                     NULL, alloc);
     return;
   }
-  DLNode *newCopied =
-      dl_create_node_deep_cp(newNode->data, newNode->dataSize, NULL, NULL);
+  DLNode *newCopied = dl_create_node_deep_cp_a(newNode->data, newNode->dataSize,
+                                               NULL, NULL, alloc);
   newCopied->next = *root;
   (*root)->previous = newCopied;
   *root = newCopied;
 }
 
+/**
+ * @brief Prepends a node at the beginning of the list (deep copy).
+ */
+static inline void dl_push_front_deep_cp_node(DLNode **root, DLNode *newNode) {
+  dl_push_front_deep_cp_node_a(root, newNode, cds_default_allocator());
+}
+
 /**
  * @brief Prepends a node at the beginning of the list (move semantics).
  */
@@ -262,19 +391,53 @@ static inline void dl_push_front_mv_node(DLNode **root, DLNode **newNode) {
   *root = (DLNode *)move((void **)newNode);
 }
 
+/**
+ * @brief Allocator-aware variant of dl_push_front_cp_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void dl_push_front_cp_data_a(DLNode **root, void *data,
+                                           size_t dataSize,
+                                           const CDSAllocator *alloc) {
+  dl_push_front_cp_node(root,
+                        dl_create_node_cp_a(data, dataSize, NULL, NULL, alloc));
+}
+
 /**
  * @brief Prepends data at the beginning of the list (shallow copy).
  */
 static inline void dl_push_front_cp_data(DLNode **root, void *data,
                                          size_t dataSize) {
-  dl_push_front_cp_node(root, dl_create_node_cp(data, dataSize, NULL, NULL));
+  dl_push_front_cp_data_a(root, data, dataSize, cds_default_allocator());
 }
+
+/**
+ * @brief Allocator-aware variant of dl_push_front_cp_data_deep().
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline void dl_push_front_cp_data_deep_a(DLNode **root, void *data,
+                                                size_t dataSize,
+                                                const CDSAllocator *alloc) {
+  dl_push_front_cp_node(
+      root, dl_create_node_deep_cp_a(data, dataSize, NULL, NULL, alloc));
+}
+
 /**
  * @brief Prepends data at the beginning of the list (shallow copy).
  */
 static inline void dl_push_front_cp_data_deep(DLNode **root, void *data,
                                          size_t dataSize) {
-  dl_push_front_cp_node(root, dl_create_node_deep_cp(data, dataSize, NULL, NULL));
+  dl_push_front_cp_data_deep_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_push_front_deep_cp_data().
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline void dl_push_front_deep_cp_data_a(DLNode **root, void *data,
+                                                size_t dataSize,
+                                                const CDSAllocator *alloc) {
+  dl_push_front_cp_node(
+      root, dl_create_node_deep_cp_a(data, dataSize, NULL, NULL, alloc));
 }
 
 /**
@@ -282,8 +445,18 @@ static inline void dl_push_front_cp_data_deep(DLNode **root, void *data,
  */
 static inline void dl_push_front_deep_cp_data(DLNode **root, void *data,
                                               size_t dataSize) {
-  dl_push_front_deep_cp_node(
-      root, dl_create_node_deep_cp(data, dataSize, NULL, NULL));
+  dl_push_front_deep_cp_data_a(root, data, dataSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_push_front_mv_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void dl_push_front_mv_data_a(DLNode **root, void **data,
+                                           size_t dataSize,
+                                           const CDSAllocator *alloc) {
+  DLNode *n = dl_create_node_mv_a(data, dataSize, NULL, NULL, alloc);
+  dl_push_front_mv_node(root, &n);
 }
 
 /**
@@ -291,16 +464,15 @@ static inline void dl_push_front_deep_cp_data(DLNode **root, void *data,
  */
 static inline void dl_push_front_mv_data(DLNode **root, void **data,
                                          size_t dataSize) {
-  DLNode *n = dl_create_node_mv(data, dataSize, NULL, NULL);
-  dl_push_front_mv_node(root, &n);
+  dl_push_front_mv_data_a(root, data, dataSize, cds_default_allocator());
 }
 
 /**
- * @brief Deletes a node at the specified index.
- * @param root Pointer to the root node.
- * @param index Zero-based index of the node to delete.
+ * @brief Allocator-aware variant of dl_delete_at_index().
+ * @param alloc Allocator the list was built with.
  */
-static inline void dl_delete_at_index(DLNode **root, size_t index) {
+static inline void dl_delete_at_index_a(DLNode **root, size_t index,
+                                        const CDSAllocator *alloc) {
   if (*root == NULL)
     return;
 
@@ -322,19 +494,25 @@ static inline void dl_delete_at_index(DLNode **root, size_t index) {
   if (current->next)
     current->next->previous = current->previous;
 
-  if (current->data)
-    free(current->data);
-  free(current);
+  dl_destroy_node_a(current, alloc);
 }
 
 /**
- * @brief Deletes the first node whose data matches the given value.
+ * @brief Deletes a node at the specified index.
  * @param root Pointer to the root node.
- * @param data Pointer to the value to match.
- * @param dataSize Size of the value.
+ * @param index Zero-based index of the node to delete.
  */
-static inline void dl_delete_by_value(DLNode **root, void *data,
-                                      size_t dataSize) {
+static inline void dl_delete_at_index(DLNode **root, size_t index) {
+  dl_delete_at_index_a(root, index, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_delete_by_value().
+ * @param alloc Allocator the list was built with.
+ */
+static inline void dl_delete_by_value_a(DLNode **root, void *data,
+                                        size_t dataSize,
+                                        const CDSAllocator *alloc) {
   if (*root == NULL)
     return;
 
@@ -351,15 +529,24 @@ static inline void dl_delete_by_value(DLNode **root, void *data,
       if (current->next)
         current->next->previous = current->previous;
 
-      if (current->data)
-        free(current->data);
-      free(current);
+      dl_destroy_node_a(current, alloc);
       return;
     }
     current = current->next;
   }
 }
 
+/**
+ * @brief Deletes the first node whose data matches the given value.
+ * @param root Pointer to the root node.
+ * @param data Pointer to the value to match.
+ * @param dataSize Size of the value.
+ */
+static inline void dl_delete_by_value(DLNode **root, void *data,
+                                      size_t dataSize) {
+  dl_delete_by_value_a(root, data, dataSize, cds_default_allocator());
+}
+
 /**
  * @brief Checks if a value exists in the list.
  * @param root Pointer to the root node.
@@ -378,24 +565,82 @@ static inline bool dl_contains(DLNode *root, void *data, size_t dataSize) {
   return false;
 }
 
+/**
+ * @brief Looks up the node at the specified index without printing.
+ * @param root Root node (may be NULL for an empty list).
+ * @param index Zero-based index.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus dl_try_get_by_index(DLNode *root, size_t index,
+                                            DLNode **out) {
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  DLNode *current = root;
+  for (size_t i = 0; current != NULL && i < index; i++)
+    current = current->next;
+  *out = current;
+  return current ? CDS_OK : CDS_ERR_OUT_OF_BOUNDS;
+}
+
+/**
+ * @brief Looks up the data at the specified index without printing.
+ * @param root Root node (may be NULL for an empty list).
+ * @param idx Zero-based index.
+ * @param out Receives the data pointer, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus dl_try_get_at_index(DLNode *root, int idx, void **out) {
+  DLNode *n = NULL;
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  CDSStatus status =
+      idx < 0 ? CDS_ERR_OUT_OF_BOUNDS : dl_try_get_by_index(root, (size_t)idx, &n);
+  *out = n ? n->data : NULL;
+  return status;
+}
+
+/**
+ * @brief Looks up the first node whose data matches a value without printing.
+ * @param root Root node (may be NULL for an empty list).
+ * @param data Pointer to the value to match.
+ * @param dataSize Size of the value.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NOT_FOUND.
+ */
+static inline CDSStatus dl_try_get_by_value(DLNode *root, void *data,
+                                            size_t dataSize, DLNode **out) {
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  if (data == NULL)
+    return CDS_ERR_NULL;
+  CDS_PROF_BEGIN();
+  for (DLNode *current = root; current != NULL; current = current->next) {
+    if (current->data && current->dataSize == dataSize &&
+        memcmp(current->data, data, dataSize) == 0) {
+      *out = current;
+      break;
+    }
+  }
+  CDS_PROF_END(LAT_DL_GET_BY_VALUE);
+  return *out ? CDS_OK : CDS_ERR_NOT_FOUND;
+}
+
 /**
  * @brief Returns the data at the specified index.
  * @param rootPtr Root node pointer.
  * @param idx Index to retrieve.
  * @return Pointer to data or NULL if out of bounds.
+ * @note Failures go through CDS_DIAGNOSTIC; use dl_try_get_at_index() on hot
+ * paths.
  */
 static inline void *dl_get_at_index(DLNode *rootPtr, int idx) {
-  DLNode *c = rootPtr;
-  int i = 0;
-  while (c->next != NULL && i < idx) {
-    c = c->next;
-    i++;
-  }
-  if (i < idx) {
-    fprintf(stderr, "Error: Index out of bounds.\n");
-    return NULL;
-  }
-  return c->data;
+  void *data;
+  CDSStatus status = dl_try_get_at_index(rootPtr, idx, &data);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Index out of bounds.\n");
+  return data;
 }
 
 /**
@@ -407,14 +652,14 @@ static inline void *dl_get_at_index(DLNode *rootPtr, int idx) {
  */
 static inline DLNode *dl_get_by_value(DLNode *root, void *data,
                                       size_t dataSize) {
+  CDS_PROF_BEGIN();
   DLNode *current = root;
-  while (current != NULL) {
-    if (current->data && data && current->dataSize == dataSize &&
-        memcmp(current->data, data, dataSize) == 0)
-      return current;
+  while (current != NULL &&
+         !(current->data && data && current->dataSize == dataSize &&
+           memcmp(current->data, data, dataSize) == 0))
     current = current->next;
-  }
-  return NULL;
+  CDS_PROF_END(LAT_DL_GET_BY_VALUE);
+  return current;
 }
 
 /**
@@ -446,25 +691,11 @@ static inline void dl_insert_at_index_mv_node(DLNode **root,
                                               DLNode **toBeInserted, int idx) {
   if (!root || !*root || !toBeInserted || !*toBeInserted)
     return;
-
+  CDS_PROF_BEGIN();
   DLNode *nati = dl_iterate_to_index(root, idx);
-  if (!nati)
-    return;
-
-  DLNode *newNode = (DLNode *)move((void **)toBeInserted);
-
-  if (nati->previous == NULL) {
-    newNode->previous = NULL;
-    newNode->next = nati;
-    nati->previous = newNode;
-    *root = newNode;
-    return;
-  }
-
-  newNode->previous = nati->previous;
-  newNode->next = nati;
-  nati->previous->next = newNode;
-  nati->previous = newNode;
+  if (nati)
+    dl_link_before(root, nati, (DLNode *)move((void **)toBeInserted));
+  CDS_PROF_END(LAT_DL_INSERT_AT_INDEX);
 }
 
 /**
@@ -480,23 +711,31 @@ static inline void dl_insert_at_index_cp_node(DLNode **root,
                                               DLNode *toBeInserted, int idx) {
   if (!root || !*root || !toBeInserted)
     return;
-
+  CDS_PROF_BEGIN();
   DLNode *nati = dl_iterate_to_index(root, idx);
-  if (!nati)
-    return;
+  if (nati)
+    dl_link_before(root, nati, toBeInserted);
+  CDS_PROF_END(LAT_DL_INSERT_AT_INDEX);
+}
 
-  if (nati->previous == NULL) {
-    toBeInserted->previous = NULL;
-    toBeInserted->next = nati;
-    nati->previous = toBeInserted;
-    *root = toBeInserted;
+/**
+ * @brief Allocator-aware variant of dl_insert_at_index_deep_cp_node().
+ * @param alloc Allocator used for the copy.
+ */
+static inline void dl_insert_at_index_deep_cp_node_a(DLNode **root,
+                                                     DLNode *toBeCopied,
+                                                     int idx,
+                                                     const CDSAllocator *alloc) {
+  if (!root || !*root || !toBeCopied)
     return;
-  }
-
-  toBeInserted->previous = nati->previous;
-  toBeInserted->next = nati;
-  nati->previous->next = toBeInserted;
-  nati->previous = toBeInserted;
+  CDS_PROF_BEGIN();
+  DLNode *nati = dl_iterate_to_index(root, idx);
+  if (nati)
+    dl_link_before(root, nati,
+                   dl_create_node_deep_cp_a(toBeCopied->data,
+                                            toBeCopied->dataSize, NULL, NULL,
+                                            alloc));
+  CDS_PROF_END(LAT_DL_INSERT_AT_INDEX);
 }
 
 /**
@@ -509,28 +748,26 @@ static inline void dl_insert_at_index_cp_node(DLNode **root,
 
 static inline void
 dl_insert_at_index_deep_cp_node(DLNode **root, DLNode *toBeCopied, int idx) {
-  if (!root || !*root || !toBeCopied)
-    return;
-
-  DLNode *nati = dl_iterate_to_index(root, idx);
-  if (!nati)
-    return;
-
-  DLNode *newNode = dl_create_node_deep_cp(toBeCopied->data,
-                                           toBeCopied->dataSize, NULL, NULL);
-
-  if (nati->previous == NULL) {
-    newNode->previous = NULL;
-    newNode->next = nati;
-    nati->previous = newNode;
-    *root = newNode;
-    return;
-  }
+  dl_insert_at_index_deep_cp_node_a(root, toBeCopied, idx,
+                                    cds_default_allocator());
+}
 
-  newNode->previous = nati->previous;
-  newNode->next = nati;
-  nati->previous->next = newNode;
-  nati->previous = newNode;
+/**
+ * @brief Allocator-aware variant of dl_insert_at_index_mv_data().
+ * @param alloc Allocator used for the node.
+ * @note If idx is out of bounds, the node and the moved data are released.
+ */
+static inline void dl_insert_at_index_mv_data_a(DLNode **root, void **data,
+                                                size_t dataSize, int idx,
+                                                const CDSAllocator *alloc) {
+  CDS_PROF_BEGIN();
+  DLNode *node = dl_create_node_mv_a(data, dataSize, NULL, NULL, alloc);
+  DLNode *nati = root && *root ? dl_iterate_to_index(root, idx) : NULL;
+  if (nati)
+    dl_link_before(root, nati, node);
+  else
+    dl_destroy_node_a(node, alloc);
+  CDS_PROF_END(LAT_DL_INSERT_AT_INDEX);
 }
 
 /**
@@ -543,8 +780,26 @@ dl_insert_at_index_deep_cp_node(DLNode **root, DLNode *toBeCopied, int idx) {
 
 static inline void dl_insert_at_index_mv_data(DLNode **root, void **data,
                                               size_t dataSize, int idx) {
-  DLNode *node = dl_create_node_mv(data, dataSize, NULL, NULL);
-  dl_insert_at_index_mv_node(root, &node, idx);
+  dl_insert_at_index_mv_data_a(root, data, dataSize, idx,
+                               cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_insert_at_index_cp_data().
+ * @param alloc Allocator used for the node.
+ * @note If idx is out of bounds, the node is released (the data is not).
+ */
+static inline void dl_insert_at_index_cp_data_a(DLNode **root, void *data,
+                                                size_t dataSize, int idx,
+                                                const CDSAllocator *alloc) {
+  CDS_PROF_BEGIN();
+  DLNode *node = dl_create_node_cp_a(data, dataSize, NULL, NULL, alloc);
+  DLNode *nati = root && *root ? dl_iterate_to_index(root, idx) : NULL;
+  if (nati)
+    dl_link_before(root, nati, node);
+  else
+    cds_free(alloc, node);
+  CDS_PROF_END(LAT_DL_INSERT_AT_INDEX);
 }
 
 /**
@@ -558,8 +813,26 @@ static inline void dl_insert_at_index_mv_data(DLNode **root, void **data,
 
 static inline void dl_insert_at_index_cp_data(DLNode **root, void *data,
                                               size_t dataSize, int idx) {
-  dl_insert_at_index_cp_node(
-      root, dl_create_node_cp(data, dataSize, NULL, NULL), idx);
+  dl_insert_at_index_cp_data_a(root, data, dataSize, idx,
+                               cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_insert_at_index_deep_cp_data().
+ * @param alloc Allocator used for the node and the copied data.
+ * @note If idx is out of bounds, the copy is released.
+ */
+static inline void dl_insert_at_index_deep_cp_data_a(DLNode **root, void *data,
+                                                     size_t dataSize, int idx,
+                                                     const CDSAllocator *alloc) {
+  CDS_PROF_BEGIN();
+  DLNode *node = dl_create_node_deep_cp_a(data, dataSize, NULL, NULL, alloc);
+  DLNode *nati = root && *root ? dl_iterate_to_index(root, idx) : NULL;
+  if (nati)
+    dl_link_before(root, nati, node);
+  else
+    dl_destroy_node_a(node, alloc);
+  CDS_PROF_END(LAT_DL_INSERT_AT_INDEX);
 }
 
 /**
@@ -572,29 +845,617 @@ static inline void dl_insert_at_index_cp_data(DLNode **root, void *data,
 
 static inline void dl_insert_at_index_deep_cp_data(DLNode **root, void *data,
                                                    size_t dataSize, int idx) {
-  dl_insert_at_index_deep_cp_node(
-      root, dl_create_node_deep_cp(data, dataSize, NULL, NULL), idx);
+  dl_insert_at_index_deep_cp_data_a(root, data, dataSize, idx,
+                                    cds_default_allocator());
 }
 
 /**
- * @brief Frees the entire doubly linked list.
- * @param root Pointer to the root node of the list.
- * @note Frees all nodes and their data, then sets *root to NULL.
+ * @brief Allocator-aware variant of dl_free_list().
+ * @param alloc Allocator the list was built with.
  */
-
-static inline void dl_free_list(DLNode **root) {
+static inline void dl_free_list_a(DLNode **root, const CDSAllocator *alloc) {
   if (!root || !*root)
     return;
-
+  CDS_PROF_BEGIN();
   DLNode *current = *root;
   while (current != NULL) {
     DLNode *next = current->next;
-    if (current->data)
-      free(current->data);
-    free(current);
+    dl_destroy_node_a(current, alloc);
     current = next;
   }
   *root = NULL;
+  CDS_PROF_END(LAT_DL_FREE_LIST);
+}
+
+/**
+ * @brief Frees the entire doubly linked list.
+ * @param root Pointer to the root node of the list.
+ * @note Frees all nodes and their data, then sets *root to NULL.
+ */
+
+static inline void dl_free_list(DLNode **root) {
+  dl_free_list_a(root, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_remove_if().
+ * @param alloc Allocator the list was built with.
+ */
+static inline size_t dl_remove_if_a(DLNode **root, CDSPredicateFn pred,
+                                    void *ctx, CDSReleaseFn release,
+                                    void *releaseCtx, DLNode **removed,
+                                    const CDSAllocator *alloc) {
+  size_t count = 0;
+  DLNode *removedTail = NULL;
+  DLNode *c = *root;
+  if (removed)
+    *removed = NULL;
+  while (c != NULL) {
+    DLNode *next = c->next;
+    if (pred(c->data, c->dataSize, ctx)) {
+      if (c->previous)
+        c->previous->next = next;
+      else
+        *root = next;
+      if (next)
+        next->previous = c->previous;
+      count++;
+      if (removed) {
+        c->previous = removedTail;
+        c->next = NULL;
+        if (removedTail)
+          removedTail->next = c;
+        else
+          *removed = c;
+        removedTail = c;
+      } else {
+        if (release)
+          release(c->data, c->dataSize, releaseCtx);
+        else
+          cds_free(alloc, c->data);
+        cds_free(alloc, c);
+      }
+    }
+    c = next;
+  }
+  return count;
+}
+
+/**
+ * @brief Removes every node whose data matches a predicate, in one pass.
+ * @param root Pointer to the root node of the list.
+ * @param pred Predicate; nodes for which it returns true are removed.
+ * @param ctx Context passed to pred.
+ * @param release Called with each removed payload; NULL frees it with the
+ * allocator, CDS_KEEP_DATA leaves it to the caller.
+ * @param releaseCtx Context passed to release.
+ * @param removed If not NULL, receives the removed nodes as a detached
+ * doubly linked chain in list order instead of freeing them (release is not
+ * called).
+ * @return Number of removed nodes.
+ */
+static inline size_t dl_remove_if(DLNode **root, CDSPredicateFn pred,
+                                  void *ctx, CDSReleaseFn release,
+                                  void *releaseCtx, DLNode **removed) {
+  return dl_remove_if_a(root, pred, ctx, release, releaseCtx, removed,
+                        cds_default_allocator());
+}
+
+/**
+ * @brief Stable n-way partition that relinks the existing nodes.
+ *
+ * Moves every node into outs[classify(...)] in one pass, keeping their
+ * relative order and rebuilding the `previous` links. Nothing is allocated
+ * or copied.
+ * @param root Pointer to the root node of the list; set to NULL.
+ * @param classify Returns the output index of a payload; indices >= nOuts go
+ * to the last output.
+ * @param ctx Context passed to classify.
+ * @param outs Array of nOuts root pointers, overwritten with the results.
+ * @param nOuts Number of outputs (> 0).
+ */
+static inline void dl_partition_n(DLNode **root, CDSClassifyFn classify,
+                                  void *ctx, DLNode **outs, size_t nOuts) {
+  DLNode *c = *root;
+  for (size_t i = 0; i < nOuts; i++)
+    outs[i] = NULL;
+  // during the pass each head's previous points at its tail
+  while (c != NULL) {
+    DLNode *next = c->next;
+    size_t k = classify(c->data, c->dataSize, ctx);
+    if (k >= nOuts)
+      k = nOuts - 1;
+    c->next = NULL;
+    if (outs[k]) {
+      DLNode *tail = outs[k]->previous;
+      tail->next = c;
+      c->previous = tail;
+    } else {
+      outs[k] = c;
+    }
+    outs[k]->previous = c;
+    c = next;
+  }
+  for (size_t i = 0; i < nOuts; i++)
+    if (outs[i])
+      outs[i]->previous = NULL;
+  *root = NULL;
+}
+
+/**
+ * @brief Stable partition into matching and non-matching lists (zero-copy).
+ * @param root Pointer to the root node of the list; set to NULL.
+ * @param matching Receives the nodes for which pred returns true.
+ * @param rest Receives the other nodes.
+ */
+static inline void dl_partition(DLNode **root, CDSPredicateFn pred, void *ctx,
+                                DLNode **matching, DLNode **rest) {
+  CDSPredicateBinder b = {pred, ctx};
+  DLNode *outs[2];
+  dl_partition_n(root, cds_predicate_to_index, &b, outs, 2);
+  *matching = outs[0];
+  *rest = outs[1];
+}
+
+/**
+ * @brief Keeps only the nodes matching pred, relinking the others.
+ * @param root Pointer to the root node; keeps the matches.
+ * @param rejected Receives the other nodes in their original order.
+ */
+static inline void dl_filter(DLNode **root, CDSPredicateFn pred, void *ctx,
+                             DLNode **rejected) {
+  DLNode *matching;
+  dl_partition(root, pred, ctx, &matching, rejected);
+  *root = matching;
+}
+
+/**
+ * @brief Counts the nodes of a list.
+ * @param root Root node of the list (may be NULL).
+ * @return Number of nodes.
+ */
+static inline size_t dl_count(const DLNode *root) {
+  size_t n = 0;
+  for (; root != NULL; root = root->next)
+    n++;
+  return n;
+}
+
+/**
+ * @brief Copies the payloads into a fixed-stride array in one pass.
+ *
+ * Each payload fills one stride-byte slot; shorter payloads are zero-padded
+ * and longer ones truncated.
+ * @param root Root node of the list.
+ * @param dst Destination of at least maxCount * stride bytes.
+ * @param stride Slot size in bytes.
+ * @param maxCount Number of slots in dst.
+ * @return Number of slots written.
+ */
+static inline size_t dl_to_array(const DLNode *root, void *dst, size_t stride,
+                                 size_t maxCount) {
+  size_t n = 0;
+  for (; root != NULL && n < maxCount; root = root->next, n++)
+    cds_stride_put((unsigned char *)dst + n * stride, stride, root->data,
+                   root->dataSize);
+  return n;
+}
+
+/**
+ * @brief Serializes the payloads in the length-prefixed packed format.
+ * @param root Root node of the list.
+ * @param dst Destination buffer, or NULL to only compute the size.
+ * @param dstSize Size of dst; the records from the first one that does not
+ * fit on are left out.
+ * @return Bytes needed for the whole list (see cds_packed_record_size()).
+ */
+static inline size_t dl_to_packed(const DLNode *root, void *dst,
+                                  size_t dstSize) {
+  size_t offset = 0;
+  for (; root != NULL; root = root->next)
+    cds_packed_put(dst, dstSize, &offset, root->data, root->dataSize);
+  return offset;
+}
+
+/**
+ * @brief Collects the payload pointers without copying the payloads.
+ * @param root Root node of the list.
+ * @param data Receives up to maxCount payload pointers.
+ * @param sizes Receives the payload sizes (may be NULL).
+ * @param maxCount Number of entries in data (and sizes).
+ * @return Number of entries written.
+ */
+static inline size_t dl_to_ptr_array(const DLNode *root, void **data,
+                                     size_t *sizes, size_t maxCount) {
+  size_t n = 0;
+  for (; root != NULL && n < maxCount; root = root->next, n++) {
+    data[n] = root->data;
+    if (sizes)
+      sizes[n] = root->dataSize;
+  }
+  return n;
+}
+
+/**
+ * @brief Allocator-aware variant of dl_to_array_alloc().
+ * @param alloc Allocator used for the array.
+ */
+static inline void *dl_to_array_alloc_a(const DLNode *root, size_t stride,
+                                        size_t *count,
+                                        const CDSAllocator *alloc) {
+  size_t n = dl_count(root);
+  void *dst;
+  *count = 0;
+  if (n == 0 || stride == 0)
+    return NULL;
+  dst = cds_alloc(alloc, n * stride);
+  if (dst != NULL)
+    *count = dl_to_array(root, dst, stride, n);
+  return dst;
+}
+
+/**
+ * @brief Allocates a fixed-stride array holding the payloads.
+ *
+ * Walks the list twice: dl_count() sizes the array, then dl_to_array()
+ * fills it. Call dl_to_array() directly when the count is already known.
+ * @param root Root node of the list.
+ * @param stride Slot size in bytes (see dl_to_array()).
+ * @param count Receives the number of slots.
+ * @return The array (release it with free()), or NULL if the list is empty
+ * or out of memory.
+ */
+static inline void *dl_to_array_alloc(const DLNode *root, size_t stride,
+                                      size_t *count) {
+  return dl_to_array_alloc_a(root, stride, count, cds_default_allocator());
+}
+
+// appends a node after *tail (or as the root) and makes it the new tail
+static inline void dl_link_after_tail(DLNode **root, DLNode **tail,
+                                      DLNode *n) {
+  n->next = NULL;
+  n->previous = *tail;
+  if (*tail)
+    (*tail)->next = n;
+  else
+    *root = n;
+  *tail = n;
+}
+
+static inline bool dl_link_deep_cp_a(DLNode **root, DLNode **tail,
+                                     const void *data, size_t dataSize,
+                                     const CDSAllocator *alloc) {
+  DLNode *n = (DLNode *)cds_alloc(alloc, sizeof(DLNode));
+  void *copy = cds_alloc(alloc, dataSize);
+  if (n == NULL || (copy == NULL && dataSize > 0)) {
+    cds_free(alloc, copy);
+    cds_free(alloc, n);
+    return false;
+  }
+  if (dataSize > 0)
+    memcpy(copy, data, dataSize);
+  n->data = copy;
+  n->dataSize = dataSize;
+  dl_link_after_tail(root, tail, n);
+  return true;
+}
+
+/**
+ * @brief Allocator-aware variant of dl_from_array().
+ * @param alloc Allocator used for the nodes and the copies.
+ */
+static inline CDSStatus dl_from_array_a(DLNode **root, const void *src,
+                                        size_t stride, size_t count,
+                                        const CDSAllocator *alloc) {
+  DLNode *tail = *root ? dl_iterate_to_last_node(root) : NULL;
+  for (size_t i = 0; i < count; i++)
+    if (!dl_link_deep_cp_a(root, &tail,
+                           (const unsigned char *)src + i * stride, stride,
+                           alloc))
+      return CDS_ERR_NO_MEMORY;
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends count stride-byte records, each deep-copied into a node.
+ *
+ * The end of the list is found once and every node is linked in O(1).
+ * @param root Pointer to the root node of the list.
+ * @param src Array of count * stride bytes.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the records appended so far
+ * kept.
+ */
+static inline CDSStatus dl_from_array(DLNode **root, const void *src,
+                                      size_t stride, size_t count) {
+  return dl_from_array_a(root, src, stride, count, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_from_packed().
+ * @param alloc Allocator used for the nodes and the copies.
+ */
+static inline CDSStatus dl_from_packed_a(DLNode **root, const void *src,
+                                         size_t srcSize,
+                                         const CDSAllocator *alloc) {
+  DLNode *tail = *root ? dl_iterate_to_last_node(root) : NULL;
+  size_t offset = 0;
+  const void *data;
+  size_t size;
+  while (cds_packed_get(src, srcSize, &offset, &data, &size))
+    if (!dl_link_deep_cp_a(root, &tail, data, size, alloc))
+      return CDS_ERR_NO_MEMORY;
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends the records of a packed buffer (see dl_to_packed()).
+ * @param root Pointer to the root node of the list.
+ * @param src Packed records; a truncated last record is ignored.
+ * @param srcSize Size of src in bytes.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the records appended so far
+ * kept.
+ */
+static inline CDSStatus dl_from_packed(DLNode **root, const void *src,
+                                       size_t srcSize) {
+  return dl_from_packed_a(root, src, srcSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of dl_from_ptr_array().
+ * @param alloc Allocator used for the nodes.
+ * @note The moved payloads must come from the same allocator.
+ */
+static inline CDSStatus dl_from_ptr_array_a(DLNode **root, void **data,
+                                            const size_t *sizes, size_t count,
+                                            const CDSAllocator *alloc) {
+  DLNode *tail = *root ? dl_iterate_to_last_node(root) : NULL;
+  for (size_t i = 0; i < count; i++) {
+    DLNode *n = (DLNode *)cds_alloc(alloc, sizeof(DLNode));
+    if (n == NULL)
+      return CDS_ERR_NO_MEMORY;
+    n->data = move(&data[i]);
+    n->dataSize = sizes[i];
+    dl_link_after_tail(root, &tail, n);
+  }
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends payloads by moving the pointers of an array into new nodes.
+ * @param root Pointer to the root node of the list.
+ * @param data Payload pointers (ownership transferred); each moved entry is
+ * set to NULL.
+ * @param sizes Payload sizes.
+ * @param count Number of entries.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY; entries not moved stay with the
+ * caller.
+ */
+static inline CDSStatus dl_from_ptr_array(DLNode **root, void **data,
+                                          const size_t *sizes, size_t count) {
+  return dl_from_ptr_array_a(root, data, sizes, count,
+                             cds_default_allocator());
+}
+
+/**
+ * @struct DLCursor
+ * @brief Position in a doubly linked list.
+ *
+ * The cursor sits between `before` and `node`. When it is past the end,
+ * `node` is NULL and `before` is the last node, so dl_cursor_prev() and
+ * insertion at the end stay O(1).
+ */
+typedef struct DLCursor {
+    DLNode **root;             /**< Root of the list */
+    DLNode *before;            /**< Node before the cursor (NULL at the start) */
+    DLNode *node;              /**< Current node (NULL past the end) */
+    size_t index;              /**< Index of the current node */
+    const CDSAllocator *alloc; /**< Allocator used by insert and erase */
+} DLCursor;
+
+/**
+ * @brief Allocator-aware variant of dl_cursor_init().
+ * @param alloc Allocator used by the cursor's insert and erase functions.
+ */
+static inline void dl_cursor_init_a(DLCursor *cur, DLNode **root,
+                                    const CDSAllocator *alloc) {
+  cur->root = root;
+  cur->before = NULL;
+  cur->node = *root;
+  cur->index = 0;
+  cur->alloc = alloc;
+}
+
+/**
+ * @brief Places a cursor on the first node of a list.
+ * @param cur Cursor to initialize.
+ * @param root Pointer to the root node.
+ */
+static inline void dl_cursor_init(DLCursor *cur, DLNode **root) {
+  dl_cursor_init_a(cur, root, cds_default_allocator());
+}
+
+/**
+ * @brief Returns true if the cursor is on a node (not past the end).
+ */
+static inline bool dl_cursor_valid(const DLCursor *cur) {
+  return cur->node != NULL;
+}
+
+/**
+ * @brief Returns the data of the current node, or NULL past the end.
+ */
+static inline void *dl_cursor_get(const DLCursor *cur) {
+  return cur->node ? cur->node->data : NULL;
+}
+
+/**
+ * @brief Returns the data of the node after the current one without moving.
+ */
+static inline void *dl_cursor_peek(const DLCursor *cur) {
+  return (cur->node && cur->node->next) ? cur->node->next->data : NULL;
+}
+
+/**
+ * @brief Moves to the next node.
+ * @return true if the cursor moved, false if it was already past the end.
+ */
+static inline bool dl_cursor_next(DLCursor *cur) {
+  if (cur->node == NULL)
+    return false;
+  cur->before = cur->node;
+  cur->node = cur->node->next;
+  cur->index++;
+  return true;
+}
+
+/**
+ * @brief Moves to the previous node.
+ * @return true if the cursor moved, false if it was on the first node.
+ */
+static inline bool dl_cursor_prev(DLCursor *cur) {
+  if (cur->before == NULL)
+    return false;
+  cur->node = cur->before;
+  cur->before = cur->node->previous;
+  cur->index--;
+  return true;
+}
+
+/**
+ * @brief Moves the cursor to an absolute index.
+ *
+ * Moves relative to the current position, or restarts from the root when
+ * that is closer.
+ * @return true if there is a node at idx.
+ */
+static inline bool dl_cursor_seek(DLCursor *cur, size_t idx) {
+  if (idx < cur->index && idx < cur->index - idx) {
+    cur->before = NULL;
+    cur->node = *cur->root;
+    cur->index = 0;
+  }
+  while (cur->index > idx && dl_cursor_prev(cur))
+    ;
+  while (cur->index < idx && dl_cursor_next(cur))
+    ;
+  return cur->index == idx && cur->node != NULL;
+}
+
+/**
+ * @brief Deletes the current node and moves to the following one.
+ * @return true if a node was deleted.
+ */
+static inline bool dl_cursor_erase(DLCursor *cur) {
+  DLNode *victim = cur->node;
+  if (victim == NULL)
+    return false;
+  if (victim->previous)
+    victim->previous->next = victim->next;
+  else
+    *cur->root = victim->next;
+  if (victim->next)
+    victim->next->previous = victim->previous;
+  cur->node = victim->next;
+  dl_destroy_node_a(victim, cur->alloc);
+  return true;
+}
+
+/**
+ * @brief Links a node before the current one (or at the end when past it).
+ * @note The cursor stays on the same node; its index grows by one.
+ */
+static inline void dl_cursor_insert_before_node(DLCursor *cur, DLNode *node) {
+  node->previous = cur->before;
+  node->next = cur->node;
+  if (cur->before)
+    cur->before->next = node;
+  else
+    *cur->root = node;
+  if (cur->node)
+    cur->node->previous = node;
+  cur->before = node;
+  cur->index++;
+}
+
+/**
+ * @brief Links a node after the current one.
+ * @return false (and leaves the node alone) if the cursor is past the end.
+ */
+static inline bool dl_cursor_insert_after_node(DLCursor *cur, DLNode *node) {
+  DLNode *c = cur->node;
+  if (c == NULL)
+    return false;
+  node->previous = c;
+  node->next = c->next;
+  if (c->next)
+    c->next->previous = node;
+  c->next = node;
+  return true;
+}
+
+/**
+ * @brief Inserts data before the current node (move semantics).
+ */
+static inline void dl_cursor_insert_before_mv_data(DLCursor *cur, void **data,
+                                                   size_t dataSize) {
+  dl_cursor_insert_before_node(
+      cur, dl_create_node_mv_a(data, dataSize, NULL, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data before the current node (shallow copy).
+ */
+static inline void dl_cursor_insert_before_cp_data(DLCursor *cur, void *data,
+                                                   size_t dataSize) {
+  dl_cursor_insert_before_node(
+      cur, dl_create_node_cp_a(data, dataSize, NULL, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data before the current node (deep copy).
+ */
+static inline void dl_cursor_insert_before_deep_cp_data(DLCursor *cur,
+                                                        void *data,
+                                                        size_t dataSize) {
+  dl_cursor_insert_before_node(
+      cur, dl_create_node_deep_cp_a(data, dataSize, NULL, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data after the current node (move semantics).
+ * @return false if the cursor is past the end; the data stays with the caller.
+ */
+static inline bool dl_cursor_insert_after_mv_data(DLCursor *cur, void **data,
+                                                  size_t dataSize) {
+  if (cur->node == NULL)
+    return false;
+  return dl_cursor_insert_after_node(
+      cur, dl_create_node_mv_a(data, dataSize, NULL, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data after the current node (shallow copy).
+ * @return false if the cursor is past the end.
+ */
+static inline bool dl_cursor_insert_after_cp_data(DLCursor *cur, void *data,
+                                                  size_t dataSize) {
+  if (cur->node == NULL)
+    return false;
+  return dl_cursor_insert_after_node(
+      cur, dl_create_node_cp_a(data, dataSize, NULL, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data after the current node (deep copy).
+ * @return false if the cursor is past the end.
+ */
+static inline bool dl_cursor_insert_after_deep_cp_data(DLCursor *cur,
+                                                       void *data,
+                                                       size_t dataSize) {
+  if (cur->node == NULL)
+    return false;
+  return dl_cursor_insert_after_node(
+      cur, dl_create_node_deep_cp_a(data, dataSize, NULL, NULL, cur->alloc));
 }
 
 #endif // DOUBLELINKEDLIST_H
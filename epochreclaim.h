@@ -0,0 +1,348 @@
+#ifndef EPOCHRECLAIM_H
+#define EPOCHRECLAIM_H
+
+#include "generics.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file epochreclaim.h
+ * @brief Epoch-based memory reclamation (`ebr_*`).
+ *
+ * Lock-free readers may still be standing on a node another thread has just
+ * unlinked, so it cannot be freed at once. With epoch-based reclamation each
+ * thread brackets its accesses with ebr_enter()/ebr_exit() and hands
+ * unlinked memory to ebr_retire() instead of free():
+ *
+ * - the domain keeps a global epoch; it advances when every thread inside a
+ *   critical section has seen the current value;
+ * - memory retired in epoch e is freed once the global epoch reaches e + 2,
+ *   when no critical section that could have reached it is left.
+ *
+ * ebr_enter() and ebr_exit() only touch the thread's own cache line (one
+ * atomic exchange on entry, one plain store on exit). Retired pointers are
+ * kept per thread in three epoch bags of chunked records, and every
+ * EBR_RETIRE_BATCH retirements the thread tries to advance the epoch and
+ * frees its expired bags, so reclamation is batched and amortized.
+ *
+ * ebr_retire_sl_node() and ebr_retire_dl_node() retire Node and DLNode
+ * together with their payload; any other memory goes through ebr_retire()
+ * with its own free function.
+ */
+
+#define EBR_CACHE_LINE 64
+
+/** @brief Retirements between two reclamation attempts. */
+#ifndef EBR_RETIRE_BATCH
+#define EBR_RETIRE_BATCH 64
+#endif
+
+/** @brief Records per chunk of a bag. */
+#define EBR_CHUNK_SIZE 62
+
+/**
+ * @brief Frees retired memory once it is safe.
+ */
+typedef void (*EBRFreeFn)(void *ptr, void *ctx);
+
+typedef struct EBRRetired {
+    void *ptr;    /**< Retired memory */
+    EBRFreeFn fn; /**< Called with ptr and ctx to free it */
+    void *ctx;    /**< Context for fn */
+} EBRRetired;
+
+typedef struct EBRChunk {
+    struct EBRChunk *next;              /**< Older chunk of the same bag */
+    size_t count;                       /**< Records used in items */
+    EBRRetired items[EBR_CHUNK_SIZE];   /**< Retired records */
+} EBRChunk;
+
+/**
+ * @struct EBRBag
+ * @brief Memory retired by one thread during one epoch.
+ */
+typedef struct EBRBag {
+    uint64_t epoch;   /**< Epoch the records were retired in */
+    EBRChunk *chunks; /**< Newest chunk first */
+} EBRBag;
+
+struct EBRDomain;
+
+/**
+ * @struct EBRThread
+ * @brief Per-thread registration with a domain.
+ * @note Give every thread its own instance (thread-local or on its stack).
+ */
+typedef struct EBRThread {
+    uint64_t state;            /**< epoch << 1 | 1 inside a section (atomic) */
+    unsigned nesting;          /**< Depth of nested ebr_enter() calls */
+    unsigned sinceCollect;     /**< Retirements since the last attempt */
+    EBRBag bags[3];            /**< Limbo bags, indexed by epoch % 3 */
+    EBRChunk *spare;           /**< Emptied chunk kept for reuse */
+    size_t pending;            /**< Records waiting in the bags */
+    struct EBRDomain *domain;  /**< Domain it is registered with */
+    struct EBRThread *next;    /**< Link in the domain's thread list */
+    char pad[EBR_CACHE_LINE];  /**< Keeps neighbours off the state line */
+} EBRThread;
+
+/**
+ * @struct EBRDomain
+ * @brief Reclamation domain shared by the threads of one or more structures.
+ */
+typedef struct EBRDomain {
+    uint64_t epoch;            /**< Global epoch, starts at 1 (atomic) */
+    char pad[EBR_CACHE_LINE - sizeof(uint64_t)]; /**< Own cache line */
+    pthread_mutex_t lock;      /**< Protects the thread list */
+    EBRThread *threads;        /**< Registered threads */
+    const CDSAllocator *alloc; /**< Allocator for the record chunks */
+} EBRDomain;
+
+/**
+ * @brief Initializes a domain.
+ * @param alloc Allocator for the retire records, NULL for the default one.
+ */
+static inline void ebr_domain_init(EBRDomain *domain,
+                                   const CDSAllocator *alloc) {
+  domain->epoch = 1;
+  pthread_mutex_init(&domain->lock, NULL);
+  domain->threads = NULL;
+  domain->alloc = alloc ? alloc : cds_default_allocator();
+}
+
+/**
+ * @brief Destroys a domain. Every thread must be unregistered.
+ */
+static inline void ebr_domain_destroy(EBRDomain *domain) {
+  pthread_mutex_destroy(&domain->lock);
+}
+
+/**
+ * @brief Returns the global epoch (for diagnostics).
+ */
+static inline uint64_t ebr_epoch(const EBRDomain *domain) {
+  return __atomic_load_n(&domain->epoch, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Registers the calling thread.
+ * @param thread Registration owned by the calling thread.
+ */
+static inline void ebr_register(EBRDomain *domain, EBRThread *thread) {
+  thread->state = 0;
+  thread->nesting = 0;
+  thread->sinceCollect = 0;
+  for (int i = 0; i < 3; i++) {
+    thread->bags[i].epoch = 0;
+    thread->bags[i].chunks = NULL;
+  }
+  thread->spare = NULL;
+  thread->pending = 0;
+  thread->domain = domain;
+  pthread_mutex_lock(&domain->lock);
+  thread->next = domain->threads;
+  domain->threads = thread;
+  pthread_mutex_unlock(&domain->lock);
+}
+
+/**
+ * @brief Enters a critical section; may be nested.
+ * @note Memory reached inside the section stays valid until the matching
+ * ebr_exit().
+ */
+static inline void ebr_enter(EBRThread *thread) {
+  if (thread->nesting++ > 0)
+    return;
+  // a sequentially consistent exchange (one locked instruction on x86) makes
+  // the announcement visible before any shared pointer is read, and is
+  // cheaper than a store followed by a full fence
+  __atomic_exchange_n(
+      &thread->state,
+      (__atomic_load_n(&thread->domain->epoch, __ATOMIC_ACQUIRE) << 1) | 1,
+      __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Leaves a critical section.
+ */
+static inline void ebr_exit(EBRThread *thread) {
+  if (--thread->nesting > 0)
+    return;
+  __atomic_store_n(&thread->state, (uint64_t)0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Returns true between ebr_enter() and the matching ebr_exit().
+ */
+static inline bool ebr_in_critical(const EBRThread *thread) {
+  return thread->nesting > 0;
+}
+
+static inline void ebr_free_bag(EBRThread *thread, EBRBag *bag) {
+  EBRChunk *c = bag->chunks;
+  bag->chunks = NULL;
+  while (c != NULL) {
+    EBRChunk *next = c->next;
+    for (size_t i = 0; i < c->count; i++)
+      c->items[i].fn(c->items[i].ptr, c->items[i].ctx);
+    thread->pending -= c->count;
+    if (thread->spare == NULL) {
+      c->count = 0;
+      thread->spare = c;
+    } else {
+      cds_free(thread->domain->alloc, c);
+    }
+    c = next;
+  }
+}
+
+/**
+ * @brief Tries to advance the global epoch.
+ *
+ * Fails while a thread inside a critical section has not yet seen the
+ * current epoch, or when another thread holds the registration lock.
+ * @return true if the epoch advanced.
+ */
+static inline bool ebr_try_advance(EBRDomain *domain) {
+  uint64_t epoch = __atomic_load_n(&domain->epoch, __ATOMIC_ACQUIRE);
+  bool ok = true;
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (pthread_mutex_trylock(&domain->lock) != 0)
+    return false;
+  for (EBRThread *t = domain->threads; t != NULL; t = t->next) {
+    uint64_t s = __atomic_load_n(&t->state, __ATOMIC_ACQUIRE);
+    if ((s & 1) && (s >> 1) != epoch) {
+      ok = false;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&domain->lock);
+  if (ok)
+    ok = __atomic_compare_exchange_n(&domain->epoch, &epoch, epoch + 1, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+  return ok;
+}
+
+/**
+ * @brief Frees the calling thread's retired memory that has become safe.
+ *
+ * Tries to advance the epoch first. Called automatically every
+ * EBR_RETIRE_BATCH retirements.
+ * @return Number of records still waiting.
+ */
+static inline size_t ebr_collect(EBRThread *thread) {
+  uint64_t epoch;
+  thread->sinceCollect = 0;
+  ebr_try_advance(thread->domain);
+  epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_ACQUIRE);
+  for (int i = 0; i < 3; i++)
+    if (thread->bags[i].chunks != NULL && thread->bags[i].epoch + 2 <= epoch)
+      ebr_free_bag(thread, &thread->bags[i]);
+  return thread->pending;
+}
+
+/**
+ * @brief Hands over unlinked memory, to be freed by fn(ptr, ctx) once no
+ * critical section can still reach it.
+ * @param ptr Memory no longer reachable by new critical sections.
+ * @param fn Free function; it runs on this thread, from ebr_retire(),
+ * ebr_collect(), ebr_barrier() or ebr_unregister().
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY if no record could be allocated (ptr
+ * is then still owned by the caller).
+ */
+static inline CDSStatus ebr_retire(EBRThread *thread, void *ptr, EBRFreeFn fn,
+                                   void *ctx) {
+  uint64_t epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_ACQUIRE);
+  EBRBag *bag = &thread->bags[epoch % 3];
+  EBRChunk *c;
+  if (bag->epoch != epoch) {
+    // whatever is left in this slot is from epoch - 3 at the latest
+    ebr_free_bag(thread, bag);
+    bag->epoch = epoch;
+  }
+  c = bag->chunks;
+  if (c == NULL || c->count == EBR_CHUNK_SIZE) {
+    if (thread->spare != NULL) {
+      c = thread->spare;
+      thread->spare = NULL;
+    } else {
+      c = (EBRChunk *)cds_alloc(thread->domain->alloc, sizeof(EBRChunk));
+      if (c == NULL)
+        return CDS_ERR_NO_MEMORY;
+      c->count = 0;
+    }
+    c->next = bag->chunks;
+    bag->chunks = c;
+  }
+  c->items[c->count].ptr = ptr;
+  c->items[c->count].fn = fn;
+  c->items[c->count].ctx = ctx;
+  c->count++;
+  thread->pending++;
+  if (++thread->sinceCollect >= EBR_RETIRE_BATCH)
+    ebr_collect(thread);
+  return CDS_OK;
+}
+
+/**
+ * @brief Waits until everything the calling thread retired has been freed.
+ * @note Must not be called inside a critical section.
+ */
+static inline void ebr_barrier(EBRThread *thread) {
+  while (ebr_collect(thread) > 0)
+    sched_yield();
+}
+
+/**
+ * @brief Frees the thread's retired memory (waiting for it to become safe)
+ * and unregisters it.
+ * @note Must not be called inside a critical section.
+ */
+static inline void ebr_unregister(EBRThread *thread) {
+  EBRDomain *domain = thread->domain;
+  ebr_barrier(thread);
+  cds_free(domain->alloc, thread->spare);
+  thread->spare = NULL;
+  pthread_mutex_lock(&domain->lock);
+  EBRThread **t = &domain->threads;
+  while (*t != NULL && *t != thread)
+    t = &(*t)->next;
+  if (*t != NULL)
+    *t = thread->next;
+  pthread_mutex_unlock(&domain->lock);
+}
+
+// ctx is the CDSAllocator of the node (NULL for the default one)
+static inline void ebr_free_sl_node(void *ptr, void *ctx) {
+  Node *n = (Node *)ptr;
+  cds_free((const CDSAllocator *)ctx, n->data);
+  cds_free((const CDSAllocator *)ctx, n);
+}
+
+static inline void ebr_free_dl_node(void *ptr, void *ctx) {
+  DLNode *n = (DLNode *)ptr;
+  cds_free((const CDSAllocator *)ctx, n->data);
+  cds_free((const CDSAllocator *)ctx, n);
+}
+
+/**
+ * @brief Retires an unlinked Node (sl_ or cl_) and its payload.
+ * @param alloc Allocator of the node and payload, NULL for the default one.
+ */
+static inline CDSStatus ebr_retire_sl_node(EBRThread *thread, Node *node,
+                                           const CDSAllocator *alloc) {
+  return ebr_retire(thread, node, ebr_free_sl_node, (void *)alloc);
+}
+
+/**
+ * @brief Retires an unlinked DLNode and its payload.
+ * @param alloc Allocator of the node and payload, NULL for the default one.
+ */
+static inline CDSStatus ebr_retire_dl_node(EBRThread *thread, DLNode *node,
+                                           const CDSAllocator *alloc) {
+  return ebr_retire(thread, node, ebr_free_dl_node, (void *)alloc);
+}
+
+#endif // EPOCHRECLAIM_H
@@ -0,0 +1,79 @@
+#include "circularlinkedlist.h"
+#include "doublelinkedlist.h"
+#include "linkedlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SAMPLES 20000
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+  double *values = (double *)malloc(SAMPLES * sizeof(double));
+  for (int i = 0; i < SAMPLES; i++)
+    values[i] = i * 0.5;
+
+  // import: push_back walks to the end each time, sl_from_array links once
+  Node *slow = NULL;
+  double start = now_seconds();
+  for (int i = 0; i < SAMPLES; i++)
+    sl_push_back_cp_data_deep(&slow, &values[i], sizeof(double));
+  double pushTime = now_seconds() - start;
+
+  Node *list = NULL;
+  start = now_seconds();
+  sl_from_array(&list, values, sizeof(double), SAMPLES);
+  double importTime = now_seconds() - start;
+  printf("import %d doubles: push_back loop %.1f ms, sl_from_array %.2f ms\n",
+         SAMPLES, pushTime * 1e3, importTime * 1e3);
+
+  // export: indexing is O(n) per element, sl_to_array is one pass
+  double *flat = (double *)malloc(SAMPLES * sizeof(double));
+  start = now_seconds();
+  for (int i = 0; i < SAMPLES; i++)
+    flat[i] = *(double *)sl_get_at_index(list, i);
+  double indexTime = now_seconds() - start;
+
+  start = now_seconds();
+  size_t n = sl_to_array(list, flat, sizeof(double), SAMPLES);
+  double exportTime = now_seconds() - start;
+  double sum = 0;
+  for (size_t i = 0; i < n; i++)
+    sum += flat[i];
+  printf("export: sl_get_at_index loop %.1f ms, sl_to_array %.2f ms "
+         "(%zu values, sum %.1f)\n",
+         indexTime * 1e3, exportTime * 1e3, n, sum);
+
+  // variable-length payloads travel as length-prefixed records
+  const char *words[] = {"alpha", "be", "gamma delta", ""};
+  DLNode *names = NULL;
+  for (int i = 0; i < 4; i++)
+    dl_push_back_cp_data_deep(&names, (void *)words[i], strlen(words[i]) + 1);
+  size_t bytes = dl_to_packed(names, NULL, 0);
+  void *packed = malloc(bytes);
+  dl_to_packed(names, packed, bytes);
+
+  Node *ring = NULL;
+  cl_from_packed(&ring, packed, bytes);
+  printf("\n%zu names packed into %zu bytes, rebuilt as a ring:",
+         dl_count(names), bytes);
+  const void *ptrs[4];
+  size_t got = cl_to_ptr_array(ring, (void **)ptrs, NULL, 4);
+  for (size_t i = 0; i < got; i++)
+    printf(" \"%s\"", (const char *)ptrs[i]);
+  printf("\n");
+
+  free(packed);
+  cl_free_list(&ring);
+  dl_free_list(&names);
+  sl_free_list(&list);
+  sl_free_list(&slow);
+  free(flat);
+  free(values);
+  return 0;
+}
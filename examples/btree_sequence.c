@@ -0,0 +1,87 @@
+#include "btreeseq.h"
+#include "linkedlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define ELEMENTS 1000000
+#define EDITS 100000
+#define LIST_ELEMENTS 20000
+#define LIST_EDITS 2000
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+  srand(42);
+
+  // baseline: positional edits on a singly linked list walk to the index
+  Node *list = NULL;
+  for (int i = 0; i < LIST_ELEMENTS; i++)
+    sl_push_back_cp_data_deep(&list, &i, sizeof(int));
+  double start = now_seconds();
+  for (int i = 0; i < LIST_EDITS; i++) {
+    int pos = rand() % LIST_ELEMENTS;
+    sl_insert_at_index_deep_cp_data(&list, &i, sizeof(int), pos);
+    sl_delete_at_index(&list, rand() % LIST_ELEMENTS);
+  }
+  double listTime = now_seconds() - start;
+  printf("sl_ insert+delete at index, %d elements: %.2f us per edit\n",
+         LIST_ELEMENTS, listTime * 1e6 / LIST_EDITS);
+  sl_free_list(&list);
+
+  // bulk load a million characters, then edit at random positions
+  char *text = (char *)malloc(ELEMENTS);
+  for (int i = 0; i < ELEMENTS; i++)
+    text[i] = (char)('a' + i % 26);
+  BTSeq seq;
+  bts_init(&seq, NULL);
+  start = now_seconds();
+  bts_from_array(&seq, text, 1, ELEMENTS);
+  printf("bts_from_array: %d elements in %.1f ms (height %zu)\n", ELEMENTS,
+         (now_seconds() - start) * 1e3, seq.height);
+
+  start = now_seconds();
+  for (int i = 0; i < EDITS; i++) {
+    char c = (char)('A' + i % 26);
+    bts_insert_at_index_deep_cp_data(&seq, &c, 1,
+                                     (size_t)rand() % (bts_size(&seq) + 1));
+    bts_delete_at_index(&seq, (size_t)rand() % bts_size(&seq));
+  }
+  double seqTime = now_seconds() - start;
+  printf("bts_ insert+delete at index, %zu elements: %.2f us per edit\n",
+         bts_size(&seq), seqTime * 1e6 / EDITS);
+
+  size_t upper = 0;
+  start = now_seconds();
+  for (int i = 0; i < EDITS; i++) {
+    char *c = (char *)bts_get_at_index(&seq, (size_t)rand() % bts_size(&seq));
+    upper += *c < 'a';
+  }
+  printf("bts_get_at_index: %.2f us per lookup\n",
+         (now_seconds() - start) * 1e6 / EDITS);
+
+  // the leaves are chained, so a cursor streams through the sequence
+  BTSCursor cur;
+  size_t scanned = 0;
+  start = now_seconds();
+  for (bts_cursor_init(&cur, &seq); bts_cursor_valid(&cur);
+       bts_cursor_next(&cur))
+    scanned += *(char *)bts_cursor_get(&cur) < 'a';
+  printf("cursor scan: %.1f ms, %zu upper-case characters (%zu sampled)\n",
+         (now_seconds() - start) * 1e3, scanned, upper);
+
+  // print a window around the middle of the edited text
+  bts_cursor_seek(&cur, &seq, bts_size(&seq) / 2);
+  printf("middle: ");
+  for (int i = 0; i < 40 && bts_cursor_valid(&cur); i++, bts_cursor_next(&cur))
+    putchar(*(char *)bts_cursor_get(&cur));
+  putchar('\n');
+
+  bts_free_list(&seq);
+  free(text);
+  return 0;
+}
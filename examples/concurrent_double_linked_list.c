@@ -0,0 +1,81 @@
+#include "concurrentdoublelinkedlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define INITIAL_SIZE 256
+#define OPS_PER_THREAD 20000
+
+static CDLList list;
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void *worker(void *arg) {
+  unsigned int seed = (unsigned int)(size_t)arg;
+  for (int i = 0; i < OPS_PER_THREAD; i++) {
+    int key = rand_r(&seed) % (INITIAL_SIZE * 2);
+    int op = rand_r(&seed) % 100;
+    if (op < 90) {
+      cdl_contains(&list, &key, sizeof(key));
+    } else if (op < 95) {
+      cdl_push_back_deep_cp_data(&list, &key, sizeof(key));
+    } else {
+      cdl_delete_by_value(&list, &key, sizeof(key));
+    }
+  }
+  return NULL;
+}
+
+static void print_list(CDLList *l) {
+  for (CDLNode *n = l->head.next; n != &l->tail; n = n->next)
+    printf("%s\n", (char *)n->data);
+}
+
+int main(void) {
+  printf("---------------\n");
+  printf("Basic usage\n");
+  printf("---------------\n");
+
+  cdl_init(&list, NULL);
+  cdl_push_back_deep_cp_data(&list, "Second", 7);
+  cdl_push_front_deep_cp_data(&list, "First", 6);
+  cdl_push_back_deep_cp_data(&list, "Fourth", 7);
+  cdl_insert_at_index_deep_cp_data(&list, "Third", 6, 2);
+  print_list(&list);
+  printf("Contains \"Third\": %d\n", cdl_contains(&list, "Third", 6));
+  printf("Data at index 1: %s\n", (char *)cdl_get_at_index(&list, 1));
+  cdl_delete_by_value(&list, "Second", 7);
+  cdl_delete_at_index(&list, 0);
+  print_list(&list);
+  cdl_free_list(&list);
+
+  printf("---------------\n");
+  printf("Scaling (90%% contains, 5%% push, 5%% delete)\n");
+  printf("---------------\n");
+
+  int threadCounts[] = {1, 2, 4, 8};
+  for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+    int n = threadCounts[t];
+    pthread_t threads[8];
+    cdl_init(&list, NULL);
+    for (int i = 0; i < INITIAL_SIZE; i++)
+      cdl_push_back_deep_cp_data(&list, &i, sizeof(i));
+
+    double start = now_seconds();
+    for (int i = 0; i < n; i++)
+      pthread_create(&threads[i], NULL, worker, (void *)(size_t)(i + 1));
+    for (int i = 0; i < n; i++)
+      pthread_join(threads[i], NULL);
+    double elapsed = now_seconds() - start;
+
+    printf("%d thread(s): %.2f Mops/s\n", n,
+           (double)n * OPS_PER_THREAD / elapsed / 1e6);
+    cdl_free_list(&list);
+  }
+  return 0;
+}
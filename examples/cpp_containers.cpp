@@ -0,0 +1,77 @@
+#include "cdscontainers.hpp"
+#include "linkedlist.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <string>
+
+#define LIST_SIZE 200000
+
+struct Point {
+  int x, y;
+  Point(int x, int y) : x(x), y(y) {}
+};
+
+static double now_seconds() {
+  using clock = std::chrono::steady_clock;
+  return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+}
+
+int main() {
+  // emplace constructs in place; no separate payload allocation
+  cds::slist<Point> points;
+  for (int i = 0; i < 5; i++)
+    points.emplace_back(i, i * i);
+  for (const Point &p : points)
+    printf("(%d, %d) ", p.x, p.y);
+  printf("\n");
+
+  // move-only and non-trivial types work
+  cds::dlist<std::string> words{"linked", "lists", "in", "c++"};
+  words.push_front(std::string("typed"));
+  words.remove_if([](const std::string &s) { return s.size() < 3; });
+  for (auto it = words.rbegin(); it != words.rend(); ++it)
+    printf("%s ", it->c_str());
+  printf("\n");
+
+  cds::dlist<std::unique_ptr<int>> owned;
+  owned.emplace_back(new int(42));
+  cds::dlist<std::unique_ptr<int>> stolen = std::move(owned);
+  printf("moved: %d (source size %zu)\n", *stolen.front(), owned.size());
+
+  // circular list with O(1) rotation
+  cds::clist<int> ring{1, 2, 3, 4};
+  ring.rotate();
+  for (int v : ring)
+    printf("%d ", v);
+  printf("\n");
+
+  // <algorithm> works through the iterators
+  cds::slist<int> numbers;
+  for (int i = LIST_SIZE - 1; i >= 0; i--)
+    numbers.push_front(i);
+  auto found = std::find(numbers.begin(), numbers.end(), 1234);
+  printf("found %d\n", *found);
+
+  // typed sum vs. the void * list
+  Node *root = NULL;
+  for (int i = LIST_SIZE - 1; i >= 0; i--)
+    sl_push_front_cp_data_deep(&root, &i, sizeof(i));
+
+  double start = now_seconds();
+  long long typedSum = std::accumulate(numbers.begin(), numbers.end(), 0LL);
+  double typedTime = now_seconds() - start;
+
+  start = now_seconds();
+  long long cSum = 0;
+  for (Node *n = root; n; n = n->next)
+    cSum += *(int *)n->data;
+  double cTime = now_seconds() - start;
+
+  printf("cds::slist sum %lld in %.3f ms, Node sum %lld in %.3f ms\n", typedSum,
+         typedTime * 1e3, cSum, cTime * 1e3);
+
+  sl_free_list(&root);
+  return 0;
+}
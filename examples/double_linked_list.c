@@ -3,6 +3,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+static bool longer_than(const void *data, size_t dataLen, void *ctx) {
+  (void)data;
+  return dataLen > *(size_t *)ctx;
+}
+
 static inline void print_list(DLNode *root) {
   DLNode *tmp = root;
   DLNode *last = root;
@@ -139,6 +144,34 @@ int main(void) {
     dl_insert_at_index_deep_cp_data(&root, (void*)dataFi, 8, 4);
     free(dataFi);
 
+    print_list(root);
+
+    printf("---------------\n");
+    printf("Cursor\n");
+    printf("---------------\n");
+
+    // walk to the end, then back to the front, inserting in a single pass
+    DLCursor cur;
+    dl_cursor_init(&cur, &root);
+    while (dl_cursor_next(&cur))
+      ;
+    dl_cursor_insert_before_deep_cp_data(&cur, "Last", 5);
+    while (dl_cursor_prev(&cur))
+      ;
+    dl_cursor_insert_before_deep_cp_data(&cur, "New first", 10);
+    if (dl_cursor_seek(&cur, 3)) {
+      printf("Data at index 3: %s\n", (char *)dl_cursor_get(&cur));
+      dl_cursor_erase(&cur);
+    }
+    print_list(root);
+
+    printf("---------------\n");
+    printf("Remove if\n");
+    printf("---------------\n");
+
+    size_t maxLen = 6;
+    size_t count = dl_remove_if(&root, longer_than, &maxLen, NULL, NULL, NULL);
+    printf("Removed %zu entries longer than %zu bytes\n", count, maxLen);
     print_list(root);
     dl_free_list(&root);
   return 0;
@@ -0,0 +1,97 @@
+#include "epochreclaim.h"
+#include "linkedlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define READERS 3
+#define UPDATES 100000
+#define ENTERS 10000000
+
+static EBRDomain domain;
+static Node *head; // read lock-free, written under writeLock
+static pthread_mutex_t writeLock = PTHREAD_MUTEX_INITIALIZER;
+static int done;
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void *reader(void *arg) {
+  EBRThread self;
+  long scans = 0;
+  (void)arg;
+  ebr_register(&domain, &self);
+  while (!__atomic_load_n(&done, __ATOMIC_ACQUIRE)) {
+    long sum = 0;
+    ebr_enter(&self);
+    for (Node *c = __atomic_load_n(&head, __ATOMIC_ACQUIRE); c != NULL;
+         c = __atomic_load_n(&c->next, __ATOMIC_ACQUIRE))
+      sum += *(int *)c->data; // safe: unlinked nodes are only retired
+    ebr_exit(&self);
+    scans += sum >= 0;
+  }
+  ebr_unregister(&self);
+  return (void *)scans;
+}
+
+int main(void) {
+  ebr_domain_init(&domain, NULL);
+
+  // cost of an empty critical section
+  EBRThread self;
+  ebr_register(&domain, &self);
+  double start = now_seconds();
+  for (int i = 0; i < ENTERS; i++) {
+    ebr_enter(&self);
+    ebr_exit(&self);
+  }
+  double t = now_seconds() - start;
+  printf("ebr_enter + ebr_exit: %.1f ns\n", t / ENTERS * 1e9);
+
+  // the writer keeps 16 nodes: push a new one, unlink and retire the oldest
+  for (int i = 0; i < 16; i++)
+    sl_push_front_cp_data_deep(&head, &i, sizeof(i));
+  pthread_t readers[READERS];
+  for (int i = 0; i < READERS; i++)
+    pthread_create(&readers[i], NULL, reader, NULL);
+
+  start = now_seconds();
+  for (int i = 0; i < UPDATES; i++) {
+    Node *n = (Node *)malloc(sizeof(Node));
+    n->data = malloc(sizeof(int));
+    *(int *)n->data = i;
+    n->dataLen = sizeof(int);
+    pthread_mutex_lock(&writeLock);
+    n->next = head;
+    __atomic_store_n(&head, n, __ATOMIC_RELEASE);
+    Node **link = &n->next;
+    while ((*link)->next != NULL)
+      link = &(*link)->next;
+    Node *oldest = *link;
+    __atomic_store_n(link, (Node *)NULL, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&writeLock);
+    ebr_retire_sl_node(&self, oldest, NULL); // instead of free()
+  }
+  t = now_seconds() - start;
+  printf("%d updates with %d concurrent readers: %.1f ms, epoch now %llu, "
+         "%zu nodes still waiting\n",
+         UPDATES, READERS, t * 1e3, (unsigned long long)ebr_epoch(&domain),
+         self.pending);
+
+  __atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+  long scans = 0;
+  for (int i = 0; i < READERS; i++) {
+    void *r;
+    pthread_join(readers[i], &r);
+    scans += (long)r;
+  }
+  ebr_unregister(&self); // frees the rest once it is safe
+  printf("readers finished %ld scans; all retired nodes freed: %s\n", scans,
+         self.pending == 0 ? "yes" : "no");
+  sl_free_list(&head);
+  ebr_domain_destroy(&domain);
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include "hashmap.h"
+#include "linkedlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define KEYS 250000
+#define LOOKUPS 10000000
+#define LIST_KEYS 10000
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+  // baseline: key lookups as sl_get_by_value scans
+  Node *list = NULL;
+  for (uint64_t k = 0; k < LIST_KEYS; k++)
+    sl_push_front_cp_data_deep(&list, &k, sizeof(k));
+  double start = now_seconds();
+  size_t found = 0;
+  for (uint64_t i = 0; i < 2000; i++) {
+    uint64_t k = (i * 7919) % LIST_KEYS;
+    found += sl_get_by_value(list, &k, sizeof(k)) != NULL;
+  }
+  double listTime = now_seconds() - start;
+  printf("sl_get_by_value, %d keys: %.2f M lookups/s (%zu found)\n",
+         LIST_KEYS, 2000 / listTime / 1e6, found);
+  sl_free_list(&list);
+
+  // puts grow the table incrementally, so no single put rehashes it all
+  HashMap map;
+  hm_init(&map, 0, NULL);
+  double worst = 0;
+  start = now_seconds();
+  for (uint64_t k = 0; k < KEYS; k++) {
+    uint64_t value = k * 3;
+    double t0 = now_seconds();
+    hm_put_deep_cp(&map, &k, sizeof(k), &value, sizeof(value));
+    double dt = now_seconds() - t0;
+    if (dt > worst)
+      worst = dt;
+  }
+  printf("hm_put_deep_cp: %d keys in %.1f ms, slowest put %.1f us\n", KEYS,
+         (now_seconds() - start) * 1e3, worst * 1e6);
+
+  found = 0;
+  start = now_seconds();
+  for (uint64_t i = 0; i < LOOKUPS; i++) {
+    uint64_t k = (i * 2654435761u) % (KEYS * 2); // half of them miss
+    found += hm_get(&map, &k, sizeof(k), NULL) != NULL;
+  }
+  double getTime = now_seconds() - start;
+  uint64_t probe = 4242;
+  printf("hm_get: %.1f M lookups/s (%zu hits), value of 4242: %llu\n",
+         LOOKUPS / getTime / 1e6, found,
+         (unsigned long long)*(uint64_t *)hm_get(&map, &probe, sizeof(probe),
+                                                 NULL));
+
+  // for comparison: a resize done in one go, as hm_reserve() does
+  start = now_seconds();
+  hm_reserve(&map, KEYS * 4);
+  printf("hm_reserve (full rehash of %zu entries): %.1f ms\n", hm_size(&map),
+         (now_seconds() - start) * 1e3);
+
+  // string keys with borrowed values, then iteration
+  HashMap names;
+  static int ages[] = {31, 27, 45};
+  const char *who[] = {"ada", "grace", "linus"};
+  hm_init(&names, 4, NULL);
+  for (int i = 0; i < 3; i++)
+    hm_put_cp(&names, (void *)who[i], strlen(who[i]), &ages[i], sizeof(int));
+  hm_remove(&names, "grace", 5);
+  HMIter it;
+  const void *key;
+  size_t keyLen;
+  void *value;
+  hm_iter_init(&names, &it);
+  while (hm_iter_next(&names, &it, &key, &keyLen, &value, NULL))
+    printf("  %.*s -> %d\n", (int)keyLen, (const char *)key, *(int *)value);
+
+  hm_free(&names);
+  hm_free(&map);
+  return 0;
+}
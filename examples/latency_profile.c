@@ -0,0 +1,68 @@
+// the hooks are compiled in only when CDS_PROFILE is defined before the
+// first include (or with -DCDS_PROFILE)
+#ifndef CDS_PROFILE
+#define CDS_PROFILE
+#endif
+#include "circularlinkedlist.h"
+#include "doublelinkedlist.h"
+#include "linkedlist.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define THREADS 2
+#define ELEMENTS 3000
+
+static void *workload(void *arg) {
+  unsigned seed = (unsigned)(size_t)arg;
+  Node *list = NULL;
+  DLNode *dlist = NULL;
+  for (int i = 0; i < ELEMENTS; i++) {
+    sl_push_back_cp_data_deep(&list, &i, sizeof(int));
+    if (dlist == NULL)
+      dl_push_back_cp_data_deep(&dlist, &i, sizeof(int));
+    else
+      dl_insert_at_index_deep_cp_data(&dlist, &i, sizeof(int),
+                                      (int)(rand_r(&seed) % (unsigned)(i)));
+  }
+  Node *found;
+  DLNode *dfound;
+  for (int i = 0; i < ELEMENTS; i++) {
+    int key = (int)(rand_r(&seed) % (2 * ELEMENTS)); // half of them miss
+    sl_try_get_by_value(list, &key, sizeof(int), &found);
+    dl_try_get_by_value(dlist, &key, sizeof(int), &dfound);
+  }
+  sl_free_list(&list);
+  dl_free_list(&dlist);
+  return NULL;
+}
+
+int main(void) {
+  // every thread records into its own histograms
+  pthread_t threads[THREADS];
+  for (size_t t = 0; t < THREADS; t++)
+    pthread_create(&threads[t], NULL, workload, (void *)(t + 1));
+  workload((void *)0);
+  for (size_t t = 0; t < THREADS; t++)
+    pthread_join(threads[t], NULL);
+
+  Node *ring = NULL;
+  for (int i = 0; i < 100; i++)
+    cl_push_back_deep_cp_data(&ring, &i, sizeof(int));
+  Node *hit;
+  int key = 42;
+  cl_try_get_by_value(&ring, &key, sizeof(int), &hit);
+  cl_free_list(&ring);
+
+  // reports merge all threads on demand
+  printf("clock: %.2f ticks/ns\n", lat_ticks_per_ns());
+  lat_dump(stdout, LAT_TEXT);
+  lat_dump(stdout, LAT_JSON);
+
+  LatSummary s;
+  if (lat_summary(LAT_SL_PUSH_BACK, &s))
+    printf("sl_push_back tail: p99 %.0f ns is %.1fx the median\n", s.p99,
+           s.p99 / s.p50);
+  lat_reset();
+  return 0;
+}
@@ -1,5 +1,11 @@
 #include "linkedlist.h"
 
+static bool starts_with(const void *data, size_t dataLen, void *ctx) {
+  const char *prefix = (const char *)ctx;
+  (void)dataLen;
+  return strncmp((const char *)data, prefix, strlen(prefix)) == 0;
+}
+
 static inline void print_list(Node *root) {
   Node *tmp = root;
   while (tmp != NULL) {
@@ -126,5 +132,41 @@ int main(void) {
   sl_insert_at_index_deep_cp_data(&root, (void*)dataFi, 8, 4);
   free(dataFi);
   print_list(root);
+
+  printf("---------------\n");
+  printf("Cursor\n");
+  printf("---------------\n");
+
+  // single pass: drop every "Fifth.*" entry and tag the node after "Third"
+  SLCursor cur;
+  sl_cursor_init(&cur, &root);
+  while (sl_cursor_valid(&cur)) {
+    char *value = (char *)sl_cursor_get(&cur);
+    if (strncmp(value, "Fifth.", 6) == 0) {
+      sl_cursor_erase(&cur);
+      continue;
+    }
+    if (strcmp(value, "Third") == 0)
+      sl_cursor_insert_after_deep_cp_data(&cur, "After Third", 12);
+    sl_cursor_next(&cur);
+  }
+  print_list(root);
+  if (sl_cursor_seek(&cur, 2))
+    printf("Data at index 2: %s\n", (char *)sl_cursor_get(&cur));
+  else
+    printf("No data at index 2\n");
+
+  printf("---------------\n");
+  printf("Remove if\n");
+  printf("---------------\n");
+
+  // one traversal; the removed nodes come back as their own chain
+  Node *removed = NULL;
+  size_t count = sl_remove_if(&root, starts_with, "F", NULL, NULL, &removed);
+  printf("Removed %zu:\n", count);
+  print_list(removed);
+  printf("Kept:\n");
+  print_list(root);
+  sl_free_list(&removed);
   sl_free_list(&root);
 }
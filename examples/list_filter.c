@@ -0,0 +1,81 @@
+#include "doublelinkedlist.h"
+#include "linkedlist.h"
+#include "listfilter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define ELEMENTS 20000
+#define LOOKUPS 20000
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+  // baseline: every miss scans the whole list
+  DLNode *plain = NULL;
+  for (int i = 0; i < ELEMENTS; i++)
+    dl_push_front_deep_cp_data(&plain, &i, sizeof(int));
+  size_t found = 0;
+  double start = now_seconds();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int key = i * 17; // about one in seventeen is present
+    found += dl_contains(plain, &key, sizeof(int));
+  }
+  double plainTime = now_seconds() - start;
+  printf("dl_contains, %d elements: %.2f us per lookup (%zu hits)\n",
+         ELEMENTS, plainTime * 1e6 / LOOKUPS, found);
+  dl_free_list(&plain);
+
+  // the same lookups against a filtered list: misses skip the scan
+  FDList list;
+  fdl_init(&list, ELEMENTS, NULL);
+  for (int i = 0; i < ELEMENTS; i++)
+    fdl_push_back_deep_cp_data(&list, &i, sizeof(int));
+  found = 0;
+  start = now_seconds();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int key = i * 17;
+    found += fdl_contains(&list, &key, sizeof(int));
+  }
+  double filterTime = now_seconds() - start;
+  printf("fdl_contains, %d elements: %.2f us per lookup (%zu hits)\n",
+         ELEMENTS, filterTime * 1e6 / LOOKUPS, found);
+
+  // deletes keep the filter exact: removed values become definite misses
+  for (int i = 0; i < ELEMENTS; i += 2)
+    fdl_delete_at_index(&list, (size_t)i / 2);
+  int gone = 0, kept = 1;
+  printf("after deleting the even values: 0 %s, 1 %s (%zu left)\n",
+         fdl_contains(&list, &gone, sizeof(int)) ? "present" : "absent",
+         fdl_contains(&list, &kept, sizeof(int)) ? "present" : "absent",
+         fdl_size(&list));
+
+  LFStats stats;
+  fdl_stats(&list, &stats);
+  printf("filter: %llu queries, %llu skipped, %llu false positives "
+         "(observed %.5f, expected %.5f), load %.2f, %llu rebuilds\n",
+         (unsigned long long)stats.queries,
+         (unsigned long long)stats.negatives,
+         (unsigned long long)stats.falsePositives, stats.observedFpr,
+         stats.expectedFpr, stats.load, (unsigned long long)stats.rebuilds);
+  fdl_free(&list);
+
+  // singly linked variant, built from an existing list
+  Node *root = NULL;
+  const char *words[] = {"alpha", "beta", "gamma", "delta"};
+  for (int i = 0; i < 4; i++)
+    sl_push_back_cp_data_deep(&root, (void *)words[i], strlen(words[i]));
+  FSList names;
+  fsl_init(&names, 0, NULL);
+  fsl_adopt(&names, &root);
+  fsl_delete_by_value(&names, "beta", 4);
+  printf("gamma %s, beta %s\n",
+         fsl_contains(&names, "gamma", 5) ? "present" : "absent",
+         fsl_contains(&names, "beta", 4) ? "present" : "absent");
+  fsl_free(&names);
+  return 0;
+}
@@ -0,0 +1,136 @@
+#include "doublelinkedlist.h"
+#include "lrucache.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CAPACITY 2000
+#define KEY_SPACE 4000
+#define LOOKUPS 50000
+#define OPS_PER_THREAD 200000
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void on_evict(const void *key, size_t keySize, void **value,
+                     size_t valueSize, void *ctx) {
+  (void)keySize;
+  (void)valueSize;
+  if (*(int *)ctx < 3)
+    printf("  evicted %s -> %s\n", (const char *)key, (const char *)*value);
+  ++*(int *)ctx;
+}
+
+// the hand-built version: every hit scans the list and moves the node
+static bool naive_get(DLNode **root, size_t *count, int key) {
+  DLNode *n = dl_get_by_value(*root, &key, sizeof(key));
+  bool hit = n != NULL;
+  if (hit)
+    dl_delete_by_value(root, &key, sizeof(key));
+  else if (++*count > CAPACITY) {
+    dl_delete_at_index(root, CAPACITY - 1);
+    --*count;
+  }
+  dl_push_front_deep_cp_data(root, &key, sizeof(key));
+  return hit;
+}
+
+static LRUSharded shared;
+
+static void *worker(void *arg) {
+  unsigned int seed = (unsigned int)(size_t)arg;
+  for (int i = 0; i < OPS_PER_THREAD; i++) {
+    int key = rand_r(&seed) % KEY_SPACE;
+    int value;
+    if (!lru_sharded_get(&shared, &key, sizeof(key), &value, sizeof(value),
+                         NULL)) {
+      value = key * 2;
+      lru_sharded_put_deep_cp_data(&shared, &key, sizeof(key), &value,
+                                   sizeof(value));
+    }
+  }
+  return NULL;
+}
+
+int main(void) {
+  // string keys and values, at most 3 entries or 64 value bytes
+  LRUCache cache;
+  int evicted = 0;
+  lru_init(&cache, 3, 64, NULL);
+  lru_set_evict_callback(&cache, on_evict, &evicted);
+
+  const char *keys[] = {"alpha", "beta", "gamma", "delta"};
+  const char *values[] = {"one", "two", "three", "four"};
+  for (int i = 0; i < 3; i++)
+    lru_put_deep_cp_data(&cache, keys[i], strlen(keys[i]) + 1, values[i],
+                         strlen(values[i]) + 1);
+  lru_get(&cache, "alpha", 6, NULL); // alpha becomes most recent
+  printf("Inserting delta:\n");
+  lru_put_deep_cp_data(&cache, keys[3], strlen(keys[3]) + 1, values[3],
+                       strlen(values[3]) + 1);
+  printf("beta cached: %d, alpha -> %s\n", lru_contains(&cache, "beta", 5),
+         (char *)lru_get(&cache, "alpha", 6, NULL));
+
+  char big[60] = "sixty bytes";
+  printf("Inserting a 60-byte value:\n");
+  lru_put_deep_cp_data(&cache, "big", 4, big, sizeof(big));
+  LRUStats st;
+  lru_stats(&cache, &st);
+  printf("entries %zu, bytes %zu, hits %llu, misses %llu, evictions %llu\n",
+         st.entries, st.bytes, (unsigned long long)st.hits,
+         (unsigned long long)st.misses, (unsigned long long)st.evictions);
+  lru_free(&cache);
+
+  // O(1) cache vs. the DLNode scan it replaces
+  unsigned int seed = 1;
+  int *trace = (int *)malloc(LOOKUPS * sizeof(int));
+  for (int i = 0; i < LOOKUPS; i++)
+    trace[i] = rand_r(&seed) % KEY_SPACE;
+
+  DLNode *root = NULL;
+  size_t count = 0, naiveHits = 0;
+  double start = now_seconds();
+  for (int i = 0; i < LOOKUPS; i++)
+    naiveHits += naive_get(&root, &count, trace[i]);
+  double naiveTime = now_seconds() - start;
+  dl_free_list(&root);
+
+  lru_init(&cache, CAPACITY, 0, NULL);
+  start = now_seconds();
+  for (int i = 0; i < LOOKUPS; i++)
+    if (!lru_get(&cache, &trace[i], sizeof(int), NULL))
+      lru_put_deep_cp_data(&cache, &trace[i], sizeof(int), &trace[i],
+                           sizeof(int));
+  double lruTime = now_seconds() - start;
+  lru_stats(&cache, &st);
+  lru_free(&cache);
+  printf("\n%d lookups, capacity %d: DLNode scan %.1f ms (%zu hits), "
+         "lru_* %.1f ms (%llu hits)\n",
+         LOOKUPS, CAPACITY, naiveTime * 1e3, naiveHits, lruTime * 1e3,
+         (unsigned long long)st.hits);
+  free(trace);
+
+  // sharded cache across threads
+  size_t threadCounts[] = {1, 2, 4, 8};
+  for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+    pthread_t threads[8];
+    lru_sharded_init(&shared, 16, CAPACITY, 0, NULL);
+    start = now_seconds();
+    for (size_t i = 0; i < threadCounts[t]; i++)
+      pthread_create(&threads[i], NULL, worker, (void *)(i + 1));
+    for (size_t i = 0; i < threadCounts[t]; i++)
+      pthread_join(threads[i], NULL);
+    double elapsed = now_seconds() - start;
+    lru_sharded_stats(&shared, &st);
+    printf("%zu thread(s): %.2f Mops/s, hit rate %.1f%%\n", threadCounts[t],
+           (double)(threadCounts[t] * OPS_PER_THREAD) / elapsed / 1e6,
+           100.0 * (double)st.hits / (double)(st.hits + st.misses));
+    lru_sharded_free(&shared);
+  }
+  return 0;
+}
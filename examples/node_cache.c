@@ -0,0 +1,88 @@
+#include "linkedlist.h"
+#include "nodecache.h"
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define ITEMS 500000
+#define PRODUCERS 2
+#define CONSUMERS 2
+
+// nodes travel from producers to consumers through a locked stack
+static Node *queue;
+static pthread_mutex_t queueLock = PTHREAD_MUTEX_INITIALIZER;
+static int producersLeft;
+static const CDSAllocator *alloc;
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void *producer(void *arg) {
+  (void)arg;
+  for (int i = 0; i < ITEMS; i++) {
+    Node *n = NULL;
+    sl_push_front_cp_data_deep_a(&n, &i, sizeof(i), alloc);
+    pthread_mutex_lock(&queueLock);
+    n->next = queue;
+    queue = n;
+    pthread_mutex_unlock(&queueLock);
+  }
+  __atomic_sub_fetch(&producersLeft, 1, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+static void *consumer(void *arg) {
+  NCachePool *pool = (NCachePool *)arg;
+  for (;;) {
+    pthread_mutex_lock(&queueLock);
+    Node *n = queue;
+    if (n != NULL)
+      queue = n->next;
+    pthread_mutex_unlock(&queueLock);
+    if (n == NULL) {
+      if (__atomic_load_n(&producersLeft, __ATOMIC_ACQUIRE) == 0)
+        break;
+      sched_yield();
+      continue;
+    }
+    n->next = NULL;
+    sl_delete_at_index_a(&n, 0, alloc); // frees on the consumer thread
+  }
+  if (pool)
+    ncache_flush(pool); // hand back the last partial batch
+  return NULL;
+}
+
+static double run(NCachePool *pool) {
+  pthread_t threads[PRODUCERS + CONSUMERS];
+  double start = now_seconds();
+  producersLeft = PRODUCERS;
+  alloc = pool ? ncache_allocator(pool) : cds_default_allocator();
+  for (int i = 0; i < CONSUMERS; i++)
+    pthread_create(&threads[i], NULL, consumer, pool);
+  for (int i = 0; i < PRODUCERS; i++)
+    pthread_create(&threads[CONSUMERS + i], NULL, producer, NULL);
+  for (int i = 0; i < PRODUCERS + CONSUMERS; i++)
+    pthread_join(threads[i], NULL);
+  return now_seconds() - start;
+}
+
+int main(void) {
+  NCachePool pool;
+  double mallocTime = run(NULL);
+  ncache_pool_init(&pool, NULL);
+  double cacheTime = run(&pool);
+  NCacheStats s = ncache_stats(&pool);
+  printf("%d producers -> %d consumers, %d nodes each\n", PRODUCERS,
+         CONSUMERS, ITEMS);
+  printf("  malloc/free:  %.1f ms\n", mallocTime * 1e3);
+  printf("  node caches:  %.1f ms (%zu chunks, %zu remote frees in %zu "
+         "batches)\n",
+         cacheTime * 1e3, s.chunks, s.remoteFrees, s.remoteBatches);
+  ncache_pool_destroy(&pool);
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include "linkedlist.h"
+#include "parallellist.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LIST_SIZE 200000
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// deliberately compute-heavy per-node work
+static void hash_node(void *acc, const void *data, size_t dataLen, void *ctx) {
+  (void)ctx;
+  uint64_t h = 1469598103934665603ULL;
+  for (int round = 0; round < 64; round++)
+    for (size_t i = 0; i < dataLen; i++)
+      h = (h ^ ((const unsigned char *)data)[i]) * 1099511628211ULL;
+  *(uint64_t *)acc ^= h;
+}
+
+static void sum_node(void *acc, const void *data, size_t dataLen, void *ctx) {
+  (void)ctx;
+  (void)dataLen;
+  *(uint64_t *)acc += (uint64_t)*(const int *)data;
+}
+
+static bool is_even(const void *data, size_t dataLen, void *ctx) {
+  (void)ctx;
+  (void)dataLen;
+  return (*(const int *)data % 2) == 0;
+}
+
+static void double_value(void *data, size_t dataLen, void *ctx) {
+  (void)ctx;
+  (void)dataLen;
+  *(int *)data *= 2;
+}
+
+int main(void) {
+  Node *root = NULL;
+  for (int i = LIST_SIZE - 1; i >= 0; i--)
+    sl_push_front_cp_data_deep(&root, &i, sizeof(i));
+
+  ParSegments segs;
+  par_segments_from_sl(&segs, root, 4096);
+  printf("%zu nodes in %zu segments\n", segs.nNodes, segs.nSegments);
+
+  size_t threadCounts[] = {0, 1, 3, 7};
+  for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+    ParPool pool;
+    uint64_t zero = 0, sum, evens, checksum;
+    par_pool_init(&pool, threadCounts[t]);
+
+    double start = now_seconds();
+    bool ok = par_reduce(&pool, &segs, sizeof(uint64_t), &zero, hash_node,
+                         par_combine_xor_u64, NULL, &checksum);
+    double elapsed = now_seconds() - start;
+
+    ok = ok && par_reduce(&pool, &segs, sizeof(uint64_t), &zero, sum_node,
+                          par_combine_sum_u64, NULL, &sum);
+    if (!ok) {
+      fprintf(stderr, "par_reduce: out of memory\n");
+      return 1;
+    }
+    evens = par_count_if(&pool, &segs, is_even, NULL);
+    printf("%zu thread(s): sum=%llu evens=%llu checksum=%016llx "
+           "hash pass %.3fs\n",
+           threadCounts[t] + 1, (unsigned long long)sum,
+           (unsigned long long)evens, (unsigned long long)checksum, elapsed);
+    par_pool_destroy(&pool);
+  }
+
+  ParPool pool;
+  uint64_t zero = 0, sum;
+  par_pool_init(&pool, 3);
+  par_for_each(&pool, &segs, double_value, NULL);
+  if (!par_reduce(&pool, &segs, sizeof(uint64_t), &zero, sum_node,
+                  par_combine_sum_u64, NULL, &sum)) {
+    fprintf(stderr, "par_reduce: out of memory\n");
+    return 1;
+  }
+  printf("sum after doubling every value: %llu\n", (unsigned long long)sum);
+  par_pool_destroy(&pool);
+
+  par_segments_free(&segs);
+  sl_free_list(&root);
+  return 0;
+}
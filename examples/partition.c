@@ -0,0 +1,119 @@
+#include "circularlinkedlist.h"
+#include "doublelinkedlist.h"
+#include "linkedlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LIST_SIZE 20000
+
+typedef struct {
+  int id;
+  int blocked;
+  int priority;
+} Task;
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static bool is_ready(const void *data, size_t dataLen, void *ctx) {
+  (void)dataLen;
+  (void)ctx;
+  return !((const Task *)data)->blocked;
+}
+
+static size_t by_priority(const void *data, size_t dataLen, void *ctx) {
+  (void)dataLen;
+  (void)ctx;
+  return (size_t)((const Task *)data)->priority;
+}
+
+static void print_ids(const char *label, Node *root) {
+  printf("%-8s", label);
+  for (Node *n = root; n; n = n->next)
+    printf("%d ", ((Task *)n->data)->id);
+  printf("\n");
+}
+
+static Node *make_tasks(int n) {
+  Node *root = NULL;
+  for (int i = n - 1; i >= 0; i--) {
+    Task t = {i, i % 3 == 0, i % 4};
+    sl_push_front_cp_data_deep(&root, &t, sizeof(t));
+  }
+  return root;
+}
+
+int main(void) {
+  Node *tasks = make_tasks(12);
+  Node *ready, *blocked;
+  sl_partition(&tasks, is_ready, NULL, &ready, &blocked);
+  print_ids("ready:", ready);
+  print_ids("blocked:", blocked);
+
+  // n-way: one list per priority level, same nodes
+  Node *levels[4];
+  sl_partition_n(&ready, by_priority, NULL, levels, 4);
+  for (int i = 0; i < 4; i++) {
+    char label[8];
+    snprintf(label, sizeof(label), "prio %d:", i);
+    print_ids(label, levels[i]);
+    sl_free_list(&levels[i]);
+  }
+  sl_free_list(&blocked);
+
+  // doubly linked: previous links are rebuilt
+  DLNode *dlTasks = NULL, *dlBlocked;
+  for (int i = 0; i < 6; i++) {
+    Task t = {i, i % 2, 0};
+    dl_push_back_cp_data_deep(&dlTasks, &t, sizeof(t));
+  }
+  dl_filter(&dlTasks, is_ready, NULL, &dlBlocked);
+  DLNode *last = dlBlocked;
+  while (last->next)
+    last = last->next;
+  printf("dl blocked, walked backwards: ");
+  for (DLNode *n = last; n; n = n->previous)
+    printf("%d ", ((Task *)n->data)->id);
+  printf("\n");
+  dl_free_list(&dlTasks);
+  dl_free_list(&dlBlocked);
+
+  // circular: both outputs are rings again
+  Node *ring = NULL, *clReady, *clBlocked;
+  for (int i = 0; i < 6; i++) {
+    Task t = {i, i >= 4, 0};
+    cl_push_back_deep_cp_data(&ring, &t, sizeof(t));
+  }
+  cl_partition(&ring, is_ready, NULL, &clReady, &clBlocked);
+  printf("cl blocked ring: %d -> %d -> %d\n", ((Task *)clBlocked->data)->id,
+         ((Task *)clBlocked->next->data)->id,
+         ((Task *)clBlocked->next->next->data)->id);
+  cl_free_list(&clReady);
+  cl_free_list(&clBlocked);
+
+  // relinking vs. rebuilding two lists with deep copies
+  tasks = make_tasks(LIST_SIZE);
+  double start = now_seconds();
+  Node *copyReady = NULL, *copyBlocked = NULL;
+  for (Node *n = tasks; n; n = n->next)
+    sl_push_back_cp_data_deep(is_ready(n->data, n->dataLen, NULL) ? &copyReady
+                                                                   : &copyBlocked,
+                              n->data, n->dataLen);
+  double copyTime = now_seconds() - start;
+
+  start = now_seconds();
+  sl_partition(&tasks, is_ready, NULL, &ready, &blocked);
+  double relinkTime = now_seconds() - start;
+  printf("%d tasks: rebuild with copies %.1f ms, sl_partition %.3f ms\n",
+         LIST_SIZE, copyTime * 1e3, relinkTime * 1e3);
+
+  sl_free_list(&copyReady);
+  sl_free_list(&copyBlocked);
+  sl_free_list(&ready);
+  sl_free_list(&blocked);
+  return 0;
+}
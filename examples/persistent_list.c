@@ -0,0 +1,107 @@
+#include "persistentlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define ENTRIES 2000
+#define REQUESTS 2000
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void print_list(const char *name, const PSList *list) {
+  printf("%s:", name);
+  for (const Node *n = psl_nodes(list); n; n = n->next)
+    printf(" %d", *(const int *)n->data);
+  printf("\n");
+}
+
+int main(void) {
+  // versions share structure: v2 and v3 reuse every node of v1
+  PSList v0 = psl_empty();
+  PSList v1 = v0;
+  for (int i = 5; i >= 1; i--) {
+    PSList next;
+    if (psl_prepend(&v1, &i, sizeof(i), &next) != CDS_OK) {
+      psl_release(&v1);
+      return 1;
+    }
+    psl_release(&v1);
+    v1 = next;
+  }
+  int zero = 0, forty = 40;
+  PSList v2, v3, v4;
+  if (psl_prepend(&v1, &zero, sizeof(zero), &v2) != CDS_OK) {
+    psl_release(&v1);
+    return 1;
+  }
+  if (psl_set_at(&v1, 3, &forty, sizeof(forty), &v3) != CDS_OK) { // copies 3
+    psl_release(&v1);
+    psl_release(&v2);
+    return 1;
+  }
+  psl_delete_at(&v1, 0, &v4); // copies nothing, cannot run out of memory
+  print_list("v1", &v1);
+  print_list("v2", &v2);
+  print_list("v3", &v3);
+  print_list("v4", &v4);
+  printf("v2 tail is v1: %d, v3 shares v1 from index 4: %d, v4 is v1's "
+         "tail: %d\n",
+         v2.head->node.next == &v1.head->node,
+         v3.head->node.next->next->next->next ==
+             v1.head->node.next->next->next->next,
+         v4.head == psl_next(v1.head));
+  psl_release(&v1); // v2, v3 and v4 keep what they use alive
+  print_list("v4 after releasing v1", &v4);
+  psl_release(&v2);
+  psl_release(&v3);
+  psl_release(&v4);
+
+  // one snapshot per request while a writer keeps updating the config
+  Node *config = NULL;
+  for (int i = 0; i < ENTRIES; i++)
+    sl_push_back_cp_data_deep(&config, &i, sizeof(i));
+
+  double start = now_seconds();
+  for (int r = 0; r < REQUESTS; r++) {
+    Node *snap = NULL;
+    Node **tail = &snap; // append in O(1) by pushing onto the empty tail link
+    for (Node *c = config; c; c = c->next) {
+      sl_push_back_cp_data_deep(tail, c->data, c->dataLen);
+      tail = &(*tail)->next;
+    }
+    sl_free_list(&snap);
+  }
+  double deepTime = now_seconds() - start;
+
+  PSList current;
+  if (psl_from_sl(config, &current) != CDS_OK) {
+    sl_free_list(&config);
+    return 1;
+  }
+  PSLCell cell;
+  psl_cell_init(&cell, &current);
+  start = now_seconds();
+  for (int r = 0; r < REQUESTS; r++) {
+    PSList snap = psl_cell_load(&cell);
+    if (r % 100 == 0) { // an occasional update at the front
+      PSList next;
+      if (psl_set_at(&snap, 0, &r, sizeof(r), &next) == CDS_OK)
+        psl_cell_store(&cell, &next);
+    }
+    psl_release(&snap);
+  }
+  double snapTime = now_seconds() - start;
+  PSList last = psl_cell_load(&cell);
+  printf("\n%d request snapshots of %d entries: deep copies %.2f ms, "
+         "persistent %.3f ms (front now %d)\n",
+         REQUESTS, ENTRIES, deepTime * 1e3, snapTime * 1e3,
+         *(const int *)psl_front(&last));
+  psl_release(&last);
+  psl_cell_destroy(&cell);
+  sl_free_list(&config);
+  return 0;
+}
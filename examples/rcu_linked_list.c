@@ -0,0 +1,101 @@
+#include "rculinkedlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TABLE_SIZE 128
+#define LOOKUPS_PER_THREAD 200000
+
+static RSLList table;
+static int stopWriter;
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void *reader(void *arg) {
+  RSLReader self;
+  unsigned int seed = (unsigned int)(size_t)arg;
+  long hits = 0;
+  rsl_register_reader(&table, &self);
+  for (int i = 0; i < LOOKUPS_PER_THREAD; i++) {
+    int key = rand_r(&seed) % TABLE_SIZE;
+    rsl_read_lock(&table, &self);
+    hits += rsl_contains(&table, &key, sizeof(key));
+    rsl_read_unlock(&table, &self);
+  }
+  rsl_unregister_reader(&table, &self);
+  return (void *)hits;
+}
+
+static void *writer(void *arg) {
+  (void)arg;
+  int key = 0;
+  while (!__atomic_load_n(&stopWriter, __ATOMIC_ACQUIRE)) {
+    rsl_delete_by_value(&table, &key, sizeof(key));
+    rsl_push_back_cp_data_deep(&table, &key, sizeof(key));
+    key = (key + 1) % TABLE_SIZE;
+    sched_yield();
+  }
+  return NULL;
+}
+
+int main(void) {
+  printf("---------------\n");
+  printf("Basic usage\n");
+  printf("---------------\n");
+
+  RSLReader self;
+  rsl_init(&table, NULL);
+  rsl_register_reader(&table, &self);
+  rsl_push_back_cp_data_deep(&table, "Second", 7);
+  rsl_push_front_cp_data_deep(&table, "First", 6);
+  rsl_insert_at_index_deep_cp_data(&table, "Third", 6, 2);
+
+  rsl_read_lock(&table, &self);
+  for (Node *n = table.root; n != NULL; n = n->next)
+    printf("%s\n", (char *)n->data);
+  printf("Data at index 1: %s\n", (char *)rsl_get_at_index(&table, 1));
+  rsl_read_unlock(&table, &self);
+
+  rsl_delete_by_value(&table, "Second", 7);
+  rsl_synchronize(&table);
+  rsl_read_lock(&table, &self);
+  printf("Contains \"Second\": %d\n", rsl_contains(&table, "Second", 7));
+  rsl_read_unlock(&table, &self);
+  rsl_unregister_reader(&table, &self);
+  rsl_free_list(&table);
+
+  printf("---------------\n");
+  printf("Reader scaling (one concurrent writer)\n");
+  printf("---------------\n");
+
+  int threadCounts[] = {1, 2, 4, 8};
+  for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+    int n = threadCounts[t];
+    pthread_t threads[8];
+    pthread_t writerThread;
+    rsl_init(&table, NULL);
+    for (int i = 0; i < TABLE_SIZE; i++)
+      rsl_push_back_cp_data_deep(&table, &i, sizeof(i));
+
+    __atomic_store_n(&stopWriter, 0, __ATOMIC_RELEASE);
+    pthread_create(&writerThread, NULL, writer, NULL);
+    double start = now_seconds();
+    for (int i = 0; i < n; i++)
+      pthread_create(&threads[i], NULL, reader, (void *)(size_t)(i + 1));
+    for (int i = 0; i < n; i++)
+      pthread_join(threads[i], NULL);
+    double elapsed = now_seconds() - start;
+    __atomic_store_n(&stopWriter, 1, __ATOMIC_RELEASE);
+    pthread_join(writerThread, NULL);
+
+    printf("%d reader(s): %.2f Mlookups/s\n", n,
+           (double)n * LOOKUPS_PER_THREAD / elapsed / 1e6);
+    rsl_free_list(&table);
+  }
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include "linkedlist.h"
+#include "nodecache.h"
+#include "recordloader.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LINES 200000
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void report(uint64_t bytes, uint64_t records, void *ctx) {
+  uint64_t *blocks = (uint64_t *)ctx;
+  (*blocks)++;
+  (void)bytes;
+  (void)records;
+}
+
+int main(void) {
+  char path[] = "/tmp/record_loader_XXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    perror("mkstemp");
+    return 1;
+  }
+  FILE *out = fdopen(fd, "w");
+  for (int i = 0; i < LINES; i++)
+    fprintf(out, "record %d,%d,%d\n", i, i * 7, i % 13);
+  fclose(out);
+
+  // baseline: fgets plus push_back, which walks the list on every line
+  Node *naive = NULL;
+  char line[128];
+  double start = now_seconds();
+  FILE *in = fopen(path, "r");
+  for (int i = 0; i < 20000 && fgets(line, sizeof(line), in); i++)
+    sl_push_back_cp_data_deep(&naive, line, strlen(line) - 1);
+  fclose(in);
+  double naiveTime = now_seconds() - start;
+  printf("fgets + sl_push_back: %zu lines in %.1f ms\n", sl_count(naive),
+         naiveTime * 1e3);
+  sl_free_list(&naive);
+
+  // double-buffered reads on a reader thread, parsed while the next block
+  // is read
+  RLOptions opt = rl_default_options(RL_LINES);
+  uint64_t blocks = 0;
+  RLStats stats;
+  opt.bufferSize = 1 << 20;
+  opt.progress = report;
+  opt.ctx = &blocks;
+  Node *list = NULL;
+  start = now_seconds();
+  CDSStatus status = rl_load_sl(path, &opt, &list, &stats);
+  double loadTime = now_seconds() - start;
+  printf("rl_load_sl: %s, %llu lines, %.1f ms (%.0f MB/s, %llu blocks)\n",
+         cds_status_str(status), (unsigned long long)stats.records,
+         loadTime * 1e3, stats.bytes / loadTime / 1e6,
+         (unsigned long long)blocks);
+  printf("first record: %.*s\n", (int)list->dataLen, (char *)list->data);
+  sl_free_list(&list);
+
+  // mapped input and nodes carved out of a node cache
+  NCachePool pool;
+  ncache_pool_init(&pool, NULL);
+  opt.useMmap = true;
+  opt.progress = NULL;
+  start = now_seconds();
+  status = rl_load_sl_a(path, &opt, &list, &stats, ncache_allocator(&pool));
+  loadTime = now_seconds() - start;
+  printf("rl_load_sl_a (mmap, node cache): %s, %llu lines, %.1f ms "
+         "(%.0f MB/s)\n",
+         cds_status_str(status), (unsigned long long)stats.records,
+         loadTime * 1e3, stats.bytes / loadTime / 1e6);
+  sl_free_list_a(&list, ncache_allocator(&pool));
+  ncache_pool_destroy(&pool);
+
+  unlink(path);
+  return 0;
+}
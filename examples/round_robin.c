@@ -0,0 +1,94 @@
+#include "circularlinkedlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define QUEUE_SIZE 20000
+#define PICKS 1000000
+
+typedef struct {
+  char name[8];
+  size_t weight;
+  size_t runs;
+} Task;
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static size_t task_weight(const void *data, size_t dataLen, void *ctx) {
+  (void)dataLen;
+  (void)ctx;
+  return ((const Task *)data)->weight;
+}
+
+int main(void) {
+  CLRing queue;
+  clr_init(&queue, NULL);
+
+  Task tasks[] = {{"A", 3, 0}, {"B", 1, 0}, {"C", 2, 0}, {"idle", 0, 0}};
+  for (size_t i = 0; i < sizeof(tasks) / sizeof(tasks[0]); i++)
+    clr_push_back_cp_data(&queue, &tasks[i], sizeof(Task));
+
+  printf("Round-robin: ");
+  for (int i = 0; i < 6; i++) {
+    Task *t = (Task *)clr_advance(&queue);
+    if (t != NULL)
+      printf("%s ", t->name);
+  }
+  printf("\nWeighted:    ");
+  for (int i = 0; i < 12; i++) {
+    Task *t = (Task *)clr_wrr_next(&queue, task_weight, NULL);
+    if (t == NULL)
+      break;
+    t->runs++;
+    printf("%s ", t->name);
+  }
+  printf("\n");
+
+  clr_rotate_k(&queue, 2);
+  printf("After rotate by 2 the head is %s\n", ((Task *)clr_front(&queue))->name);
+  // the tasks live on the stack, so take them out instead of freeing them
+  while (clr_size(&queue) > 0) {
+    Node *n = clr_detach_front(&queue);
+    cds_free(queue.alloc, n);
+  }
+
+  // advance-and-requeue over a large run queue: CLRing vs. root-based cl_
+  Node *root = NULL;
+  for (int i = 0; i < QUEUE_SIZE; i++) {
+    clr_push_back_deep_cp_data(&queue, &i, sizeof(i));
+    cl_push_front_deep_cp_data(&root, &i, sizeof(i));
+  }
+
+  // dequeue the head and requeue it at the back
+  long long sum = 0;
+  double start = now_seconds();
+  for (int i = 0; i < PICKS; i++) {
+    size_t size;
+    void *data = clr_pop_front(&queue, &size);
+    sum += *(int *)data;
+    clr_push_back_mv_data(&queue, &data, size);
+  }
+  double ringTime = now_seconds() - start;
+
+  int rootPicks = PICKS / 1000;
+  start = now_seconds();
+  for (int i = 0; i < rootPicks; i++) {
+    int v = *(int *)root->data;
+    sum -= v;
+    cl_delete_at_index(&root, 0);
+    cl_push_back_deep_cp_data(&root, &v, sizeof(v));
+  }
+  double rootTime = now_seconds() - start;
+
+  printf("%d-entry queue, dequeue + requeue: CLRing %.1f ns, root-based cl_ "
+         "%.1f ns\n",
+         QUEUE_SIZE, ringTime * 1e9 / PICKS, rootTime * 1e9 / rootPicks);
+
+  clr_free(&queue);
+  cl_free_list(&root);
+  return 0;
+}
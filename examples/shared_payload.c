@@ -0,0 +1,69 @@
+#include "sharedpayload.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BLOB_SIZE 4096
+#define BLOBS 2000
+#define LISTS 3
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+  // one blob, three lists, no copies
+  char *blob = (char *)cds_shared_from("shared configuration blob", 26);
+  Node *slRoot = NULL, *clRoot = NULL;
+  DLNode *dlRoot = NULL;
+  sl_push_back_shared_data(&slRoot, blob, 26);
+  dl_push_back_shared_data(&dlRoot, blob, 26);
+  cl_push_front_shared_data(&clRoot, blob, 26);
+  printf("refs after 3 inserts: %zu (same pointer: %d)\n",
+         cds_shared_refs(blob), slRoot->data == dlRoot->data);
+
+  cds_shared_release(blob); // the creator's reference
+  sl_delete_at_index_a(&slRoot, 0, cds_shared_allocator());
+  printf("refs after release + sl delete: %zu\n", cds_shared_refs(blob));
+  dl_free_list_shared(&dlRoot);
+  printf("refs after dl free: %zu, still readable: %s\n",
+         cds_shared_refs(blob), (char *)clRoot->data);
+  cl_free_list_shared(&clRoot); // last reference: the blob is freed here
+
+  // the same BLOB_SIZE payloads on LISTS lists: deep copies vs. sharing
+  char *payload = (char *)malloc(BLOB_SIZE);
+  for (int i = 0; i < BLOB_SIZE; i++)
+    payload[i] = (char)i;
+
+  Node *deep[LISTS] = {NULL};
+  double start = now_seconds();
+  for (int b = 0; b < BLOBS; b++)
+    for (int l = 0; l < LISTS; l++)
+      sl_push_front_cp_data_deep(&deep[l], payload, BLOB_SIZE);
+  double deepTime = now_seconds() - start;
+
+  Node *shared[LISTS] = {NULL};
+  start = now_seconds();
+  for (int b = 0; b < BLOBS; b++) {
+    void *buf = cds_shared_from(payload, BLOB_SIZE);
+    for (int l = 0; l < LISTS; l++)
+      sl_push_front_shared_data(&shared[l], buf, BLOB_SIZE);
+    cds_shared_release(buf);
+  }
+  double sharedTime = now_seconds() - start;
+
+  printf("\n%d blobs of %d B on %d lists: deep copies %.1f ms (%d KiB of "
+         "payload), shared %.1f ms (%d KiB)\n",
+         BLOBS, BLOB_SIZE, LISTS, deepTime * 1e3,
+         BLOBS * LISTS * BLOB_SIZE / 1024, sharedTime * 1e3,
+         BLOBS * BLOB_SIZE / 1024);
+
+  for (int l = 0; l < LISTS; l++) {
+    sl_free_list(&deep[l]);
+    sl_free_list_shared(&shared[l]);
+  }
+  free(payload);
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include "doublelinkedlist.h"
+#include "soalist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define KEYS 1000000
+#define LOOKUPS 50
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+  SOAList keys;
+  DLNode *nodes = NULL;
+  uint64_t *column = (uint64_t *)malloc(KEYS * sizeof(uint64_t));
+  soa_init(&keys, sizeof(uint64_t), KEYS, NULL);
+  for (uint64_t i = 0; i < KEYS; i++) {
+    column[i] = i * 2654435761u;
+    soa_push_back(&keys, &column[i]);
+  }
+  dl_from_array(&nodes, column, sizeof(uint64_t), KEYS);
+  free(column);
+
+  // a missing key makes every lookup scan all KEYS keys
+  uint64_t missing = 1;
+  double bytes = (double)KEYS * sizeof(uint64_t) * LOOKUPS;
+  double start = now_seconds();
+  for (int r = 0; r < LOOKUPS; r++)
+    if (dl_contains(nodes, &missing, sizeof(missing)))
+      return 1;
+  double dlTime = now_seconds() - start;
+  printf("%d lookups over %d 8-byte keys\n", LOOKUPS, KEYS);
+  printf("  dl memcmp per node:  %8.2f ms (%5.2f GB/s)\n", dlTime * 1e3,
+         bytes / dlTime / 1e9);
+
+  start = now_seconds();
+  for (int r = 0; r < LOOKUPS; r++)
+    if (soa_find(&keys, &missing) != SOA_NIL)
+      return 1;
+  double listTime = now_seconds() - start;
+  printf("  soa_find (links):    %8.2f ms (%5.2f GB/s)\n", listTime * 1e3,
+         bytes / listTime / 1e9);
+
+  CDSScanISA isas[] = {CDS_SCAN_SCALAR, CDS_SCAN_SSE2, CDS_SCAN_AVX2};
+  for (int k = 0; k < 3; k++) {
+    cds_scan_set_isa(isas[k]);
+    if (cds_scan_isa() != isas[k])
+      continue; // not available on this CPU
+    start = now_seconds();
+    for (int r = 0; r < LOOKUPS; r++)
+      if (soa_find_any(&keys, &missing) != SOA_NIL)
+        return 1;
+    double t = now_seconds() - start;
+    printf("  soa_find_any %-6s: %8.2f ms (%5.2f GB/s)\n",
+           cds_scan_isa_str(isas[k]), t * 1e3, bytes / t / 1e9);
+  }
+  cds_scan_set_isa(CDS_SCAN_AUTO);
+
+  // 16-byte keys: count and collect the duplicates
+  SOAList wide;
+  soa_init(&wide, 16, 0, NULL);
+  for (int i = 0; i < 1000; i++) {
+    uint64_t key[2] = {(uint64_t)(i % 7), 42};
+    soa_push_back(&wide, key);
+  }
+  uint64_t needle[2] = {3, 42};
+  SOAIndex hits[4];
+  uint32_t count = soa_count_value(&wide, needle);
+  soa_find_all(&wide, needle, hits, 4);
+  printf("\n16-byte key {3, 42}: %u matches, first slots %u %u %u %u (%s)\n",
+         count, hits[0], hits[1], hits[2], hits[3],
+         cds_scan_isa_str(cds_scan_isa()));
+
+  soa_free_list(&wide);
+  soa_free_list(&keys);
+  dl_free_list(&nodes);
+  return 0;
+}
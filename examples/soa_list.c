@@ -0,0 +1,124 @@
+#include "linkedlist.h"
+#include "soalist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LIST_SIZE 1000000
+
+typedef struct {
+  int id;
+  float score;
+} Record;
+
+typedef struct {
+  size_t bytes;
+} Tally;
+
+static void *tally_alloc(void *state, size_t size) {
+  ((Tally *)state)->bytes += size;
+  return malloc(size);
+}
+
+static void *tally_realloc(void *state, void *ptr, size_t size) {
+  // the example only grows from NULL, so this is an exact count
+  if (ptr == NULL)
+    ((Tally *)state)->bytes += size;
+  return realloc(ptr, size);
+}
+
+static void tally_free(void *state, void *ptr) {
+  (void)state;
+  free(ptr);
+}
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void print_list(const SOAList *list) {
+  for (SOAIndex i = soa_first(list); i != SOA_NIL; i = soa_next(list, i)) {
+    Record *r = (Record *)soa_at(list, i);
+    printf("[slot %u] %d:%.1f  ", i, r->id, r->score);
+  }
+  printf("\n");
+}
+
+int main(void) {
+  SOAList list;
+  soa_init(&list, sizeof(Record), 0, NULL);
+
+  SOAIndex handles[5];
+  for (int i = 0; i < 5; i++) {
+    Record r = {i, i * 1.5f};
+    handles[i] = soa_push_back(&list, &r);
+  }
+  Record front = {-1, 0.0f};
+  soa_push_front(&list, &front);
+  Record mid = {100, 9.9f};
+  soa_insert_after(&list, handles[2], &mid);
+
+  // O(1) removal through a handle kept from insertion
+  soa_remove(&list, handles[1]);
+  soa_remove(&list, handles[3]);
+  print_list(&list);
+
+  // the freed slots are reused
+  Record back = {7, 7.0f};
+  soa_push_back(&list, &back);
+  print_list(&list);
+
+  soa_compact(&list, true);
+  printf("After compact (%u slots): ", list.capacity);
+  print_list(&list);
+
+  Record popped;
+  soa_pop_front(&list, &popped);
+  printf("Popped %d, position 1 is id %d, contains {100, 9.9}: %d\n", popped.id,
+         ((Record *)soa_get_at_index(&list, 1))->id, soa_contains(&list, &mid));
+  soa_free_list(&list);
+
+  // memory: LIST_SIZE records in Node lists vs. one SOAList
+  Tally slTally = {0}, soaTally = {0};
+  CDSAllocator slAlloc = {tally_alloc, tally_realloc, tally_free, &slTally};
+  CDSAllocator soaAlloc = {tally_alloc, tally_realloc, tally_free, &soaTally};
+
+  Node *root = NULL;
+  soa_init(&list, sizeof(Record), LIST_SIZE, &soaAlloc);
+  for (int i = LIST_SIZE - 1; i >= 0; i--) {
+    Record r = {i, (float)i};
+    sl_push_front_cp_data_deep_a(&root, &r, sizeof(r), &slAlloc);
+    soa_push_front(&list, &r);
+  }
+  printf("\n%d records of %zu bytes (malloc headers not counted)\n", LIST_SIZE, sizeof(Record));
+  printf("Node list: %zu bytes requested in %d blocks (%.1f B/elem)\n",
+         slTally.bytes, 2 * LIST_SIZE, (double)slTally.bytes / LIST_SIZE);
+  printf("SOAList:   %zu bytes requested in 3 blocks (%.1f B/elem)\n",
+         soaTally.bytes, (double)soaTally.bytes / LIST_SIZE);
+
+  Record needle = {LIST_SIZE / 2, (float)(LIST_SIZE / 2)};
+  double start = now_seconds();
+  Node *hit;
+  bool slFound =
+      sl_try_get_by_value(root, &needle, sizeof(needle), &hit) == CDS_OK;
+  double slTime = now_seconds() - start;
+
+  start = now_seconds();
+  bool soaFound = soa_find(&list, &needle) != SOA_NIL;
+  double soaTime = now_seconds() - start;
+
+  start = now_seconds();
+  bool soaAnyFound = soa_find_any(&list, &needle) != SOA_NIL;
+  double soaAnyTime = now_seconds() - start;
+
+  printf("Search mid-list: Node %.2f ms (%d), soa_find %.2f ms (%d), "
+         "soa_find_any %.2f ms (%d)\n",
+         slTime * 1e3, slFound, soaTime * 1e3, soaFound, soaAnyTime * 1e3,
+         soaAnyFound);
+
+  sl_free_list_a(&root, &slAlloc);
+  soa_free_list(&list);
+  return 0;
+}
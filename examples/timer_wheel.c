@@ -0,0 +1,110 @@
+#include "doublelinkedlist.h"
+#include "timerwheel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define CONNECTIONS 200000
+#define SORTED_CONNECTIONS 20000
+#define TIMEOUT_TICKS 30000
+
+typedef struct {
+  int id;
+  TWTimer timeout;
+  int expired;
+} Connection;
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void on_timeout(TWTimer *timer, void *data) {
+  (void)timer;
+  ((Connection *)data)->expired = 1;
+}
+
+static void on_demo(TWTimer *timer, void *data) {
+  printf("  tick %llu: %s\n", (unsigned long long)timer->expires,
+         (const char *)data);
+}
+
+// what the wheel replaces: a list kept sorted by deadline
+static void sorted_insert(DLNode **root, uint64_t deadline) {
+  DLCursor cur;
+  dl_cursor_init(&cur, root);
+  while (dl_cursor_valid(&cur) && *(uint64_t *)dl_cursor_get(&cur) <= deadline)
+    dl_cursor_next(&cur);
+  dl_cursor_insert_before_deep_cp_data(&cur, &deadline, sizeof(deadline));
+}
+
+int main(void) {
+  TimerWheel wheel;
+  tw_init(&wheel, 0);
+
+  TWTimer a, b, c;
+  tw_timer_init(&a, on_demo, "a (5 ticks)");
+  tw_timer_init(&b, on_demo, "b (300 ticks, cascades once)");
+  tw_timer_init(&c, on_demo, "c (cancelled)");
+  tw_schedule(&wheel, &a, 5);
+  tw_schedule(&wheel, &b, 300);
+  tw_schedule(&wheel, &c, 10);
+  tw_cancel(&wheel, &c);
+  printf("Demo: %zu pending\n", tw_pending(&wheel));
+  tw_advance(&wheel, 400);
+
+  // connection timeouts: schedule, refresh half of them, expire
+  Connection *conns = (Connection *)calloc(CONNECTIONS, sizeof(Connection));
+  unsigned int seed = 42;
+  double start = now_seconds();
+  for (int i = 0; i < CONNECTIONS; i++) {
+    conns[i].id = i;
+    tw_timer_init(&conns[i].timeout, on_timeout, &conns[i]);
+    tw_schedule(&wheel, &conns[i].timeout,
+                TIMEOUT_TICKS + rand_r(&seed) % TIMEOUT_TICKS);
+  }
+  double scheduleTime = now_seconds() - start;
+
+  start = now_seconds();
+  for (int i = 0; i < CONNECTIONS; i += 2)
+    tw_cancel(&wheel, &conns[i].timeout);
+  double cancelTime = now_seconds() - start;
+
+  start = now_seconds();
+  size_t fired = tw_advance(&wheel, 2 * TIMEOUT_TICKS);
+  double advanceTime = now_seconds() - start;
+
+  size_t expired = 0;
+  for (int i = 0; i < CONNECTIONS; i++)
+    expired += (size_t)conns[i].expired;
+  printf("\n%d timers: schedule %.1f ms, cancel half %.1f ms, "
+         "%d ticks %.1f ms (%zu fired, %zu flagged)\n",
+         CONNECTIONS, scheduleTime * 1e3, cancelTime * 1e3,
+         2 * TIMEOUT_TICKS, advanceTime * 1e3, fired, expired);
+
+  // batch expiry: take a whole range of due timers at once
+  for (int i = 0; i < 1000; i++)
+    tw_schedule(&wheel, &conns[i].timeout, 1 + i % 50);
+  TWBatch batch;
+  tw_batch_init(&batch);
+  size_t collected = tw_collect_expired(&wheel, 51, &batch);
+  size_t popped = 0;
+  while (tw_batch_pop(&batch) != NULL)
+    popped++;
+  printf("Collected %zu due timers in one batch (%zu popped)\n", collected,
+         popped);
+
+  DLNode *sorted = NULL;
+  seed = 42;
+  start = now_seconds();
+  for (int i = 0; i < SORTED_CONNECTIONS; i++)
+    sorted_insert(&sorted, TIMEOUT_TICKS + rand_r(&seed) % TIMEOUT_TICKS);
+  double sortedTime = now_seconds() - start;
+  printf("Sorted DLNode list: %d inserts %.1f ms\n", SORTED_CONNECTIONS,
+         sortedTime * 1e3);
+
+  dl_free_list(&sorted);
+  free(conns);
+  return 0;
+}
@@ -0,0 +1,145 @@
+#include "doublelinkedlist.h"
+#include "xorlinkedlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LIST_SIZE 1000000
+
+typedef struct {
+  size_t bytes;  // what the list asked for
+  size_t chunks; // what a glibc-style malloc hands out for it
+  size_t blocks;
+} Tally;
+
+// a request occupies size plus one size_t header, rounded up to
+// 2 * sizeof(size_t) with a minimum of 4 * sizeof(size_t) (glibc malloc)
+static size_t chunk_size(size_t size) {
+  size_t align = 2 * sizeof(size_t);
+  size_t chunk = (size + sizeof(size_t) + align - 1) / align * align;
+  return chunk < 2 * align ? 2 * align : chunk;
+}
+
+static void *tally_alloc(void *state, size_t size) {
+  ((Tally *)state)->bytes += size;
+  ((Tally *)state)->chunks += chunk_size(size);
+  ((Tally *)state)->blocks++;
+  return malloc(size);
+}
+
+static void *tally_realloc(void *state, void *ptr, size_t size) {
+  (void)state;
+  return realloc(ptr, size);
+}
+
+static void tally_free(void *state, void *ptr) {
+  (void)state;
+  free(ptr);
+}
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void print_list(XDLList *list, bool reverse) {
+  XDLCursor cur;
+  if (reverse) {
+    xdl_cursor_init_back(&cur, list);
+    while (xdl_cursor_valid(&cur)) {
+      printf("%d ", *(int *)xdl_cursor_get(&cur));
+      if (!xdl_cursor_prev(&cur))
+        break;
+    }
+  } else {
+    for (xdl_cursor_init(&cur, list); xdl_cursor_valid(&cur);
+         xdl_cursor_next(&cur))
+      printf("%d ", *(int *)xdl_cursor_get(&cur));
+  }
+  printf("\n");
+}
+
+int main(void) {
+  XDLList list;
+  xdl_init(&list, NULL);
+
+  for (int i = 1; i <= 5; i++)
+    xdl_push_back_deep_cp_data(&list, &i, sizeof(i));
+  int zero = 0, hundred = 100;
+  xdl_push_front_deep_cp_data(&list, &zero, sizeof(zero));
+  xdl_insert_at_index_deep_cp_data(&list, &hundred, sizeof(hundred), 3);
+  printf("Forward:  ");
+  print_list(&list, false);
+  printf("Backward: ");
+  print_list(&list, true);
+
+  int three = 3;
+  xdl_delete_by_value(&list, &three, sizeof(three));
+  xdl_delete_at_index(&list, 0);
+  int *popped = (int *)xdl_pop_back(&list, NULL);
+  printf("Popped %d, index 2 is %d, contains 3: %d\n", *popped,
+         *(int *)xdl_get_at_index(&list, 2),
+         xdl_contains(&list, &three, sizeof(three)));
+  cds_free(list.alloc, popped);
+
+  // cursor: double every even value and drop every odd one
+  XDLCursor cur;
+  xdl_cursor_init(&cur, &list);
+  while (xdl_cursor_valid(&cur)) {
+    int *v = (int *)xdl_cursor_get(&cur);
+    if (*v % 2) {
+      xdl_cursor_erase(&cur);
+    } else {
+      *v *= 2;
+      xdl_cursor_next(&cur);
+    }
+  }
+  printf("Evens doubled: ");
+  print_list(&list, false);
+  xdl_free_list(&list);
+
+  // memory footprint of LIST_SIZE ints
+  Tally dlTally = {0, 0, 0}, xdlTally = {0, 0, 0};
+  CDSAllocator dlAlloc = {tally_alloc, tally_realloc, tally_free, &dlTally};
+  CDSAllocator xdlAlloc = {tally_alloc, tally_realloc, tally_free, &xdlTally};
+
+  DLNode *root = NULL;
+  xdl_init(&list, &xdlAlloc);
+  for (int i = LIST_SIZE - 1; i >= 0; i--) {
+    dl_push_front_deep_cp_data_a(&root, &i, sizeof(i), &dlAlloc);
+    xdl_push_front_deep_cp_data(&list, &i, sizeof(i));
+  }
+
+  printf("\n%d ints, node size DLNode %zu B vs XDLNode %zu B\n", LIST_SIZE,
+         sizeof(DLNode), sizeof(XDLNode));
+  printf("DLNode list:  %zu bytes requested, %zu in malloc chunks "
+         "(%zu blocks)\n",
+         dlTally.bytes, dlTally.chunks, dlTally.blocks);
+  printf("XDLNode list: %zu bytes requested, %zu in malloc chunks "
+         "(%zu blocks)\n",
+         xdlTally.bytes, xdlTally.chunks, xdlTally.blocks);
+  printf("Saving: %.1f%% of requested bytes, %.1f%% of malloc chunks\n",
+         100.0 * (double)(dlTally.bytes - xdlTally.bytes) /
+             (double)dlTally.bytes,
+         100.0 * (double)(dlTally.chunks - xdlTally.chunks) /
+             (double)dlTally.chunks);
+
+  long long sum = 0;
+  double start = now_seconds();
+  for (DLNode *n = root; n; n = n->next)
+    sum += *(int *)n->data;
+  double dlTime = now_seconds() - start;
+
+  start = now_seconds();
+  for (xdl_cursor_init(&cur, &list); xdl_cursor_valid(&cur);
+       xdl_cursor_next(&cur))
+    sum -= *(int *)xdl_cursor_get(&cur);
+  double xdlTime = now_seconds() - start;
+  printf("Traversal: DLNode %.2f ms, XDLNode %.2f ms (checksum %lld)\n",
+         dlTime * 1e3, xdlTime * 1e3, sum);
+
+  dl_free_list_a(&root, &dlAlloc);
+  xdl_free_list(&list);
+  return 0;
+}
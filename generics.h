@@ -1,7 +1,11 @@
 #ifndef GENERICS_H
 #define GENERICS_H
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 /**
  * @struct Node
@@ -14,6 +18,73 @@ typedef struct Node {
 } Node;
 
 
+/**
+ * @enum CDSStatus
+ * @brief Result of the non-printing `*_try_*` functions.
+ */
+typedef enum CDSStatus {
+    CDS_OK = 0,            /**< Success */
+    CDS_ERR_NULL,          /**< A required pointer argument was NULL */
+    CDS_ERR_OUT_OF_BOUNDS, /**< Index outside the list */
+    CDS_ERR_NOT_FOUND,     /**< No node holds the value */
+    CDS_ERR_NO_MEMORY,     /**< The allocator returned NULL */
+    CDS_ERR_IO             /**< A file could not be opened or read */
+} CDSStatus;
+
+/**
+ * @brief Returns a short description of a status code.
+ */
+static inline const char *cds_status_str(CDSStatus status) {
+  switch (status) {
+  case CDS_OK:
+    return "ok";
+  case CDS_ERR_NULL:
+    return "null argument";
+  case CDS_ERR_OUT_OF_BOUNDS:
+    return "index out of bounds";
+  case CDS_ERR_NOT_FOUND:
+    return "value not found";
+  case CDS_ERR_NO_MEMORY:
+    return "out of memory";
+  case CDS_ERR_IO:
+    return "i/o error";
+  }
+  return "unknown status";
+}
+
+/**
+ * @def CDS_DIAGNOSTIC(status, msg)
+ * @brief Hook called by the printing lookup functions when they fail.
+ *
+ * Defaults to writing msg to stderr. Define CDS_NO_DIAGNOSTICS to compile it
+ * out, or define CDS_DIAGNOSTIC yourself before including any header to
+ * route it elsewhere. The `*_try_*` functions never call it.
+ */
+#ifndef CDS_DIAGNOSTIC
+#ifdef CDS_NO_DIAGNOSTICS
+#define CDS_DIAGNOSTIC(status, msg) ((void)(status))
+#else
+#include <stdio.h>
+#define CDS_DIAGNOSTIC(status, msg) ((void)(status), fputs((msg), stderr))
+#endif
+#endif
+
+/**
+ * @def CDS_PROF_BEGIN()
+ * @brief Starts timing a list operation; CDS_PROF_END(op) records it.
+ *
+ * With -DCDS_PROFILE the pair records the latency into the per-thread
+ * histograms of latency.h; without it both expand to nothing.
+ */
+#ifdef CDS_PROFILE
+#include "latency.h"
+#define CDS_PROF_BEGIN() uint64_t cdsProfStart = lat_now()
+#define CDS_PROF_END(op) lat_record((op), lat_now() - cdsProfStart)
+#else
+#define CDS_PROF_BEGIN() ((void)0)
+#define CDS_PROF_END(op) ((void)0)
+#endif
+
 /**
  * @brief Moves a pointer and sets the old pointer to NULL (simulates std::move
  * in C++).
@@ -26,6 +97,50 @@ static inline void *move(void **old) {
   return newPtr;
 }
 
+/**
+ * @brief Predicate over a payload, used by the `*_remove_if` functions.
+ */
+typedef bool (*CDSPredicateFn)(const void *data, size_t dataLen, void *ctx);
+
+/**
+ * @brief Picks the output list of a payload, used by the `*_partition_n`
+ * functions.
+ */
+typedef size_t (*CDSClassifyFn)(const void *data, size_t dataLen, void *ctx);
+
+/**
+ * @brief Takes over the payload of a node being removed.
+ */
+typedef void (*CDSReleaseFn)(void *data, size_t dataLen, void *ctx);
+
+/**
+ * @brief Release callback that leaves the payload alone (list does not own it).
+ */
+static inline void cds_keep_data(void *data, size_t dataLen, void *ctx) {
+  (void)data;
+  (void)dataLen;
+  (void)ctx;
+}
+
+/** @brief Pass as a CDSReleaseFn when the caller still owns the payloads. */
+#define CDS_KEEP_DATA cds_keep_data
+
+/**
+ * @struct CDSPredicateBinder
+ * @brief Adapts a CDSPredicateFn to a two-way CDSClassifyFn.
+ */
+typedef struct CDSPredicateBinder {
+    CDSPredicateFn pred; /**< Wrapped predicate */
+    void *ctx;           /**< Its context */
+} CDSPredicateBinder;
+
+// maps true to output 0 and false to output 1
+static inline size_t cds_predicate_to_index(const void *data, size_t dataLen,
+                                            void *ctx) {
+  CDSPredicateBinder *b = (CDSPredicateBinder *)ctx;
+  return b->pred(data, dataLen, b->ctx) ? 0 : 1;
+}
+
 /**
  * @struct DLNode
  * @brief Node for a doubly linked list.
@@ -37,4 +152,164 @@ typedef struct DLNode {
     struct DLNode *previous; /**< Pointer to the previous node */
 } DLNode;
 
+/**
+ * @struct CDSAllocator
+ * @brief Allocator used for node and payload memory.
+ *
+ * All `*_a` variants of the list APIs take a pointer to one of these and
+ * route every allocation through it. `state` is passed back to each
+ * callback unchanged, so it can point at an arena, a pool or anything else.
+ */
+typedef struct CDSAllocator {
+    void *(*alloc)(void *state, size_t size);              /**< Allocates size bytes */
+    void *(*realloc)(void *state, void *ptr, size_t size); /**< Resizes ptr to size bytes */
+    void (*free)(void *state, void *ptr);                  /**< Releases ptr */
+    void *state;                                           /**< User state */
+} CDSAllocator;
+
+static inline void *cds_std_alloc(void *state, size_t size) {
+  (void)state;
+  return malloc(size);
+}
+
+static inline void *cds_std_realloc(void *state, void *ptr, size_t size) {
+  (void)state;
+  return realloc(ptr, size);
+}
+
+static inline void cds_std_free(void *state, void *ptr) {
+  (void)state;
+  free(ptr);
+}
+
+/**
+ * @brief Returns the default allocator (malloc/realloc/free).
+ * @return Pointer to the default allocator.
+ * @note This is what all functions without the `_a` suffix use.
+ */
+static inline const CDSAllocator *cds_default_allocator(void) {
+  static const CDSAllocator def = {cds_std_alloc, cds_std_realloc,
+                                   cds_std_free, NULL};
+  return &def;
+}
+
+/**
+ * @brief Allocates memory through an allocator.
+ * @param alloc Allocator to use, NULL selects the default allocator.
+ * @param size Number of bytes.
+ * @return Pointer to the memory or NULL.
+ */
+static inline void *cds_alloc(const CDSAllocator *alloc, size_t size) {
+  if (alloc == NULL)
+    alloc = cds_default_allocator();
+  return alloc->alloc(alloc->state, size);
+}
+
+/**
+ * @brief Resizes memory through an allocator.
+ * @param alloc Allocator to use, NULL selects the default allocator.
+ * @param ptr Memory previously returned by the same allocator.
+ * @param size New size in bytes.
+ * @return Pointer to the resized memory or NULL.
+ */
+static inline void *cds_realloc(const CDSAllocator *alloc, void *ptr,
+                                size_t size) {
+  if (alloc == NULL)
+    alloc = cds_default_allocator();
+  return alloc->realloc(alloc->state, ptr, size);
+}
+
+/**
+ * @brief Releases memory through an allocator.
+ * @param alloc Allocator to use, NULL selects the default allocator.
+ * @param ptr Memory previously returned by the same allocator (may be NULL).
+ */
+static inline void cds_free(const CDSAllocator *alloc, void *ptr) {
+  if (ptr == NULL)
+    return;
+  if (alloc == NULL)
+    alloc = cds_default_allocator();
+  alloc->free(alloc->state, ptr);
+}
+
+/**
+ * @brief Hashes a byte string, eight bytes per step, with a final avalanche.
+ * @param data Bytes to hash (may be NULL when len is 0).
+ * @param len Number of bytes.
+ * @return 64-bit hash; every bit is usable as a table index.
+ */
+static inline uint64_t cds_hash_bytes(const void *data, size_t len) {
+  const unsigned char *p = (const unsigned char *)data;
+  uint64_t h = 0x9e3779b97f4a7c15ULL ^ (uint64_t)len;
+  uint64_t w;
+  for (; len >= 8; p += 8, len -= 8) {
+    memcpy(&w, p, 8);
+    h = (h ^ w) * 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 31;
+  }
+  if (len > 0) {
+    w = 0;
+    memcpy(&w, p, len);
+    h = (h ^ w) * 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 31;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
+/**
+ * @brief Returns the size of one record of the length-prefixed packed format.
+ *
+ * Used by the `*_to_packed` and `*_from_packed` functions. A record is the
+ * payload length as a size_t followed by the payload, zero-padded to a
+ * multiple of sizeof(size_t) so every length prefix stays aligned.
+ */
+static inline size_t cds_packed_record_size(size_t len) {
+  return (sizeof(size_t) + len + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+}
+
+// writes a record at *offset if it fits and always advances *offset, so once
+// a record is left out all the following ones are too
+static inline void cds_packed_put(void *dst, size_t dstSize, size_t *offset,
+                                  const void *data, size_t len) {
+  size_t rec = cds_packed_record_size(len);
+  if (dst != NULL && *offset + rec <= dstSize) {
+    unsigned char *p = (unsigned char *)dst + *offset;
+    memcpy(p, &len, sizeof(size_t));
+    if (len > 0)
+      memcpy(p + sizeof(size_t), data, len);
+    memset(p + sizeof(size_t) + len, 0, rec - sizeof(size_t) - len);
+  }
+  *offset += rec;
+}
+
+// reads the record at *offset; false at the end or on a truncated record
+static inline bool cds_packed_get(const void *src, size_t srcSize,
+                                  size_t *offset, const void **data,
+                                  size_t *len) {
+  const unsigned char *p;
+  if (*offset > srcSize || srcSize - *offset < sizeof(size_t))
+    return false;
+  p = (const unsigned char *)src + *offset;
+  memcpy(len, p, sizeof(size_t));
+  if (*len > srcSize - *offset - sizeof(size_t))
+    return false;
+  *data = p + sizeof(size_t);
+  *offset += cds_packed_record_size(*len);
+  if (*offset > srcSize) // last record without its padding
+    *offset = srcSize;
+  return true;
+}
+
+// copies a payload into a stride-byte slot, truncating or zero-padding it
+static inline void cds_stride_put(void *slot, size_t stride, const void *data,
+                                  size_t len) {
+  size_t n = len < stride ? len : stride;
+  if (n > 0)
+    memcpy(slot, data, n);
+  memset((unsigned char *)slot + n, 0, stride - n);
+}
+
 #endif // GENERICS_H
\ No newline at end of file
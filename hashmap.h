@@ -0,0 +1,647 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include "generics.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file hashmap.h
+ * @brief Open-addressing hash map of (data, len) keys and values (`hm_*`).
+ *
+ * The table follows the SwissTable layout: slots are grouped by 16, and
+ * every slot has a control byte holding 7 bits of the key's hash, or an
+ * empty/deleted marker. A lookup loads the 16 control bytes of a group and
+ * compares them all at once (SSE2 when available, plain C otherwise), so
+ * only slots whose hash bits match are compared with memcmp(). Probing
+ * moves from group to group and stops at the first group with an empty
+ * slot.
+ *
+ * Growing does not rehash everything in one call: the old table is kept
+ * next to the new one and every put or remove moves at least
+ * HM_MIGRATE_GROUPS groups across, while lookups consult both tables until
+ * the move is done.
+ *
+ * Keys and values follow the list ownership conventions: `_mv` puts take
+ * over the pointers, `_deep_cp` puts copy the bytes, and `_cp` puts store
+ * the pointers without owning them (the map never frees them). Owned keys
+ * and values are freed through the map's allocator. Keys of up to
+ * HM_INLINE_KEY bytes are always copied into the slot, so comparing them
+ * touches no other memory.
+ *
+ * HashMap is not thread-safe.
+ */
+
+#if !defined(CDS_NO_SIMD) && defined(__SSE2__)
+#define CDS_HM_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/** @brief Slots per probing group. */
+#define HM_GROUP 16
+
+/** @brief Minimum old-table groups moved by a put or remove while growing. */
+#ifndef HM_MIGRATE_GROUPS
+#define HM_MIGRATE_GROUPS 4
+#endif
+
+#define HM_CTRL_EMPTY ((uint8_t)0x80)
+#define HM_CTRL_DELETED ((uint8_t)0xFE)
+
+/** @brief Keys up to this many bytes are stored inside the slot. */
+#define HM_INLINE_KEY 16
+
+#define HM_OWN_KEY 1u
+#define HM_OWN_VALUE 2u
+#define HM_KEY_INLINE 4u
+
+/**
+ * @struct HMEntry
+ * @brief One key/value slot.
+ */
+typedef struct HMEntry {
+    union {
+        void *ptr;                          /**< Longer keys */
+        unsigned char bytes[HM_INLINE_KEY]; /**< Short keys, copied in */
+    } key;
+    size_t keyLen;   /**< Key length */
+    void *value;     /**< Value bytes */
+    size_t valueLen; /**< Value length */
+    unsigned flags;  /**< HM_OWN_KEY, HM_OWN_VALUE, HM_KEY_INLINE */
+} HMEntry;
+
+/**
+ * @struct HMTable
+ * @brief Control bytes and slots of one table generation.
+ */
+typedef struct HMTable {
+    uint8_t *ctrl;    /**< One control byte per slot */
+    HMEntry *slots;   /**< groups * HM_GROUP entries */
+    size_t groupMask; /**< Number of groups - 1 (power of two) */
+    size_t used;      /**< Full plus deleted slots */
+    size_t live;      /**< Full slots */
+} HMTable;
+
+/**
+ * @struct HashMap
+ * @brief Handle of a hash map.
+ */
+typedef struct HashMap {
+    HMTable cur;               /**< Table receiving inserts */
+    HMTable old;               /**< Table being drained, ctrl NULL if none */
+    size_t migrated;           /**< Old groups already moved */
+    size_t step;               /**< Old groups moved per put or remove */
+    const CDSAllocator *alloc; /**< Allocator for tables, keys and values */
+} HashMap;
+
+/**
+ * @struct HMIter
+ * @brief Position of an iteration over a map.
+ * @note Any put or remove invalidates the iteration.
+ */
+typedef struct HMIter {
+    int table;  /**< 0 for the old table, 1 for the current one */
+    size_t pos; /**< Next slot to look at */
+} HMIter;
+
+static inline const void *hm_entry_key(const HMEntry *e) {
+  return (e->flags & HM_KEY_INLINE) ? (const void *)e->key.bytes : e->key.ptr;
+}
+
+static inline size_t hm_group_of(uint64_t hash, size_t groupMask) {
+  return (size_t)(hash >> 7) & groupMask;
+}
+
+static inline uint8_t hm_h2(uint64_t hash) { return (uint8_t)(hash & 0x7F); }
+
+// bit i set if control byte i equals b
+static inline uint32_t hm_group_match(const uint8_t *g, uint8_t b) {
+#ifdef CDS_HM_SSE2
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)g);
+  return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)b)));
+#else
+  uint32_t bits = 0;
+  for (int i = 0; i < HM_GROUP; i++)
+    bits |= (uint32_t)(g[i] == b) << i;
+  return bits;
+#endif
+}
+
+// bit i set if slot i is empty or deleted (high bit of the control byte)
+static inline uint32_t hm_group_free(const uint8_t *g) {
+#ifdef CDS_HM_SSE2
+  return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)g));
+#else
+  uint32_t bits = 0;
+  for (int i = 0; i < HM_GROUP; i++)
+    bits |= (uint32_t)(g[i] >> 7) << i;
+  return bits;
+#endif
+}
+
+static inline size_t hm_table_capacity(const HMTable *t) {
+  return t->ctrl ? (t->groupMask + 1) * HM_GROUP : 0;
+}
+
+// grow once full plus deleted slots pass 7/8 of the capacity
+static inline bool hm_table_has_room(const HMTable *t) {
+  return t->ctrl && (t->used + 1) * 8 <= hm_table_capacity(t) * 7;
+}
+
+static inline CDSStatus hm_table_init(HMTable *t, size_t groups,
+                                      const CDSAllocator *alloc) {
+  memset(t, 0, sizeof(*t));
+  t->ctrl = (uint8_t *)cds_alloc(alloc, groups * HM_GROUP);
+  t->slots = (HMEntry *)cds_alloc(alloc, groups * HM_GROUP * sizeof(HMEntry));
+  if (t->ctrl == NULL || t->slots == NULL) {
+    cds_free(alloc, t->ctrl);
+    cds_free(alloc, t->slots);
+    t->ctrl = NULL;
+    t->slots = NULL;
+    return CDS_ERR_NO_MEMORY;
+  }
+  memset(t->ctrl, HM_CTRL_EMPTY, groups * HM_GROUP);
+  t->groupMask = groups - 1;
+  return CDS_OK;
+}
+
+static inline void hm_table_release(HMTable *t, const CDSAllocator *alloc) {
+  cds_free(alloc, t->ctrl);
+  cds_free(alloc, t->slots);
+  memset(t, 0, sizeof(*t));
+}
+
+// returns the slot holding the key, or SIZE_MAX
+static inline size_t hm_table_find(const HMTable *t, const void *key,
+                                   size_t keyLen, uint64_t hash) {
+  size_t g, step = 0;
+  uint8_t h2 = hm_h2(hash);
+  if (t->ctrl == NULL)
+    return SIZE_MAX;
+  g = hm_group_of(hash, t->groupMask);
+  for (;;) {
+    const uint8_t *ctrl = t->ctrl + g * HM_GROUP;
+    uint32_t bits = hm_group_match(ctrl, h2);
+    while (bits) {
+      size_t i = g * HM_GROUP + (size_t)__builtin_ctz(bits);
+      const HMEntry *e = &t->slots[i];
+      if (e->keyLen == keyLen &&
+          (keyLen == 0 || memcmp(hm_entry_key(e), key, keyLen) == 0))
+        return i;
+      bits &= bits - 1;
+    }
+    if (hm_group_match(ctrl, HM_CTRL_EMPTY))
+      return SIZE_MAX;
+    // triangular steps visit every group of a power-of-two table
+    g = (g + ++step) & t->groupMask;
+    if (step > t->groupMask)
+      return SIZE_MAX;
+  }
+}
+
+// returns the first free slot on the key's probe sequence
+static inline size_t hm_table_free_slot(const HMTable *t, uint64_t hash) {
+  size_t g = hm_group_of(hash, t->groupMask), step = 0;
+  for (;;) {
+    uint32_t bits = hm_group_free(t->ctrl + g * HM_GROUP);
+    if (bits)
+      return g * HM_GROUP + (size_t)__builtin_ctz(bits);
+    g = (g + ++step) & t->groupMask;
+  }
+}
+
+// stores an entry whose key is known to be absent; the table must have room
+static inline HMEntry *hm_table_place(HMTable *t, uint64_t hash) {
+  size_t i = hm_table_free_slot(t, hash);
+  if (t->ctrl[i] == HM_CTRL_EMPTY)
+    t->used++;
+  t->ctrl[i] = hm_h2(hash);
+  t->live++;
+  return &t->slots[i];
+}
+
+static inline void hm_table_erase(HMTable *t, size_t i) {
+  const uint8_t *group = t->ctrl + (i / HM_GROUP) * HM_GROUP;
+  // a group with an empty slot has never been full, so no probe went past
+  // it and the slot can become empty again instead of a tombstone
+  if (hm_group_match(group, HM_CTRL_EMPTY)) {
+    t->ctrl[i] = HM_CTRL_EMPTY;
+    t->used--;
+  } else {
+    t->ctrl[i] = HM_CTRL_DELETED;
+  }
+  t->live--;
+}
+
+static inline void hm_entry_release(HashMap *map, HMEntry *e) {
+  if (e->flags & HM_OWN_KEY)
+    cds_free(map->alloc, e->key.ptr);
+  if (e->flags & HM_OWN_VALUE)
+    cds_free(map->alloc, e->value);
+}
+
+// moves up to `groups` old groups into the current table
+static inline void hm_migrate(HashMap *map, size_t groups) {
+  HMTable *old = &map->old;
+  if (old->ctrl == NULL)
+    return;
+  while (groups-- > 0 && map->migrated <= old->groupMask) {
+    size_t base = map->migrated++ * HM_GROUP;
+    for (size_t i = base; i < base + HM_GROUP; i++) {
+      const HMEntry *e = &old->slots[i];
+      if (old->ctrl[i] & 0x80)
+        continue;
+      *hm_table_place(&map->cur, cds_hash_bytes(hm_entry_key(e), e->keyLen)) =
+          *e;
+      old->ctrl[i] = HM_CTRL_DELETED;
+      old->live--;
+    }
+  }
+  if (map->migrated > old->groupMask)
+    hm_table_release(old, map->alloc);
+}
+
+static inline size_t hm_groups_for(size_t entries) {
+  size_t groups = 1;
+  while (groups * HM_GROUP * 7 < entries * 8)
+    groups <<= 1;
+  return groups;
+}
+
+// makes `next` the current table and starts draining the old one; the
+// step is chosen so the old table is empty before half of the new table's
+// headroom is used up
+static inline void hm_start_generation(HashMap *map, HMTable *next) {
+  size_t live = map->cur.live;
+  size_t budget = (hm_table_capacity(next) * 7 / 8 - live) / 2;
+  size_t groups = map->cur.groupMask + 1;
+  map->old = map->cur;
+  map->cur = *next;
+  map->migrated = 0;
+  map->step = budget ? (groups + budget - 1) / budget : groups;
+  if (map->step < HM_MIGRATE_GROUPS)
+    map->step = HM_MIGRATE_GROUPS;
+}
+
+// makes room for one more entry, starting a new generation if needed
+static inline CDSStatus hm_make_room(HashMap *map) {
+  HMTable next;
+  size_t groups;
+  if (hm_table_has_room(&map->cur))
+    return CDS_OK;
+  // a second generation cannot start while one is still draining
+  hm_migrate(map, SIZE_MAX);
+  if (hm_table_has_room(&map->cur))
+    return CDS_OK;
+  // sized by live entries, so a table clogged with tombstones is rebuilt
+  // at the same size instead of doubled
+  groups = hm_groups_for(map->cur.live + 1);
+  if ((map->cur.live + 1) * 2 > groups * HM_GROUP)
+    groups *= 2;
+  if (hm_table_init(&next, groups, map->alloc) != CDS_OK)
+    return CDS_ERR_NO_MEMORY;
+  hm_start_generation(map, &next);
+  return CDS_OK;
+}
+
+/**
+ * @brief Initializes an empty map.
+ * @param capacity Number of entries to size the table for (may be 0).
+ * @param alloc Allocator, NULL for the default one.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus hm_init(HashMap *map, size_t capacity,
+                                const CDSAllocator *alloc) {
+  memset(map, 0, sizeof(*map));
+  map->alloc = alloc ? alloc : cds_default_allocator();
+  return hm_table_init(&map->cur, hm_groups_for(capacity), map->alloc);
+}
+
+/**
+ * @brief Returns the number of entries.
+ */
+static inline size_t hm_size(const HashMap *map) {
+  return map->cur.live + map->old.live;
+}
+
+/**
+ * @brief Returns true while an incremental resize is in progress.
+ */
+static inline bool hm_is_resizing(const HashMap *map) {
+  return map->old.ctrl != NULL;
+}
+
+// finds a key in either table
+static inline HMEntry *hm_lookup(const HashMap *map, const void *key,
+                                 size_t keyLen, uint64_t hash) {
+  size_t i = hm_table_find(&map->cur, key, keyLen, hash);
+  if (i != SIZE_MAX)
+    return &map->cur.slots[i];
+  if (map->old.ctrl != NULL) {
+    i = hm_table_find(&map->old, key, keyLen, hash);
+    if (i != SIZE_MAX)
+      return &map->old.slots[i];
+  }
+  return NULL;
+}
+
+// how hm_put_entry() gets the key
+typedef enum HMKeyMode { HM_KEY_BORROW, HM_KEY_MOVE, HM_KEY_COPY } HMKeyMode;
+
+// inserts or replaces; on CDS_OK a moved key belongs to the map, and so does
+// the value if ownValue is set
+static inline CDSStatus hm_put_entry(HashMap *map, void *key, size_t keyLen,
+                                     HMKeyMode mode, void *value,
+                                     size_t valueLen, bool ownValue) {
+  uint64_t hash = cds_hash_bytes(key, keyLen);
+  HMEntry *e = hm_lookup(map, key, keyLen, hash);
+  void *copy = NULL;
+  if (e != NULL) {
+    // the stored key has the same bytes: keep it, drop the incoming one
+    if (e->flags & HM_OWN_VALUE)
+      cds_free(map->alloc, e->value);
+    if (mode == HM_KEY_MOVE)
+      cds_free(map->alloc, key);
+    e->value = value;
+    e->valueLen = valueLen;
+    e->flags = (e->flags & ~HM_OWN_VALUE) | (ownValue ? HM_OWN_VALUE : 0);
+    hm_migrate(map, map->step);
+    return CDS_OK;
+  }
+  if (mode == HM_KEY_COPY && keyLen > HM_INLINE_KEY) {
+    copy = cds_alloc(map->alloc, keyLen);
+    if (copy == NULL)
+      return CDS_ERR_NO_MEMORY;
+    memcpy(copy, key, keyLen);
+  }
+  if (hm_make_room(map) != CDS_OK) {
+    cds_free(map->alloc, copy);
+    return CDS_ERR_NO_MEMORY;
+  }
+  e = hm_table_place(&map->cur, hash);
+  e->keyLen = keyLen;
+  e->value = value;
+  e->valueLen = valueLen;
+  e->flags = ownValue ? HM_OWN_VALUE : 0;
+  if (keyLen <= HM_INLINE_KEY) {
+    if (keyLen > 0)
+      memcpy(e->key.bytes, key, keyLen);
+    e->flags |= HM_KEY_INLINE;
+    if (mode == HM_KEY_MOVE)
+      cds_free(map->alloc, key);
+  } else if (mode == HM_KEY_BORROW) {
+    e->key.ptr = key;
+  } else {
+    e->key.ptr = mode == HM_KEY_COPY ? copy : key;
+    e->flags |= HM_OWN_KEY;
+  }
+  hm_migrate(map, map->step);
+  return CDS_OK;
+}
+
+/**
+ * @brief Inserts or replaces an entry, taking over key and value.
+ * @param key Pointer to the key pointer; set to NULL on success.
+ * @param value Pointer to the value pointer; set to NULL on success.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NO_MEMORY; on failure both stay
+ * with the caller.
+ * @note Both must come from the map's allocator. Replacing an entry frees
+ * its old key and value if the map owned them.
+ */
+static inline CDSStatus hm_put_mv(HashMap *map, void **key, size_t keyLen,
+                                  void **value, size_t valueLen) {
+  CDSStatus status;
+  if (map == NULL || key == NULL || value == NULL)
+    return CDS_ERR_NULL;
+  status = hm_put_entry(map, *key, keyLen, HM_KEY_MOVE, *value, valueLen,
+                        true);
+  if (status == CDS_OK) {
+    *key = NULL;
+    *value = NULL;
+  }
+  return status;
+}
+
+/**
+ * @brief Inserts or replaces an entry that points at the caller's key and
+ * value (shallow copy).
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NO_MEMORY.
+ * @note The map does not own them; they must outlive the entry. Keys of up
+ * to HM_INLINE_KEY bytes are copied into the slot anyway.
+ */
+static inline CDSStatus hm_put_cp(HashMap *map, void *key, size_t keyLen,
+                                  void *value, size_t valueLen) {
+  if (map == NULL)
+    return CDS_ERR_NULL;
+  return hm_put_entry(map, key, keyLen, HM_KEY_BORROW, value, valueLen,
+                      false);
+}
+
+/**
+ * @brief Inserts or replaces an entry with copies of key and value.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus hm_put_deep_cp(HashMap *map, const void *key,
+                                       size_t keyLen, const void *value,
+                                       size_t valueLen) {
+  void *copy = NULL;
+  CDSStatus status;
+  if (map == NULL)
+    return CDS_ERR_NULL;
+  if (value && valueLen) {
+    copy = cds_alloc(map->alloc, valueLen);
+    if (copy == NULL)
+      return CDS_ERR_NO_MEMORY;
+    memcpy(copy, value, valueLen);
+  }
+  status = hm_put_entry(map, (void *)key, keyLen, HM_KEY_COPY, copy, valueLen,
+                        true);
+  if (status != CDS_OK)
+    cds_free(map->alloc, copy);
+  return status;
+}
+
+/**
+ * @brief Looks up a key without printing.
+ * @param value Receives the value pointer, or NULL on failure.
+ * @param valueLen Receives the value length (may be NULL).
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NOT_FOUND.
+ */
+static inline CDSStatus hm_try_get(const HashMap *map, const void *key,
+                                   size_t keyLen, void **value,
+                                   size_t *valueLen) {
+  HMEntry *e;
+  if (map == NULL || value == NULL)
+    return CDS_ERR_NULL;
+  e = hm_lookup(map, key, keyLen, cds_hash_bytes(key, keyLen));
+  *value = e ? e->value : NULL;
+  if (e == NULL)
+    return CDS_ERR_NOT_FOUND;
+  if (valueLen)
+    *valueLen = e->valueLen;
+  return CDS_OK;
+}
+
+/**
+ * @brief Returns the value of a key, or NULL if absent.
+ * @param valueLen Receives the value length (may be NULL).
+ * @note Misses are not reported; use hm_contains() when values may be NULL.
+ */
+static inline void *hm_get(const HashMap *map, const void *key, size_t keyLen,
+                           size_t *valueLen) {
+  void *value = NULL;
+  hm_try_get(map, key, keyLen, &value, valueLen);
+  return value;
+}
+
+/**
+ * @brief Checks if a key is present.
+ */
+static inline bool hm_contains(const HashMap *map, const void *key,
+                               size_t keyLen) {
+  return hm_lookup(map, key, keyLen, cds_hash_bytes(key, keyLen)) != NULL;
+}
+
+/**
+ * @brief Removes an entry and hands its value to the caller.
+ * @param value Receives the value (ownership transferred if the map owned
+ * it).
+ * @param valueLen Receives the value length (may be NULL).
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NOT_FOUND.
+ */
+static inline CDSStatus hm_take(HashMap *map, const void *key, size_t keyLen,
+                                void **value, size_t *valueLen) {
+  uint64_t hash;
+  HMTable *t;
+  size_t i;
+  if (map == NULL || value == NULL)
+    return CDS_ERR_NULL;
+  t = &map->cur;
+  hash = cds_hash_bytes(key, keyLen);
+  i = hm_table_find(t, key, keyLen, hash);
+  if (i == SIZE_MAX && map->old.ctrl != NULL) {
+    t = &map->old;
+    i = hm_table_find(t, key, keyLen, hash);
+  }
+  *value = NULL;
+  if (i == SIZE_MAX)
+    return CDS_ERR_NOT_FOUND;
+  *value = t->slots[i].value;
+  if (valueLen)
+    *valueLen = t->slots[i].valueLen;
+  if (t->slots[i].flags & HM_OWN_KEY)
+    cds_free(map->alloc, t->slots[i].key.ptr);
+  hm_table_erase(t, i);
+  hm_migrate(map, map->step);
+  return CDS_OK;
+}
+
+/**
+ * @brief Removes an entry, freeing the key and value the map owns.
+ * @return true if the key was present.
+ */
+static inline bool hm_remove(HashMap *map, const void *key, size_t keyLen) {
+  uint64_t hash = cds_hash_bytes(key, keyLen);
+  HMTable *t = &map->cur;
+  size_t i = hm_table_find(t, key, keyLen, hash);
+  if (i == SIZE_MAX && map->old.ctrl != NULL) {
+    t = &map->old;
+    i = hm_table_find(t, key, keyLen, hash);
+  }
+  if (i == SIZE_MAX)
+    return false;
+  hm_entry_release(map, &t->slots[i]);
+  hm_table_erase(t, i);
+  hm_migrate(map, map->step);
+  return true;
+}
+
+/**
+ * @brief Sizes the table for at least `entries` entries at once.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus hm_reserve(HashMap *map, size_t entries) {
+  HMTable next;
+  size_t groups = hm_groups_for(entries);
+  hm_migrate(map, SIZE_MAX);
+  if (groups <= map->cur.groupMask + 1)
+    return CDS_OK;
+  if (hm_table_init(&next, groups, map->alloc) != CDS_OK)
+    return CDS_ERR_NO_MEMORY;
+  hm_start_generation(map, &next);
+  hm_migrate(map, SIZE_MAX);
+  return CDS_OK;
+}
+
+/**
+ * @brief Starts an iteration.
+ */
+static inline void hm_iter_init(const HashMap *map, HMIter *it) {
+  it->table = map->old.ctrl != NULL ? 0 : 1;
+  it->pos = 0;
+}
+
+/**
+ * @brief Returns the next entry of an iteration, in no particular order.
+ * @param key, keyLen, value, valueLen Receive the entry (each may be NULL).
+ * @return false once every entry has been returned.
+ * @note An inline key points into the table and moves on the next put or
+ * remove.
+ */
+static inline bool hm_iter_next(const HashMap *map, HMIter *it,
+                                const void **key, size_t *keyLen,
+                                void **value, size_t *valueLen) {
+  for (; it->table < 2; it->table++, it->pos = 0) {
+    const HMTable *t = it->table ? &map->cur : &map->old;
+    size_t cap = hm_table_capacity(t);
+    while (it->pos < cap) {
+      size_t i = it->pos++;
+      if (t->ctrl[i] & 0x80)
+        continue;
+      if (key)
+        *key = hm_entry_key(&t->slots[i]);
+      if (keyLen)
+        *keyLen = t->slots[i].keyLen;
+      if (value)
+        *value = t->slots[i].value;
+      if (valueLen)
+        *valueLen = t->slots[i].valueLen;
+      return true;
+    }
+  }
+  return false;
+}
+
+static inline void hm_table_clear(HashMap *map, HMTable *t) {
+  size_t cap = hm_table_capacity(t);
+  for (size_t i = 0; i < cap; i++)
+    if (!(t->ctrl[i] & 0x80))
+      hm_entry_release(map, &t->slots[i]);
+  if (cap)
+    memset(t->ctrl, HM_CTRL_EMPTY, cap);
+  t->used = t->live = 0;
+}
+
+/**
+ * @brief Removes every entry but keeps the current table.
+ */
+static inline void hm_clear(HashMap *map) {
+  if (map->old.ctrl != NULL) {
+    hm_table_clear(map, &map->old);
+    hm_table_release(&map->old, map->alloc);
+  }
+  hm_table_clear(map, &map->cur);
+}
+
+/**
+ * @brief Frees every entry and the tables. The handle must be
+ * re-initialized before reuse.
+ */
+static inline void hm_free(HashMap *map) {
+  hm_clear(map);
+  hm_table_release(&map->cur, map->alloc);
+}
+
+#endif // HASHMAP_H
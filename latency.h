@@ -0,0 +1,473 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @file latency.h
+ * @brief Per-operation latency histograms for profiling (`lat_*`).
+ *
+ * Compile with -DCDS_PROFILE and the list operations of LatOp time themselves
+ * through the CDS_PROF_BEGIN()/CDS_PROF_END() hooks of generics.h. Without
+ * it the hooks expand to nothing and this header is not even included.
+ *
+ * - Latencies are read from the time-stamp counter (rdtsc on x86,
+ *   cntvct_el0 on AArch64, lat_clock_ns() elsewhere or with LAT_NO_TSC)
+ *   and converted to nanoseconds only when a report is made.
+ * - Every thread records into its own histograms, found through a
+ *   thread-local pointer, so the hot path is a handful of uncontended
+ *   stores. Reports merge all threads on demand; histograms of threads
+ *   that exited are kept.
+ * - Histograms are HDR-style log-linear: values below 2^LAT_SUB_BITS ticks
+ *   are exact, larger ones fall into 2^LAT_SUB_BITS buckets per power of
+ *   two, so a percentile is off by at most 1 / 2^LAT_SUB_BITS (about 3%).
+ *   Values are capped at 2^LAT_MAX_BITS - 1 ticks.
+ *
+ * The process-wide state is a weak symbol, so every translation unit that
+ * includes this header shares it (GCC and Clang). A recording thread costs
+ * LAT_OPS histograms of LAT_BUCKETS counters (about 80 KB), which are
+ * never freed.
+ *
+ * LatHistogram can also be used on its own through lat_hist_*.
+ */
+
+#if !defined(LAT_NO_TSC) && (defined(__x86_64__) || defined(__i386__))
+#define LAT_TSC 1
+#include <x86intrin.h>
+#elif !defined(LAT_NO_TSC) && defined(__aarch64__)
+#define LAT_TSC 1
+#endif
+
+/** @brief log2 of the sub-buckets per power of two. */
+#ifndef LAT_SUB_BITS
+#define LAT_SUB_BITS 5
+#endif
+
+/** @brief Largest recorded value is 2^LAT_MAX_BITS - 1 ticks. */
+#ifndef LAT_MAX_BITS
+#define LAT_MAX_BITS 44
+#endif
+
+#define LAT_SUB (1u << LAT_SUB_BITS)
+#define LAT_MAX_VALUE ((UINT64_C(1) << LAT_MAX_BITS) - 1)
+#define LAT_BUCKETS ((LAT_MAX_BITS - LAT_SUB_BITS + 1) * LAT_SUB)
+
+/**
+ * @brief Operations timed when CDS_PROFILE is defined.
+ */
+typedef enum LatOp {
+  LAT_SL_PUSH_BACK,       /**< sl_push_back_* */
+  LAT_DL_INSERT_AT_INDEX, /**< dl_insert_at_index_* */
+  LAT_SL_GET_BY_VALUE,    /**< sl_get_by_value, sl_try_get_by_value */
+  LAT_DL_GET_BY_VALUE,    /**< dl_get_by_value, dl_try_get_by_value */
+  LAT_CL_GET_BY_VALUE,    /**< cl_try_get_by_value */
+  LAT_SL_FREE_LIST,       /**< sl_free_list, sl_free_list_a */
+  LAT_DL_FREE_LIST,       /**< dl_free_list, dl_free_list_a */
+  LAT_CL_FREE_LIST,       /**< cl_free_list, cl_free_list_a */
+  LAT_OPS
+} LatOp;
+
+/**
+ * @brief Output format of lat_dump().
+ */
+typedef enum LatFormat { LAT_TEXT, LAT_JSON } LatFormat;
+
+/**
+ * @struct LatHistogram
+ * @brief Log-linear histogram of tick counts.
+ */
+typedef struct LatHistogram {
+    uint64_t count;                /**< Recorded values */
+    uint64_t sum;                  /**< Sum of the values */
+    uint64_t min;                  /**< Smallest value, UINT64_MAX if none */
+    uint64_t max;                  /**< Largest value */
+    uint64_t buckets[LAT_BUCKETS]; /**< Values per bucket */
+} LatHistogram;
+
+/**
+ * @struct LatSummary
+ * @brief Percentiles of one operation, in nanoseconds.
+ */
+typedef struct LatSummary {
+    uint64_t count; /**< Recorded operations */
+    double mean;    /**< Mean latency */
+    double p50;     /**< Median */
+    double p99;     /**< 99th percentile */
+    double p999;    /**< 99.9th percentile */
+    double max;     /**< Largest latency */
+} LatSummary;
+
+/**
+ * @brief Reads a nanosecond clock.
+ *
+ * CLOCK_MONOTONIC needs POSIX (it is hidden by a strict -std=c99 unless
+ * _POSIX_C_SOURCE >= 199309L is defined); without it this falls back to
+ * C11 timespec_get() and then to the coarse processor-time clock().
+ */
+static inline uint64_t lat_clock_ns(void) {
+#if defined(CLOCK_MONOTONIC)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#elif defined(TIME_UTC)
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#else
+  return (uint64_t)((double)clock() * (1e9 / CLOCKS_PER_SEC));
+#endif
+}
+
+/**
+ * @brief Reads the profiling clock.
+ * @return Ticks; see lat_ticks_per_ns() for the rate.
+ */
+static inline uint64_t lat_now(void) {
+#if defined(LAT_TSC) && (defined(__x86_64__) || defined(__i386__))
+  return __rdtsc();
+#elif defined(LAT_TSC)
+  uint64_t v;
+  __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+#else
+  return lat_clock_ns();
+#endif
+}
+
+/**
+ * @brief Returns the bucket of a value (capped at LAT_MAX_VALUE).
+ */
+static inline size_t lat_bucket(uint64_t v) {
+  if (v > LAT_MAX_VALUE)
+    v = LAT_MAX_VALUE;
+  if (v < LAT_SUB)
+    return (size_t)v;
+  int shift = 63 - __builtin_clzll(v) - LAT_SUB_BITS;
+  return (size_t)shift * LAT_SUB + (size_t)(v >> shift);
+}
+
+/**
+ * @brief Returns the largest value that falls into a bucket.
+ */
+static inline uint64_t lat_bucket_upper(size_t idx) {
+  if (idx < 2 * LAT_SUB)
+    return idx;
+  size_t shift = idx / LAT_SUB - 1;
+  uint64_t sub = idx % LAT_SUB + LAT_SUB;
+  return ((sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief Empties a histogram.
+ */
+static inline void lat_hist_init(LatHistogram *h) {
+  memset(h, 0, sizeof(*h));
+  h->min = UINT64_MAX;
+}
+
+// a histogram has a single writer, so updates are a load and a store; they
+// are atomic only so that merges and resets from other threads are not
+// data races
+static inline void lat_store(uint64_t *p, uint64_t v) {
+  __atomic_store_n(p, v, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t lat_load(const uint64_t *p) {
+  return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Adds a value to a histogram.
+ * @note Only one thread may record into a histogram; any thread may merge
+ * it.
+ */
+static inline void lat_hist_record(LatHistogram *h, uint64_t v) {
+  if (v > LAT_MAX_VALUE)
+    v = LAT_MAX_VALUE;
+  size_t b = lat_bucket(v);
+  lat_store(&h->buckets[b], lat_load(&h->buckets[b]) + 1);
+  lat_store(&h->count, lat_load(&h->count) + 1);
+  lat_store(&h->sum, lat_load(&h->sum) + v);
+  if (v < lat_load(&h->min))
+    lat_store(&h->min, v);
+  if (v > lat_load(&h->max))
+    lat_store(&h->max, v);
+}
+
+/**
+ * @brief Adds the contents of src to dst.
+ */
+static inline void lat_hist_merge(LatHistogram *dst, const LatHistogram *src) {
+  uint64_t min = lat_load(&src->min);
+  uint64_t max = lat_load(&src->max);
+  for (size_t i = 0; i < LAT_BUCKETS; i++)
+    dst->buckets[i] += lat_load(&src->buckets[i]);
+  dst->count += lat_load(&src->count);
+  dst->sum += lat_load(&src->sum);
+  if (min < dst->min)
+    dst->min = min;
+  if (max > dst->max)
+    dst->max = max;
+}
+
+/**
+ * @brief Returns the value below which a fraction q of the values lie.
+ *
+ * The result is the upper end of the bucket holding that rank, capped at
+ * the largest recorded value.
+ * @param q Fraction in [0, 1]; 0.5 is the median.
+ * @return Ticks, 0 for an empty histogram.
+ */
+static inline uint64_t lat_hist_percentile(const LatHistogram *h, double q) {
+  if (h->count == 0)
+    return 0;
+  uint64_t rank = (uint64_t)(q * (double)h->count + 0.999999);
+  if (rank < 1)
+    rank = 1;
+  if (rank >= h->count)
+    return h->max;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < LAT_BUCKETS; i++) {
+    seen += h->buckets[i];
+    if (seen >= rank) {
+      uint64_t upper = lat_bucket_upper(i);
+      return upper < h->max ? upper : h->max;
+    }
+  }
+  return h->max;
+}
+
+/**
+ * @struct LatThread
+ * @brief Histograms recorded by one thread.
+ */
+typedef struct LatThread {
+    LatHistogram hist[LAT_OPS]; /**< One histogram per operation */
+    struct LatThread *next;     /**< Next registered thread */
+} LatThread;
+
+/**
+ * @struct LatRegistry
+ * @brief Process-wide list of per-thread histograms.
+ */
+typedef struct LatRegistry {
+    pthread_mutex_t lock;  /**< Guards threads and ticksPerNs */
+    pthread_once_t once;   /**< Creates key */
+    pthread_key_t key;     /**< Current thread's LatThread */
+    LatThread *threads;    /**< Every thread that recorded */
+    double ticksPerNs;     /**< Clock rate, 0 until calibrated */
+} LatRegistry;
+
+__attribute__((weak)) LatRegistry lat_registry = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_ONCE_INIT, 0, NULL, 0.0};
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define LAT_THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define LAT_THREAD_LOCAL _Thread_local
+#else
+#define LAT_THREAD_LOCAL __thread
+#endif
+
+// per translation unit; a miss falls back to the shared key, so a thread
+// still owns a single LatThread
+static LAT_THREAD_LOCAL LatThread *lat_current;
+
+static inline void lat_key_create(void) {
+  pthread_key_create(&lat_registry.key, NULL);
+}
+
+// first record of a thread in this translation unit
+static inline LatThread *lat_register(void) {
+  pthread_once(&lat_registry.once, lat_key_create);
+  LatThread *t = (LatThread *)pthread_getspecific(lat_registry.key);
+  if (t == NULL) {
+    t = (LatThread *)malloc(sizeof(LatThread));
+    if (t == NULL)
+      return NULL;
+    for (int op = 0; op < LAT_OPS; op++)
+      lat_hist_init(&t->hist[op]);
+    pthread_setspecific(lat_registry.key, t);
+    pthread_mutex_lock(&lat_registry.lock);
+    t->next = lat_registry.threads;
+    lat_registry.threads = t;
+    pthread_mutex_unlock(&lat_registry.lock);
+  }
+  lat_current = t;
+  return t;
+}
+
+/**
+ * @brief Returns the calling thread's histograms, registering it first.
+ * @return NULL if they could not be allocated.
+ */
+static inline LatThread *lat_thread(void) {
+  LatThread *t = lat_current;
+  return t != NULL ? t : lat_register();
+}
+
+/**
+ * @brief Records a latency for an operation on the calling thread.
+ * @param ticks Difference of two lat_now() readings.
+ */
+static inline void lat_record(LatOp op, uint64_t ticks) {
+  LatThread *t = lat_thread();
+  if (t != NULL)
+    lat_hist_record(&t->hist[op], ticks);
+}
+
+// called with the registry lock held
+static inline double lat_calibrate(void) {
+#ifdef LAT_TSC
+  if (lat_registry.ticksPerNs == 0.0) {
+    uint64_t a = lat_clock_ns();
+    uint64_t t0 = lat_now();
+    double ns;
+    do {
+      ns = (double)(lat_clock_ns() - a);
+    } while (ns < 10e6);
+    lat_registry.ticksPerNs = (double)(lat_now() - t0) / ns;
+  }
+  return lat_registry.ticksPerNs;
+#else
+  return 1.0;
+#endif
+}
+
+/**
+ * @brief Returns the clock rate in ticks per nanosecond.
+ *
+ * The first call with the TSC clock spins for 10 ms to measure it.
+ */
+static inline double lat_ticks_per_ns(void) {
+  pthread_mutex_lock(&lat_registry.lock);
+  double rate = lat_calibrate();
+  pthread_mutex_unlock(&lat_registry.lock);
+  return rate;
+}
+
+/**
+ * @brief Merges the histograms of every thread for one operation.
+ * @param out Receives the merged histogram (in ticks).
+ */
+static inline void lat_snapshot(LatOp op, LatHistogram *out) {
+  lat_hist_init(out);
+  pthread_mutex_lock(&lat_registry.lock);
+  for (LatThread *t = lat_registry.threads; t != NULL; t = t->next)
+    lat_hist_merge(out, &t->hist[op]);
+  pthread_mutex_unlock(&lat_registry.lock);
+}
+
+/**
+ * @brief Computes count, mean, p50, p99, p99.9 and max of an operation.
+ * @return false if nothing was recorded for it.
+ */
+static inline bool lat_summary(LatOp op, LatSummary *out) {
+  LatHistogram *h = (LatHistogram *)malloc(sizeof(LatHistogram));
+  memset(out, 0, sizeof(*out));
+  if (h == NULL)
+    return false;
+  lat_snapshot(op, h);
+  double perNs = lat_ticks_per_ns();
+  out->count = h->count;
+  if (h->count > 0) {
+    out->mean = (double)h->sum / (double)h->count / perNs;
+    out->p50 = (double)lat_hist_percentile(h, 0.5) / perNs;
+    out->p99 = (double)lat_hist_percentile(h, 0.99) / perNs;
+    out->p999 = (double)lat_hist_percentile(h, 0.999) / perNs;
+    out->max = (double)h->max / perNs;
+  }
+  free(h);
+  return out->count > 0;
+}
+
+/**
+ * @brief Returns the function family an operation stands for.
+ */
+static inline const char *lat_op_name(LatOp op) {
+  switch (op) {
+  case LAT_SL_PUSH_BACK:
+    return "sl_push_back";
+  case LAT_DL_INSERT_AT_INDEX:
+    return "dl_insert_at_index";
+  case LAT_SL_GET_BY_VALUE:
+    return "sl_get_by_value";
+  case LAT_DL_GET_BY_VALUE:
+    return "dl_get_by_value";
+  case LAT_CL_GET_BY_VALUE:
+    return "cl_get_by_value";
+  case LAT_SL_FREE_LIST:
+    return "sl_free_list";
+  case LAT_DL_FREE_LIST:
+    return "dl_free_list";
+  case LAT_CL_FREE_LIST:
+    return "cl_free_list";
+  case LAT_OPS:
+    break;
+  }
+  return "unknown";
+}
+
+/**
+ * @brief Writes the summary of every recorded operation.
+ *
+ * LAT_TEXT prints one aligned row per operation; LAT_JSON prints an object
+ * keyed by operation name with count, mean, p50, p99, p999 and max in
+ * nanoseconds. Operations that were never recorded are left out.
+ */
+static inline void lat_dump(FILE *out, LatFormat format) {
+  bool first = true;
+  if (format == LAT_TEXT)
+    fprintf(out, "%-20s %10s %10s %10s %10s %10s %10s\n", "operation",
+            "count", "mean ns", "p50 ns", "p99 ns", "p99.9 ns", "max ns");
+  else
+    fputs("{", out);
+  for (int op = 0; op < LAT_OPS; op++) {
+    LatSummary s;
+    if (!lat_summary((LatOp)op, &s))
+      continue;
+    if (format == LAT_TEXT) {
+      fprintf(out, "%-20s %10llu %10.0f %10.0f %10.0f %10.0f %10.0f\n",
+              lat_op_name((LatOp)op), (unsigned long long)s.count, s.mean,
+              s.p50, s.p99, s.p999, s.max);
+    } else {
+      fprintf(out,
+              "%s\"%s\":{\"count\":%llu,\"mean\":%.1f,\"p50\":%.1f,"
+              "\"p99\":%.1f,\"p999\":%.1f,\"max\":%.1f}",
+              first ? "" : ",", lat_op_name((LatOp)op),
+              (unsigned long long)s.count, s.mean, s.p50, s.p99, s.p999,
+              s.max);
+    }
+    first = false;
+  }
+  if (format == LAT_JSON)
+    fputs("}\n", out);
+}
+
+/**
+ * @brief Empties the histograms of every thread.
+ * @note Values recorded concurrently with the reset may survive it.
+ */
+static inline void lat_reset(void) {
+  pthread_mutex_lock(&lat_registry.lock);
+  for (LatThread *t = lat_registry.threads; t != NULL; t = t->next)
+    for (int op = 0; op < LAT_OPS; op++) {
+      LatHistogram *h = &t->hist[op];
+      for (size_t i = 0; i < LAT_BUCKETS; i++)
+        lat_store(&h->buckets[i], 0);
+      lat_store(&h->count, 0);
+      lat_store(&h->sum, 0);
+      lat_store(&h->min, UINT64_MAX);
+      lat_store(&h->max, 0);
+    }
+  pthread_mutex_unlock(&lat_registry.lock);
+}
+
+#endif // LATENCY_H
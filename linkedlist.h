@@ -1,6 +1,7 @@
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -8,18 +9,44 @@
 
 
 
+/**
+ * @brief Allocator-aware variant of sl_create_node_mv().
+ * @param alloc Allocator used for the node.
+ * @note The moved data must come from the same allocator.
+ */
+static inline Node *sl_create_node_mv_a(void **data, size_t dataLen, Node *next,
+                                        const CDSAllocator *alloc) {
+  Node *newNode = (Node *)cds_alloc(alloc, sizeof(Node));
+  if (newNode == NULL)
+    return NULL;
+  newNode->dataLen = dataLen;
+  newNode->data = move(data);
+  newNode->next = next;
+  return newNode;
+}
+
 /**
  * @brief Creates a new node using move semantics for the data.
  * @param data Pointer to pointer of data (ownership transferred).
  * @param dataLen Size of the data in bytes.
  * @param next Pointer to the next node.
- * @return Pointer to the new node.
+ * @return Pointer to the new node, or NULL if out of memory.
  */
 static inline Node *sl_create_node_mv(void **data, size_t dataLen, Node *next) {
-  Node *newNode = (Node *)malloc(sizeof(Node));
+  return sl_create_node_mv_a(data, dataLen, next, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_create_node_deep_mv().
+ * @param alloc Allocator used for the node.
+ */
+static inline Node *sl_create_node_deep_mv_a(void **data, size_t dataLen,
+                                             Node **next,
+                                             const CDSAllocator *alloc) {
+  Node *newNode = (Node *)cds_alloc(alloc, sizeof(Node));
   newNode->dataLen = dataLen;
   newNode->data = move(data);
-  newNode->next = next;
+  newNode->next = (Node *)move((void **)next);
   return newNode;
 }
 
@@ -33,10 +60,21 @@ static inline Node *sl_create_node_mv(void **data, size_t dataLen, Node *next) {
  */
 static inline Node *sl_create_node_deep_mv(void **data, size_t dataLen,
                                            Node **next) {
-  Node *newNode = (Node *)malloc(sizeof(Node));
+  return sl_create_node_deep_mv_a(data, dataLen, next, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_create_node_cp().
+ * @param alloc Allocator used for the node.
+ */
+static inline Node *sl_create_node_cp_a(void *data, size_t dataLen, Node *next,
+                                        const CDSAllocator *alloc) {
+  Node *newNode = (Node *)cds_alloc(alloc, sizeof(Node));
+  if (newNode == NULL)
+    return NULL;
   newNode->dataLen = dataLen;
-  newNode->data = move(data);
-  newNode->next = (Node *)move((void **)next);
+  newNode->data = data;
+  newNode->next = next;
   return newNode;
 }
 
@@ -45,13 +83,34 @@ static inline Node *sl_create_node_deep_mv(void **data, size_t dataLen,
  * @param data Pointer to the data (not copied).
  * @param dataLen Size of the data.
  * @param next Pointer to the next node.
- * @return Pointer to the new node.
+ * @return Pointer to the new node, or NULL if out of memory.
  * @note Node does not own the data.
  */
 static inline Node *sl_create_node_cp(void *data, size_t dataLen, Node *next) {
-  Node *newNode = (Node *)malloc(sizeof(Node));
+  return sl_create_node_cp_a(data, dataLen, next, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_create_node_deep_cp().
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline Node *sl_create_node_deep_cp_a(void *data, size_t dataLen,
+                                             Node *next,
+                                             const CDSAllocator *alloc) {
+  Node *newNode = (Node *)cds_alloc(alloc, sizeof(Node));
+  if (newNode == NULL)
+    return NULL;
   newNode->dataLen = dataLen;
-  newNode->data = data;
+  if (data != NULL && dataLen > 0) {
+    newNode->data = cds_alloc(alloc, dataLen);
+    if (newNode->data == NULL) {
+      cds_free(alloc, newNode);
+      return NULL;
+    }
+    memmove(newNode->data, data, dataLen);
+  } else {
+    newNode->data = NULL;
+  }
   newNode->next = next;
   return newNode;
 }
@@ -61,20 +120,33 @@ static inline Node *sl_create_node_cp(void *data, size_t dataLen, Node *next) {
  * @param data Pointer to the data to copy.
  * @param dataLen Size of the data.
  * @param next Pointer to the next node.
- * @return Pointer to the new node.
+ * @return Pointer to the new node, or NULL if out of memory.
  */
 static inline Node *sl_create_node_deep_cp(void *data, size_t dataLen,
                                            Node *next) {
-  Node *newNode = (Node *)malloc(sizeof(Node));
-  newNode->dataLen = dataLen;
-  if (data != NULL && dataLen > 0) {
-    newNode->data = malloc(dataLen);
-    memmove(newNode->data, data, dataLen);
-  } else {
-    newNode->data = NULL;
-  }
-  newNode->next = next;
-  return newNode;
+  return sl_create_node_deep_cp_a(data, dataLen, next, cds_default_allocator());
+}
+
+/**
+ * @brief Releases a single node and its data through an allocator.
+ * @param node Node to release (may be NULL).
+ * @param alloc Allocator the node and its data were allocated with.
+ * @note The node must already be unlinked from its list.
+ */
+static inline void sl_destroy_node_a(Node *node, const CDSAllocator *alloc) {
+  if (node == NULL)
+    return;
+  cds_free(alloc, node->data);
+  cds_free(alloc, node);
+}
+
+// walks to the last link and stores node there; the push_back functions
+// share it so that each records a single latency sample
+static inline void sl_link_back(Node **rootPtrPtr, Node *node) {
+  Node **link = rootPtrPtr;
+  while (*link != NULL)
+    link = &(*link)->next;
+  *link = node;
 }
 
 /**
@@ -83,17 +155,22 @@ static inline Node *sl_create_node_deep_cp(void *data, size_t dataLen,
  * @param nodePtrPtr Pointer to node pointer (ownership transferred).
  */
 static inline void sl_push_back_mv_node(Node **rootPtrPtr, Node **nodePtrPtr) {
-  if (*rootPtrPtr == NULL) {
-    *rootPtrPtr = *nodePtrPtr;
-    *nodePtrPtr = NULL;
-    return;
-  } else {
-    Node *current = *rootPtrPtr;
-    while (current->next != NULL)
-      current = current->next;
-    current->next = *nodePtrPtr;
-    *nodePtrPtr = NULL;
-  }
+  CDS_PROF_BEGIN();
+  sl_link_back(rootPtrPtr, *nodePtrPtr);
+  *nodePtrPtr = NULL;
+  CDS_PROF_END(LAT_SL_PUSH_BACK);
+}
+
+/**
+ * @brief Allocator-aware variant of sl_push_back_mv_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void sl_push_back_mv_data_a(Node **rootPtrPtr, void **data,
+                                          size_t dataLen,
+                                          const CDSAllocator *alloc) {
+  CDS_PROF_BEGIN();
+  sl_link_back(rootPtrPtr, sl_create_node_mv_a(data, dataLen, NULL, alloc));
+  CDS_PROF_END(LAT_SL_PUSH_BACK);
 }
 
 /**
@@ -104,11 +181,7 @@ static inline void sl_push_back_mv_node(Node **rootPtrPtr, Node **nodePtrPtr) {
  */
 static inline void sl_push_back_mv_data(Node **rootPtrPtr, void **data,
                                         size_t dataLen) {
-  Node *nNode = (Node *)malloc(sizeof(Node));
-  nNode->dataLen = dataLen;
-  nNode->data = move(data);
-  nNode->next = NULL;
-  sl_push_back_mv_node(rootPtrPtr, &nNode);
+  sl_push_back_mv_data_a(rootPtrPtr, data, dataLen, cds_default_allocator());
 }
 
 /**
@@ -117,15 +190,21 @@ static inline void sl_push_back_mv_data(Node **rootPtrPtr, void **data,
  * @param nodePtr Node to append.
  */
 static inline void sl_push_back_cp_node(Node **rootPtrPtr, Node *nodePtr) {
-  if (*rootPtrPtr == NULL) {
-    *rootPtrPtr = nodePtr;
-    return;
-  } else {
-    Node *current = *rootPtrPtr;
-    while (current->next != NULL)
-      current = current->next;
-    current->next = nodePtr;
-  }
+  CDS_PROF_BEGIN();
+  sl_link_back(rootPtrPtr, nodePtr);
+  CDS_PROF_END(LAT_SL_PUSH_BACK);
+}
+
+/**
+ * @brief Allocator-aware variant of sl_push_back_cp_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void sl_push_back_cp_data_a(Node **rootPtrPtr, void *data,
+                                          size_t dataLen,
+                                          const CDSAllocator *alloc) {
+  CDS_PROF_BEGIN();
+  sl_link_back(rootPtrPtr, sl_create_node_cp_a(data, dataLen, NULL, alloc));
+  CDS_PROF_END(LAT_SL_PUSH_BACK);
 }
 
 /**
@@ -136,11 +215,24 @@ static inline void sl_push_back_cp_node(Node **rootPtrPtr, Node *nodePtr) {
  */
 static inline void sl_push_back_cp_data(Node **rootPtrPtr, void *data,
                                         size_t dataLen) {
-  Node *nNode = (Node *)malloc(sizeof(Node));
+  sl_push_back_cp_data_a(rootPtrPtr, data, dataLen, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_push_back_cp_data_deep().
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline void sl_push_back_cp_data_deep_a(Node **rootPtrPtr, void *data,
+                                               size_t dataLen,
+                                               const CDSAllocator *alloc) {
+  CDS_PROF_BEGIN();
+  Node *nNode = (Node *)cds_alloc(alloc, sizeof(Node));
   nNode->dataLen = dataLen;
-  nNode->data = data;
+  nNode->data = cds_alloc(alloc, dataLen);
+  memmove(nNode->data, data, dataLen);
   nNode->next = NULL;
-  sl_push_back_cp_node(rootPtrPtr, nNode);
+  sl_link_back(rootPtrPtr, nNode);
+  CDS_PROF_END(LAT_SL_PUSH_BACK);
 }
 
 /**
@@ -151,12 +243,8 @@ static inline void sl_push_back_cp_data(Node **rootPtrPtr, void *data,
  */
 static inline void sl_push_back_cp_data_deep(Node **rootPtrPtr, void *data,
                                         size_t dataLen) {
-  Node *nNode = (Node *)malloc(sizeof(Node));
-  nNode->dataLen = dataLen;
-  nNode->data = malloc(dataLen);
-  memmove(nNode->data, data, dataLen);
-  nNode->next = NULL;
-  sl_push_back_cp_node(rootPtrPtr, nNode);
+  sl_push_back_cp_data_deep_a(rootPtrPtr, data, dataLen,
+                              cds_default_allocator());
 }
 
 /**
@@ -173,16 +261,23 @@ static inline void sl_push_front_mv_node(Node **rootPtrPtr, Node **nodePtrPtr) {
   *rootPtrPtr = (Node *)move((void **)nodePtrPtr);
 }
 
+/**
+ * @brief Allocator-aware variant of sl_push_front_mv_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void sl_push_front_mv_data_a(Node **rootPtrPtr, void **data,
+                                           size_t dataLen,
+                                           const CDSAllocator *alloc) {
+  Node *nNode = sl_create_node_mv_a(data, dataLen, NULL, alloc);
+  sl_push_front_mv_node(rootPtrPtr, &nNode);
+}
+
 /**
  * @brief Prepends data to the start of the list using move semantics.
  */
 static inline void sl_push_front_mv_data(Node **rootPtrPtr, void **data,
                                          size_t dataLen) {
-  Node *nNode = (Node *)malloc(sizeof(Node));
-  nNode->data = move(data);
-  nNode->dataLen = dataLen;
-  nNode->next = NULL;
-  sl_push_front_mv_node(rootPtrPtr, &nNode);
+  sl_push_front_mv_data_a(rootPtrPtr, data, dataLen, cds_default_allocator());
 }
 
 /**
@@ -197,14 +292,37 @@ static inline void sl_push_front_cp_node(Node **rootPtrPtr, Node *nodePtr) {
   *rootPtrPtr = nodePtr;
 }
 
+/**
+ * @brief Allocator-aware variant of sl_push_front_cp_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void sl_push_front_cp_data_a(Node **rootPtrPtr, void *data,
+                                           size_t dataLen,
+                                           const CDSAllocator *alloc) {
+  sl_push_front_cp_node(rootPtrPtr,
+                        sl_create_node_cp_a(data, dataLen, NULL, alloc));
+}
+
 /**
  * @brief Prepends data to the start of the list using deep copy.
  */
 static inline void sl_push_front_cp_data(Node **rootPtrPtr, void *data,
                                          size_t dataLen) {
-  Node *nNode = (Node *)malloc(sizeof(Node));
-  nNode->data = data;
+  sl_push_front_cp_data_a(rootPtrPtr, data, dataLen, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_push_front_cp_data_deep().
+ * @param alloc Allocator used for the node and the copied data.
+ */
+static inline void sl_push_front_cp_data_deep_a(Node **rootPtrPtr, void *data,
+                                                size_t dataLen,
+                                                const CDSAllocator *alloc) {
+  Node *nNode = (Node *)cds_alloc(alloc, sizeof(Node));
+  nNode->data = cds_alloc(alloc, dataLen);
+  memmove(nNode->data, data, dataLen);
   nNode->dataLen = dataLen;
+  nNode->next = NULL;
   sl_push_front_cp_node(rootPtrPtr, nNode);
 }
 
@@ -213,11 +331,71 @@ static inline void sl_push_front_cp_data(Node **rootPtrPtr, void *data,
  */
 static inline void sl_push_front_cp_data_deep(Node **rootPtrPtr, void *data,
                                          size_t dataLen) {
-  Node *nNode = (Node *)malloc(sizeof(Node));
-  nNode->data = malloc(dataLen);
-  memmove(nNode->data, data, dataLen);
-  nNode->dataLen = dataLen;
-  sl_push_front_cp_node(rootPtrPtr, nNode);
+  sl_push_front_cp_data_deep_a(rootPtrPtr, data, dataLen,
+                               cds_default_allocator());
+}
+
+/**
+ * @brief Looks up the node at the specified index without printing.
+ * @param rootPtr Root node pointer (may be NULL for an empty list).
+ * @param idx Index to retrieve.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus sl_try_get_by_index(Node *rootPtr, int idx,
+                                            Node **out) {
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  if (idx < 0)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  Node *c = rootPtr;
+  for (int i = 0; c != NULL && i < idx; i++)
+    c = c->next;
+  if (c == NULL)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  *out = c;
+  return CDS_OK;
+}
+
+/**
+ * @brief Looks up the data at the specified index without printing.
+ * @param rootPtr Root node pointer (may be NULL for an empty list).
+ * @param idx Index to retrieve.
+ * @param out Receives the data pointer, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus sl_try_get_at_index(Node *rootPtr, int idx,
+                                            void **out) {
+  Node *n;
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  CDSStatus status = sl_try_get_by_index(rootPtr, idx, &n);
+  *out = n ? n->data : NULL;
+  return status;
+}
+
+/**
+ * @brief Looks up the first node containing a value without printing.
+ * @param rootPtr Root node pointer (may be NULL for an empty list).
+ * @param _val Pointer to the value to search for.
+ * @param valueLen Size of the value in bytes.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NOT_FOUND.
+ */
+static inline CDSStatus sl_try_get_by_value(Node *rootPtr, void *_val,
+                                            size_t valueLen, Node **out) {
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  CDS_PROF_BEGIN();
+  Node *c = rootPtr;
+  while (c != NULL &&
+         !(valueLen == c->dataLen && memcmp(_val, c->data, c->dataLen) == 0))
+    c = c->next;
+  *out = c;
+  CDS_PROF_END(LAT_SL_GET_BY_VALUE);
+  return c ? CDS_OK : CDS_ERR_NOT_FOUND;
 }
 
 /**
@@ -225,19 +403,15 @@ static inline void sl_push_front_cp_data_deep(Node **rootPtrPtr, void *data,
  * @param rootPtr Root node pointer.
  * @param idx Index to retrieve.
  * @return Pointer to data or NULL if out of bounds.
+ * @note Failures go through CDS_DIAGNOSTIC; use sl_try_get_at_index() on hot
+ * paths.
  */
 static inline void *sl_get_at_index(Node *rootPtr, int idx) {
-  Node *c = rootPtr;
-  int i = 0;
-  while (c->next != NULL && i < idx) {
-    c = c->next;
-    i++;
-  }
-  if (i < idx) {
-    fprintf(stderr, "Error: Index out of bounds.\n");
-    return NULL;
-  }
-  return c->data;
+  void *data;
+  CDSStatus status = sl_try_get_at_index(rootPtr, idx, &data);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Index out of bounds.\n");
+  return data;
 }
 
 /**
@@ -246,46 +420,42 @@ static inline void *sl_get_at_index(Node *rootPtr, int idx) {
  * @param _val Pointer to the value to search for.
  * @param valueLen Size of the data as bytes in size_t (long long)
  * @return Pointer to node or NULL if value not found.
+ * @note Failures go through CDS_DIAGNOSTIC; use sl_try_get_by_value() on hot
+ * paths.
  */
 static inline Node *sl_get_by_value(Node *rootPtr, void *_val, size_t valueLen) {
-  Node *c = rootPtr;
-  while (c != NULL) {
-    if (valueLen == c->dataLen && memcmp(_val, c->data, c->dataLen) == 0)
-      return c;
-    c = c->next;
-  }
-  fprintf(stderr, "Error: Value does not exist in Linked List.\n");
-  return NULL;
+  Node *n;
+  CDSStatus status = sl_try_get_by_value(rootPtr, _val, valueLen, &n);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Value does not exist in Linked List.\n");
+  return n;
 }
 
 /**
  * @brief Returns the node at the specified index.
+ * @note Failures go through CDS_DIAGNOSTIC; use sl_try_get_by_index() on hot
+ * paths.
  */
 static inline Node *sl_get_by_index(Node *rootPtr, int idx) {
-  Node *c = rootPtr;
-  int i = 0;
-  while (c != NULL && i < idx) {
-    c = c->next;
-    i++;
-  }
-  if (i < idx) {
-    fprintf(stderr, "Error: Index out of bounds.\n");
-    return NULL;
-  }
-  return c;
+  Node *n;
+  CDSStatus status = sl_try_get_by_index(rootPtr, idx, &n);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Index out of bounds.\n");
+  return n;
 }
 
 /**
- * @brief Deletes the node at the specified index.
+ * @brief Allocator-aware variant of sl_delete_at_index().
+ * @param alloc Allocator the list was built with.
  */
-static inline void sl_delete_at_index(Node **rootPtrPtr, int idx) {
+static inline void sl_delete_at_index_a(Node **rootPtrPtr, int idx,
+                                        const CDSAllocator *alloc) {
   if (*rootPtrPtr == NULL || idx < 0)
     return;
   Node *temp = *rootPtrPtr;
   if (idx == 0) {
     *rootPtrPtr = temp->next;
-    free(temp->data);
-    free(temp);
+    sl_destroy_node_a(temp, alloc);
     return;
   }
   for (int i = 0; temp != NULL && i < idx - 1; i++)
@@ -294,23 +464,30 @@ static inline void sl_delete_at_index(Node **rootPtrPtr, int idx) {
     return;
   Node *nodeToDelete = temp->next;
   temp->next = nodeToDelete->next;
-  free(nodeToDelete->data);
-  free(nodeToDelete);
+  sl_destroy_node_a(nodeToDelete, alloc);
 }
 
 /**
- * @brief Deletes the first node containing the specified value.
+ * @brief Deletes the node at the specified index.
  */
-static inline void sl_delete_by_value(Node **rootPtrPtr, void *val,
-                                      size_t dataLen) {
+static inline void sl_delete_at_index(Node **rootPtrPtr, int idx) {
+  sl_delete_at_index_a(rootPtrPtr, idx, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_delete_by_value().
+ * @param alloc Allocator the list was built with.
+ */
+static inline void sl_delete_by_value_a(Node **rootPtrPtr, void *val,
+                                        size_t dataLen,
+                                        const CDSAllocator *alloc) {
   if (*rootPtrPtr == NULL || val == NULL || dataLen == 0)
     return;
   Node *c = *rootPtrPtr;
 
   if (c->dataLen == dataLen && memcmp(c->data, val, dataLen) == 0) {
     *rootPtrPtr = c->next;
-    free(c->data);
-    free(c);
+    sl_destroy_node_a(c, alloc);
     return;
   }
 
@@ -319,8 +496,7 @@ static inline void sl_delete_by_value(Node **rootPtrPtr, void *val,
         memcmp(c->next->data, val, dataLen) == 0) {
       Node *nodeToDelete = c->next;
       c->next = nodeToDelete->next;
-      free(nodeToDelete->data);
-      free(nodeToDelete);
+      sl_destroy_node_a(nodeToDelete, alloc);
       return;
     }
     c = c->next;
@@ -328,14 +504,21 @@ static inline void sl_delete_by_value(Node **rootPtrPtr, void *val,
 }
 
 /**
- * @brief Inserts a node at a specific index using move semantics.
- * @param rootPtrPtr Pointer to the root node pointer.
- * @param toBeInsertedPtrPtr Pointer to node pointer (ownership transferred).
- * @param idx Index to insert at.
+ * @brief Deletes the first node containing the specified value.
  */
-static inline void sl_insert_at_index_mv_node(Node **rootPtrPtr,
-                                              Node **toBeInsertedPtrPtr,
-                                              int idx) {
+static inline void sl_delete_by_value(Node **rootPtrPtr, void *val,
+                                      size_t dataLen) {
+  sl_delete_by_value_a(rootPtrPtr, val, dataLen, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_insert_at_index_mv_node().
+ * @param alloc Allocator used to release the node if idx is out of bounds.
+ */
+static inline void sl_insert_at_index_mv_node_a(Node **rootPtrPtr,
+                                                Node **toBeInsertedPtrPtr,
+                                                int idx,
+                                                const CDSAllocator *alloc) {
   if (!rootPtrPtr || !toBeInsertedPtrPtr || !*toBeInsertedPtrPtr || idx < 0)
     return;
 
@@ -355,14 +538,26 @@ static inline void sl_insert_at_index_mv_node(Node **rootPtrPtr,
   }
   if (!current) {
     // index out of bounds
-    free(newNode->data);
-    free(newNode);
+    sl_destroy_node_a(newNode, alloc);
     return;
   }
   newNode->next = current->next;
   current->next = newNode;
 }
 
+/**
+ * @brief Inserts a node at a specific index using move semantics.
+ * @param rootPtrPtr Pointer to the root node pointer.
+ * @param toBeInsertedPtrPtr Pointer to node pointer (ownership transferred).
+ * @param idx Index to insert at.
+ */
+static inline void sl_insert_at_index_mv_node(Node **rootPtrPtr,
+                                              Node **toBeInsertedPtrPtr,
+                                              int idx) {
+  sl_insert_at_index_mv_node_a(rootPtrPtr, toBeInsertedPtrPtr, idx,
+                               cds_default_allocator());
+}
+
 /**
  * @brief Inserts a node at a specific index using shallow copy.
  */
@@ -391,15 +586,17 @@ static inline void sl_insert_at_index_cp_node(Node **rootPtrPtr,
 }
 
 /**
- * @brief Inserts a node at a specific index using deep copy.
+ * @brief Allocator-aware variant of sl_insert_at_index_deep_cp_node().
+ * @param alloc Allocator used for the new node and the copied data.
  */
-static inline void sl_insert_at_index_deep_cp_node(Node **rootPtrPtr,
-                                                   Node *toBeCopied, int idx) {
+static inline void sl_insert_at_index_deep_cp_node_a(Node **rootPtrPtr,
+                                                     Node *toBeCopied, int idx,
+                                                     const CDSAllocator *alloc) {
   if (!rootPtrPtr || !toBeCopied || idx < 0)
     return;
 
-  Node *newNode =
-      sl_create_node_deep_cp(toBeCopied->data, toBeCopied->dataLen, NULL);
+  Node *newNode = sl_create_node_deep_cp_a(toBeCopied->data,
+                                           toBeCopied->dataLen, NULL, alloc);
 
   if (idx == 0) {
     newNode->next = *rootPtrPtr;
@@ -414,8 +611,7 @@ static inline void sl_insert_at_index_deep_cp_node(Node **rootPtrPtr,
     i++;
   }
   if (!current) {
-    free(newNode->data);
-    free(newNode);
+    sl_destroy_node_a(newNode, alloc);
     return;
   }
 
@@ -423,13 +619,44 @@ static inline void sl_insert_at_index_deep_cp_node(Node **rootPtrPtr,
   current->next = newNode;
 }
 
+/**
+ * @brief Inserts a node at a specific index using deep copy.
+ */
+static inline void sl_insert_at_index_deep_cp_node(Node **rootPtrPtr,
+                                                   Node *toBeCopied, int idx) {
+  sl_insert_at_index_deep_cp_node_a(rootPtrPtr, toBeCopied, idx,
+                                    cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_insert_at_index_mv_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void sl_insert_at_index_mv_data_a(Node **rootPtrPtr, void **data,
+                                                size_t dataLen, int idx,
+                                                const CDSAllocator *alloc) {
+  Node *node = sl_create_node_mv_a(data, dataLen, NULL, alloc);
+  sl_insert_at_index_mv_node_a(rootPtrPtr, &node, idx, alloc);
+}
+
 /**
  * @brief Inserts data at a specific index using move semantics.
  */
 static inline void sl_insert_at_index_mv_data(Node **rootPtrPtr, void **data,
                                               size_t dataLen, int idx) {
-  Node *node = sl_create_node_mv(data, dataLen, NULL);
-  sl_insert_at_index_mv_node(rootPtrPtr, &node, idx);
+  sl_insert_at_index_mv_data_a(rootPtrPtr, data, dataLen, idx,
+                               cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_insert_at_index_cp_data().
+ * @param alloc Allocator used for the node.
+ */
+static inline void sl_insert_at_index_cp_data_a(Node **rootPtrPtr, void *data,
+                                                size_t dataLen, int idx,
+                                                const CDSAllocator *alloc) {
+  Node *node = sl_create_node_cp_a(data, dataLen, NULL, alloc);
+  sl_insert_at_index_cp_node(rootPtrPtr, node, idx);
 }
 
 /**
@@ -437,8 +664,20 @@ static inline void sl_insert_at_index_mv_data(Node **rootPtrPtr, void **data,
  */
 static inline void sl_insert_at_index_cp_data(Node **rootPtrPtr, void *data,
                                               size_t dataLen, int idx) {
-  Node *node = sl_create_node_cp(data, dataLen, NULL);
-  sl_insert_at_index_cp_node(rootPtrPtr, node, idx);
+  sl_insert_at_index_cp_data_a(rootPtrPtr, data, dataLen, idx,
+                               cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_insert_at_index_deep_cp_data().
+ * @param alloc Allocator used for the nodes and the copied data.
+ */
+static inline void sl_insert_at_index_deep_cp_data_a(Node **rootPtrPtr,
+                                                     void *data, size_t dataLen,
+                                                     int idx,
+                                                     const CDSAllocator *alloc) {
+  Node *node = sl_create_node_deep_cp_a(data, dataLen, NULL, alloc);
+  sl_insert_at_index_mv_node_a(rootPtrPtr, &node, idx, alloc);
 }
 
 /**
@@ -447,8 +686,24 @@ static inline void sl_insert_at_index_cp_data(Node **rootPtrPtr, void *data,
 static inline void sl_insert_at_index_deep_cp_data(Node **rootPtrPtr,
                                                    void *data, size_t dataLen,
                                                    int idx) {
-  Node *node = sl_create_node_deep_cp(data, dataLen, NULL);
-  sl_insert_at_index_deep_cp_node(rootPtrPtr, node, idx);
+  sl_insert_at_index_deep_cp_data_a(rootPtrPtr, data, dataLen, idx,
+                                    cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_free_list().
+ * @param alloc Allocator the list was built with.
+ */
+static inline void sl_free_list_a(Node **rootPtrPtr, const CDSAllocator *alloc) {
+  CDS_PROF_BEGIN();
+  Node *c = *rootPtrPtr;
+  while (c != NULL) {
+    Node *next = c->next;
+    sl_destroy_node_a(c, alloc);
+    c = next;
+  }
+  *rootPtrPtr = NULL;
+  CDS_PROF_END(LAT_SL_FREE_LIST);
 }
 
 /**
@@ -456,14 +711,553 @@ static inline void sl_insert_at_index_deep_cp_data(Node **rootPtrPtr,
  * @param rootPtrPtr Pointer to the root node pointer.
  */
 static inline void sl_free_list(Node **rootPtrPtr) {
+  sl_free_list_a(rootPtrPtr, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_remove_if().
+ * @param alloc Allocator the list was built with.
+ */
+static inline size_t sl_remove_if_a(Node **rootPtrPtr, CDSPredicateFn pred,
+                                    void *ctx, CDSReleaseFn release,
+                                    void *releaseCtx, Node **removed,
+                                    const CDSAllocator *alloc) {
+  size_t count = 0;
+  Node **link = rootPtrPtr;
+  Node **removedLink = removed;
+  while (*link != NULL) {
+    Node *c = *link;
+    if (!pred(c->data, c->dataLen, ctx)) {
+      link = &c->next;
+      continue;
+    }
+    *link = c->next;
+    count++;
+    if (removedLink) {
+      *removedLink = c;
+      removedLink = &c->next;
+      continue;
+    }
+    if (release)
+      release(c->data, c->dataLen, releaseCtx);
+    else
+      cds_free(alloc, c->data);
+    cds_free(alloc, c);
+  }
+  if (removedLink)
+    *removedLink = NULL;
+  return count;
+}
+
+/**
+ * @brief Removes every node whose data matches a predicate, in one pass.
+ * @param rootPtrPtr Pointer to the root node pointer.
+ * @param pred Predicate; nodes for which it returns true are removed.
+ * @param ctx Context passed to pred.
+ * @param release Called with each removed payload; NULL frees it with the
+ * allocator, CDS_KEEP_DATA leaves it to the caller.
+ * @param releaseCtx Context passed to release.
+ * @param removed If not NULL, receives the removed nodes as a NULL-terminated
+ * chain in list order instead of freeing them (release is not called).
+ * @return Number of removed nodes.
+ */
+static inline size_t sl_remove_if(Node **rootPtrPtr, CDSPredicateFn pred,
+                                  void *ctx, CDSReleaseFn release,
+                                  void *releaseCtx, Node **removed) {
+  return sl_remove_if_a(rootPtrPtr, pred, ctx, release, releaseCtx, removed,
+                        cds_default_allocator());
+}
+
+/**
+ * @brief Stable n-way partition that relinks the existing nodes.
+ *
+ * Moves every node of the list into outs[classify(...)] in one pass, keeping
+ * their relative order. Nothing is allocated or copied.
+ * @param rootPtrPtr Pointer to the root node pointer; set to NULL.
+ * @param classify Returns the output index of a payload; indices >= nOuts go
+ * to the last output.
+ * @param ctx Context passed to classify.
+ * @param outs Array of nOuts root pointers, overwritten with the resulting
+ * NULL-terminated lists.
+ * @param nOuts Number of outputs (> 0).
+ */
+static inline void sl_partition_n(Node **rootPtrPtr, CDSClassifyFn classify,
+                                  void *ctx, Node **outs, size_t nOuts) {
   Node *c = *rootPtrPtr;
+  for (size_t i = 0; i < nOuts; i++)
+    outs[i] = NULL;
+  // during the pass outs[i] is the tail of a ring whose next is the head
   while (c != NULL) {
     Node *next = c->next;
-    free(c->data);
-    free(c);
+    size_t k = classify(c->data, c->dataLen, ctx);
+    if (k >= nOuts)
+      k = nOuts - 1;
+    if (outs[k]) {
+      c->next = outs[k]->next;
+      outs[k]->next = c;
+    } else {
+      c->next = c;
+    }
+    outs[k] = c;
     c = next;
   }
+  for (size_t i = 0; i < nOuts; i++) {
+    if (outs[i]) {
+      Node *head = outs[i]->next;
+      outs[i]->next = NULL;
+      outs[i] = head;
+    }
+  }
   *rootPtrPtr = NULL;
 }
 
+/**
+ * @brief Stable partition into matching and non-matching lists (zero-copy).
+ * @param rootPtrPtr Pointer to the root node pointer; set to NULL.
+ * @param matching Receives the nodes for which pred returns true.
+ * @param rest Receives the other nodes.
+ */
+static inline void sl_partition(Node **rootPtrPtr, CDSPredicateFn pred,
+                                void *ctx, Node **matching, Node **rest) {
+  CDSPredicateBinder b = {pred, ctx};
+  Node *outs[2];
+  sl_partition_n(rootPtrPtr, cds_predicate_to_index, &b, outs, 2);
+  *matching = outs[0];
+  *rest = outs[1];
+}
+
+/**
+ * @brief Keeps only the nodes matching pred, relinking the others.
+ * @param rootPtrPtr Pointer to the root node pointer; keeps the matches.
+ * @param rejected Receives the other nodes in their original order.
+ */
+static inline void sl_filter(Node **rootPtrPtr, CDSPredicateFn pred, void *ctx,
+                             Node **rejected) {
+  Node *matching;
+  sl_partition(rootPtrPtr, pred, ctx, &matching, rejected);
+  *rootPtrPtr = matching;
+}
+
+/**
+ * @brief Counts the nodes of a list.
+ * @param root Root node of the list (may be NULL).
+ * @return Number of nodes.
+ */
+static inline size_t sl_count(const Node *root) {
+  size_t n = 0;
+  for (; root != NULL; root = root->next)
+    n++;
+  return n;
+}
+
+/**
+ * @brief Copies the payloads into a fixed-stride array in one pass.
+ *
+ * Each payload fills one stride-byte slot; shorter payloads are zero-padded
+ * and longer ones truncated. Size dst from a count you already keep, or
+ * from sl_count().
+ * @param root Root node of the list.
+ * @param dst Destination of at least maxCount * stride bytes.
+ * @param stride Slot size in bytes.
+ * @param maxCount Number of slots in dst.
+ * @return Number of slots written.
+ */
+static inline size_t sl_to_array(const Node *root, void *dst, size_t stride,
+                                 size_t maxCount) {
+  size_t n = 0;
+  for (; root != NULL && n < maxCount; root = root->next, n++)
+    cds_stride_put((unsigned char *)dst + n * stride, stride, root->data,
+                   root->dataLen);
+  return n;
+}
+
+/**
+ * @brief Serializes the payloads in the length-prefixed packed format.
+ * @param root Root node of the list.
+ * @param dst Destination buffer, or NULL to only compute the size.
+ * @param dstSize Size of dst; the records from the first one that does not
+ * fit on are left out.
+ * @return Bytes needed for the whole list (see cds_packed_record_size()).
+ */
+static inline size_t sl_to_packed(const Node *root, void *dst,
+                                  size_t dstSize) {
+  size_t offset = 0;
+  for (; root != NULL; root = root->next)
+    cds_packed_put(dst, dstSize, &offset, root->data, root->dataLen);
+  return offset;
+}
+
+/**
+ * @brief Collects the payload pointers without copying the payloads.
+ * @param root Root node of the list.
+ * @param data Receives up to maxCount payload pointers.
+ * @param lens Receives the payload lengths (may be NULL).
+ * @param maxCount Number of entries in data (and lens).
+ * @return Number of entries written.
+ */
+static inline size_t sl_to_ptr_array(const Node *root, void **data,
+                                     size_t *lens, size_t maxCount) {
+  size_t n = 0;
+  for (; root != NULL && n < maxCount; root = root->next, n++) {
+    data[n] = root->data;
+    if (lens)
+      lens[n] = root->dataLen;
+  }
+  return n;
+}
+
+/**
+ * @brief Allocator-aware variant of sl_to_array_alloc().
+ * @param alloc Allocator used for the array.
+ */
+static inline void *sl_to_array_alloc_a(const Node *root, size_t stride,
+                                        size_t *count,
+                                        const CDSAllocator *alloc) {
+  size_t n = sl_count(root);
+  void *dst;
+  *count = 0;
+  if (n == 0 || stride == 0)
+    return NULL;
+  dst = cds_alloc(alloc, n * stride);
+  if (dst != NULL)
+    *count = sl_to_array(root, dst, stride, n);
+  return dst;
+}
+
+/**
+ * @brief Allocates a fixed-stride array holding the payloads.
+ *
+ * Walks the list twice: sl_count() sizes the array, then sl_to_array()
+ * fills it. Call sl_to_array() directly when the count is already known.
+ * @param root Root node of the list.
+ * @param stride Slot size in bytes (see sl_to_array()).
+ * @param count Receives the number of slots.
+ * @return The array (release it with free()), or NULL if the list is empty
+ * or out of memory.
+ */
+static inline void *sl_to_array_alloc(const Node *root, size_t stride,
+                                      size_t *count) {
+  return sl_to_array_alloc_a(root, stride, count, cds_default_allocator());
+}
+
+// appends a node with a copy of data at *link and moves link past it
+static inline bool sl_link_deep_cp_a(Node ***link, const void *data,
+                                     size_t dataLen,
+                                     const CDSAllocator *alloc) {
+  Node *n = (Node *)cds_alloc(alloc, sizeof(Node));
+  void *copy = cds_alloc(alloc, dataLen);
+  if (n == NULL || (copy == NULL && dataLen > 0)) {
+    cds_free(alloc, copy);
+    cds_free(alloc, n);
+    return false;
+  }
+  if (dataLen > 0)
+    memcpy(copy, data, dataLen);
+  n->data = copy;
+  n->dataLen = dataLen;
+  n->next = NULL;
+  **link = n;
+  *link = &n->next;
+  return true;
+}
+
+static inline Node **sl_tail_link(Node **rootPtrPtr) {
+  Node **link = rootPtrPtr;
+  while (*link != NULL)
+    link = &(*link)->next;
+  return link;
+}
+
+/**
+ * @brief Allocator-aware variant of sl_from_array().
+ * @param alloc Allocator used for the nodes and the copies.
+ */
+static inline CDSStatus sl_from_array_a(Node **rootPtrPtr, const void *src,
+                                        size_t stride, size_t count,
+                                        const CDSAllocator *alloc) {
+  Node **link = sl_tail_link(rootPtrPtr);
+  for (size_t i = 0; i < count; i++)
+    if (!sl_link_deep_cp_a(&link, (const unsigned char *)src + i * stride,
+                           stride, alloc))
+      return CDS_ERR_NO_MEMORY;
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends count stride-byte records, each deep-copied into a node.
+ *
+ * The end of the list is found once and every node is linked in O(1).
+ * @param rootPtrPtr Pointer to the root node pointer.
+ * @param src Array of count * stride bytes.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the records appended so far
+ * kept.
+ */
+static inline CDSStatus sl_from_array(Node **rootPtrPtr, const void *src,
+                                      size_t stride, size_t count) {
+  return sl_from_array_a(rootPtrPtr, src, stride, count,
+                         cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_from_packed().
+ * @param alloc Allocator used for the nodes and the copies.
+ */
+static inline CDSStatus sl_from_packed_a(Node **rootPtrPtr, const void *src,
+                                         size_t srcSize,
+                                         const CDSAllocator *alloc) {
+  Node **link = sl_tail_link(rootPtrPtr);
+  size_t offset = 0;
+  const void *data;
+  size_t len;
+  while (cds_packed_get(src, srcSize, &offset, &data, &len))
+    if (!sl_link_deep_cp_a(&link, data, len, alloc))
+      return CDS_ERR_NO_MEMORY;
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends the records of a packed buffer (see sl_to_packed()).
+ * @param rootPtrPtr Pointer to the root node pointer.
+ * @param src Packed records; a truncated last record is ignored.
+ * @param srcSize Size of src in bytes.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the records appended so far
+ * kept.
+ */
+static inline CDSStatus sl_from_packed(Node **rootPtrPtr, const void *src,
+                                       size_t srcSize) {
+  return sl_from_packed_a(rootPtrPtr, src, srcSize, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of sl_from_ptr_array().
+ * @param alloc Allocator used for the nodes.
+ * @note The moved payloads must come from the same allocator.
+ */
+static inline CDSStatus sl_from_ptr_array_a(Node **rootPtrPtr, void **data,
+                                            const size_t *lens, size_t count,
+                                            const CDSAllocator *alloc) {
+  Node **link = sl_tail_link(rootPtrPtr);
+  for (size_t i = 0; i < count; i++) {
+    Node *n = (Node *)cds_alloc(alloc, sizeof(Node));
+    if (n == NULL)
+      return CDS_ERR_NO_MEMORY;
+    n->data = move(&data[i]);
+    n->dataLen = lens[i];
+    n->next = NULL;
+    *link = n;
+    link = &n->next;
+  }
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends payloads by moving the pointers of an array into new nodes.
+ * @param rootPtrPtr Pointer to the root node pointer.
+ * @param data Payload pointers (ownership transferred); each moved entry is
+ * set to NULL.
+ * @param lens Payload lengths.
+ * @param count Number of entries.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY; entries not moved stay with the
+ * caller.
+ */
+static inline CDSStatus sl_from_ptr_array(Node **rootPtrPtr, void **data,
+                                          const size_t *lens, size_t count) {
+  return sl_from_ptr_array_a(rootPtrPtr, data, lens, count,
+                             cds_default_allocator());
+}
+
+/**
+ * @struct SLCursor
+ * @brief Position in a singly linked list.
+ *
+ * The cursor keeps a pointer to the link that points at the current node,
+ * so erase and insert-before are O(1). Moving forward is O(1); seeking
+ * backwards restarts from the root.
+ */
+typedef struct SLCursor {
+    Node **rootPtrPtr;         /**< Root of the list */
+    Node **link;               /**< Link pointing at the current node */
+    size_t index;              /**< Index of the current node */
+    const CDSAllocator *alloc; /**< Allocator used by insert and erase */
+} SLCursor;
+
+/**
+ * @brief Allocator-aware variant of sl_cursor_init().
+ * @param alloc Allocator used by the cursor's insert and erase functions.
+ */
+static inline void sl_cursor_init_a(SLCursor *cur, Node **rootPtrPtr,
+                                    const CDSAllocator *alloc) {
+  cur->rootPtrPtr = rootPtrPtr;
+  cur->link = rootPtrPtr;
+  cur->index = 0;
+  cur->alloc = alloc;
+}
+
+/**
+ * @brief Places a cursor on the first node of a list.
+ * @param cur Cursor to initialize.
+ * @param rootPtrPtr Pointer to the root node pointer.
+ */
+static inline void sl_cursor_init(SLCursor *cur, Node **rootPtrPtr) {
+  sl_cursor_init_a(cur, rootPtrPtr, cds_default_allocator());
+}
+
+/**
+ * @brief Returns true if the cursor is on a node (not past the end).
+ */
+static inline bool sl_cursor_valid(const SLCursor *cur) {
+  return *cur->link != NULL;
+}
+
+/**
+ * @brief Returns the current node, or NULL past the end.
+ */
+static inline Node *sl_cursor_node(const SLCursor *cur) { return *cur->link; }
+
+/**
+ * @brief Returns the data of the current node, or NULL past the end.
+ */
+static inline void *sl_cursor_get(const SLCursor *cur) {
+  return *cur->link ? (*cur->link)->data : NULL;
+}
+
+/**
+ * @brief Returns the data of the node after the current one without moving.
+ */
+static inline void *sl_cursor_peek(const SLCursor *cur) {
+  Node *n = *cur->link;
+  return (n && n->next) ? n->next->data : NULL;
+}
+
+/**
+ * @brief Moves to the next node.
+ * @return true if the cursor moved, false if it was already past the end.
+ */
+static inline bool sl_cursor_next(SLCursor *cur) {
+  if (*cur->link == NULL)
+    return false;
+  cur->link = &(*cur->link)->next;
+  cur->index++;
+  return true;
+}
+
+/**
+ * @brief Moves the cursor to an absolute index.
+ *
+ * Forward seeks continue from the current position; backward seeks restart
+ * from the root.
+ * @return true if there is a node at idx.
+ */
+static inline bool sl_cursor_seek(SLCursor *cur, size_t idx) {
+  if (idx < cur->index) {
+    cur->link = cur->rootPtrPtr;
+    cur->index = 0;
+  }
+  while (cur->index < idx && sl_cursor_next(cur))
+    ;
+  return cur->index == idx && *cur->link != NULL;
+}
+
+/**
+ * @brief Deletes the current node and moves to the following one.
+ * @return true if a node was deleted.
+ */
+static inline bool sl_cursor_erase(SLCursor *cur) {
+  Node *victim = *cur->link;
+  if (victim == NULL)
+    return false;
+  *cur->link = victim->next;
+  sl_destroy_node_a(victim, cur->alloc);
+  return true;
+}
+
+/**
+ * @brief Links a node before the current one (or at the end when past it).
+ * @note The cursor stays on the same node; its index grows by one.
+ */
+static inline void sl_cursor_insert_before_node(SLCursor *cur, Node *node) {
+  node->next = *cur->link;
+  *cur->link = node;
+  cur->link = &node->next;
+  cur->index++;
+}
+
+/**
+ * @brief Links a node after the current one.
+ * @return false (and leaves the node alone) if the cursor is past the end.
+ */
+static inline bool sl_cursor_insert_after_node(SLCursor *cur, Node *node) {
+  Node *c = *cur->link;
+  if (c == NULL)
+    return false;
+  node->next = c->next;
+  c->next = node;
+  return true;
+}
+
+/**
+ * @brief Inserts data before the current node (move semantics).
+ */
+static inline void sl_cursor_insert_before_mv_data(SLCursor *cur, void **data,
+                                                   size_t dataLen) {
+  sl_cursor_insert_before_node(
+      cur, sl_create_node_mv_a(data, dataLen, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data before the current node (shallow copy).
+ */
+static inline void sl_cursor_insert_before_cp_data(SLCursor *cur, void *data,
+                                                   size_t dataLen) {
+  sl_cursor_insert_before_node(
+      cur, sl_create_node_cp_a(data, dataLen, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data before the current node (deep copy).
+ */
+static inline void sl_cursor_insert_before_deep_cp_data(SLCursor *cur,
+                                                        void *data,
+                                                        size_t dataLen) {
+  sl_cursor_insert_before_node(
+      cur, sl_create_node_deep_cp_a(data, dataLen, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data after the current node (move semantics).
+ * @return false if the cursor is past the end; the data stays with the caller.
+ */
+static inline bool sl_cursor_insert_after_mv_data(SLCursor *cur, void **data,
+                                                  size_t dataLen) {
+  if (*cur->link == NULL)
+    return false;
+  return sl_cursor_insert_after_node(
+      cur, sl_create_node_mv_a(data, dataLen, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data after the current node (shallow copy).
+ * @return false if the cursor is past the end.
+ */
+static inline bool sl_cursor_insert_after_cp_data(SLCursor *cur, void *data,
+                                                  size_t dataLen) {
+  if (*cur->link == NULL)
+    return false;
+  return sl_cursor_insert_after_node(
+      cur, sl_create_node_cp_a(data, dataLen, NULL, cur->alloc));
+}
+
+/**
+ * @brief Inserts data after the current node (deep copy).
+ * @return false if the cursor is past the end.
+ */
+static inline bool sl_cursor_insert_after_deep_cp_data(SLCursor *cur,
+                                                       void *data,
+                                                       size_t dataLen) {
+  if (*cur->link == NULL)
+    return false;
+  return sl_cursor_insert_after_node(
+      cur, sl_create_node_deep_cp_a(data, dataLen, NULL, cur->alloc));
+}
+
 #endif // LINKEDLIST_H
@@ -0,0 +1,1244 @@
+#ifndef LISTFILTER_H
+#define LISTFILTER_H
+
+#include "doublelinkedlist.h"
+#include "generics.h"
+#include "linkedlist.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file listfilter.h
+ * @brief Lists with an attached cuckoo filter for fast misses (`fsl_*`,
+ * `fdl_*`).
+ *
+ * A cuckoo filter (`cf_*`) stores a 16-bit fingerprint of every payload in
+ * one of two 4-slot buckets. Unlike a Bloom filter it supports deletion, so
+ * the filter can follow a list through inserts and deletes. Contains and
+ * get-by-value consult it first: when neither bucket holds the fingerprint
+ * the value is definitely absent and the list is not touched. Otherwise the
+ * list is scanned as usual, and a scan that finds nothing is counted as a
+ * false positive.
+ *
+ * FSList and FDList are handles around ordinary `Node` and `DLNode` lists
+ * that keep the filter, the size and the tail in step with the nodes (push
+ * at either end is O(1)). The nodes must only be changed through the
+ * handle; after changing them any other way (or handing them to sl_/dl_
+ * functions and back), call fsl_rebuild() / fdl_rebuild().
+ *
+ * The filter is rebuilt from the list, with room for twice the current
+ * size, when it degrades:
+ * - its load passes LF_MAX_LOAD,
+ * - an insert ran out of evictions (the fingerprint waits in a one-entry
+ *   stash), or was lost because the stash was taken; a filter that lost a
+ *   fingerprint answers "maybe" until the rebuild,
+ * - the observed false-positive rate over at least LF_MIN_SAMPLES absent
+ *   lookups exceeds the handle's maxFpr (LF_DEFAULT_MAX_FPR by default).
+ * Every rebuild picks a new hash seed, so values that collided before are
+ * unlikely to collide again.
+ *
+ * Repeated values do not pile up in their buckets: a fingerprint already
+ * stored twice in its bucket pair is counted in a small overflow table
+ * instead, and cf_remove() takes copies from that count before it touches
+ * the slots. A list full of duplicates therefore keeps a working filter.
+ *
+ * Lookups update the counters and may rebuild the filter, so the handles
+ * need exclusive access for reads as well as writes.
+ */
+
+/** @brief Fingerprint slots per bucket. */
+#define CF_BUCKET 4
+
+/** @brief Evictions tried before an insert falls back to the stash. */
+#ifndef CF_MAX_KICKS
+#define CF_MAX_KICKS 500
+#endif
+
+/** @brief Filter load (entries / slots) that triggers a rebuild. */
+#define LF_MAX_LOAD 0.95
+
+/** @brief Default false-positive rate above which the filter is rebuilt. */
+#define LF_DEFAULT_MAX_FPR 0.01
+
+/** @brief Absent lookups observed before the false-positive rate counts. */
+#define LF_MIN_SAMPLES 1024
+
+/** @brief Copies of one fingerprint kept in the slots of its bucket pair. */
+#define CF_MAX_COPIES 2
+
+/**
+ * @struct CFOverflow
+ * @brief Overflow count of a fingerprint repeated in its bucket pair.
+ */
+typedef struct CFOverflow {
+    size_t bucket;  /**< Lower bucket of the pair */
+    uint32_t extra; /**< Copies beyond CF_MAX_COPIES, 0 = free entry */
+    uint16_t fp;    /**< Fingerprint */
+} CFOverflow;
+
+/**
+ * @struct CuckooFilter
+ * @brief Cuckoo filter of 16-bit fingerprints in 4-slot buckets.
+ */
+typedef struct CuckooFilter {
+    uint16_t *slots;           /**< CF_BUCKET fingerprints per bucket, 0 = empty */
+    size_t bucketMask;         /**< Number of buckets - 1 (a power of two) */
+    size_t count;              /**< Fingerprints in slots, stash included */
+    uint64_t seed;             /**< Mixed into every hash */
+    uint64_t rng;              /**< Xorshift state for picking eviction victims */
+    size_t stashBucket;        /**< One of the stashed fingerprint's buckets */
+    uint16_t stashFp;          /**< Fingerprint that found no slot, 0 if none */
+    bool saturated;            /**< A fingerprint was lost; lookups answer maybe */
+    CFOverflow *overflow;      /**< Linear-probing table, NULL until needed */
+    size_t overflowMask;       /**< Table size - 1 */
+    size_t overflowUsed;       /**< Occupied table entries */
+    size_t overflowCopies;     /**< Copies counted in the table */
+    const CDSAllocator *alloc; /**< Allocator for the overflow table */
+} CuckooFilter;
+
+/**
+ * @brief Allocates a filter with at least `capacity` slots.
+ * @param seed Hash seed; filters with different seeds collide differently.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus cf_init(CuckooFilter *cf, size_t capacity,
+                                uint64_t seed, const CDSAllocator *alloc) {
+  size_t buckets = 1;
+  while (buckets * CF_BUCKET < capacity)
+    buckets <<= 1;
+  memset(cf, 0, sizeof(*cf));
+  cf->slots = (uint16_t *)cds_alloc(alloc, buckets * CF_BUCKET * sizeof(uint16_t));
+  if (cf->slots == NULL)
+    return CDS_ERR_NO_MEMORY;
+  memset(cf->slots, 0, buckets * CF_BUCKET * sizeof(uint16_t));
+  cf->bucketMask = buckets - 1;
+  cf->alloc = alloc;
+  cf->seed = seed;
+  cf->rng = seed * 0x9e3779b97f4a7c15ULL + 1;
+  return CDS_OK;
+}
+
+/**
+ * @brief Frees the fingerprint storage.
+ */
+static inline void cf_free(CuckooFilter *cf, const CDSAllocator *alloc) {
+  cds_free(alloc, cf->slots);
+  cds_free(alloc, cf->overflow);
+  cf->slots = NULL;
+  cf->overflow = NULL;
+  cf->count = cf->overflowUsed = cf->overflowCopies = 0;
+}
+
+/**
+ * @brief Removes every fingerprint, keeping the storage.
+ */
+static inline void cf_clear(CuckooFilter *cf) {
+  if (cf->slots)
+    memset(cf->slots, 0,
+           (cf->bucketMask + 1) * CF_BUCKET * sizeof(uint16_t));
+  if (cf->overflow)
+    memset(cf->overflow, 0, (cf->overflowMask + 1) * sizeof(CFOverflow));
+  cf->count = cf->overflowUsed = cf->overflowCopies = 0;
+  cf->stashFp = 0;
+  cf->saturated = false;
+}
+
+/**
+ * @brief Returns the number of fingerprint slots.
+ */
+static inline size_t cf_capacity(const CuckooFilter *cf) {
+  return cf->slots ? (cf->bucketMask + 1) * CF_BUCKET : 0;
+}
+
+/**
+ * @brief Returns the fraction of slots in use.
+ */
+static inline double cf_load(const CuckooFilter *cf) {
+  size_t cap = cf_capacity(cf);
+  return cap ? (double)cf->count / (double)cap : 0.0;
+}
+
+/**
+ * @brief False-positive rate expected at the current load.
+ *
+ * A lookup compares against at most 2 * CF_BUCKET fingerprints, each a
+ * false match with probability 2^-16.
+ */
+static inline double cf_expected_fpr(const CuckooFilter *cf) {
+  if (cf->saturated)
+    return 1.0;
+  return cf_load(cf) * 2.0 * CF_BUCKET / 65536.0;
+}
+
+static inline uint64_t cf_mix(const CuckooFilter *cf, uint64_t hash) {
+  uint64_t h = (hash ^ cf->seed) * 0xbf58476d1ce4e5b9ULL;
+  return h ^ (h >> 31);
+}
+
+static inline uint16_t cf_fingerprint(uint64_t h) {
+  uint16_t fp = (uint16_t)(h >> 48);
+  return fp ? fp : 1;
+}
+
+/**
+ * @brief The other bucket of a fingerprint; applying it twice gives `i` back.
+ */
+static inline size_t cf_alt_bucket(const CuckooFilter *cf, size_t i,
+                                   uint16_t fp) {
+  return (i ^ (size_t)((uint32_t)fp * 0x5bd1e995u)) & cf->bucketMask;
+}
+
+static inline bool cf_bucket_put(uint16_t *b, uint16_t fp) {
+  for (int k = 0; k < CF_BUCKET; k++) {
+    if (b[k] == 0) {
+      b[k] = fp;
+      return true;
+    }
+  }
+  return false;
+}
+
+static inline bool cf_bucket_has(const uint16_t *b, uint16_t fp) {
+  for (int k = 0; k < CF_BUCKET; k++)
+    if (b[k] == fp)
+      return true;
+  return false;
+}
+
+static inline bool cf_bucket_drop(uint16_t *b, uint16_t fp) {
+  for (int k = 0; k < CF_BUCKET; k++) {
+    if (b[k] == fp) {
+      b[k] = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+static inline size_t cf_bucket_copies(const uint16_t *b, uint16_t fp) {
+  size_t n = 0;
+  for (int k = 0; k < CF_BUCKET; k++)
+    n += b[k] == fp;
+  return n;
+}
+
+// copies of fp held by the slots (and stash) of the pair i, j
+static inline size_t cf_pair_copies(const CuckooFilter *cf, size_t i,
+                                    size_t j, uint16_t fp) {
+  size_t n = cf_bucket_copies(cf->slots + i * CF_BUCKET, fp);
+  if (j != i)
+    n += cf_bucket_copies(cf->slots + j * CF_BUCKET, fp);
+  if (cf->stashFp == fp && (cf->stashBucket == i || cf->stashBucket == j))
+    n++;
+  return n;
+}
+
+static inline size_t cf_overflow_home(const CuckooFilter *cf, size_t bucket,
+                                      uint16_t fp) {
+  uint64_t k = ((uint64_t)bucket << 16 | fp) * 0x9e3779b97f4a7c15ULL;
+  return (size_t)(k >> 32) & cf->overflowMask;
+}
+
+static inline CFOverflow *cf_overflow_find(const CuckooFilter *cf,
+                                           size_t bucket, uint16_t fp) {
+  if (cf->overflow == NULL)
+    return NULL;
+  for (size_t p = cf_overflow_home(cf, bucket, fp);;
+       p = (p + 1) & cf->overflowMask) {
+    CFOverflow *e = cf->overflow + p;
+    if (e->extra == 0)
+      return NULL;
+    if (e->bucket == bucket && e->fp == fp)
+      return e;
+  }
+}
+
+static inline CFOverflow *cf_overflow_slot(CuckooFilter *cf, size_t bucket,
+                                           uint16_t fp) {
+  size_t p = cf_overflow_home(cf, bucket, fp);
+  while (cf->overflow[p].extra != 0)
+    p = (p + 1) & cf->overflowMask;
+  return cf->overflow + p;
+}
+
+static inline bool cf_overflow_grow(CuckooFilter *cf) {
+  CFOverflow *old = cf->overflow;
+  size_t oldSize = old ? cf->overflowMask + 1 : 0;
+  size_t size = oldSize ? oldSize * 2 : 16;
+  CFOverflow *table =
+      (CFOverflow *)cds_alloc(cf->alloc, size * sizeof(CFOverflow));
+  if (table == NULL)
+    return false;
+  memset(table, 0, size * sizeof(CFOverflow));
+  cf->overflow = table;
+  cf->overflowMask = size - 1;
+  for (size_t k = 0; k < oldSize; k++)
+    if (old[k].extra != 0)
+      *cf_overflow_slot(cf, old[k].bucket, old[k].fp) = old[k];
+  cds_free(cf->alloc, old);
+  return true;
+}
+
+// counts one more copy of fp outside the slots
+static inline bool cf_overflow_add(CuckooFilter *cf, size_t bucket,
+                                   uint16_t fp) {
+  CFOverflow *e = cf_overflow_find(cf, bucket, fp);
+  if (e == NULL) {
+    // keep the table at most half full
+    if ((cf->overflowUsed + 1) * 2 > (cf->overflow ? cf->overflowMask + 1 : 0) &&
+        !cf_overflow_grow(cf))
+      return false;
+    e = cf_overflow_slot(cf, bucket, fp);
+    e->bucket = bucket;
+    e->fp = fp;
+    cf->overflowUsed++;
+  } else if (e->extra == UINT32_MAX) {
+    return false;
+  }
+  e->extra++;
+  cf->overflowCopies++;
+  return true;
+}
+
+// takes one copy from an entry, closing the probe gap when it empties
+static inline void cf_overflow_take(CuckooFilter *cf, CFOverflow *e) {
+  cf->overflowCopies--;
+  if (--e->extra != 0)
+    return;
+  cf->overflowUsed--;
+  size_t hole = (size_t)(e - cf->overflow);
+  for (size_t p = (hole + 1) & cf->overflowMask; cf->overflow[p].extra != 0;
+       p = (p + 1) & cf->overflowMask) {
+    size_t home = cf_overflow_home(cf, cf->overflow[p].bucket,
+                                   cf->overflow[p].fp);
+    // move the entry back unless its home lies in (hole, p]
+    if (((p - home) & cf->overflowMask) >= ((p - hole) & cf->overflowMask)) {
+      cf->overflow[hole] = cf->overflow[p];
+      cf->overflow[p].extra = 0;
+      hole = p;
+    }
+  }
+}
+
+/**
+ * @brief Adds a hash to the filter.
+ *
+ * When both buckets are full, resident fingerprints are moved to their
+ * other bucket for up to CF_MAX_KICKS steps; the one left over goes to the
+ * stash. A fingerprint already stored CF_MAX_COPIES times in its bucket
+ * pair is only counted in the overflow table.
+ * @param hash Hash of the value (cds_hash_bytes()).
+ * @return false if the fingerprint was lost (stash taken, or no memory for
+ * the overflow table); the filter is then saturated.
+ */
+static inline bool cf_insert(CuckooFilter *cf, uint64_t hash) {
+  if (cf->slots == NULL || cf->saturated) {
+    cf->saturated = true;
+    return false;
+  }
+  uint64_t h = cf_mix(cf, hash);
+  uint16_t fp = cf_fingerprint(h);
+  size_t i = (size_t)h & cf->bucketMask;
+  size_t j = cf_alt_bucket(cf, i, fp);
+  if (cf_pair_copies(cf, i, j, fp) >= CF_MAX_COPIES) {
+    if (cf_overflow_add(cf, i < j ? i : j, fp))
+      return true;
+    cf->saturated = true;
+    return false;
+  }
+  if (cf_bucket_put(cf->slots + i * CF_BUCKET, fp) ||
+      cf_bucket_put(cf->slots + j * CF_BUCKET, fp)) {
+    cf->count++;
+    return true;
+  }
+  if (cf->stashFp != 0) {
+    cf->saturated = true;
+    return false;
+  }
+  size_t at = (cf->rng & 1) ? i : j;
+  for (int n = 0; n < CF_MAX_KICKS; n++) {
+    cf->rng ^= cf->rng << 13;
+    cf->rng ^= cf->rng >> 7;
+    cf->rng ^= cf->rng << 17;
+    uint16_t *slot = cf->slots + at * CF_BUCKET + (cf->rng >> 32) % CF_BUCKET;
+    uint16_t victim = *slot;
+    *slot = fp;
+    fp = victim;
+    at = cf_alt_bucket(cf, at, fp);
+    if (cf_bucket_put(cf->slots + at * CF_BUCKET, fp)) {
+      cf->count++;
+      return true;
+    }
+  }
+  cf->stashFp = fp;
+  cf->stashBucket = at;
+  cf->count++;
+  return true;
+}
+
+/**
+ * @brief Checks whether a hash may be in the filter.
+ * @return false only if the value was definitely never added (or removed).
+ */
+static inline bool cf_contains(const CuckooFilter *cf, uint64_t hash) {
+  if (cf->slots == NULL || cf->saturated)
+    return true;
+  uint64_t h = cf_mix(cf, hash);
+  uint16_t fp = cf_fingerprint(h);
+  size_t i = (size_t)h & cf->bucketMask;
+  size_t j = cf_alt_bucket(cf, i, fp);
+  if (cf_bucket_has(cf->slots + i * CF_BUCKET, fp) ||
+      cf_bucket_has(cf->slots + j * CF_BUCKET, fp))
+    return true;
+  return cf->stashFp == fp && (cf->stashBucket == i || cf->stashBucket == j);
+}
+
+/**
+ * @brief Removes one copy of a hash.
+ * @warning Only remove hashes that were added, or another value's
+ * fingerprint may be dropped.
+ * @return true if a fingerprint was removed.
+ */
+static inline bool cf_remove(CuckooFilter *cf, uint64_t hash) {
+  if (cf->slots == NULL)
+    return false;
+  uint64_t h = cf_mix(cf, hash);
+  uint16_t fp = cf_fingerprint(h);
+  size_t i = (size_t)h & cf->bucketMask;
+  size_t j = cf_alt_bucket(cf, i, fp);
+  CFOverflow *e = cf_overflow_find(cf, i < j ? i : j, fp);
+  if (e != NULL) {
+    cf_overflow_take(cf, e);
+    return true;
+  }
+  if (cf_bucket_drop(cf->slots + i * CF_BUCKET, fp) ||
+      cf_bucket_drop(cf->slots + j * CF_BUCKET, fp)) {
+    cf->count--;
+    return true;
+  }
+  if (cf->stashFp == fp && (cf->stashBucket == i || cf->stashBucket == j)) {
+    cf->stashFp = 0;
+    cf->count--;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @struct LFStats
+ * @brief Filter counters of an FSList or FDList.
+ */
+typedef struct LFStats {
+    uint64_t queries;        /**< Value lookups, deletes by value included */
+    uint64_t negatives;      /**< Lookups answered by the filter alone */
+    uint64_t falsePositives; /**< Lookups that passed the filter and missed */
+    uint64_t rebuilds;       /**< Filter rebuilds */
+    size_t entries;          /**< Fingerprints stored in slots */
+    size_t overflow;         /**< Repeated copies counted outside the slots */
+    size_t capacity;         /**< Fingerprint slots */
+    double load;             /**< entries / capacity */
+    double expectedFpr;      /**< False-positive rate expected at this load */
+    double observedFpr;      /**< falsePositives / absent lookups */
+    bool saturated;          /**< A fingerprint was lost; no misses skipped */
+} LFStats;
+
+/**
+ * @struct ListFilter
+ * @brief Filter and counters shared by FSList and FDList.
+ */
+typedef struct ListFilter {
+    CuckooFilter cf;                /**< Fingerprints of the payloads */
+    double maxFpr;                  /**< Rebuild above this observed rate */
+    uint64_t queries;               /**< Value lookups */
+    uint64_t negatives;             /**< Misses answered by the filter */
+    uint64_t falsePositives;        /**< Misses that needed a scan */
+    uint64_t rebuilds;              /**< Rebuilds so far */
+    uint64_t windowNegatives;       /**< negatives since the last rebuild */
+    uint64_t windowFalsePositives;  /**< falsePositives since the last rebuild */
+    size_t retrySize;               /**< Defer rebuilds in (this/4, this) */
+} ListFilter;
+
+static inline size_t lf_capacity_for(size_t size) {
+  return size < 32 ? 64 : size * 2;
+}
+
+static inline uint64_t lf_hash(const void *data, size_t len) {
+  return cds_hash_bytes(data, data ? len : 0);
+}
+
+static inline CDSStatus lf_init(ListFilter *lf, size_t capacity,
+                                const CDSAllocator *alloc) {
+  memset(lf, 0, sizeof(*lf));
+  lf->maxFpr = LF_DEFAULT_MAX_FPR;
+  return cf_init(&lf->cf, lf_capacity_for(capacity), 0, alloc);
+}
+
+static inline bool lf_degraded(const ListFilter *lf, size_t size) {
+  const CuckooFilter *cf = &lf->cf;
+  if (size < lf->retrySize && size > lf->retrySize / 4)
+    return false;
+  if (cf->saturated || cf->stashFp != 0 ||
+      (double)cf->count > LF_MAX_LOAD * (double)cf_capacity(cf))
+    return true;
+  uint64_t absent = lf->windowNegatives + lf->windowFalsePositives;
+  return absent >= LF_MIN_SAMPLES &&
+         (double)lf->windowFalsePositives > lf->maxFpr * (double)absent;
+}
+
+/**
+ * @brief Installs a freshly built filter in place of the current one.
+ */
+static inline void lf_swap(ListFilter *lf, CuckooFilter *fresh, size_t size,
+                           const CDSAllocator *alloc) {
+  cf_free(&lf->cf, alloc);
+  lf->cf = *fresh;
+  lf->rebuilds++;
+  lf->windowNegatives = 0;
+  lf->windowFalsePositives = 0;
+  // a fresh filter that already lost or stashed a fingerprint would be
+  // rebuilt on every lookup; wait for the list to double or halve instead
+  lf->retrySize = (fresh->saturated || fresh->stashFp != 0) ? size * 2 : 0;
+}
+
+/**
+ * @brief Counts a lookup and asks the filter about it.
+ * @return false if the value is definitely absent.
+ */
+static inline bool lf_query(ListFilter *lf, uint64_t hash) {
+  lf->queries++;
+  if (cf_contains(&lf->cf, hash))
+    return true;
+  lf->negatives++;
+  lf->windowNegatives++;
+  return false;
+}
+
+static inline void lf_false_positive(ListFilter *lf) {
+  lf->falsePositives++;
+  lf->windowFalsePositives++;
+}
+
+static inline void lf_stats(const ListFilter *lf, LFStats *out) {
+  uint64_t absent = lf->negatives + lf->falsePositives;
+  out->queries = lf->queries;
+  out->negatives = lf->negatives;
+  out->falsePositives = lf->falsePositives;
+  out->rebuilds = lf->rebuilds;
+  out->entries = lf->cf.count;
+  out->overflow = lf->cf.overflowCopies;
+  out->capacity = cf_capacity(&lf->cf);
+  out->load = cf_load(&lf->cf);
+  out->expectedFpr = cf_expected_fpr(&lf->cf);
+  out->observedFpr = absent ? (double)lf->falsePositives / (double)absent : 0.0;
+  out->saturated = lf->cf.saturated;
+}
+
+/**
+ * @struct FSList
+ * @brief Singly linked list handle with an attached cuckoo filter.
+ */
+typedef struct FSList {
+    Node *root;                /**< First node (an ordinary sl_ list) */
+    Node *tail;                /**< Last node, NULL when empty */
+    size_t size;               /**< Number of nodes */
+    ListFilter filter;         /**< Fingerprints and counters */
+    const CDSAllocator *alloc; /**< Allocator for nodes, payloads and filter */
+} FSList;
+
+/**
+ * @brief Initializes an empty list.
+ *
+ * @param capacity Expected number of elements; the filter grows past it.
+ * @param alloc Allocator, NULL for the default one.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fsl_init(FSList *list, size_t capacity,
+                                 const CDSAllocator *alloc) {
+  list->root = NULL;
+  list->tail = NULL;
+  list->size = 0;
+  list->alloc = alloc ? alloc : cds_default_allocator();
+  return lf_init(&list->filter, capacity, list->alloc);
+}
+
+/**
+ * @brief Sets the observed false-positive rate that triggers a rebuild.
+ */
+static inline void fsl_set_max_fpr(FSList *list, double maxFpr) {
+  list->filter.maxFpr = maxFpr;
+}
+
+/**
+ * @brief Returns the number of nodes.
+ */
+static inline size_t fsl_size(const FSList *list) { return list->size; }
+
+/**
+ * @brief Rebuilds the filter from the nodes, with room for twice the size.
+ *
+ * Call this after the nodes were changed without going through the handle.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY (the old filter is kept).
+ */
+static inline CDSStatus fsl_rebuild(FSList *list) {
+  CuckooFilter fresh;
+  CDSStatus status = cf_init(&fresh, lf_capacity_for(list->size),
+                             list->filter.cf.seed + 1, list->alloc);
+  if (status != CDS_OK)
+    return status;
+  size_t n = 0;
+  list->tail = NULL;
+  for (Node *c = list->root; c != NULL; c = c->next, n++) {
+    cf_insert(&fresh, lf_hash(c->data, c->dataLen));
+    list->tail = c;
+  }
+  list->size = n;
+  lf_swap(&list->filter, &fresh, n, list->alloc);
+  return CDS_OK;
+}
+
+static inline void fsl_check_filter(FSList *list) {
+  if (lf_degraded(&list->filter, list->size))
+    fsl_rebuild(list);
+}
+
+/**
+ * @brief Appends an existing sl_ list (O(n) in its length).
+ *
+ * @param root Double pointer to the head node; set to NULL.
+ */
+static inline void fsl_adopt(FSList *list, Node **root) {
+  Node *c = *root;
+  if (c == NULL)
+    return;
+  if (list->tail)
+    list->tail->next = c;
+  else
+    list->root = c;
+  for (; c != NULL; c = c->next) {
+    cf_insert(&list->filter.cf, lf_hash(c->data, c->dataLen));
+    list->tail = c;
+    list->size++;
+  }
+  *root = NULL;
+  fsl_check_filter(list);
+}
+
+/**
+ * @brief Hands the nodes back as an ordinary sl_ list.
+ *
+ * @return The head node; the handle is left empty and usable.
+ */
+static inline Node *fsl_release(FSList *list) {
+  Node *head = list->root;
+  list->root = NULL;
+  list->tail = NULL;
+  list->size = 0;
+  cf_clear(&list->filter.cf);
+  return head;
+}
+
+/**
+ * @brief Links a node at idx (0..size) and adds it to the filter.
+ */
+static inline void fsl_link_at(FSList *list, Node *node, size_t idx) {
+  if (idx == list->size) {
+    node->next = NULL;
+    if (list->tail)
+      list->tail->next = node;
+    else
+      list->root = node;
+    list->tail = node;
+  } else {
+    SLCursor cur;
+    sl_cursor_init_a(&cur, &list->root, list->alloc);
+    sl_cursor_seek(&cur, idx);
+    sl_cursor_insert_before_node(&cur, node);
+  }
+  list->size++;
+  cf_insert(&list->filter.cf, lf_hash(node->data, node->dataLen));
+  fsl_check_filter(list);
+}
+
+/**
+ * @brief Inserts data at an index (move semantics).
+ *
+ * @param data Pointer to the data pointer; set to NULL on success.
+ * @param idx Position 0..size.
+ * @return CDS_OK, or CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY with the data
+ * left to the caller.
+ */
+static inline CDSStatus fsl_insert_at_index_mv_data(FSList *list, void **data,
+                                                    size_t dataLen,
+                                                    size_t idx) {
+  if (idx > list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  Node *node = sl_create_node_mv_a(data, dataLen, NULL, list->alloc);
+  if (node == NULL)
+    return CDS_ERR_NO_MEMORY;
+  fsl_link_at(list, node, idx);
+  return CDS_OK;
+}
+
+/**
+ * @brief Inserts data at an index (shallow copy: the pointer is stored).
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fsl_insert_at_index_cp_data(FSList *list, void *data,
+                                                    size_t dataLen,
+                                                    size_t idx) {
+  if (idx > list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  Node *node = sl_create_node_cp_a(data, dataLen, NULL, list->alloc);
+  if (node == NULL)
+    return CDS_ERR_NO_MEMORY;
+  fsl_link_at(list, node, idx);
+  return CDS_OK;
+}
+
+/**
+ * @brief Inserts a deep copy of data at an index.
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fsl_insert_at_index_deep_cp_data(FSList *list,
+                                                         void *data,
+                                                         size_t dataLen,
+                                                         size_t idx) {
+  if (idx > list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  Node *node = sl_create_node_deep_cp_a(data, dataLen, NULL, list->alloc);
+  if (node == NULL)
+    return CDS_ERR_NO_MEMORY;
+  fsl_link_at(list, node, idx);
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends data (move semantics), O(1).
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the data left to the caller.
+ */
+static inline CDSStatus fsl_push_back_mv_data(FSList *list, void **data,
+                                              size_t dataLen) {
+  return fsl_insert_at_index_mv_data(list, data, dataLen, list->size);
+}
+
+/**
+ * @brief Appends data (shallow copy), O(1).
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fsl_push_back_cp_data(FSList *list, void *data,
+                                              size_t dataLen) {
+  return fsl_insert_at_index_cp_data(list, data, dataLen, list->size);
+}
+
+/**
+ * @brief Appends a deep copy of data, O(1).
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fsl_push_back_deep_cp_data(FSList *list, void *data,
+                                                   size_t dataLen) {
+  return fsl_insert_at_index_deep_cp_data(list, data, dataLen, list->size);
+}
+
+/**
+ * @brief Prepends data (move semantics).
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the data left to the caller.
+ */
+static inline CDSStatus fsl_push_front_mv_data(FSList *list, void **data,
+                                               size_t dataLen) {
+  return fsl_insert_at_index_mv_data(list, data, dataLen, 0);
+}
+
+/**
+ * @brief Prepends data (shallow copy).
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fsl_push_front_cp_data(FSList *list, void *data,
+                                               size_t dataLen) {
+  return fsl_insert_at_index_cp_data(list, data, dataLen, 0);
+}
+
+/**
+ * @brief Prepends a deep copy of data.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fsl_push_front_deep_cp_data(FSList *list, void *data,
+                                                    size_t dataLen) {
+  return fsl_insert_at_index_deep_cp_data(list, data, dataLen, 0);
+}
+
+/**
+ * @brief Unlinks and frees the cursor's node, keeping tail and filter in
+ * step.
+ */
+static inline void fsl_erase_at(FSList *list, SLCursor *cur) {
+  Node *victim = *cur->link;
+  cf_remove(&list->filter.cf, lf_hash(victim->data, victim->dataLen));
+  sl_cursor_erase(cur);
+  list->size--;
+  if (*cur->link == NULL)
+    list->tail = cur->link == &list->root
+                     ? NULL
+                     : (Node *)((char *)cur->link - offsetof(Node, next));
+}
+
+/**
+ * @brief Deletes the node at an index.
+ * @return CDS_OK or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus fsl_delete_at_index(FSList *list, size_t idx) {
+  if (idx >= list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  SLCursor cur;
+  sl_cursor_init_a(&cur, &list->root, list->alloc);
+  sl_cursor_seek(&cur, idx);
+  fsl_erase_at(list, &cur);
+  return CDS_OK;
+}
+
+/**
+ * @brief Looks up the first node holding a value without printing.
+ *
+ * A definite miss in the filter returns without touching the list.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NOT_FOUND.
+ */
+static inline CDSStatus fsl_try_get_by_value(FSList *list, void *data,
+                                             size_t dataLen, Node **out) {
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  if (data == NULL)
+    return CDS_ERR_NULL;
+  if (!lf_query(&list->filter, lf_hash(data, dataLen)))
+    return CDS_ERR_NOT_FOUND;
+  CDSStatus status = sl_try_get_by_value(list->root, data, dataLen, out);
+  if (status == CDS_ERR_NOT_FOUND) {
+    lf_false_positive(&list->filter);
+    fsl_check_filter(list);
+  }
+  return status;
+}
+
+/**
+ * @brief Returns the first node holding a value.
+ * @return The node, or NULL if the value is not in the list.
+ * @note Failures go through CDS_DIAGNOSTIC; use fsl_try_get_by_value() on hot
+ * paths.
+ */
+static inline Node *fsl_get_by_value(FSList *list, void *data, size_t dataLen) {
+  Node *n;
+  CDSStatus status = fsl_try_get_by_value(list, data, dataLen, &n);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Value does not exist in Linked List.\n");
+  return n;
+}
+
+/**
+ * @brief Checks whether the list holds a value.
+ */
+static inline bool fsl_contains(FSList *list, void *data, size_t dataLen) {
+  Node *n;
+  return fsl_try_get_by_value(list, data, dataLen, &n) == CDS_OK;
+}
+
+/**
+ * @brief Deletes the first node holding a value.
+ * @return true if a node was deleted.
+ */
+static inline bool fsl_delete_by_value(FSList *list, void *data,
+                                       size_t dataLen) {
+  if (!lf_query(&list->filter, lf_hash(data, dataLen)))
+    return false;
+  SLCursor cur;
+  sl_cursor_init_a(&cur, &list->root, list->alloc);
+  for (Node *c; (c = *cur.link) != NULL; sl_cursor_next(&cur)) {
+    if (c->dataLen == dataLen && memcmp(c->data, data, dataLen) == 0) {
+      fsl_erase_at(list, &cur);
+      return true;
+    }
+  }
+  lf_false_positive(&list->filter);
+  fsl_check_filter(list);
+  return false;
+}
+
+/**
+ * @brief Copies the filter counters.
+ */
+static inline void fsl_stats(const FSList *list, LFStats *out) {
+  lf_stats(&list->filter, out);
+}
+
+/**
+ * @brief Frees every node and its data. The list stays usable (empty).
+ */
+static inline void fsl_clear(FSList *list) {
+  sl_free_list_a(&list->root, list->alloc);
+  fsl_release(list);
+}
+
+/**
+ * @brief Frees the nodes and the filter; fsl_init() before reuse.
+ */
+static inline void fsl_free(FSList *list) {
+  fsl_clear(list);
+  cf_free(&list->filter.cf, list->alloc);
+}
+
+/**
+ * @struct FDList
+ * @brief Doubly linked list handle with an attached cuckoo filter.
+ */
+typedef struct FDList {
+    DLNode *root;              /**< First node (an ordinary dl_ list) */
+    DLNode *tail;              /**< Last node, NULL when empty */
+    size_t size;               /**< Number of nodes */
+    ListFilter filter;         /**< Fingerprints and counters */
+    const CDSAllocator *alloc; /**< Allocator for nodes, payloads and filter */
+} FDList;
+
+/**
+ * @brief Initializes an empty list.
+ *
+ * @param capacity Expected number of elements; the filter grows past it.
+ * @param alloc Allocator, NULL for the default one.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fdl_init(FDList *list, size_t capacity,
+                                 const CDSAllocator *alloc) {
+  list->root = NULL;
+  list->tail = NULL;
+  list->size = 0;
+  list->alloc = alloc ? alloc : cds_default_allocator();
+  return lf_init(&list->filter, capacity, list->alloc);
+}
+
+/**
+ * @brief Sets the observed false-positive rate that triggers a rebuild.
+ */
+static inline void fdl_set_max_fpr(FDList *list, double maxFpr) {
+  list->filter.maxFpr = maxFpr;
+}
+
+/**
+ * @brief Returns the number of nodes.
+ */
+static inline size_t fdl_size(const FDList *list) { return list->size; }
+
+/**
+ * @brief Rebuilds the filter from the nodes, with room for twice the size.
+ *
+ * Call this after the nodes were changed without going through the handle.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY (the old filter is kept).
+ */
+static inline CDSStatus fdl_rebuild(FDList *list) {
+  CuckooFilter fresh;
+  CDSStatus status = cf_init(&fresh, lf_capacity_for(list->size),
+                             list->filter.cf.seed + 1, list->alloc);
+  if (status != CDS_OK)
+    return status;
+  size_t n = 0;
+  list->tail = NULL;
+  for (DLNode *c = list->root; c != NULL; c = c->next, n++) {
+    cf_insert(&fresh, lf_hash(c->data, c->dataSize));
+    list->tail = c;
+  }
+  list->size = n;
+  lf_swap(&list->filter, &fresh, n, list->alloc);
+  return CDS_OK;
+}
+
+static inline void fdl_check_filter(FDList *list) {
+  if (lf_degraded(&list->filter, list->size))
+    fdl_rebuild(list);
+}
+
+/**
+ * @brief Appends an existing dl_ list (O(n) in its length).
+ *
+ * @param root Double pointer to the head node; set to NULL.
+ */
+static inline void fdl_adopt(FDList *list, DLNode **root) {
+  DLNode *c = *root;
+  if (c == NULL)
+    return;
+  c->previous = list->tail;
+  if (list->tail)
+    list->tail->next = c;
+  else
+    list->root = c;
+  for (; c != NULL; c = c->next) {
+    cf_insert(&list->filter.cf, lf_hash(c->data, c->dataSize));
+    list->tail = c;
+    list->size++;
+  }
+  *root = NULL;
+  fdl_check_filter(list);
+}
+
+/**
+ * @brief Hands the nodes back as an ordinary dl_ list.
+ *
+ * @return The head node; the handle is left empty and usable.
+ */
+static inline DLNode *fdl_release(FDList *list) {
+  DLNode *head = list->root;
+  list->root = NULL;
+  list->tail = NULL;
+  list->size = 0;
+  cf_clear(&list->filter.cf);
+  return head;
+}
+
+/**
+ * @brief Links a node at idx (0..size) and adds it to the filter.
+ *
+ * Walks from whichever end is closer.
+ */
+static inline void fdl_link_at(FDList *list, DLNode *node, size_t idx) {
+  DLCursor cur;
+  dl_cursor_init_a(&cur, &list->root, list->alloc);
+  if (idx > list->size / 2) {
+    cur.before = list->tail;
+    cur.node = NULL;
+    cur.index = list->size;
+  }
+  dl_cursor_seek(&cur, idx);
+  dl_cursor_insert_before_node(&cur, node);
+  if (node->next == NULL)
+    list->tail = node;
+  list->size++;
+  cf_insert(&list->filter.cf, lf_hash(node->data, node->dataSize));
+  fdl_check_filter(list);
+}
+
+/**
+ * @brief Inserts data at an index (move semantics).
+ *
+ * @param data Pointer to the data pointer; set to NULL on success.
+ * @param idx Position 0..size.
+ * @return CDS_OK, or CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY with the data
+ * left to the caller.
+ */
+static inline CDSStatus fdl_insert_at_index_mv_data(FDList *list, void **data,
+                                                    size_t dataSize,
+                                                    size_t idx) {
+  if (idx > list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  DLNode *node = dl_create_node_mv_a(data, dataSize, NULL, NULL, list->alloc);
+  if (node == NULL)
+    return CDS_ERR_NO_MEMORY;
+  fdl_link_at(list, node, idx);
+  return CDS_OK;
+}
+
+/**
+ * @brief Inserts data at an index (shallow copy: the pointer is stored).
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fdl_insert_at_index_cp_data(FDList *list, void *data,
+                                                    size_t dataSize,
+                                                    size_t idx) {
+  if (idx > list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  DLNode *node = dl_create_node_cp_a(data, dataSize, NULL, NULL, list->alloc);
+  if (node == NULL)
+    return CDS_ERR_NO_MEMORY;
+  fdl_link_at(list, node, idx);
+  return CDS_OK;
+}
+
+/**
+ * @brief Inserts a deep copy of data at an index.
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fdl_insert_at_index_deep_cp_data(FDList *list,
+                                                         void *data,
+                                                         size_t dataSize,
+                                                         size_t idx) {
+  if (idx > list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  DLNode *node =
+      dl_create_node_deep_cp_a(data, dataSize, NULL, NULL, list->alloc);
+  if (node == NULL)
+    return CDS_ERR_NO_MEMORY;
+  fdl_link_at(list, node, idx);
+  return CDS_OK;
+}
+
+/**
+ * @brief Appends data (move semantics), O(1).
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the data left to the caller.
+ */
+static inline CDSStatus fdl_push_back_mv_data(FDList *list, void **data,
+                                              size_t dataSize) {
+  return fdl_insert_at_index_mv_data(list, data, dataSize, list->size);
+}
+
+/**
+ * @brief Appends data (shallow copy), O(1).
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fdl_push_back_cp_data(FDList *list, void *data,
+                                              size_t dataSize) {
+  return fdl_insert_at_index_cp_data(list, data, dataSize, list->size);
+}
+
+/**
+ * @brief Appends a deep copy of data, O(1).
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fdl_push_back_deep_cp_data(FDList *list, void *data,
+                                                   size_t dataSize) {
+  return fdl_insert_at_index_deep_cp_data(list, data, dataSize, list->size);
+}
+
+/**
+ * @brief Prepends data (move semantics).
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY with the data left to the caller.
+ */
+static inline CDSStatus fdl_push_front_mv_data(FDList *list, void **data,
+                                               size_t dataSize) {
+  return fdl_insert_at_index_mv_data(list, data, dataSize, 0);
+}
+
+/**
+ * @brief Prepends data (shallow copy).
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fdl_push_front_cp_data(FDList *list, void *data,
+                                               size_t dataSize) {
+  return fdl_insert_at_index_cp_data(list, data, dataSize, 0);
+}
+
+/**
+ * @brief Prepends a deep copy of data.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus fdl_push_front_deep_cp_data(FDList *list, void *data,
+                                                    size_t dataSize) {
+  return fdl_insert_at_index_deep_cp_data(list, data, dataSize, 0);
+}
+
+/**
+ * @brief Unlinks and frees a node, keeping tail and filter in step.
+ */
+static inline void fdl_erase_node(FDList *list, DLNode *node) {
+  DLCursor cur;
+  cf_remove(&list->filter.cf, lf_hash(node->data, node->dataSize));
+  if (node == list->tail)
+    list->tail = node->previous;
+  dl_cursor_init_a(&cur, &list->root, list->alloc);
+  cur.before = node->previous;
+  cur.node = node;
+  dl_cursor_erase(&cur);
+  list->size--;
+}
+
+/**
+ * @brief Deletes the node at an index, walking from the closer end.
+ * @return CDS_OK or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus fdl_delete_at_index(FDList *list, size_t idx) {
+  if (idx >= list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  DLNode *c;
+  if (idx < list->size / 2) {
+    c = list->root;
+    for (size_t i = 0; i < idx; i++)
+      c = c->next;
+  } else {
+    c = list->tail;
+    for (size_t i = list->size - 1; i > idx; i--)
+      c = c->previous;
+  }
+  fdl_erase_node(list, c);
+  return CDS_OK;
+}
+
+/**
+ * @brief Looks up the first node holding a value without printing.
+ *
+ * A definite miss in the filter returns without touching the list.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NOT_FOUND.
+ */
+static inline CDSStatus fdl_try_get_by_value(FDList *list, void *data,
+                                             size_t dataSize, DLNode **out) {
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  if (data == NULL)
+    return CDS_ERR_NULL;
+  if (!lf_query(&list->filter, lf_hash(data, dataSize)))
+    return CDS_ERR_NOT_FOUND;
+  CDSStatus status = dl_try_get_by_value(list->root, data, dataSize, out);
+  if (status == CDS_ERR_NOT_FOUND) {
+    lf_false_positive(&list->filter);
+    fdl_check_filter(list);
+  }
+  return status;
+}
+
+/**
+ * @brief Returns the first node holding a value.
+ * @return The node, or NULL if the value is not in the list.
+ * @note Failures go through CDS_DIAGNOSTIC; use fdl_try_get_by_value() on hot
+ * paths.
+ */
+static inline DLNode *fdl_get_by_value(FDList *list, void *data,
+                                       size_t dataSize) {
+  DLNode *n;
+  CDSStatus status = fdl_try_get_by_value(list, data, dataSize, &n);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Value does not exist in Linked List.\n");
+  return n;
+}
+
+/**
+ * @brief Checks whether the list holds a value.
+ */
+static inline bool fdl_contains(FDList *list, void *data, size_t dataSize) {
+  DLNode *n;
+  return fdl_try_get_by_value(list, data, dataSize, &n) == CDS_OK;
+}
+
+/**
+ * @brief Deletes the first node holding a value.
+ * @return true if a node was deleted.
+ */
+static inline bool fdl_delete_by_value(FDList *list, void *data,
+                                       size_t dataSize) {
+  DLNode *n;
+  if (fdl_try_get_by_value(list, data, dataSize, &n) != CDS_OK)
+    return false;
+  fdl_erase_node(list, n);
+  return true;
+}
+
+/**
+ * @brief Copies the filter counters.
+ */
+static inline void fdl_stats(const FDList *list, LFStats *out) {
+  lf_stats(&list->filter, out);
+}
+
+/**
+ * @brief Frees every node and its data. The list stays usable (empty).
+ */
+static inline void fdl_clear(FDList *list) {
+  dl_free_list_a(&list->root, list->alloc);
+  fdl_release(list);
+}
+
+/**
+ * @brief Frees the nodes and the filter; fdl_init() before reuse.
+ */
+static inline void fdl_free(FDList *list) {
+  fdl_clear(list);
+  cf_free(&list->filter.cf, list->alloc);
+}
+
+#endif // LISTFILTER_H
@@ -0,0 +1,622 @@
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include "generics.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file lrucache.h
+ * @brief Least-recently-used cache (`lru_*`) and its sharded variant.
+ *
+ * Entries sit on a DLNode recency list (most recent at the root) and are
+ * indexed by an open-addressing hash table with linear probing, so get, put,
+ * touch and evict are all O(1) instead of the O(n) dl_get_by_value() scan.
+ * The DLNode embedded in each entry holds the value (`data`/`dataSize`);
+ * the key is stored next to it.
+ *
+ * Capacity is a number of entries, a number of value bytes (sum of
+ * `dataSize`), or both; 0 disables a limit. When an insert goes over a
+ * limit, the least recently used entries are evicted and passed to the
+ * eviction callback.
+ *
+ * LRUCache is not thread-safe. LRUSharded splits the key space over
+ * independently locked caches.
+ */
+
+/**
+ * @brief Called for every evicted entry, just before it is freed.
+ * @note value may be taken over by setting *value to NULL.
+ */
+typedef void (*LRUEvictFn)(const void *key, size_t keySize, void **value,
+                           size_t valueSize, void *ctx);
+
+/**
+ * @struct LRUEntry
+ * @brief Cache entry. The node must stay the first member.
+ */
+typedef struct LRUEntry {
+    DLNode node;    /**< Recency links; data/dataSize hold the value */
+    void *key;      /**< Copy of the key */
+    size_t keySize; /**< Size of the key in bytes */
+    uint64_t hash;  /**< Cached cds_hash_bytes() of the key */
+} LRUEntry;
+
+/**
+ * @struct LRUStats
+ * @brief Counters of a cache.
+ */
+typedef struct LRUStats {
+    uint64_t hits;      /**< lru_get() calls that found the key */
+    uint64_t misses;    /**< lru_get() calls that did not */
+    uint64_t evictions; /**< Entries dropped to respect the capacity */
+    size_t entries;     /**< Current number of entries */
+    size_t bytes;       /**< Current sum of value sizes */
+} LRUStats;
+
+/**
+ * @struct LRUCache
+ * @brief Handle of an LRU cache.
+ */
+typedef struct LRUCache {
+    DLNode *root;              /**< Most recently used entry */
+    DLNode *last;              /**< Least recently used entry */
+    LRUEntry **slots;          /**< Hash table, NULL marks an empty slot */
+    size_t slotMask;           /**< Table size - 1 (power of two) */
+    size_t maxEntries;         /**< Entry limit, 0 for none */
+    size_t maxBytes;           /**< Value byte limit, 0 for none */
+    LRUEvictFn onEvict;        /**< Eviction callback, may be NULL */
+    void *evictCtx;            /**< Context passed to onEvict */
+    LRUStats stats;            /**< Counters */
+    const CDSAllocator *alloc; /**< Allocator for entries, keys and values */
+} LRUCache;
+
+static inline size_t lru_table_size_for(size_t entries) {
+  size_t size = 16;
+  while (size < entries * 2)
+    size <<= 1;
+  return size;
+}
+
+/**
+ * @brief Initializes an empty cache.
+ * @param cache Cache handle.
+ * @param maxEntries Maximum number of entries, 0 for no limit.
+ * @param maxBytes Maximum sum of value sizes, 0 for no limit.
+ * @param alloc Allocator, NULL for the default one.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus lru_init(LRUCache *cache, size_t maxEntries,
+                                 size_t maxBytes, const CDSAllocator *alloc) {
+  size_t slots = lru_table_size_for(maxEntries);
+  memset(cache, 0, sizeof(*cache));
+  cache->maxEntries = maxEntries;
+  cache->maxBytes = maxBytes;
+  cache->alloc = alloc ? alloc : cds_default_allocator();
+  cache->slots = (LRUEntry **)cds_alloc(cache->alloc, slots * sizeof(LRUEntry *));
+  if (cache->slots == NULL)
+    return CDS_ERR_NO_MEMORY;
+  memset(cache->slots, 0, slots * sizeof(LRUEntry *));
+  cache->slotMask = slots - 1;
+  return CDS_OK;
+}
+
+/**
+ * @brief Installs the eviction callback (NULL to remove it).
+ */
+static inline void lru_set_evict_callback(LRUCache *cache, LRUEvictFn fn,
+                                          void *ctx) {
+  cache->onEvict = fn;
+  cache->evictCtx = ctx;
+}
+
+/**
+ * @brief Copies the counters of a cache.
+ */
+static inline void lru_stats(const LRUCache *cache, LRUStats *out) {
+  *out = cache->stats;
+}
+
+/**
+ * @brief Returns the number of entries.
+ */
+static inline size_t lru_size(const LRUCache *cache) {
+  return cache->stats.entries;
+}
+
+static inline void lru_unlink(LRUCache *cache, DLNode *n) {
+  if (n->previous)
+    n->previous->next = n->next;
+  else
+    cache->root = n->next;
+  if (n->next)
+    n->next->previous = n->previous;
+  else
+    cache->last = n->previous;
+  n->next = n->previous = NULL;
+}
+
+static inline void lru_link_front(LRUCache *cache, DLNode *n) {
+  n->previous = NULL;
+  n->next = cache->root;
+  if (cache->root)
+    cache->root->previous = n;
+  else
+    cache->last = n;
+  cache->root = n;
+}
+
+// returns the slot holding the key, or the empty slot where it would go
+static inline size_t lru_probe(const LRUCache *cache, const void *key,
+                               size_t keySize, uint64_t hash) {
+  size_t i = (size_t)hash & cache->slotMask;
+  for (;;) {
+    LRUEntry *e = cache->slots[i];
+    if (e == NULL || (e->hash == hash && e->keySize == keySize &&
+                      memcmp(e->key, key, keySize) == 0))
+      return i;
+    i = (i + 1) & cache->slotMask;
+  }
+}
+
+// backward-shift deletion keeps probe chains intact without tombstones
+static inline void lru_slot_clear(LRUCache *cache, size_t i) {
+  size_t j = i;
+  for (;;) {
+    j = (j + 1) & cache->slotMask;
+    LRUEntry *e = cache->slots[j];
+    if (e == NULL)
+      break;
+    size_t home = (size_t)e->hash & cache->slotMask;
+    if (((j - home) & cache->slotMask) >= ((j - i) & cache->slotMask)) {
+      cache->slots[i] = e;
+      i = j;
+    }
+  }
+  cache->slots[i] = NULL;
+}
+
+static inline CDSStatus lru_grow(LRUCache *cache) {
+  size_t oldSize = cache->slotMask + 1;
+  size_t newSize = oldSize * 2;
+  LRUEntry **old = cache->slots;
+  LRUEntry **slots =
+      (LRUEntry **)cds_alloc(cache->alloc, newSize * sizeof(LRUEntry *));
+  if (slots == NULL)
+    return CDS_ERR_NO_MEMORY;
+  memset(slots, 0, newSize * sizeof(LRUEntry *));
+  cache->slots = slots;
+  cache->slotMask = newSize - 1;
+  for (size_t i = 0; i < oldSize; i++) {
+    if (old[i]) {
+      size_t j = (size_t)old[i]->hash & cache->slotMask;
+      while (slots[j])
+        j = (j + 1) & cache->slotMask;
+      slots[j] = old[i];
+    }
+  }
+  cds_free(cache->alloc, old);
+  return CDS_OK;
+}
+
+static inline void lru_destroy_entry(LRUCache *cache, LRUEntry *e) {
+  cds_free(cache->alloc, e->node.data);
+  cds_free(cache->alloc, e->key);
+  cds_free(cache->alloc, e);
+}
+
+// unlinks an entry from both the table and the recency list
+static inline void lru_detach(LRUCache *cache, LRUEntry *e) {
+  lru_slot_clear(cache, lru_probe(cache, e->key, e->keySize, e->hash));
+  lru_unlink(cache, &e->node);
+  cache->stats.entries--;
+  cache->stats.bytes -= e->node.dataSize;
+}
+
+/**
+ * @brief Evicts the least recently used entry through the callback.
+ * @return false if the cache is empty.
+ */
+static inline bool lru_evict(LRUCache *cache) {
+  LRUEntry *e = (LRUEntry *)cache->last;
+  if (e == NULL)
+    return false;
+  lru_detach(cache, e);
+  cache->stats.evictions++;
+  if (cache->onEvict)
+    cache->onEvict(e->key, e->keySize, &e->node.data, e->node.dataSize,
+                   cache->evictCtx);
+  lru_destroy_entry(cache, e);
+  return true;
+}
+
+static inline bool lru_over_limit(const LRUCache *cache) {
+  return (cache->maxEntries && cache->stats.entries > cache->maxEntries) ||
+         (cache->maxBytes && cache->stats.bytes > cache->maxBytes);
+}
+
+static inline LRUEntry *lru_find(const LRUCache *cache, const void *key,
+                                 size_t keySize) {
+  return cache->slots[lru_probe(cache, key, keySize,
+                                cds_hash_bytes(key, keySize))];
+}
+
+/**
+ * @brief Looks up a key and marks it as most recently used.
+ * @param valueSize Receives the size of the value (may be NULL).
+ * @return The cached value, or NULL on a miss.
+ * @note The pointer stays valid until the entry is replaced, removed or
+ * evicted.
+ */
+static inline void *lru_get(LRUCache *cache, const void *key, size_t keySize,
+                            size_t *valueSize) {
+  LRUEntry *e = lru_find(cache, key, keySize);
+  if (e == NULL) {
+    cache->stats.misses++;
+    return NULL;
+  }
+  cache->stats.hits++;
+  if (cache->root != &e->node) {
+    lru_unlink(cache, &e->node);
+    lru_link_front(cache, &e->node);
+  }
+  if (valueSize)
+    *valueSize = e->node.dataSize;
+  return e->node.data;
+}
+
+/**
+ * @brief Looks up a key without changing its recency or the counters.
+ * @return The cached value, or NULL if absent.
+ */
+static inline void *lru_peek(const LRUCache *cache, const void *key,
+                             size_t keySize, size_t *valueSize) {
+  LRUEntry *e = lru_find(cache, key, keySize);
+  if (e == NULL)
+    return NULL;
+  if (valueSize)
+    *valueSize = e->node.dataSize;
+  return e->node.data;
+}
+
+/**
+ * @brief Checks if a key is cached without changing its recency.
+ */
+static inline bool lru_contains(const LRUCache *cache, const void *key,
+                                size_t keySize) {
+  return lru_find(cache, key, keySize) != NULL;
+}
+
+/**
+ * @brief Marks a key as most recently used.
+ * @return false if the key is not cached.
+ */
+static inline bool lru_touch(LRUCache *cache, const void *key,
+                             size_t keySize) {
+  LRUEntry *e = lru_find(cache, key, keySize);
+  if (e == NULL)
+    return false;
+  lru_unlink(cache, &e->node);
+  lru_link_front(cache, &e->node);
+  return true;
+}
+
+/**
+ * @brief Removes a key without calling the eviction callback.
+ * @return true if the key was cached.
+ */
+static inline bool lru_remove(LRUCache *cache, const void *key,
+                              size_t keySize) {
+  LRUEntry *e = lru_find(cache, key, keySize);
+  if (e == NULL)
+    return false;
+  lru_detach(cache, e);
+  lru_destroy_entry(cache, e);
+  return true;
+}
+
+/**
+ * @brief Inserts or replaces a value (move semantics).
+ *
+ * The key is copied. The entry becomes the most recently used one and older
+ * entries are evicted until the cache is within its limits.
+ * @param data Pointer to the value pointer; set to NULL on success.
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS if the value alone exceeds maxBytes,
+ * or CDS_ERR_NO_MEMORY. On failure the value stays with the caller.
+ * @note The value must come from the cache's allocator.
+ */
+static inline CDSStatus lru_put_mv_data(LRUCache *cache, const void *key,
+                                        size_t keySize, void **data,
+                                        size_t dataSize) {
+  uint64_t hash = cds_hash_bytes(key, keySize);
+  size_t slot;
+  LRUEntry *e;
+  if (cache->maxBytes && dataSize > cache->maxBytes)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  slot = lru_probe(cache, key, keySize, hash);
+  e = cache->slots[slot];
+  if (e) {
+    cds_free(cache->alloc, e->node.data);
+    cache->stats.bytes += dataSize - e->node.dataSize;
+    e->node.data = move(data);
+    e->node.dataSize = dataSize;
+    lru_unlink(cache, &e->node);
+  } else {
+    if ((cache->stats.entries + 1) * 2 > cache->slotMask + 1) {
+      if (lru_grow(cache) != CDS_OK)
+        return CDS_ERR_NO_MEMORY;
+      slot = lru_probe(cache, key, keySize, hash);
+    }
+    e = (LRUEntry *)cds_alloc(cache->alloc, sizeof(LRUEntry));
+    if (e == NULL)
+      return CDS_ERR_NO_MEMORY;
+    e->key = keySize ? cds_alloc(cache->alloc, keySize) : NULL;
+    if (keySize && e->key == NULL) {
+      cds_free(cache->alloc, e);
+      return CDS_ERR_NO_MEMORY;
+    }
+    if (keySize)
+      memcpy(e->key, key, keySize);
+    e->keySize = keySize;
+    e->hash = hash;
+    e->node.data = move(data);
+    e->node.dataSize = dataSize;
+    cache->slots[slot] = e;
+    cache->stats.entries++;
+    cache->stats.bytes += dataSize;
+  }
+  lru_link_front(cache, &e->node);
+  while (lru_over_limit(cache) && cache->last != &e->node)
+    lru_evict(cache);
+  return CDS_OK;
+}
+
+/**
+ * @brief Inserts or replaces a value (deep copy).
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY.
+ * @see lru_put_mv_data()
+ */
+static inline CDSStatus lru_put_deep_cp_data(LRUCache *cache, const void *key,
+                                             size_t keySize, const void *data,
+                                             size_t dataSize) {
+  void *copy = NULL;
+  CDSStatus status;
+  if (cache->maxBytes && dataSize > cache->maxBytes)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  if (data && dataSize) {
+    copy = cds_alloc(cache->alloc, dataSize);
+    if (copy == NULL)
+      return CDS_ERR_NO_MEMORY;
+    memcpy(copy, data, dataSize);
+  }
+  status = lru_put_mv_data(cache, key, keySize, &copy, dataSize);
+  cds_free(cache->alloc, copy);
+  return status;
+}
+
+/**
+ * @brief Removes every entry without calling the eviction callback.
+ * @note The counters are kept.
+ */
+static inline void lru_clear(LRUCache *cache) {
+  DLNode *n = cache->root;
+  while (n) {
+    DLNode *next = n->next;
+    lru_destroy_entry(cache, (LRUEntry *)n);
+    n = next;
+  }
+  memset(cache->slots, 0, (cache->slotMask + 1) * sizeof(LRUEntry *));
+  cache->root = cache->last = NULL;
+  cache->stats.entries = 0;
+  cache->stats.bytes = 0;
+}
+
+/**
+ * @brief Frees the cache. The handle must be re-initialized before reuse.
+ */
+static inline void lru_free(LRUCache *cache) {
+  lru_clear(cache);
+  cds_free(cache->alloc, cache->slots);
+  cache->slots = NULL;
+}
+
+/**
+ * @struct LRUShard
+ * @brief One independently locked cache of an LRUSharded.
+ */
+typedef struct LRUShard {
+    pthread_mutex_t lock; /**< Protects cache */
+    LRUCache cache;       /**< Cache for the keys hashed to this shard */
+    char pad[64];         /**< Keeps neighbouring locks off the same line */
+} LRUShard;
+
+/**
+ * @struct LRUSharded
+ * @brief Thread-safe LRU cache made of independently locked shards.
+ *
+ * A key always maps to the same shard, so recency is tracked per shard:
+ * eviction picks the least recently used entry of the shard that overflows.
+ */
+typedef struct LRUSharded {
+    LRUShard *shards;          /**< Array of nShards shards */
+    size_t nShards;            /**< Number of shards (power of two) */
+    const CDSAllocator *alloc; /**< Allocator for the shard array */
+} LRUSharded;
+
+/**
+ * @brief Initializes a sharded cache.
+ * @param nShards Requested shard count, rounded up to a power of two.
+ * @param maxEntries Total entry limit split evenly over the shards (0: none).
+ * @param maxBytes Total value byte limit split evenly over the shards
+ * (0: none).
+ * @return CDS_OK or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus lru_sharded_init(LRUSharded *s, size_t nShards,
+                                         size_t maxEntries, size_t maxBytes,
+                                         const CDSAllocator *alloc) {
+  size_t n = 1;
+  while (n < nShards)
+    n <<= 1;
+  s->alloc = alloc ? alloc : cds_default_allocator();
+  s->nShards = n;
+  s->shards = (LRUShard *)cds_alloc(s->alloc, n * sizeof(LRUShard));
+  if (s->shards == NULL)
+    return CDS_ERR_NO_MEMORY;
+  for (size_t i = 0; i < n; i++) {
+    size_t entries = maxEntries ? (maxEntries + n - 1) / n : 0;
+    size_t bytes = maxBytes ? (maxBytes + n - 1) / n : 0;
+    if (lru_init(&s->shards[i].cache, entries, bytes, alloc) != CDS_OK) {
+      while (i-- > 0) {
+        lru_free(&s->shards[i].cache);
+        pthread_mutex_destroy(&s->shards[i].lock);
+      }
+      cds_free(s->alloc, s->shards);
+      s->shards = NULL;
+      return CDS_ERR_NO_MEMORY;
+    }
+    pthread_mutex_init(&s->shards[i].lock, NULL);
+  }
+  return CDS_OK;
+}
+
+static inline LRUShard *lru_shard_for(LRUSharded *s, const void *key,
+                                      size_t keySize) {
+  // top bits pick the shard, low bits are used inside the shard's table
+  uint64_t hash = cds_hash_bytes(key, keySize);
+  return &s->shards[(size_t)(hash >> 40) & (s->nShards - 1)];
+}
+
+/**
+ * @brief Installs the same eviction callback on every shard.
+ * @note The callback runs with the shard lock held.
+ */
+static inline void lru_sharded_set_evict_callback(LRUSharded *s,
+                                                  LRUEvictFn fn, void *ctx) {
+  for (size_t i = 0; i < s->nShards; i++) {
+    pthread_mutex_lock(&s->shards[i].lock);
+    lru_set_evict_callback(&s->shards[i].cache, fn, ctx);
+    pthread_mutex_unlock(&s->shards[i].lock);
+  }
+}
+
+/**
+ * @brief Looks up a key and copies its value out.
+ *
+ * The value is copied under the shard lock because another thread may evict
+ * it as soon as the lock is released.
+ * @param out Buffer receiving up to outSize bytes of the value (may be NULL).
+ * @param valueSize Receives the full size of the value (may be NULL).
+ * @return true on a hit.
+ */
+static inline bool lru_sharded_get(LRUSharded *s, const void *key,
+                                   size_t keySize, void *out, size_t outSize,
+                                   size_t *valueSize) {
+  LRUShard *shard = lru_shard_for(s, key, keySize);
+  size_t size = 0;
+  void *value;
+  pthread_mutex_lock(&shard->lock);
+  value = lru_get(&shard->cache, key, keySize, &size);
+  if (value && out)
+    memcpy(out, value, size < outSize ? size : outSize);
+  pthread_mutex_unlock(&shard->lock);
+  if (valueSize)
+    *valueSize = size;
+  return value != NULL;
+}
+
+/**
+ * @brief Inserts or replaces a value (deep copy).
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus lru_sharded_put_deep_cp_data(LRUSharded *s,
+                                                     const void *key,
+                                                     size_t keySize,
+                                                     const void *data,
+                                                     size_t dataSize) {
+  LRUShard *shard = lru_shard_for(s, key, keySize);
+  CDSStatus status;
+  pthread_mutex_lock(&shard->lock);
+  status = lru_put_deep_cp_data(&shard->cache, key, keySize, data, dataSize);
+  pthread_mutex_unlock(&shard->lock);
+  return status;
+}
+
+/**
+ * @brief Inserts or replaces a value (move semantics).
+ * @see lru_put_mv_data()
+ */
+static inline CDSStatus lru_sharded_put_mv_data(LRUSharded *s,
+                                                const void *key, size_t keySize,
+                                                void **data, size_t dataSize) {
+  LRUShard *shard = lru_shard_for(s, key, keySize);
+  CDSStatus status;
+  pthread_mutex_lock(&shard->lock);
+  status = lru_put_mv_data(&shard->cache, key, keySize, data, dataSize);
+  pthread_mutex_unlock(&shard->lock);
+  return status;
+}
+
+/**
+ * @brief Marks a key as most recently used in its shard.
+ * @return false if the key is not cached.
+ */
+static inline bool lru_sharded_touch(LRUSharded *s, const void *key,
+                                     size_t keySize) {
+  LRUShard *shard = lru_shard_for(s, key, keySize);
+  bool found;
+  pthread_mutex_lock(&shard->lock);
+  found = lru_touch(&shard->cache, key, keySize);
+  pthread_mutex_unlock(&shard->lock);
+  return found;
+}
+
+/**
+ * @brief Removes a key without calling the eviction callback.
+ * @return true if the key was cached.
+ */
+static inline bool lru_sharded_remove(LRUSharded *s, const void *key,
+                                      size_t keySize) {
+  LRUShard *shard = lru_shard_for(s, key, keySize);
+  bool found;
+  pthread_mutex_lock(&shard->lock);
+  found = lru_remove(&shard->cache, key, keySize);
+  pthread_mutex_unlock(&shard->lock);
+  return found;
+}
+
+/**
+ * @brief Sums the counters of every shard.
+ */
+static inline void lru_sharded_stats(LRUSharded *s, LRUStats *out) {
+  memset(out, 0, sizeof(*out));
+  for (size_t i = 0; i < s->nShards; i++) {
+    LRUStats st;
+    pthread_mutex_lock(&s->shards[i].lock);
+    lru_stats(&s->shards[i].cache, &st);
+    pthread_mutex_unlock(&s->shards[i].lock);
+    out->hits += st.hits;
+    out->misses += st.misses;
+    out->evictions += st.evictions;
+    out->entries += st.entries;
+    out->bytes += st.bytes;
+  }
+}
+
+/**
+ * @brief Frees every shard. No other thread may use the cache.
+ */
+static inline void lru_sharded_free(LRUSharded *s) {
+  for (size_t i = 0; i < s->nShards; i++) {
+    lru_free(&s->shards[i].cache);
+    pthread_mutex_destroy(&s->shards[i].lock);
+  }
+  cds_free(s->alloc, s->shards);
+  s->shards = NULL;
+  s->nShards = 0;
+}
+
+#endif // LRUCACHE_H
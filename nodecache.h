@@ -0,0 +1,406 @@
+#ifndef NODECACHE_H
+#define NODECACHE_H
+
+#include "generics.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file nodecache.h
+ * @brief Thread-local node caches with batched remote frees (`ncache_*`).
+ *
+ * An NCachePool is a CDSAllocator for the `_a` functions of every list:
+ * pass ncache_allocator(&pool) wherever an allocator is taken, and node and
+ * payload allocations of up to NCACHE_MAX_SMALL bytes are served from
+ * per-thread free lists, one per 16-byte size class.
+ *
+ * - An empty free list is refilled NCACHE_REFILL blocks at a time, first
+ *   from the blocks other threads have handed back, then from one new chunk
+ *   of the backing allocator.
+ * - Every block remembers the thread that carved it. Freeing a block of
+ *   another thread (the producer/consumer pattern) does not touch the shared
+ *   heap: the block is added to a per-owner batch that is pushed onto the
+ *   owner's lock-free queue with a single compare-and-swap every
+ *   NCACHE_REMOTE_BATCH frees. The owner takes its whole queue with one
+ *   exchange on its next refill.
+ * - A thread that exits leaves its cache to the next thread that registers
+ *   with the pool, so blocks freed to it are not lost.
+ *
+ * Blocks carry a 16-byte header; larger requests go straight to the backing
+ * allocator. Chunks are only returned to the backing allocator by
+ * ncache_pool_destroy().
+ */
+
+/** @brief Granularity of the size classes (header included). */
+#define NCACHE_GRANULE 16
+
+/** @brief Number of size classes. */
+#define NCACHE_CLASSES 16
+
+/** @brief Blocks carved per chunk. */
+#ifndef NCACHE_REFILL
+#define NCACHE_REFILL 64
+#endif
+
+/** @brief Remote frees collected before they are handed back. */
+#ifndef NCACHE_REMOTE_BATCH
+#define NCACHE_REMOTE_BATCH 32
+#endif
+
+#define NCACHE_CACHE_LINE 64
+
+/** @brief Class of blocks that bypass the caches. */
+#define NCACHE_LARGE ((size_t)-1)
+
+struct NCacheThread;
+struct NCachePool;
+
+/**
+ * @union NCacheHeader
+ * @brief Header stored in front of every block.
+ */
+typedef union NCacheHeader {
+    struct {
+        struct NCacheThread *owner; /**< Thread that carved the block */
+        size_t cls;                 /**< Size class or NCACHE_LARGE */
+    } h;
+    long double alignLd; /**< Keeps the data maximally aligned */
+    void *alignPtr;
+    long long alignLl;
+} NCacheHeader;
+
+/** @brief Largest request served from the caches. */
+#define NCACHE_MAX_SMALL                                                       \
+  (NCACHE_CLASSES * NCACHE_GRANULE - sizeof(NCacheHeader))
+
+// a free block; the link overlays the start of the user data
+typedef struct NCacheFree {
+    struct NCacheFree *next;
+} NCacheFree;
+
+typedef union NCacheChunk {
+    union NCacheChunk *next; /**< Next chunk of the pool */
+    NCacheHeader align;      /**< Keeps the blocks aligned */
+} NCacheChunk;
+
+/**
+ * @struct NCacheThread
+ * @brief Cache of one thread; allocated by the pool on first use.
+ */
+typedef struct NCacheThread {
+    NCacheFree *remote; /**< Blocks handed back by other threads (atomic) */
+    char pad[NCACHE_CACHE_LINE - sizeof(void *)]; /**< Keeps remote apart */
+    NCacheFree *local[NCACHE_CLASSES]; /**< Free lists per size class */
+    struct NCacheThread *batchOwner;   /**< Owner of the pending batch */
+    NCacheFree *batchHead;             /**< Pending remote frees */
+    NCacheFree *batchTail;             /**< Last block of the batch */
+    unsigned batchCount;               /**< Blocks in the batch */
+    bool orphan;                       /**< Its thread has exited */
+    size_t chunks;                     /**< Chunks carved (atomic) */
+    size_t remoteFrees;                /**< Blocks freed to other threads */
+    size_t remoteBatches;              /**< Batches pushed to other threads */
+    struct NCachePool *pool;           /**< Pool it belongs to */
+    struct NCacheThread *next;         /**< Link in the pool's thread list */
+} NCacheThread;
+
+/**
+ * @struct NCachePool
+ * @brief Pool of thread-local node caches exposed as a CDSAllocator.
+ */
+typedef struct NCachePool {
+    CDSAllocator allocator;      /**< What ncache_allocator() returns */
+    const CDSAllocator *backing; /**< Source of chunks and large blocks */
+    pthread_key_t key;           /**< Current thread's NCacheThread */
+    pthread_mutex_t lock;        /**< Protects threads and chunks */
+    NCacheThread *threads;       /**< Every cache, live or orphaned */
+    NCacheChunk *chunks;         /**< Every chunk carved so far */
+} NCachePool;
+
+/**
+ * @struct NCacheStats
+ * @brief Counters summed over the threads of a pool.
+ */
+typedef struct NCacheStats {
+    size_t threads;       /**< Caches created */
+    size_t chunks;        /**< Chunks taken from the backing allocator */
+    size_t remoteFrees;   /**< Blocks freed by a thread other than the owner */
+    size_t remoteBatches; /**< Compare-and-swaps used to hand them back */
+} NCacheStats;
+
+static inline NCacheHeader *ncache_header(const void *ptr) {
+  return (NCacheHeader *)ptr - 1;
+}
+
+static inline void ncache_count(size_t *counter, size_t n) {
+  __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + n,
+                   __ATOMIC_RELAXED);
+}
+
+// pushes the pending batch onto its owner's queue with one CAS
+static inline void ncache_flush_batch(NCacheThread *t) {
+  NCacheThread *owner = t->batchOwner;
+  NCacheFree *old;
+  if (t->batchHead == NULL)
+    return;
+  old = __atomic_load_n(&owner->remote, __ATOMIC_RELAXED);
+  do {
+    t->batchTail->next = old;
+  } while (!__atomic_compare_exchange_n(&owner->remote, &old, t->batchHead,
+                                        true, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED));
+  ncache_count(&t->remoteBatches, 1);
+  t->batchHead = t->batchTail = NULL;
+  t->batchCount = 0;
+  t->batchOwner = NULL;
+}
+
+// moves the blocks other threads handed back to the local free lists
+static inline void ncache_drain_remote(NCacheThread *t) {
+  NCacheFree *f = __atomic_exchange_n(&t->remote, (NCacheFree *)NULL,
+                                      __ATOMIC_ACQUIRE);
+  while (f != NULL) {
+    NCacheFree *next = f->next;
+    size_t cls = ncache_header(f)->h.cls;
+    f->next = t->local[cls];
+    t->local[cls] = f;
+    f = next;
+  }
+}
+
+static inline void ncache_thread_exit(void *arg) {
+  NCacheThread *t = (NCacheThread *)arg;
+  ncache_flush_batch(t);
+  ncache_drain_remote(t);
+  pthread_mutex_lock(&t->pool->lock);
+  t->orphan = true;
+  pthread_mutex_unlock(&t->pool->lock);
+}
+
+// returns the calling thread's cache, adopting an orphan or creating one
+static inline NCacheThread *ncache_thread(NCachePool *pool) {
+  NCacheThread *t = (NCacheThread *)pthread_getspecific(pool->key);
+  if (t != NULL)
+    return t;
+  pthread_mutex_lock(&pool->lock);
+  for (t = pool->threads; t != NULL && !t->orphan; t = t->next)
+    ;
+  if (t != NULL) {
+    t->orphan = false;
+  } else {
+    t = (NCacheThread *)cds_alloc(pool->backing, sizeof(NCacheThread));
+    if (t != NULL) {
+      memset(t, 0, sizeof(*t));
+      t->pool = pool;
+      t->next = pool->threads;
+      pool->threads = t;
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+  if (t != NULL)
+    pthread_setspecific(pool->key, t);
+  return t;
+}
+
+static inline NCacheFree *ncache_refill(NCacheThread *t, size_t cls) {
+  NCachePool *pool = t->pool;
+  size_t blockSize = (cls + 1) * NCACHE_GRANULE;
+  NCacheChunk *chunk;
+  unsigned char *p;
+  ncache_drain_remote(t);
+  if (t->local[cls] != NULL)
+    return t->local[cls];
+  chunk = (NCacheChunk *)cds_alloc(
+      pool->backing, sizeof(NCacheChunk) + NCACHE_REFILL * blockSize);
+  if (chunk == NULL)
+    return NULL;
+  pthread_mutex_lock(&pool->lock);
+  chunk->next = pool->chunks;
+  pool->chunks = chunk;
+  pthread_mutex_unlock(&pool->lock);
+  ncache_count(&t->chunks, 1);
+  p = (unsigned char *)(chunk + 1);
+  for (size_t i = NCACHE_REFILL; i-- > 0;) {
+    NCacheHeader *hdr = (NCacheHeader *)(p + i * blockSize);
+    NCacheFree *f = (NCacheFree *)(hdr + 1);
+    hdr->h.owner = t;
+    hdr->h.cls = cls;
+    f->next = t->local[cls];
+    t->local[cls] = f;
+  }
+  return t->local[cls];
+}
+
+static inline void *ncache_alloc_fn(void *state, size_t size) {
+  NCachePool *pool = (NCachePool *)state;
+  size_t total =
+      sizeof(NCacheHeader) + (size < sizeof(void *) ? sizeof(void *) : size);
+  size_t cls = (total - 1) / NCACHE_GRANULE;
+  NCacheThread *t;
+  NCacheFree *f;
+  if (cls >= NCACHE_CLASSES) {
+    NCacheHeader *hdr = (NCacheHeader *)cds_alloc(pool->backing, total);
+    if (hdr == NULL)
+      return NULL;
+    hdr->h.owner = NULL;
+    hdr->h.cls = NCACHE_LARGE;
+    return hdr + 1;
+  }
+  t = ncache_thread(pool);
+  if (t == NULL)
+    return NULL;
+  f = t->local[cls];
+  if (f == NULL && (f = ncache_refill(t, cls)) == NULL)
+    return NULL;
+  t->local[cls] = f->next;
+  return f;
+}
+
+static inline void ncache_free_fn(void *state, void *ptr) {
+  NCachePool *pool = (NCachePool *)state;
+  NCacheHeader *hdr = ncache_header(ptr);
+  NCacheThread *owner = hdr->h.owner;
+  NCacheFree *f = (NCacheFree *)ptr;
+  NCacheThread *t;
+  if (hdr->h.cls == NCACHE_LARGE) {
+    cds_free(pool->backing, hdr);
+    return;
+  }
+  t = ncache_thread(pool);
+  if (t == owner) {
+    f->next = t->local[hdr->h.cls];
+    t->local[hdr->h.cls] = f;
+    return;
+  }
+  if (t == NULL) { // no cache of our own: hand the block back alone
+    NCacheFree *old = __atomic_load_n(&owner->remote, __ATOMIC_RELAXED);
+    do {
+      f->next = old;
+    } while (!__atomic_compare_exchange_n(&owner->remote, &old, f, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    return;
+  }
+  if (t->batchOwner != owner) {
+    ncache_flush_batch(t);
+    t->batchOwner = owner;
+  }
+  f->next = t->batchHead;
+  t->batchHead = f;
+  if (t->batchTail == NULL)
+    t->batchTail = f;
+  ncache_count(&t->remoteFrees, 1);
+  if (++t->batchCount >= NCACHE_REMOTE_BATCH)
+    ncache_flush_batch(t);
+}
+
+static inline void *ncache_realloc_fn(void *state, void *ptr, size_t size) {
+  NCachePool *pool = (NCachePool *)state;
+  NCacheHeader *hdr;
+  size_t usable;
+  void *copy;
+  if (ptr == NULL)
+    return ncache_alloc_fn(state, size);
+  hdr = ncache_header(ptr);
+  if (hdr->h.cls == NCACHE_LARGE && size > NCACHE_MAX_SMALL) {
+    hdr = (NCacheHeader *)cds_realloc(pool->backing, hdr,
+                                      sizeof(NCacheHeader) + size);
+    return hdr ? hdr + 1 : NULL;
+  }
+  if (hdr->h.cls != NCACHE_LARGE) {
+    usable = (hdr->h.cls + 1) * NCACHE_GRANULE - sizeof(NCacheHeader);
+    if (size <= usable)
+      return ptr;
+  } else {
+    usable = size; // shrinking a large block into a cached one
+  }
+  copy = ncache_alloc_fn(state, size);
+  if (copy == NULL)
+    return NULL;
+  memcpy(copy, ptr, usable < size ? usable : size);
+  ncache_free_fn(state, ptr);
+  return copy;
+}
+
+/**
+ * @brief Initializes a pool.
+ * @param backing Allocator for chunks and large blocks, NULL for the default
+ * one.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY if no thread key is available.
+ */
+static inline CDSStatus ncache_pool_init(NCachePool *pool,
+                                         const CDSAllocator *backing) {
+  pool->backing = backing ? backing : cds_default_allocator();
+  pool->allocator.alloc = ncache_alloc_fn;
+  pool->allocator.realloc = ncache_realloc_fn;
+  pool->allocator.free = ncache_free_fn;
+  pool->allocator.state = pool;
+  pool->threads = NULL;
+  pool->chunks = NULL;
+  if (pthread_key_create(&pool->key, ncache_thread_exit) != 0)
+    return CDS_ERR_NO_MEMORY;
+  pthread_mutex_init(&pool->lock, NULL);
+  return CDS_OK;
+}
+
+/**
+ * @brief Returns the allocator to pass to the `_a` functions.
+ */
+static inline const CDSAllocator *ncache_allocator(NCachePool *pool) {
+  return &pool->allocator;
+}
+
+/**
+ * @brief Hands the calling thread's pending remote frees back to their
+ * owners and takes in the blocks handed back to it.
+ *
+ * Call it when a consumer goes idle, so its last partial batch does not
+ * wait for the next free.
+ */
+static inline void ncache_flush(NCachePool *pool) {
+  NCacheThread *t = (NCacheThread *)pthread_getspecific(pool->key);
+  if (t == NULL)
+    return;
+  ncache_flush_batch(t);
+  ncache_drain_remote(t);
+}
+
+/**
+ * @brief Sums the counters of every cache of the pool.
+ */
+static inline NCacheStats ncache_stats(NCachePool *pool) {
+  NCacheStats s = {0, 0, 0, 0};
+  pthread_mutex_lock(&pool->lock);
+  for (NCacheThread *t = pool->threads; t != NULL; t = t->next) {
+    s.threads++;
+    s.chunks += __atomic_load_n(&t->chunks, __ATOMIC_RELAXED);
+    s.remoteFrees += __atomic_load_n(&t->remoteFrees, __ATOMIC_RELAXED);
+    s.remoteBatches += __atomic_load_n(&t->remoteBatches, __ATOMIC_RELAXED);
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return s;
+}
+
+/**
+ * @brief Returns every chunk and cache to the backing allocator.
+ * @note Other threads must have stopped using the pool; blocks still in use
+ * become invalid, except large ones, which are freed individually.
+ */
+static inline void ncache_pool_destroy(NCachePool *pool) {
+  pthread_setspecific(pool->key, NULL);
+  pthread_key_delete(pool->key);
+  while (pool->chunks != NULL) {
+    NCacheChunk *next = pool->chunks->next;
+    cds_free(pool->backing, pool->chunks);
+    pool->chunks = next;
+  }
+  while (pool->threads != NULL) {
+    NCacheThread *next = pool->threads->next;
+    cds_free(pool->backing, pool->threads);
+    pool->threads = next;
+  }
+  pthread_mutex_destroy(&pool->lock);
+}
+
+#endif // NODECACHE_H
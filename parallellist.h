@@ -0,0 +1,459 @@
+#ifndef PARALLELLIST_H
+#define PARALLELLIST_H
+
+#include "generics.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file parallellist.h
+ * @brief Parallel for-each / count / reduce over `Node` and `DLNode` lists
+ * (`par_*`).
+ *
+ * A list cannot be split without walking it, so the work is done in two
+ * steps. par_segments_from_sl() (or the dl/cl variants) makes one cheap
+ * pointer-chasing pass that records every `segmentLen`-th node together with
+ * the segment length. The resulting ParSegments can be kept and reused for as
+ * many passes as needed while the list is not modified. The par_* passes
+ * then hand segments to a ParPool of worker threads; every segment is walked
+ * by count, so singly, doubly and circular lists are handled the same way.
+ *
+ * Reductions use one accumulator per segment and combine them in list order,
+ * so results are deterministic even for non-commutative combine functions.
+ * Every accumulator starts on its own cache line, so workers folding
+ * neighbouring segments do not share lines.
+ */
+
+/** @brief Alignment and padding of per-segment reduction accumulators. */
+#ifndef PAR_CACHE_LINE
+#define PAR_CACHE_LINE 64
+#endif
+
+/**
+ * @brief Callback applied to every payload.
+ */
+typedef void (*ParForEachFn)(void *data, size_t dataLen, void *ctx);
+
+/**
+ * @brief Predicate used by par_count_if().
+ */
+typedef bool (*ParPredicateFn)(const void *data, size_t dataLen, void *ctx);
+
+/**
+ * @brief Folds one payload into an accumulator.
+ */
+typedef void (*ParReduceFn)(void *acc, const void *data, size_t dataLen,
+                            void *ctx);
+
+/**
+ * @brief Folds accumulator `part` into accumulator `acc`.
+ */
+typedef void (*ParCombineFn)(void *acc, const void *part, void *ctx);
+
+/**
+ * @brief Task run by the pool; taskIdx goes from 0 to nTasks - 1.
+ */
+typedef void (*ParTaskFn)(void *arg, size_t taskIdx);
+
+/**
+ * @struct ParPool
+ * @brief Fixed-size pool of worker threads.
+ */
+typedef struct ParPool {
+    pthread_t *threads;     /**< Worker threads */
+    size_t nThreads;        /**< Number of workers */
+    pthread_mutex_t lock;   /**< Protects the job fields below */
+    pthread_cond_t wake;    /**< Signals a new generation or stop */
+    pthread_cond_t done;    /**< Signals that all workers are idle */
+    unsigned long gen;      /**< Incremented for every job */
+    size_t busy;            /**< Workers still running the current job */
+    bool stop;              /**< Set by par_pool_destroy() */
+    ParTaskFn fn;           /**< Current task function */
+    void *arg;              /**< Current task argument */
+    size_t nTasks;          /**< Number of tasks in the current job */
+    size_t nextTask;        /**< Next task to hand out (atomic) */
+} ParPool;
+
+/**
+ * @struct ParSegments
+ * @brief Segment table built by a marker pass over a list.
+ */
+typedef struct ParSegments {
+    void **starts;          /**< First node of every segment */
+    size_t *counts;         /**< Number of nodes in every segment */
+    size_t nSegments;       /**< Number of segments */
+    size_t nNodes;          /**< Total number of nodes */
+    int doubly;             /**< Non-zero for DLNode lists */
+} ParSegments;
+
+static inline void par_run_tasks(ParPool *pool) {
+  size_t i;
+  while ((i = __atomic_fetch_add(&pool->nextTask, 1, __ATOMIC_RELAXED)) <
+         pool->nTasks)
+    pool->fn(pool->arg, i);
+}
+
+static inline void *par_worker(void *p) {
+  ParPool *pool = (ParPool *)p;
+  unsigned long seen = 0;
+  pthread_mutex_lock(&pool->lock);
+  for (;;) {
+    while (!pool->stop && pool->gen == seen)
+      pthread_cond_wait(&pool->wake, &pool->lock);
+    if (pool->stop)
+      break;
+    seen = pool->gen;
+    pthread_mutex_unlock(&pool->lock);
+    par_run_tasks(pool);
+    pthread_mutex_lock(&pool->lock);
+    if (--pool->busy == 0)
+      pthread_cond_signal(&pool->done);
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+/**
+ * @brief Starts a pool.
+ * @param pool Pool to initialize.
+ * @param nThreads Number of worker threads. The calling thread also works
+ * during par_pool_run(), so use the core count minus one; 0 runs everything
+ * on the caller.
+ * @return true on success.
+ */
+static inline bool par_pool_init(ParPool *pool, size_t nThreads) {
+  memset(pool, 0, sizeof(*pool));
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+  pthread_cond_init(&pool->done, NULL);
+  if (nThreads == 0)
+    return true;
+  pool->threads = (pthread_t *)malloc(nThreads * sizeof(pthread_t));
+  if (pool->threads == NULL)
+    return false;
+  for (; pool->nThreads < nThreads; pool->nThreads++) {
+    if (pthread_create(&pool->threads[pool->nThreads], NULL, par_worker,
+                       pool) != 0)
+      break;
+  }
+  return pool->nThreads == nThreads;
+}
+
+/**
+ * @brief Stops and joins all workers.
+ */
+static inline void par_pool_destroy(ParPool *pool) {
+  pthread_mutex_lock(&pool->lock);
+  pool->stop = true;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+  for (size_t i = 0; i < pool->nThreads; i++)
+    pthread_join(pool->threads[i], NULL);
+  free(pool->threads);
+  pthread_cond_destroy(&pool->done);
+  pthread_cond_destroy(&pool->wake);
+  pthread_mutex_destroy(&pool->lock);
+  pool->threads = NULL;
+  pool->nThreads = 0;
+}
+
+/**
+ * @brief Runs fn(arg, i) for every i in [0, nTasks) and waits for all of them.
+ * @note Tasks are handed out dynamically, one at a time.
+ */
+static inline void par_pool_run(ParPool *pool, size_t nTasks, ParTaskFn fn,
+                                void *arg) {
+  pthread_mutex_lock(&pool->lock);
+  pool->fn = fn;
+  pool->arg = arg;
+  pool->nTasks = nTasks;
+  pool->nextTask = 0;
+  pool->busy = pool->nThreads;
+  pool->gen++;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+
+  par_run_tasks(pool);
+
+  pthread_mutex_lock(&pool->lock);
+  while (pool->busy != 0)
+    pthread_cond_wait(&pool->done, &pool->lock);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+static inline void *par_next(const ParSegments *segs, void *node) {
+  return segs->doubly ? (void *)((DLNode *)node)->next
+                      : (void *)((Node *)node)->next;
+}
+
+static inline void par_payload(const ParSegments *segs, void *node,
+                               void **data, size_t *dataLen) {
+  if (segs->doubly) {
+    *data = ((DLNode *)node)->data;
+    *dataLen = ((DLNode *)node)->dataSize;
+  } else {
+    *data = ((Node *)node)->data;
+    *dataLen = ((Node *)node)->dataLen;
+  }
+}
+
+/**
+ * @brief Releases a segment table.
+ */
+static inline void par_segments_free(ParSegments *segs) {
+  free(segs->starts);
+  free(segs->counts);
+  memset(segs, 0, sizeof(*segs));
+}
+
+/**
+ * @brief Shared marker pass. Walks at most maxNodes nodes.
+ */
+static inline bool par_segments_build(ParSegments *segs, void *root,
+                                      size_t maxNodes, size_t segmentLen,
+                                      int doubly) {
+  size_t cap = 16;
+  memset(segs, 0, sizeof(*segs));
+  segs->doubly = doubly;
+  if (segmentLen == 0)
+    segmentLen = 1;
+  segs->starts = (void **)malloc(cap * sizeof(void *));
+  segs->counts = (size_t *)malloc(cap * sizeof(size_t));
+  if (segs->starts == NULL || segs->counts == NULL) {
+    par_segments_free(segs);
+    return false;
+  }
+
+  void *c = root;
+  while (c != NULL && segs->nNodes < maxNodes) {
+    if (segs->nSegments == cap) {
+      cap *= 2;
+      void **s = (void **)realloc(segs->starts, cap * sizeof(void *));
+      if (s == NULL) {
+        par_segments_free(segs);
+        return false;
+      }
+      segs->starts = s;
+      size_t *n = (size_t *)realloc(segs->counts, cap * sizeof(size_t));
+      if (n == NULL) {
+        par_segments_free(segs);
+        return false;
+      }
+      segs->counts = n;
+    }
+    segs->starts[segs->nSegments] = c;
+    size_t k = 0;
+    while (c != NULL && k < segmentLen && segs->nNodes < maxNodes) {
+      c = par_next(segs, c);
+      k++;
+      segs->nNodes++;
+    }
+    segs->counts[segs->nSegments++] = k;
+  }
+  return true;
+}
+
+/**
+ * @brief Builds a segment table for a singly linked list.
+ * @param segs Segment table to fill (release with par_segments_free()).
+ * @param root Root node of the list.
+ * @param segmentLen Nodes per segment. A few thousand keeps scheduling
+ * overhead low while leaving enough segments for load balancing.
+ * @return true on success.
+ */
+static inline bool par_segments_from_sl(ParSegments *segs, Node *root,
+                                        size_t segmentLen) {
+  return par_segments_build(segs, root, SIZE_MAX, segmentLen, 0);
+}
+
+/**
+ * @brief Builds a segment table for a doubly linked list.
+ * @see par_segments_from_sl()
+ */
+static inline bool par_segments_from_dl(ParSegments *segs, DLNode *root,
+                                        size_t segmentLen) {
+  return par_segments_build(segs, root, SIZE_MAX, segmentLen, 1);
+}
+
+/**
+ * @brief Builds a segment table for a circular linked list.
+ * @see par_segments_from_sl()
+ */
+static inline bool par_segments_from_cl(ParSegments *segs, Node *root,
+                                        size_t segmentLen) {
+  size_t n = 0;
+  if (root != NULL) {
+    Node *c = root;
+    do {
+      n++;
+      c = c->next;
+    } while (c != root);
+  }
+  return par_segments_build(segs, root, n, segmentLen, 0);
+}
+
+typedef struct ParJob {
+    const ParSegments *segs;
+    ParForEachFn forEach;
+    ParPredicateFn pred;
+    ParReduceFn reduce;
+    void *ctx;
+    unsigned char *accs;    /* one accumulator per segment */
+    size_t accSize;
+    size_t accStride;       /* accSize rounded up to PAR_CACHE_LINE */
+    size_t *counts;         /* one counter per segment */
+} ParJob;
+
+static inline void par_for_each_task(void *arg, size_t seg) {
+  ParJob *job = (ParJob *)arg;
+  void *c = job->segs->starts[seg];
+  for (size_t i = 0; i < job->segs->counts[seg]; i++) {
+    void *data;
+    size_t len;
+    par_payload(job->segs, c, &data, &len);
+    job->forEach(data, len, job->ctx);
+    c = par_next(job->segs, c);
+  }
+}
+
+static inline void par_count_task(void *arg, size_t seg) {
+  ParJob *job = (ParJob *)arg;
+  void *c = job->segs->starts[seg];
+  size_t n = 0;
+  for (size_t i = 0; i < job->segs->counts[seg]; i++) {
+    void *data;
+    size_t len;
+    par_payload(job->segs, c, &data, &len);
+    n += job->pred(data, len, job->ctx) ? 1 : 0;
+    c = par_next(job->segs, c);
+  }
+  job->counts[seg] = n;
+}
+
+static inline void par_reduce_task(void *arg, size_t seg) {
+  ParJob *job = (ParJob *)arg;
+  void *acc = job->accs + seg * job->accStride;
+  void *c = job->segs->starts[seg];
+  for (size_t i = 0; i < job->segs->counts[seg]; i++) {
+    void *data;
+    size_t len;
+    par_payload(job->segs, c, &data, &len);
+    job->reduce(acc, data, len, job->ctx);
+    c = par_next(job->segs, c);
+  }
+}
+
+/**
+ * @brief Calls fn on every payload in parallel.
+ * @param pool Worker pool.
+ * @param segs Segment table of the list.
+ * @param fn Callback; may modify the payload in place but not the links.
+ * @param ctx User context passed to fn.
+ */
+static inline void par_for_each(ParPool *pool, const ParSegments *segs,
+                                ParForEachFn fn, void *ctx) {
+  ParJob job;
+  memset(&job, 0, sizeof(job));
+  job.segs = segs;
+  job.forEach = fn;
+  job.ctx = ctx;
+  par_pool_run(pool, segs->nSegments, par_for_each_task, &job);
+}
+
+/**
+ * @brief Counts the payloads matching pred in parallel.
+ * @return Number of matches, or SIZE_MAX if memory ran out.
+ */
+static inline size_t par_count_if(ParPool *pool, const ParSegments *segs,
+                                  ParPredicateFn pred, void *ctx) {
+  ParJob job;
+  size_t total = 0;
+  memset(&job, 0, sizeof(job));
+  job.segs = segs;
+  job.pred = pred;
+  job.ctx = ctx;
+  job.counts = (size_t *)calloc(segs->nSegments + 1, sizeof(size_t));
+  if (job.counts == NULL)
+    return SIZE_MAX;
+  par_pool_run(pool, segs->nSegments, par_count_task, &job);
+  for (size_t i = 0; i < segs->nSegments; i++)
+    total += job.counts[i];
+  free(job.counts);
+  return total;
+}
+
+/**
+ * @brief Parallel reduction.
+ * @param pool Worker pool.
+ * @param segs Segment table of the list.
+ * @param accSize Size of the accumulator in bytes.
+ * @param identity Initial accumulator value (accSize bytes).
+ * @param reduce Folds one payload into an accumulator.
+ * @param combine Folds a segment accumulator into the result.
+ * @param ctx User context passed to both callbacks.
+ * @param out Receives the result (accSize bytes).
+ * @return true on success, false if memory ran out.
+ */
+static inline bool par_reduce(ParPool *pool, const ParSegments *segs,
+                              size_t accSize, const void *identity,
+                              ParReduceFn reduce, ParCombineFn combine,
+                              void *ctx, void *out) {
+  ParJob job;
+  memset(&job, 0, sizeof(job));
+  job.segs = segs;
+  job.reduce = reduce;
+  job.ctx = ctx;
+  job.accSize = accSize;
+  job.accStride = (accSize + PAR_CACHE_LINE - 1) / PAR_CACHE_LINE *
+                  PAR_CACHE_LINE;
+  if (job.accStride == 0)
+    job.accStride = PAR_CACHE_LINE;
+  // over-allocate by a line and round the start up to a line boundary
+  unsigned char *block = (unsigned char *)malloc(
+      segs->nSegments * job.accStride + PAR_CACHE_LINE);
+  if (block == NULL)
+    return false;
+  job.accs = block + (PAR_CACHE_LINE - (uintptr_t)block % PAR_CACHE_LINE) %
+                         PAR_CACHE_LINE;
+  for (size_t i = 0; i < segs->nSegments; i++)
+    memcpy(job.accs + i * job.accStride, identity, accSize);
+  par_pool_run(pool, segs->nSegments, par_reduce_task, &job);
+  memcpy(out, identity, accSize);
+  for (size_t i = 0; i < segs->nSegments; i++)
+    combine(out, job.accs + i * job.accStride, ctx);
+  free(block);
+  return true;
+}
+
+/**
+ * @brief Combine helper for uint64_t sums, counts and checksums.
+ */
+static inline void par_combine_sum_u64(void *acc, const void *part,
+                                       void *ctx) {
+  (void)ctx;
+  *(uint64_t *)acc += *(const uint64_t *)part;
+}
+
+/**
+ * @brief Combine helper for double sums.
+ */
+static inline void par_combine_sum_double(void *acc, const void *part,
+                                          void *ctx) {
+  (void)ctx;
+  *(double *)acc += *(const double *)part;
+}
+
+/**
+ * @brief Combine helper for uint64_t XOR checksums.
+ */
+static inline void par_combine_xor_u64(void *acc, const void *part,
+                                       void *ctx) {
+  (void)ctx;
+  *(uint64_t *)acc ^= *(const uint64_t *)part;
+}
+
+#endif // PARALLELLIST_H
@@ -0,0 +1,408 @@
+#ifndef PERSISTENTLIST_H
+#define PERSISTENTLIST_H
+
+#include "generics.h"
+#include "sharedpayload.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @file persistentlist.h
+ * @brief Persistent (immutable) singly linked list (`psl_*`).
+ *
+ * A PSList value is a version of a list. Versions never change once built:
+ * prepending shares the whole old list as the tail, and index updates copy
+ * only the nodes in front of the change (path copying) and share the rest.
+ * Taking a snapshot is a single reference-count increment.
+ *
+ * Nodes are reference counted and freed when the last version using them is
+ * released; payloads are cds_shared_ buffers, so the nodes copied by path
+ * copying share their payloads instead of duplicating them.
+ *
+ * Every PSList returned by a psl_ function owns one reference and must be
+ * given back with psl_release(). Since versions are immutable they can be
+ * read from any number of threads; PSLCell publishes the current version
+ * safely.
+ *
+ * The nodes embed a Node as their first member, so psl_nodes() can be walked
+ * like any singly linked list; it must never be modified through sl_
+ * functions.
+ */
+
+/**
+ * @struct PSLNode
+ * @brief Node of a persistent list. The node must stay the first member.
+ */
+typedef struct PSLNode {
+    Node node;   /**< data is a cds_shared_ buffer; next is a PSLNode */
+    size_t refs; /**< Versions and nodes pointing here (atomic) */
+} PSLNode;
+
+/**
+ * @struct PSList
+ * @brief One version of a persistent list (passed around by value).
+ */
+typedef struct PSList {
+    PSLNode *head; /**< First node, NULL when empty */
+    size_t size;   /**< Number of nodes */
+} PSList;
+
+static inline PSLNode *psl_next(const PSLNode *n) {
+  return (PSLNode *)n->node.next;
+}
+
+static inline PSLNode *psl_node_retain(PSLNode *n) {
+  if (n)
+    __atomic_add_fetch(&n->refs, 1, __ATOMIC_RELAXED);
+  return n;
+}
+
+static inline void psl_node_release(PSLNode *n) {
+  // releasing a node drops its reference on the next one
+  while (n && __atomic_sub_fetch(&n->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+    PSLNode *next = psl_next(n);
+    cds_shared_release(n->node.data);
+    cds_free(NULL, n);
+    n = next;
+  }
+}
+
+// takes over one reference on shared and one on next (both dropped again
+// when out of memory; shared may be a failed NULL allocation)
+static inline PSLNode *psl_node_new(void *shared, size_t dataLen,
+                                    PSLNode *next) {
+  PSLNode *n = shared ? (PSLNode *)cds_alloc(NULL, sizeof(PSLNode)) : NULL;
+  if (n == NULL) {
+    cds_shared_release(shared);
+    psl_node_release(next);
+    return NULL;
+  }
+  n->node.data = shared;
+  n->node.dataLen = dataLen;
+  n->node.next = next ? &next->node : NULL;
+  n->refs = 1;
+  return n;
+}
+
+/**
+ * @brief Returns the empty list.
+ */
+static inline PSList psl_empty(void) {
+  PSList list = {NULL, 0};
+  return list;
+}
+
+/**
+ * @brief Returns a new reference to the same version in O(1).
+ */
+static inline PSList psl_snapshot(const PSList *list) {
+  PSList copy = {psl_node_retain(list->head), list->size};
+  return copy;
+}
+
+/**
+ * @brief Drops a version; nodes no other version uses are freed.
+ * @note The handle is reset to the empty list.
+ */
+static inline void psl_release(PSList *list) {
+  psl_node_release(list->head);
+  list->head = NULL;
+  list->size = 0;
+}
+
+/**
+ * @brief Returns the number of nodes.
+ */
+static inline size_t psl_size(const PSList *list) { return list->size; }
+
+/**
+ * @brief Returns the first node as a Node for read-only traversal.
+ */
+static inline const Node *psl_nodes(const PSList *list) {
+  return list->head ? &list->head->node : NULL;
+}
+
+/**
+ * @brief Returns the data of the first node, or NULL when empty.
+ */
+static inline const void *psl_front(const PSList *list) {
+  return list->head ? list->head->node.data : NULL;
+}
+
+/**
+ * @brief Builds a version with a shared buffer in front, in O(1).
+ * @param data cds_shared_ buffer; a reference is taken.
+ * @param out Receives the new version on success.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY (out is left untouched).
+ */
+static inline CDSStatus psl_prepend_shared(const PSList *list, void *data,
+                                           size_t dataLen, PSList *out) {
+  PSLNode *head = psl_node_new(cds_shared_retain(data), dataLen,
+                               psl_node_retain(list->head));
+  if (head == NULL)
+    return CDS_ERR_NO_MEMORY;
+  out->head = head;
+  out->size = list->size + 1;
+  return CDS_OK;
+}
+
+/**
+ * @brief Builds a version with a copy of data in front, in O(1).
+ *
+ * The data is copied once into a shared buffer; later versions share it.
+ * @param out Receives the new version on success.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY (out is left untouched).
+ */
+static inline CDSStatus psl_prepend(const PSList *list, const void *data,
+                                    size_t dataLen, PSList *out) {
+  PSLNode *head = psl_node_new(cds_shared_from(data, dataLen), dataLen,
+                               psl_node_retain(list->head));
+  if (head == NULL)
+    return CDS_ERR_NO_MEMORY;
+  out->head = head;
+  out->size = list->size + 1;
+  return CDS_OK;
+}
+
+/**
+ * @brief Returns the version without its first node, in O(1).
+ * @note The tail of an empty list is the empty list.
+ */
+static inline PSList psl_tail(const PSList *list) {
+  PSList out = psl_empty();
+  if (list->head) {
+    out.head = psl_node_retain(psl_next(list->head));
+    out.size = list->size - 1;
+  }
+  return out;
+}
+
+// copies nodes [0, idx), links insert (may be NULL), then shares the nodes
+// from idx + skip on; takes over insert, which is released on failure along
+// with the nodes copied so far
+static inline CDSStatus psl_splice(const PSList *list, size_t idx, size_t skip,
+                                   PSLNode *insert, PSList *out) {
+  Node *head = NULL;
+  Node **link = &head;
+  PSLNode *old = list->head;
+  for (size_t i = 0; i < idx; i++) {
+    PSLNode *copy =
+        psl_node_new(cds_shared_retain(old->node.data), old->node.dataLen, NULL);
+    if (copy == NULL) {
+      psl_node_release((PSLNode *)head);
+      psl_node_release(insert);
+      return CDS_ERR_NO_MEMORY;
+    }
+    *link = &copy->node;
+    link = &copy->node.next;
+    old = psl_next(old);
+  }
+  if (insert) {
+    *link = &insert->node;
+    link = &insert->node.next;
+  }
+  for (size_t i = 0; i < skip; i++)
+    old = psl_next(old);
+  psl_node_retain(old);
+  *link = old ? &old->node : NULL;
+  out->head = (PSLNode *)head;
+  out->size = list->size - skip + (insert ? 1 : 0);
+  return CDS_OK;
+}
+
+/**
+ * @brief Builds a version with data inserted at idx (path copying).
+ *
+ * Copies the idx nodes in front of the insertion point; the rest is shared.
+ * @param out Receives the new version on success.
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS (idx > size) or CDS_ERR_NO_MEMORY
+ * (nothing is leaked and out is left untouched).
+ */
+static inline CDSStatus psl_insert_at(const PSList *list, size_t idx,
+                                      const void *data, size_t dataLen,
+                                      PSList *out) {
+  PSLNode *insert;
+  if (idx > list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  insert = psl_node_new(cds_shared_from(data, dataLen), dataLen, NULL);
+  if (insert == NULL)
+    return CDS_ERR_NO_MEMORY;
+  return psl_splice(list, idx, 0, insert, out);
+}
+
+/**
+ * @brief Builds a version with the data at idx replaced (path copying).
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS (idx >= size) or CDS_ERR_NO_MEMORY
+ * (nothing is leaked and out is left untouched).
+ */
+static inline CDSStatus psl_set_at(const PSList *list, size_t idx,
+                                   const void *data, size_t dataLen,
+                                   PSList *out) {
+  PSLNode *insert;
+  if (idx >= list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  insert = psl_node_new(cds_shared_from(data, dataLen), dataLen, NULL);
+  if (insert == NULL)
+    return CDS_ERR_NO_MEMORY;
+  return psl_splice(list, idx, 1, insert, out);
+}
+
+/**
+ * @brief Builds a version without the node at idx (path copying).
+ * @return CDS_OK, CDS_ERR_OUT_OF_BOUNDS (idx >= size) or CDS_ERR_NO_MEMORY
+ * (nothing is leaked and out is left untouched).
+ */
+static inline CDSStatus psl_delete_at(const PSList *list, size_t idx,
+                                      PSList *out) {
+  if (idx >= list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  return psl_splice(list, idx, 1, NULL, out);
+}
+
+/**
+ * @brief Returns the index of the first node whose data matches a value.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NOT_FOUND.
+ */
+static inline CDSStatus psl_try_find(const PSList *list, const void *data,
+                                     size_t dataLen, size_t *idx) {
+  size_t i = 0;
+  if (data == NULL || idx == NULL)
+    return CDS_ERR_NULL;
+  for (const PSLNode *n = list->head; n; n = psl_next(n), i++) {
+    if (n->node.dataLen == dataLen &&
+        memcmp(n->node.data, data, dataLen) == 0) {
+      *idx = i;
+      return CDS_OK;
+    }
+  }
+  return CDS_ERR_NOT_FOUND;
+}
+
+/**
+ * @brief Builds a version without the first node matching a value.
+ * @return CDS_OK, CDS_ERR_NULL, CDS_ERR_NOT_FOUND or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus psl_delete_by_value(const PSList *list,
+                                            const void *data, size_t dataLen,
+                                            PSList *out) {
+  size_t idx;
+  CDSStatus status = psl_try_find(list, data, dataLen, &idx);
+  if (status != CDS_OK)
+    return status;
+  return psl_delete_at(list, idx, out);
+}
+
+/**
+ * @brief Looks up the data at an index without printing.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus psl_try_get_at_index(const PSList *list, size_t idx,
+                                             const void **out) {
+  const PSLNode *n = list->head;
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  if (idx >= list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  while (idx-- > 0)
+    n = psl_next(n);
+  *out = n->node.data;
+  return CDS_OK;
+}
+
+/**
+ * @brief Returns the data at an index, or NULL if out of bounds.
+ * @note Failures go through CDS_DIAGNOSTIC.
+ */
+static inline const void *psl_get_at_index(const PSList *list, size_t idx) {
+  const void *data;
+  CDSStatus status = psl_try_get_at_index(list, idx, &data);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Index out of bounds.\n");
+  return data;
+}
+
+/**
+ * @brief Builds a persistent version from a Node list (payloads copied once).
+ * @param out Receives the new version on success.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY (nothing is leaked and out is left
+ * untouched).
+ */
+static inline CDSStatus psl_from_sl(const Node *root, PSList *out) {
+  size_t size = 0;
+  Node *head = NULL;
+  Node **link = &head;
+  for (const Node *c = root; c; c = c->next) {
+    PSLNode *n = psl_node_new(cds_shared_from(c->data, c->dataLen), c->dataLen,
+                              NULL);
+    if (n == NULL) {
+      psl_node_release((PSLNode *)head);
+      return CDS_ERR_NO_MEMORY;
+    }
+    *link = &n->node;
+    link = &n->node.next;
+    size++;
+  }
+  out->head = (PSLNode *)head;
+  out->size = size;
+  return CDS_OK;
+}
+
+/**
+ * @struct PSLCell
+ * @brief Mutable slot holding the current version, shared between threads.
+ *
+ * The lock is only held for the pointer swap and the reference increment,
+ * so readers taking snapshots never wait for a writer building a version.
+ */
+typedef struct PSLCell {
+    pthread_mutex_t lock; /**< Protects current */
+    PSList current;       /**< Published version */
+} PSLCell;
+
+/**
+ * @brief Initializes a cell with a version (ownership transferred).
+ */
+static inline void psl_cell_init(PSLCell *cell, PSList *initial) {
+  pthread_mutex_init(&cell->lock, NULL);
+  cell->current = *initial;
+  *initial = psl_empty();
+}
+
+/**
+ * @brief Returns a snapshot of the current version (release it when done).
+ */
+static inline PSList psl_cell_load(PSLCell *cell) {
+  PSList snap;
+  pthread_mutex_lock(&cell->lock);
+  snap = psl_snapshot(&cell->current);
+  pthread_mutex_unlock(&cell->lock);
+  return snap;
+}
+
+/**
+ * @brief Publishes a new version (ownership transferred).
+ *
+ * Snapshots of the old version stay valid until they are released.
+ */
+static inline void psl_cell_store(PSLCell *cell, PSList *next) {
+  PSList old;
+  pthread_mutex_lock(&cell->lock);
+  old = cell->current;
+  cell->current = *next;
+  pthread_mutex_unlock(&cell->lock);
+  *next = psl_empty();
+  psl_release(&old);
+}
+
+/**
+ * @brief Releases the cell's version and its lock.
+ */
+static inline void psl_cell_destroy(PSLCell *cell) {
+  psl_release(&cell->current);
+  pthread_mutex_destroy(&cell->lock);
+}
+
+#endif // PERSISTENTLIST_H
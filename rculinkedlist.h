@@ -0,0 +1,402 @@
+#ifndef RCULINKEDLIST_H
+#define RCULINKEDLIST_H
+
+#include "generics.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file rculinkedlist.h
+ * @brief Read-mostly singly linked list with RCU-style reclamation (`rsl_*`).
+ *
+ * Readers register an RSLReader once per thread and bracket lookups with
+ * rsl_read_lock()/rsl_read_unlock(). Those only store into the reader's own
+ * cache line, so there is no atomic read-modify-write and no shared line
+ * bouncing between readers. Writers are serialized by a mutex, build the new
+ * node completely and publish it with a release store.
+ *
+ * A deleted node is unlinked at once but freed only after a grace period:
+ * every reader that could still see it has left its read-side section. The
+ * writer checks this opportunistically after each update; rsl_synchronize()
+ * waits for it.
+ */
+
+#define RSL_CACHE_LINE 64
+
+/**
+ * @struct RSLReader
+ * @brief Per-thread reader registration.
+ * @note Give every thread its own instance (thread-local or on its stack).
+ */
+typedef struct RSLReader {
+    unsigned long epoch;     /**< 0 when outside a read-side section */
+    struct RSLReader *next;  /**< Link in the list of registered readers */
+    char pad[RSL_CACHE_LINE - sizeof(unsigned long) - sizeof(void *)];
+} RSLReader;
+
+/**
+ * @struct RSLRetired
+ * @brief Unlinked node waiting for its grace period.
+ */
+typedef struct RSLRetired {
+    Node *node;              /**< The unlinked node */
+    unsigned long epoch;     /**< Global epoch when it was unlinked */
+    struct RSLRetired *next; /**< Next retired entry */
+} RSLRetired;
+
+/**
+ * @struct RSLList
+ * @brief Handle of an RCU singly linked list.
+ */
+typedef struct RSLList {
+    Node *root;                /**< First node (atomic) */
+    unsigned long epoch;       /**< Global epoch, starts at 1 (atomic) */
+    pthread_mutex_t writeLock; /**< Serializes writers and registration */
+    RSLReader *readers;        /**< Registered readers */
+    RSLRetired *retired;       /**< Nodes waiting for a grace period */
+    const CDSAllocator *alloc; /**< Allocator for nodes and payloads */
+} RSLList;
+
+/**
+ * @brief Initializes an empty list.
+ * @param list List handle.
+ * @param alloc Allocator for nodes and payloads, NULL for the default one.
+ */
+static inline void rsl_init(RSLList *list, const CDSAllocator *alloc) {
+  list->root = NULL;
+  list->epoch = 1;
+  pthread_mutex_init(&list->writeLock, NULL);
+  list->readers = NULL;
+  list->retired = NULL;
+  list->alloc = alloc ? alloc : cds_default_allocator();
+}
+
+/**
+ * @brief Registers a reader thread with the list.
+ * @param list List handle.
+ * @param reader Reader slot owned by the calling thread.
+ */
+static inline void rsl_register_reader(RSLList *list, RSLReader *reader) {
+  reader->epoch = 0;
+  pthread_mutex_lock(&list->writeLock);
+  reader->next = list->readers;
+  list->readers = reader;
+  pthread_mutex_unlock(&list->writeLock);
+}
+
+/**
+ * @brief Unregisters a reader. It must be outside a read-side section.
+ */
+static inline void rsl_unregister_reader(RSLList *list, RSLReader *reader) {
+  pthread_mutex_lock(&list->writeLock);
+  RSLReader **r = &list->readers;
+  while (*r != NULL && *r != reader)
+    r = &(*r)->next;
+  if (*r != NULL)
+    *r = reader->next;
+  pthread_mutex_unlock(&list->writeLock);
+}
+
+/**
+ * @brief Enters a read-side section.
+ * @note Nodes reached inside the section stay valid until rsl_read_unlock().
+ */
+static inline void rsl_read_lock(RSLList *list, RSLReader *reader) {
+  __atomic_store_n(&reader->epoch,
+                   __atomic_load_n(&list->epoch, __ATOMIC_ACQUIRE),
+                   __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Leaves a read-side section.
+ */
+static inline void rsl_read_unlock(RSLList *list, RSLReader *reader) {
+  (void)list;
+  __atomic_store_n(&reader->epoch, 0UL, __ATOMIC_RELEASE);
+}
+
+static inline Node *rsl_deref(Node **p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Returns the first node containing the specified value.
+ * @return Pointer to node or NULL if value not found.
+ * @note Call inside a read-side section.
+ */
+static inline Node *rsl_get_by_value(RSLList *list, void *val, size_t valueLen) {
+  Node *c = rsl_deref(&list->root);
+  while (c != NULL) {
+    if (valueLen == c->dataLen && memcmp(val, c->data, c->dataLen) == 0)
+      return c;
+    c = rsl_deref(&c->next);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Checks if a value exists in the list.
+ * @note Call inside a read-side section.
+ */
+static inline bool rsl_contains(RSLList *list, void *val, size_t valueLen) {
+  return rsl_get_by_value(list, val, valueLen) != NULL;
+}
+
+/**
+ * @brief Returns the node at the specified index.
+ * @return Pointer to node or NULL if out of bounds.
+ * @note Call inside a read-side section.
+ */
+static inline Node *rsl_get_by_index(RSLList *list, int idx) {
+  Node *c = rsl_deref(&list->root);
+  for (int i = 0; c != NULL && i < idx; i++)
+    c = rsl_deref(&c->next);
+  return idx < 0 ? NULL : c;
+}
+
+/**
+ * @brief Returns the data at the specified index.
+ * @return Pointer to data or NULL if out of bounds.
+ * @note Call inside a read-side section.
+ */
+static inline void *rsl_get_at_index(RSLList *list, int idx) {
+  Node *n = rsl_get_by_index(list, idx);
+  return n ? n->data : NULL;
+}
+
+/**
+ * @brief Frees retired nodes whose grace period has elapsed.
+ * @note Caller holds writeLock.
+ */
+static inline void rsl_reclaim_locked(RSLList *list) {
+  unsigned long oldest = (unsigned long)-1;
+  for (RSLReader *r = list->readers; r != NULL; r = r->next) {
+    unsigned long e = __atomic_load_n(&r->epoch, __ATOMIC_ACQUIRE);
+    if (e != 0 && e < oldest)
+      oldest = e;
+  }
+  RSLRetired **p = &list->retired;
+  while (*p != NULL) {
+    RSLRetired *r = *p;
+    if (r->epoch < oldest) {
+      *p = r->next;
+      cds_free(list->alloc, r->node->data);
+      cds_free(list->alloc, r->node);
+      cds_free(list->alloc, r);
+    } else {
+      p = &r->next;
+    }
+  }
+}
+
+/**
+ * @brief Retires an unlinked node and starts a new epoch.
+ * @note Caller holds writeLock.
+ */
+static inline void rsl_retire_locked(RSLList *list, Node *node) {
+  RSLRetired *r = (RSLRetired *)cds_alloc(list->alloc, sizeof(RSLRetired));
+  r->node = node;
+  r->epoch = __atomic_load_n(&list->epoch, __ATOMIC_RELAXED);
+  r->next = list->retired;
+  list->retired = r;
+  __atomic_add_fetch(&list->epoch, 1, __ATOMIC_RELEASE);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  rsl_reclaim_locked(list);
+}
+
+/**
+ * @brief Waits until every node deleted so far has been freed.
+ * @note Must not be called from inside a read-side section.
+ */
+static inline void rsl_synchronize(RSLList *list) {
+  for (;;) {
+    pthread_mutex_lock(&list->writeLock);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    rsl_reclaim_locked(list);
+    bool done = list->retired == NULL;
+    pthread_mutex_unlock(&list->writeLock);
+    if (done)
+      return;
+    sched_yield();
+  }
+}
+
+static inline Node *rsl_new_node(RSLList *list, void *data, size_t dataLen) {
+  Node *n = (Node *)cds_alloc(list->alloc, sizeof(Node));
+  n->data = data;
+  n->dataLen = dataLen;
+  n->next = NULL;
+  return n;
+}
+
+static inline void *rsl_dup(RSLList *list, void *data, size_t dataLen) {
+  void *copy;
+  if (data == NULL || dataLen == 0)
+    return NULL;
+  copy = cds_alloc(list->alloc, dataLen);
+  memmove(copy, data, dataLen);
+  return copy;
+}
+
+/**
+ * @brief Publishes a fully built node at link (writeLock held).
+ */
+static inline void rsl_publish_locked(Node **link, Node *n) {
+  n->next = *link;
+  __atomic_store_n(link, n, __ATOMIC_RELEASE);
+}
+
+static inline void rsl_push_front_node(RSLList *list, Node *n) {
+  pthread_mutex_lock(&list->writeLock);
+  rsl_publish_locked(&list->root, n);
+  pthread_mutex_unlock(&list->writeLock);
+}
+
+static inline void rsl_push_back_node(RSLList *list, Node *n) {
+  pthread_mutex_lock(&list->writeLock);
+  Node **link = &list->root;
+  while (*link != NULL)
+    link = &(*link)->next;
+  rsl_publish_locked(link, n);
+  pthread_mutex_unlock(&list->writeLock);
+}
+
+/**
+ * @brief Prepends data to the start of the list using move semantics.
+ * @note The data must come from the list's allocator.
+ */
+static inline void rsl_push_front_mv_data(RSLList *list, void **data,
+                                          size_t dataLen) {
+  rsl_push_front_node(list, rsl_new_node(list, move(data), dataLen));
+}
+
+/**
+ * @brief Prepends data to the start of the list using deep copy.
+ */
+static inline void rsl_push_front_cp_data_deep(RSLList *list, void *data,
+                                               size_t dataLen) {
+  rsl_push_front_node(
+      list, rsl_new_node(list, rsl_dup(list, data, dataLen), dataLen));
+}
+
+/**
+ * @brief Appends data to the end of the list using move semantics.
+ * @note The data must come from the list's allocator.
+ */
+static inline void rsl_push_back_mv_data(RSLList *list, void **data,
+                                         size_t dataLen) {
+  rsl_push_back_node(list, rsl_new_node(list, move(data), dataLen));
+}
+
+/**
+ * @brief Appends data to the end of the list using deep copy.
+ */
+static inline void rsl_push_back_cp_data_deep(RSLList *list, void *data,
+                                              size_t dataLen) {
+  rsl_push_back_node(list,
+                     rsl_new_node(list, rsl_dup(list, data, dataLen), dataLen));
+}
+
+/**
+ * @brief Inserts data at a specific index using deep copy.
+ * @return true if inserted, false if idx is out of bounds.
+ */
+static inline bool rsl_insert_at_index_deep_cp_data(RSLList *list, void *data,
+                                                    size_t dataLen, int idx) {
+  if (idx < 0)
+    return false;
+  pthread_mutex_lock(&list->writeLock);
+  Node **link = &list->root;
+  int i = 0;
+  for (; *link != NULL && i < idx; i++)
+    link = &(*link)->next;
+  bool ok = i == idx;
+  if (ok) {
+    Node *n = rsl_new_node(list, rsl_dup(list, data, dataLen), dataLen);
+    rsl_publish_locked(link, n);
+  }
+  pthread_mutex_unlock(&list->writeLock);
+  return ok;
+}
+
+/**
+ * @brief Unlinks *link and retires the node (writeLock held).
+ */
+static inline void rsl_unlink_locked(RSLList *list, Node **link) {
+  Node *victim = *link;
+  __atomic_store_n(link, victim->next, __ATOMIC_RELEASE);
+  rsl_retire_locked(list, victim);
+}
+
+/**
+ * @brief Deletes the node at the specified index.
+ * @return true if a node was deleted.
+ * @note The node is freed after a grace period.
+ */
+static inline bool rsl_delete_at_index(RSLList *list, int idx) {
+  if (idx < 0)
+    return false;
+  pthread_mutex_lock(&list->writeLock);
+  Node **link = &list->root;
+  for (int i = 0; *link != NULL && i < idx; i++)
+    link = &(*link)->next;
+  bool ok = *link != NULL;
+  if (ok)
+    rsl_unlink_locked(list, link);
+  pthread_mutex_unlock(&list->writeLock);
+  return ok;
+}
+
+/**
+ * @brief Deletes the first node containing the specified value.
+ * @return true if a node was deleted.
+ * @note The node is freed after a grace period.
+ */
+static inline bool rsl_delete_by_value(RSLList *list, void *val,
+                                       size_t dataLen) {
+  if (val == NULL || dataLen == 0)
+    return false;
+  pthread_mutex_lock(&list->writeLock);
+  Node **link = &list->root;
+  while (*link != NULL && !((*link)->dataLen == dataLen &&
+                            memcmp((*link)->data, val, dataLen) == 0))
+    link = &(*link)->next;
+  bool ok = *link != NULL;
+  if (ok)
+    rsl_unlink_locked(list, link);
+  pthread_mutex_unlock(&list->writeLock);
+  return ok;
+}
+
+/**
+ * @brief Frees all nodes, including those still waiting for a grace period,
+ * and destroys the write lock; rsl_init() before reuse.
+ * @note No reader may be inside a read-side section.
+ */
+static inline void rsl_free_list(RSLList *list) {
+  pthread_mutex_lock(&list->writeLock);
+  Node *c = list->root;
+  while (c != NULL) {
+    Node *next = c->next;
+    cds_free(list->alloc, c->data);
+    cds_free(list->alloc, c);
+    c = next;
+  }
+  list->root = NULL;
+  while (list->retired != NULL) {
+    RSLRetired *r = list->retired;
+    list->retired = r->next;
+    cds_free(list->alloc, r->node->data);
+    cds_free(list->alloc, r->node);
+    cds_free(list->alloc, r);
+  }
+  pthread_mutex_unlock(&list->writeLock);
+  pthread_mutex_destroy(&list->writeLock);
+}
+
+#endif // RCULINKEDLIST_H
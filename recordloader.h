@@ -0,0 +1,610 @@
+#ifndef RECORDLOADER_H
+#define RECORDLOADER_H
+
+#include "generics.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @file recordloader.h
+ * @brief Streaming loader that builds lists from record files (`rl_*`).
+ *
+ * Records are newline-delimited lines, records with a 32-bit little-endian
+ * length prefix, or the packed format written by the `*_to_packed`
+ * functions. The file is either mapped and parsed in place, or read in
+ * large blocks by a reader thread into two buffers: while the caller's
+ * thread parses one buffer the reader fills the other, so I/O overlaps
+ * parsing. A record that straddles two buffers is stitched together in a
+ * carry buffer.
+ *
+ * rl_load_sl() and rl_load_dl() append every record to a list through a
+ * tail pointer kept by the loader, so each record costs one node and one
+ * payload allocation and no list walk. Pass an ncache_allocator() (see
+ * nodecache.h) to their `_a` variants to carve those allocations out of
+ * large chunks. rl_load_fd() and rl_load_file() hand each record to a
+ * callback instead.
+ *
+ * Backpressure is natural: the reader thread never runs more than one
+ * buffer ahead, so a backpressure callback that blocks until the consumer
+ * catches up also stops the reads.
+ */
+
+/** @brief Default size of each of the two read buffers. */
+#define RL_DEFAULT_BUFFER (4u << 20)
+
+/**
+ * @enum RLFormat
+ * @brief Record framing of the input.
+ */
+typedef enum RLFormat {
+    RL_LINES = 0,    /**< '\n'-terminated, a trailing '\r' is dropped */
+    RL_U32_PREFIXED, /**< uint32 little-endian length, then the payload */
+    RL_PACKED        /**< cds_packed_record_size() records (size_t length) */
+} RLFormat;
+
+/**
+ * @brief Receives a record; the data is only valid during the call.
+ * @return false to stop loading.
+ */
+typedef bool (*RLRecordFn)(const void *data, size_t len, void *ctx);
+
+/**
+ * @brief Reports progress after every parsed block.
+ */
+typedef void (*RLProgressFn)(uint64_t bytes, uint64_t records, void *ctx);
+
+/**
+ * @brief Called after every parsed block; may block to throttle the
+ * loader.
+ * @return false to stop loading.
+ */
+typedef bool (*RLBackpressureFn)(uint64_t records, void *ctx);
+
+/**
+ * @struct RLOptions
+ * @brief Loader settings; start from rl_default_options().
+ */
+typedef struct RLOptions {
+    RLFormat format;               /**< Record framing */
+    size_t bufferSize;             /**< Bytes per read buffer */
+    bool useMmap;                  /**< Map regular files instead of reading */
+    RLProgressFn progress;         /**< May be NULL */
+    RLBackpressureFn backpressure; /**< May be NULL */
+    void *ctx;                     /**< Passed to progress and backpressure */
+} RLOptions;
+
+/**
+ * @struct RLStats
+ * @brief What a load consumed.
+ */
+typedef struct RLStats {
+    uint64_t bytes;   /**< Input bytes parsed */
+    uint64_t records; /**< Records delivered */
+    bool stopped;     /**< A callback asked to stop */
+    bool truncated;   /**< The input ended inside a record, which was dropped,
+                           or a length prefix could not be framed */
+} RLStats;
+
+/**
+ * @brief Returns the default options for a format: threaded reads into
+ * two RL_DEFAULT_BUFFER buffers, no callbacks.
+ */
+static inline RLOptions rl_default_options(RLFormat format) {
+  RLOptions opt;
+  opt.format = format;
+  opt.bufferSize = RL_DEFAULT_BUFFER;
+  opt.useMmap = false;
+  opt.progress = NULL;
+  opt.backpressure = NULL;
+  opt.ctx = NULL;
+  return opt;
+}
+
+// parser state shared by the mmap and the buffered paths
+typedef struct RLParser {
+    RLFormat format;
+    RLRecordFn fn;
+    void *fnCtx;
+    unsigned char *carry; // partial record from the previous block
+    size_t carryLen;
+    size_t carryCap;
+    bool stopped;
+    bool noMemory;
+    bool corrupt; // a length prefix larger than any record can be
+    RLStats stats;
+} RLParser;
+
+static inline size_t rl_header_size(RLFormat format) {
+  return format == RL_U32_PREFIXED ? 4 : sizeof(size_t);
+}
+
+static inline size_t rl_payload_len(RLFormat format, const unsigned char *p) {
+  if (format == RL_U32_PREFIXED)
+    return (size_t)p[0] | (size_t)p[1] << 8 | (size_t)p[2] << 16 |
+           (size_t)p[3] << 24;
+  size_t len;
+  memcpy(&len, p, sizeof(size_t));
+  return len;
+}
+
+// bytes a record occupies in the stream, padding included; 0 when that
+// does not fit in a size_t (a corrupt length prefix)
+static inline size_t rl_record_size(RLFormat format, size_t len) {
+  size_t over = rl_header_size(format) +
+                (format == RL_PACKED ? sizeof(size_t) - 1 : 0);
+  if (len > SIZE_MAX - over)
+    return 0;
+  return format == RL_PACKED ? cds_packed_record_size(len) : 4 + len;
+}
+
+// nothing after a corrupt length can be framed: drop the rest of the input
+static inline void rl_corrupt(RLParser *ps) {
+  ps->corrupt = ps->stopped = true;
+  ps->stats.truncated = true;
+  ps->carryLen = 0;
+}
+
+static inline void rl_emit(RLParser *ps, const unsigned char *data,
+                           size_t len) {
+  if (ps->format == RL_LINES && len > 0 && data[len - 1] == '\r')
+    len--;
+  ps->stats.records++;
+  if (!ps->fn(data, len, ps->fnCtx))
+    ps->stopped = true;
+}
+
+static inline bool rl_carry_append(RLParser *ps, const unsigned char *p,
+                                   size_t n) {
+  if (ps->carryLen + n > ps->carryCap) {
+    size_t cap = ps->carryCap ? ps->carryCap : 256;
+    unsigned char *grown;
+    while (cap < ps->carryLen + n)
+      cap *= 2;
+    grown = (unsigned char *)cds_realloc(NULL, ps->carry, cap);
+    if (grown == NULL) {
+      ps->noMemory = ps->stopped = true;
+      return false;
+    }
+    ps->carry = grown;
+    ps->carryCap = cap;
+  }
+  memcpy(ps->carry + ps->carryLen, p, n);
+  ps->carryLen += n;
+  return true;
+}
+
+// completes the carried record from p; returns the bytes of p it used
+static inline size_t rl_finish_carry(RLParser *ps, const unsigned char *p,
+                                     size_t n) {
+  size_t used = 0;
+  if (ps->format == RL_LINES) {
+    const unsigned char *nl = (const unsigned char *)memchr(p, '\n', n);
+    size_t take = nl ? (size_t)(nl - p) : n;
+    if (!rl_carry_append(ps, p, take))
+      return n;
+    if (nl == NULL)
+      return n;
+    rl_emit(ps, ps->carry, ps->carryLen);
+    ps->carryLen = 0;
+    return take + 1;
+  }
+  size_t hdr = rl_header_size(ps->format);
+  if (ps->carryLen < hdr) {
+    size_t take = hdr - ps->carryLen < n ? hdr - ps->carryLen : n;
+    if (!rl_carry_append(ps, p, take))
+      return n;
+    used = take;
+    if (ps->carryLen < hdr)
+      return used;
+  }
+  size_t len = rl_payload_len(ps->format, ps->carry);
+  size_t total = rl_record_size(ps->format, len);
+  if (total == 0) {
+    rl_corrupt(ps);
+    return n;
+  }
+  size_t take = total - ps->carryLen < n - used ? total - ps->carryLen
+                                                : n - used;
+  if (!rl_carry_append(ps, p + used, take))
+    return n;
+  used += take;
+  if (ps->carryLen == total) {
+    rl_emit(ps, ps->carry + hdr, len);
+    ps->carryLen = 0;
+  }
+  return used;
+}
+
+// parses one block; an incomplete last record is carried over
+static inline void rl_parse(RLParser *ps, const unsigned char *p, size_t n) {
+  size_t pos = 0;
+  ps->stats.bytes += n;
+  while (ps->carryLen > 0 && pos < n && !ps->stopped)
+    pos += rl_finish_carry(ps, p + pos, n - pos);
+  if (ps->format == RL_LINES) {
+    while (pos < n && !ps->stopped) {
+      const unsigned char *nl =
+          (const unsigned char *)memchr(p + pos, '\n', n - pos);
+      if (nl == NULL)
+        break;
+      rl_emit(ps, p + pos, (size_t)(nl - (p + pos)));
+      pos = (size_t)(nl - p) + 1;
+    }
+  } else {
+    size_t hdr = rl_header_size(ps->format);
+    while (n - pos >= hdr && !ps->stopped) {
+      size_t len = rl_payload_len(ps->format, p + pos);
+      size_t total = rl_record_size(ps->format, len);
+      if (total == 0) {
+        rl_corrupt(ps);
+        break;
+      }
+      if (len > n - pos - hdr || total > n - pos)
+        break;
+      rl_emit(ps, p + pos + hdr, len);
+      pos += total;
+    }
+  }
+  if (pos < n && !ps->stopped)
+    rl_carry_append(ps, p + pos, n - pos);
+}
+
+// flushes what is left at the end of the input
+static inline void rl_parse_end(RLParser *ps) {
+  if (ps->stopped || ps->carryLen == 0)
+    return;
+  if (ps->format == RL_LINES) {
+    rl_emit(ps, ps->carry, ps->carryLen); // last line without '\n'
+  } else if (ps->format == RL_PACKED && ps->carryLen >= sizeof(size_t) &&
+             ps->carryLen - sizeof(size_t) >=
+                 rl_payload_len(ps->format, ps->carry)) {
+    // the last packed record may come without its padding
+    rl_emit(ps, ps->carry + sizeof(size_t),
+            rl_payload_len(ps->format, ps->carry));
+  } else {
+    ps->stats.truncated = true; // header or payload cut short
+  }
+  ps->carryLen = 0;
+}
+
+static inline bool rl_after_block(RLParser *ps, const RLOptions *opt) {
+  if (opt->progress)
+    opt->progress(ps->stats.bytes, ps->stats.records, opt->ctx);
+  if (!ps->stopped && opt->backpressure &&
+      !opt->backpressure(ps->stats.records, opt->ctx))
+    ps->stopped = true;
+  return !ps->stopped;
+}
+
+// reads until the buffer is full or the input ends; -1 on error
+static inline ssize_t rl_read_full(int fd, unsigned char *buf, size_t cap) {
+  size_t got = 0;
+  while (got < cap) {
+    ssize_t n = read(fd, buf + got, cap - got);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return -1;
+    }
+    if (n == 0)
+      break;
+    got += (size_t)n;
+  }
+  return (ssize_t)got;
+}
+
+typedef struct RLReader {
+    int fd;
+    size_t cap;
+    unsigned char *buf[2];
+    ssize_t len[2];  // bytes in each buffer, 0 at the end, -1 on error
+    bool full[2];    // filled and not yet parsed
+    bool quit;       // the parser stopped early
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} RLReader;
+
+static inline void *rl_reader_main(void *arg) {
+  RLReader *r = (RLReader *)arg;
+  for (int i = 0;; i ^= 1) {
+    ssize_t n;
+    pthread_mutex_lock(&r->lock);
+    while (r->full[i] && !r->quit)
+      pthread_cond_wait(&r->cond, &r->lock);
+    bool quit = r->quit;
+    pthread_mutex_unlock(&r->lock);
+    if (quit)
+      return NULL;
+    n = rl_read_full(r->fd, r->buf[i], r->cap);
+    pthread_mutex_lock(&r->lock);
+    r->len[i] = n;
+    r->full[i] = true;
+    pthread_cond_broadcast(&r->cond);
+    pthread_mutex_unlock(&r->lock);
+    if (n <= 0)
+      return NULL;
+  }
+}
+
+static inline CDSStatus rl_load_buffered(int fd, const RLOptions *opt,
+                                         RLParser *ps) {
+  RLReader r;
+  pthread_t thread;
+  bool threaded;
+  CDSStatus status = CDS_OK;
+  memset(&r, 0, sizeof(r));
+  r.fd = fd;
+  r.cap = opt->bufferSize ? opt->bufferSize : RL_DEFAULT_BUFFER;
+  r.buf[0] = (unsigned char *)cds_alloc(NULL, r.cap);
+  r.buf[1] = (unsigned char *)cds_alloc(NULL, r.cap);
+  if (r.buf[0] == NULL || r.buf[1] == NULL) {
+    cds_free(NULL, r.buf[0]);
+    cds_free(NULL, r.buf[1]);
+    return CDS_ERR_NO_MEMORY;
+  }
+  pthread_mutex_init(&r.lock, NULL);
+  pthread_cond_init(&r.cond, NULL);
+  threaded = pthread_create(&thread, NULL, rl_reader_main, &r) == 0;
+  for (int i = 0;; i ^= 1) {
+    ssize_t n;
+    if (threaded) {
+      pthread_mutex_lock(&r.lock);
+      while (!r.full[i])
+        pthread_cond_wait(&r.cond, &r.lock);
+      n = r.len[i];
+      pthread_mutex_unlock(&r.lock);
+    } else {
+      n = rl_read_full(fd, r.buf[i], r.cap); // no thread: read in turn
+    }
+    if (n < 0)
+      status = CDS_ERR_IO;
+    if (n <= 0)
+      break;
+    rl_parse(ps, r.buf[i], (size_t)n);
+    bool more = rl_after_block(ps, opt);
+    pthread_mutex_lock(&r.lock);
+    r.full[i] = false;
+    r.quit = !more;
+    pthread_cond_broadcast(&r.cond);
+    pthread_mutex_unlock(&r.lock);
+    if (!more || (size_t)n < r.cap)
+      break;
+  }
+  if (threaded) {
+    pthread_mutex_lock(&r.lock);
+    r.quit = true;
+    pthread_cond_broadcast(&r.cond);
+    pthread_mutex_unlock(&r.lock);
+    pthread_join(thread, NULL);
+  }
+  pthread_cond_destroy(&r.cond);
+  pthread_mutex_destroy(&r.lock);
+  cds_free(NULL, r.buf[0]);
+  cds_free(NULL, r.buf[1]);
+  return status;
+}
+
+// maps a regular file from the page boundary at or before the current
+// offset, parses it from the current offset in bufferSize steps and leaves
+// the offset after the parsed bytes; false if mmap fails
+static inline bool rl_load_mapped(int fd, const RLOptions *opt, RLParser *ps) {
+  struct stat st;
+  unsigned char *map;
+  off_t start, base;
+  long page = sysconf(_SC_PAGESIZE);
+  size_t size, skip, off,
+      step = opt->bufferSize ? opt->bufferSize : RL_DEFAULT_BUFFER;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    return false;
+  start = lseek(fd, 0, SEEK_CUR);
+  if (start < 0 || start >= st.st_size)
+    return false;
+  // mmap offsets must be page aligned
+  base = page > 0 ? start - start % page : start;
+  skip = (size_t)(start - base);
+  size = (size_t)(st.st_size - base);
+  map = (unsigned char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, base);
+  if (map == MAP_FAILED)
+    return false;
+#if defined(MADV_SEQUENTIAL)
+  madvise(map, size, MADV_SEQUENTIAL);
+#elif defined(POSIX_MADV_SEQUENTIAL)
+  posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);
+#endif
+  for (off = skip; off < size;) {
+    size_t n = size - off < step ? size - off : step;
+    rl_parse(ps, map + off, n);
+    off += n;
+    if (!rl_after_block(ps, opt))
+      break;
+  }
+  munmap(map, size);
+  lseek(fd, base + (off_t)off, SEEK_SET);
+  return true;
+}
+
+/**
+ * @brief Streams the records of an open file to a callback.
+ * @param fd File descriptor positioned at the first record (not closed).
+ * @param opt Options, NULL for rl_default_options(RL_LINES).
+ * @param fn Receives every record in file order.
+ * @param stats Receives the counters (may be NULL).
+ * @return CDS_OK (also when a callback stopped the load), CDS_ERR_NULL,
+ * CDS_ERR_IO or CDS_ERR_NO_MEMORY. A prefixed or packed input that ends in
+ * the middle of a record, or whose length prefix is too large to describe
+ * a record, is CDS_ERR_IO with stats->truncated set; the records before it
+ * have been delivered.
+ */
+static inline CDSStatus rl_load_fd(int fd, const RLOptions *opt,
+                                   RLRecordFn fn, void *fnCtx,
+                                   RLStats *stats) {
+  RLOptions def = rl_default_options(RL_LINES);
+  RLParser ps;
+  CDSStatus status = CDS_OK;
+  if (fn == NULL)
+    return CDS_ERR_NULL;
+  if (opt == NULL)
+    opt = &def;
+  memset(&ps, 0, sizeof(ps));
+  ps.format = opt->format;
+  ps.fn = fn;
+  ps.fnCtx = fnCtx;
+  if (!opt->useMmap || !rl_load_mapped(fd, opt, &ps))
+    status = rl_load_buffered(fd, opt, &ps);
+  rl_parse_end(&ps);
+  cds_free(NULL, ps.carry);
+  if (status == CDS_OK && ps.noMemory)
+    status = CDS_ERR_NO_MEMORY;
+  if (status == CDS_OK && ps.stats.truncated)
+    status = CDS_ERR_IO;
+  ps.stats.stopped = ps.stopped && !ps.corrupt;
+  if (stats)
+    *stats = ps.stats;
+  return status;
+}
+
+/**
+ * @brief Streams the records of a file to a callback.
+ * @see rl_load_fd()
+ */
+static inline CDSStatus rl_load_file(const char *path, const RLOptions *opt,
+                                     RLRecordFn fn, void *fnCtx,
+                                     RLStats *stats) {
+  int fd;
+  CDSStatus status;
+  if (path == NULL)
+    return CDS_ERR_NULL;
+  fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return CDS_ERR_IO;
+  status = rl_load_fd(fd, opt, fn, fnCtx, stats);
+  close(fd);
+  return status;
+}
+
+typedef struct RLListSink {
+    Node **tail;     // sl: link to fill next
+    DLNode **root;   // dl: root of the list
+    DLNode *dlTail;  // dl: last node
+    const CDSAllocator *alloc;
+    bool noMemory;
+} RLListSink;
+
+static inline void *rl_copy_payload(RLListSink *s, const void *data,
+                                    size_t len) {
+  void *copy = cds_alloc(s->alloc, len ? len : 1);
+  if (copy != NULL && len > 0)
+    memcpy(copy, data, len);
+  return copy;
+}
+
+static inline bool rl_sl_sink(const void *data, size_t len, void *ctx) {
+  RLListSink *s = (RLListSink *)ctx;
+  Node *n = (Node *)cds_alloc(s->alloc, sizeof(Node));
+  void *copy = n ? rl_copy_payload(s, data, len) : NULL;
+  if (copy == NULL) {
+    cds_free(s->alloc, n);
+    s->noMemory = true;
+    return false;
+  }
+  n->data = copy;
+  n->dataLen = len;
+  n->next = NULL;
+  *s->tail = n;
+  s->tail = &n->next;
+  return true;
+}
+
+static inline bool rl_dl_sink(const void *data, size_t len, void *ctx) {
+  RLListSink *s = (RLListSink *)ctx;
+  DLNode *n = (DLNode *)cds_alloc(s->alloc, sizeof(DLNode));
+  void *copy = n ? rl_copy_payload(s, data, len) : NULL;
+  if (copy == NULL) {
+    cds_free(s->alloc, n);
+    s->noMemory = true;
+    return false;
+  }
+  n->data = copy;
+  n->dataSize = len;
+  n->next = NULL;
+  n->previous = s->dlTail;
+  if (s->dlTail)
+    s->dlTail->next = n;
+  else
+    *s->root = n;
+  s->dlTail = n;
+  return true;
+}
+
+/**
+ * @brief Allocator-aware variant of rl_load_sl().
+ * @param alloc Allocator for the nodes and payloads (e.g. an
+ * ncache_allocator()).
+ */
+static inline CDSStatus rl_load_sl_a(const char *path, const RLOptions *opt,
+                                     Node **rootPtrPtr, RLStats *stats,
+                                     const CDSAllocator *alloc) {
+  RLListSink s;
+  CDSStatus status;
+  memset(&s, 0, sizeof(s));
+  s.tail = rootPtrPtr;
+  while (*s.tail != NULL)
+    s.tail = &(*s.tail)->next;
+  s.alloc = alloc;
+  status = rl_load_file(path, opt, rl_sl_sink, &s, stats);
+  return status == CDS_OK && s.noMemory ? CDS_ERR_NO_MEMORY : status;
+}
+
+/**
+ * @brief Appends every record of a file to a singly linked list.
+ *
+ * Each payload is a deep copy of the record (without the line terminator
+ * or length prefix).
+ * @param rootPtrPtr Pointer to the root node pointer; the end of an existing
+ * list is found once.
+ * @param stats Receives the counters (may be NULL).
+ * @return CDS_OK, CDS_ERR_NULL, CDS_ERR_IO or CDS_ERR_NO_MEMORY; records
+ * appended before an error stay in the list.
+ */
+static inline CDSStatus rl_load_sl(const char *path, const RLOptions *opt,
+                                   Node **rootPtrPtr, RLStats *stats) {
+  return rl_load_sl_a(path, opt, rootPtrPtr, stats, cds_default_allocator());
+}
+
+/**
+ * @brief Allocator-aware variant of rl_load_dl().
+ * @param alloc Allocator for the nodes and payloads.
+ */
+static inline CDSStatus rl_load_dl_a(const char *path, const RLOptions *opt,
+                                     DLNode **root, RLStats *stats,
+                                     const CDSAllocator *alloc) {
+  RLListSink s;
+  CDSStatus status;
+  memset(&s, 0, sizeof(s));
+  s.root = root;
+  s.dlTail = *root;
+  while (s.dlTail != NULL && s.dlTail->next != NULL)
+    s.dlTail = s.dlTail->next;
+  s.alloc = alloc;
+  status = rl_load_file(path, opt, rl_dl_sink, &s, stats);
+  return status == CDS_OK && s.noMemory ? CDS_ERR_NO_MEMORY : status;
+}
+
+/**
+ * @brief Appends every record of a file to a doubly linked list.
+ * @see rl_load_sl()
+ */
+static inline CDSStatus rl_load_dl(const char *path, const RLOptions *opt,
+                                   DLNode **root, RLStats *stats) {
+  return rl_load_dl_a(path, opt, root, stats, cds_default_allocator());
+}
+
+#endif // RECORDLOADER_H
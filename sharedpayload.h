@@ -0,0 +1,266 @@
+#ifndef SHAREDPAYLOAD_H
+#define SHAREDPAYLOAD_H
+
+#include "circularlinkedlist.h"
+#include "doublelinkedlist.h"
+#include "generics.h"
+#include "linkedlist.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @file sharedpayload.h
+ * @brief Reference-counted payloads shared between lists (`cds_shared_*`).
+ *
+ * A shared buffer carries an atomic reference count in a small header in
+ * front of the data. The same buffer can sit on any number of lists; every
+ * insert through a `*_shared_data` function takes a reference and every
+ * delete or free drops one, and the last release frees the buffer. This
+ * replaces the malloc + memmove of the `*_deep_cp_*` variants with one
+ * atomic increment.
+ *
+ * Releasing goes through an allocator: cds_shared_allocator() returns one
+ * whose free() drops a reference instead of freeing outright. A list holding
+ * shared payloads must therefore use that allocator for all its `_a` calls
+ * (delete, free_list, ...). Its nodes are allocated from it too and simply
+ * start with a count of 1, so the existing list code needs no special
+ * cases; any payload deep-copied into such a list also becomes a shared
+ * buffer.
+ */
+
+/**
+ * @union CDSSharedHeader
+ * @brief Header stored in front of every shared buffer.
+ */
+typedef union CDSSharedHeader {
+    struct {
+        size_t refs; /**< Reference count (atomic) */
+        size_t size; /**< Usable size of the buffer */
+    } h;
+    long double alignLd; /**< Keeps the data maximally aligned */
+    void *alignPtr;
+    long long alignLl;
+} CDSSharedHeader;
+
+static inline CDSSharedHeader *cds_shared_header(const void *data) {
+  return (CDSSharedHeader *)data - 1;
+}
+
+static inline void *cds_shared_alloc_fn(void *state, size_t size) {
+  CDSSharedHeader *hdr = (CDSSharedHeader *)cds_alloc(
+      (const CDSAllocator *)state, sizeof(CDSSharedHeader) + size);
+  if (hdr == NULL)
+    return NULL;
+  hdr->h.refs = 1;
+  hdr->h.size = size;
+  return hdr + 1;
+}
+
+static inline void cds_shared_free_fn(void *state, void *ptr) {
+  CDSSharedHeader *hdr = cds_shared_header(ptr);
+  if (__atomic_sub_fetch(&hdr->h.refs, 1, __ATOMIC_ACQ_REL) == 0)
+    cds_free((const CDSAllocator *)state, hdr);
+}
+
+static inline void *cds_shared_realloc_fn(void *state, void *ptr,
+                                          size_t size) {
+  CDSSharedHeader *hdr;
+  void *copy;
+  if (ptr == NULL)
+    return cds_shared_alloc_fn(state, size);
+  hdr = cds_shared_header(ptr);
+  if (__atomic_load_n(&hdr->h.refs, __ATOMIC_ACQUIRE) == 1) {
+    hdr = (CDSSharedHeader *)cds_realloc((const CDSAllocator *)state, hdr,
+                                         sizeof(CDSSharedHeader) + size);
+    if (hdr == NULL)
+      return NULL;
+    hdr->h.size = size;
+    return hdr + 1;
+  }
+  // other holders keep the old contents; this caller gets a private copy
+  copy = cds_shared_alloc_fn(state, size);
+  if (copy == NULL)
+    return NULL;
+  memcpy(copy, ptr, hdr->h.size < size ? hdr->h.size : size);
+  cds_shared_free_fn(state, ptr);
+  return copy;
+}
+
+/**
+ * @brief Builds an allocator handing out reference-counted blocks.
+ * @param out Allocator to fill in.
+ * @param backing Allocator for the underlying memory, NULL for the default
+ * one. Must outlive every block.
+ */
+static inline void cds_shared_allocator_init(CDSAllocator *out,
+                                             const CDSAllocator *backing) {
+  out->alloc = cds_shared_alloc_fn;
+  out->realloc = cds_shared_realloc_fn;
+  out->free = cds_shared_free_fn;
+  out->state = (void *)(backing ? backing : cds_default_allocator());
+}
+
+/**
+ * @brief Returns the shared allocator backed by malloc/realloc/free.
+ */
+static inline const CDSAllocator *cds_shared_allocator(void) {
+  static const CDSAllocator shared = {cds_shared_alloc_fn,
+                                      cds_shared_realloc_fn,
+                                      cds_shared_free_fn, NULL};
+  return &shared;
+}
+
+/**
+ * @brief Allocates an uninitialized shared buffer with one reference.
+ * @return The buffer, or NULL if out of memory.
+ */
+static inline void *cds_shared_new(size_t size) {
+  return cds_alloc(cds_shared_allocator(), size);
+}
+
+/**
+ * @brief Copies data into a new shared buffer with one reference.
+ * @return The buffer, or NULL if out of memory.
+ */
+static inline void *cds_shared_from(const void *data, size_t size) {
+  void *buf = cds_shared_new(size);
+  if (buf && size)
+    memcpy(buf, data, size);
+  return buf;
+}
+
+/**
+ * @brief Takes an extra reference.
+ * @return data, for chaining.
+ */
+static inline void *cds_shared_retain(void *data) {
+  __atomic_add_fetch(&cds_shared_header(data)->h.refs, 1, __ATOMIC_RELAXED);
+  return data;
+}
+
+/**
+ * @brief Drops a reference and frees the buffer when it was the last one.
+ * @param data Shared buffer (may be NULL).
+ * @note Buffers made by cds_shared_new() go back to the default allocator;
+ * use cds_free() with the originating allocator otherwise.
+ */
+static inline void cds_shared_release(void *data) {
+  cds_free(cds_shared_allocator(), data);
+}
+
+/**
+ * @brief Returns the current reference count (for diagnostics).
+ */
+static inline size_t cds_shared_refs(const void *data) {
+  return __atomic_load_n(&cds_shared_header(data)->h.refs, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Appends a shared buffer to a singly linked list, taking a reference.
+ * @note Use the `_a` functions with cds_shared_allocator() to delete from or
+ * free the list, e.g. sl_free_list_a(&root, cds_shared_allocator()).
+ */
+static inline void sl_push_back_shared_data(Node **rootPtrPtr, void *data,
+                                            size_t dataLen) {
+  sl_push_back_cp_data_a(rootPtrPtr, cds_shared_retain(data), dataLen,
+                         cds_shared_allocator());
+}
+
+/**
+ * @brief Prepends a shared buffer to a singly linked list, taking a reference.
+ */
+static inline void sl_push_front_shared_data(Node **rootPtrPtr, void *data,
+                                             size_t dataLen) {
+  sl_push_front_cp_data_a(rootPtrPtr, cds_shared_retain(data), dataLen,
+                          cds_shared_allocator());
+}
+
+/**
+ * @brief Inserts a shared buffer at an index, taking a reference.
+ * @note Out-of-bounds indices leave the reference count unchanged.
+ */
+static inline void sl_insert_at_index_shared_data(Node **rootPtrPtr,
+                                                  void *data, size_t dataLen,
+                                                  int idx) {
+  void *ref;
+  if (idx < 0)
+    return;
+  ref = cds_shared_retain(data);
+  sl_insert_at_index_mv_data_a(rootPtrPtr, &ref, dataLen, idx,
+                               cds_shared_allocator());
+}
+
+/**
+ * @brief Frees a singly linked list holding shared buffers.
+ */
+static inline void sl_free_list_shared(Node **rootPtrPtr) {
+  sl_free_list_a(rootPtrPtr, cds_shared_allocator());
+}
+
+/**
+ * @brief Appends a shared buffer to a doubly linked list, taking a reference.
+ * @note Use the `_a` functions with cds_shared_allocator() to delete from or
+ * free the list.
+ */
+static inline void dl_push_back_shared_data(DLNode **root, void *data,
+                                            size_t dataSize) {
+  dl_push_back_cp_data_a(root, cds_shared_retain(data), dataSize,
+                         cds_shared_allocator());
+}
+
+/**
+ * @brief Prepends a shared buffer to a doubly linked list, taking a
+ * reference.
+ */
+static inline void dl_push_front_shared_data(DLNode **root, void *data,
+                                             size_t dataSize) {
+  dl_push_front_cp_data_a(root, cds_shared_retain(data), dataSize,
+                          cds_shared_allocator());
+}
+
+/**
+ * @brief Inserts a shared buffer at an index, taking a reference.
+ * @note Out-of-bounds indices leave the reference count unchanged.
+ */
+static inline void dl_insert_at_index_shared_data(DLNode **root, void *data,
+                                                  size_t dataSize, int idx) {
+  void *ref = cds_shared_retain(data);
+  dl_insert_at_index_mv_data_a(root, &ref, dataSize, idx,
+                               cds_shared_allocator());
+}
+
+/**
+ * @brief Frees a doubly linked list holding shared buffers.
+ */
+static inline void dl_free_list_shared(DLNode **root) {
+  dl_free_list_a(root, cds_shared_allocator());
+}
+
+/**
+ * @brief Appends a shared buffer to a circular list, taking a reference.
+ * @note Use the `_a` functions with cds_shared_allocator() to delete from or
+ * free the list.
+ */
+static inline void cl_push_back_shared_data(Node **root, void *data,
+                                            size_t dataSize) {
+  cl_push_back_cp_data_a(root, cds_shared_retain(data), dataSize,
+                         cds_shared_allocator());
+}
+
+/**
+ * @brief Prepends a shared buffer to a circular list, taking a reference.
+ */
+static inline void cl_push_front_shared_data(Node **root, void *data,
+                                             size_t dataSize) {
+  cl_push_front_cp_data_a(root, cds_shared_retain(data), dataSize,
+                          cds_shared_allocator());
+}
+
+/**
+ * @brief Frees a circular list holding shared buffers.
+ */
+static inline void cl_free_list_shared(Node **root) {
+  cl_free_list_a(root, cds_shared_allocator());
+}
+
+#endif // SHAREDPAYLOAD_H
@@ -0,0 +1,336 @@
+#ifndef SIMDSCAN_H
+#define SIMDSCAN_H
+
+#include "generics.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file simdscan.h
+ * @brief Equality scans over arrays of fixed-size keys (`cds_scan_*`).
+ *
+ * The kernels compare a whole vector of keys per instruction and turn the
+ * result into a bit mask: 4-, 8- and 16-byte keys are handled with SSE2 or
+ * AVX2, picked at run time from the CPU features, and every other size falls
+ * back to memcmp(). Define CDS_NO_SIMD to build only the scalar kernels.
+ *
+ * soa_find_any(), soa_count_value() and soa_find_all() run on top of these,
+ * since the SOA slab already is a contiguous key column.
+ */
+
+#if !defined(CDS_NO_SIMD) && defined(__GNUC__) &&                              \
+    (defined(__x86_64__) || defined(__i386__))
+#define CDS_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @enum CDSScanISA
+ * @brief Instruction set used by the scan kernels.
+ */
+typedef enum CDSScanISA {
+    CDS_SCAN_AUTO = 0, /**< Detect on first use */
+    CDS_SCAN_SCALAR,   /**< Plain C */
+    CDS_SCAN_SSE2,     /**< 16-byte vectors */
+    CDS_SCAN_AVX2      /**< 32-byte vectors */
+} CDSScanISA;
+
+static inline CDSScanISA *cds_scan_isa_slot(void) {
+  static CDSScanISA isa = CDS_SCAN_AUTO;
+  return &isa;
+}
+
+static inline CDSScanISA cds_scan_detect(void) {
+#ifdef CDS_SCAN_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return CDS_SCAN_AVX2;
+  if (__builtin_cpu_supports("sse2"))
+    return CDS_SCAN_SSE2;
+#endif
+  return CDS_SCAN_SCALAR;
+}
+
+/**
+ * @brief Returns the instruction set the kernels use, detecting it on the
+ * first call.
+ */
+static inline CDSScanISA cds_scan_isa(void) {
+  CDSScanISA *slot = cds_scan_isa_slot();
+  CDSScanISA isa = __atomic_load_n(slot, __ATOMIC_RELAXED);
+  if (isa == CDS_SCAN_AUTO) {
+    isa = cds_scan_detect();
+    __atomic_store_n(slot, isa, __ATOMIC_RELAXED);
+  }
+  return isa;
+}
+
+/**
+ * @brief Forces an instruction set, e.g. to compare kernels.
+ * @param isa CDS_SCAN_AUTO to detect again. Requests the CPU (or the build)
+ * cannot run are lowered to the best supported one.
+ */
+static inline void cds_scan_set_isa(CDSScanISA isa) {
+  CDSScanISA best = cds_scan_detect();
+  if (isa == CDS_SCAN_AUTO || isa > best)
+    isa = best;
+  __atomic_store_n(cds_scan_isa_slot(), isa, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Returns the name of an instruction set.
+ */
+static inline const char *cds_scan_isa_str(CDSScanISA isa) {
+  switch (isa) {
+  case CDS_SCAN_AUTO:
+    return "auto";
+  case CDS_SCAN_SCALAR:
+    return "scalar";
+  case CDS_SCAN_SSE2:
+    return "sse2";
+  case CDS_SCAN_AVX2:
+    return "avx2";
+  }
+  return "unknown";
+}
+
+static inline bool cds_scan_simd_size(size_t keySize) {
+  return keySize == 4 || keySize == 8 || keySize == 16;
+}
+
+static inline size_t cds_scan_find_scalar(const unsigned char *base,
+                                          size_t count, size_t keySize,
+                                          const void *key) {
+  if (keySize == 8) {
+    uint64_t k, v;
+    memcpy(&k, key, 8);
+    for (size_t i = 0; i < count; i++) {
+      memcpy(&v, base + i * 8, 8);
+      if (v == k)
+        return i;
+    }
+    return count;
+  }
+  for (size_t i = 0; i < count; i++)
+    if (memcmp(base + i * keySize, key, keySize) == 0)
+      return i;
+  return count;
+}
+
+static inline size_t cds_scan_count_scalar(const unsigned char *base,
+                                           size_t count, size_t keySize,
+                                           const void *key) {
+  size_t n = 0;
+  if (keySize == 8) {
+    uint64_t k, v;
+    memcpy(&k, key, 8);
+    for (size_t i = 0; i < count; i++) {
+      memcpy(&v, base + i * 8, 8);
+      n += v == k;
+    }
+    return n;
+  }
+  for (size_t i = 0; i < count; i++)
+    n += memcmp(base + i * keySize, key, keySize) == 0;
+  return n;
+}
+
+#ifdef CDS_SCAN_X86
+
+// all-ones in every 32-bit lane of a key equal to k
+__attribute__((target("sse2"))) static inline __m128i
+cds_scan_eq_sse2(const unsigned char *p, __m128i k, size_t keySize) {
+  __m128i e = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)p), k);
+  if (keySize >= 8)
+    e = _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+  if (keySize == 16)
+    e = _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(1, 0, 3, 2)));
+  return e;
+}
+
+// one bit per key of a 16-byte block
+__attribute__((target("sse2"))) static inline unsigned
+cds_scan_bits_sse2(__m128i e, size_t keySize) {
+  if (keySize == 4)
+    return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(e));
+  if (keySize == 8)
+    return (unsigned)_mm_movemask_pd(_mm_castsi128_pd(e));
+  return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(e)) & 1;
+}
+
+__attribute__((target("sse2"))) static inline __m128i
+cds_scan_key_sse2(const void *key, size_t keySize) {
+  unsigned char rep[16];
+  for (size_t o = 0; o < 16; o += keySize)
+    memcpy(rep + o, key, keySize);
+  return _mm_loadu_si128((const __m128i *)rep);
+}
+
+__attribute__((target("sse2"))) static inline size_t
+cds_scan_find_sse2(const unsigned char *base, size_t count, size_t keySize,
+                   const void *key) {
+  size_t per = 16 / keySize, i = 0;
+  __m128i k = cds_scan_key_sse2(key, keySize);
+  // four blocks share one test; the block is located only on a hit
+  for (; i + 4 * per <= count; i += 4 * per) {
+    const unsigned char *p = base + i * keySize;
+    __m128i e0 = cds_scan_eq_sse2(p, k, keySize);
+    __m128i e1 = cds_scan_eq_sse2(p + 16, k, keySize);
+    __m128i e2 = cds_scan_eq_sse2(p + 32, k, keySize);
+    __m128i e3 = cds_scan_eq_sse2(p + 48, k, keySize);
+    __m128i any = _mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3));
+    if (_mm_movemask_epi8(any) != 0)
+      break;
+  }
+  for (; i + per <= count; i += per) {
+    unsigned m =
+        cds_scan_bits_sse2(cds_scan_eq_sse2(base + i * keySize, k, keySize),
+                           keySize);
+    if (m)
+      return i + (size_t)__builtin_ctz(m);
+  }
+  return i + cds_scan_find_scalar(base + i * keySize, count - i, keySize,
+                                  key);
+}
+
+__attribute__((target("sse2"))) static inline size_t
+cds_scan_count_sse2(const unsigned char *base, size_t count, size_t keySize,
+                    const void *key) {
+  size_t per = 16 / keySize, i = 0, n = 0;
+  __m128i k = cds_scan_key_sse2(key, keySize);
+  for (; i + per <= count; i += per)
+    n += (size_t)__builtin_popcount(cds_scan_bits_sse2(
+        cds_scan_eq_sse2(base + i * keySize, k, keySize), keySize));
+  return n + cds_scan_count_scalar(base + i * keySize, count - i, keySize,
+                                   key);
+}
+
+// the shuffles stay within each 128-bit lane, which is what 16-byte keys need
+__attribute__((target("avx2"))) static inline __m256i
+cds_scan_eq_avx2(const unsigned char *p, __m256i k, size_t keySize) {
+  __m256i e = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)p), k);
+  if (keySize >= 8)
+    e = _mm256_and_si256(e, _mm256_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+  if (keySize == 16)
+    e = _mm256_and_si256(e, _mm256_shuffle_epi32(e, _MM_SHUFFLE(1, 0, 3, 2)));
+  return e;
+}
+
+// one bit per key of a 32-byte block
+__attribute__((target("avx2"))) static inline unsigned
+cds_scan_bits_avx2(__m256i e, size_t keySize) {
+  unsigned m;
+  if (keySize == 4)
+    return (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(e));
+  if (keySize == 8)
+    return (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(e));
+  m = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(e));
+  return (m & 1) | ((m >> 3) & 2);
+}
+
+__attribute__((target("avx2"))) static inline __m256i
+cds_scan_key_avx2(const void *key, size_t keySize) {
+  unsigned char rep[32];
+  for (size_t o = 0; o < 32; o += keySize)
+    memcpy(rep + o, key, keySize);
+  return _mm256_loadu_si256((const __m256i *)rep);
+}
+
+__attribute__((target("avx2"))) static inline size_t
+cds_scan_find_avx2(const unsigned char *base, size_t count, size_t keySize,
+                   const void *key) {
+  size_t per = 32 / keySize, i = 0;
+  __m256i k = cds_scan_key_avx2(key, keySize);
+  for (; i + 4 * per <= count; i += 4 * per) {
+    const unsigned char *p = base + i * keySize;
+    __m256i e0 = cds_scan_eq_avx2(p, k, keySize);
+    __m256i e1 = cds_scan_eq_avx2(p + 32, k, keySize);
+    __m256i e2 = cds_scan_eq_avx2(p + 64, k, keySize);
+    __m256i e3 = cds_scan_eq_avx2(p + 96, k, keySize);
+    __m256i any =
+        _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+    if (!_mm256_testz_si256(any, any))
+      break;
+  }
+  for (; i + per <= count; i += per) {
+    unsigned m =
+        cds_scan_bits_avx2(cds_scan_eq_avx2(base + i * keySize, k, keySize),
+                           keySize);
+    if (m)
+      return i + (size_t)__builtin_ctz(m);
+  }
+  return i + cds_scan_find_scalar(base + i * keySize, count - i, keySize,
+                                  key);
+}
+
+__attribute__((target("avx2"))) static inline size_t
+cds_scan_count_avx2(const unsigned char *base, size_t count, size_t keySize,
+                    const void *key) {
+  size_t per = 32 / keySize, i = 0, n = 0;
+  __m256i k = cds_scan_key_avx2(key, keySize);
+  for (; i + per <= count; i += per)
+    n += (size_t)__builtin_popcount(cds_scan_bits_avx2(
+        cds_scan_eq_avx2(base + i * keySize, k, keySize), keySize));
+  return n + cds_scan_count_scalar(base + i * keySize, count - i, keySize,
+                                   key);
+}
+
+#endif // CDS_SCAN_X86
+
+/**
+ * @brief Finds the first key equal to key in an array of keys.
+ * @param base count keys of keySize bytes, packed back to back (no
+ * alignment needed).
+ * @param count Number of keys.
+ * @param keySize Size of one key; 4, 8 and 16 use the vector kernels.
+ * @param key Key to look for.
+ * @return Index of the first match, or count if there is none.
+ */
+static inline size_t cds_scan_find(const void *base, size_t count,
+                                   size_t keySize, const void *key) {
+  const unsigned char *p = (const unsigned char *)base;
+  if (keySize == 0)
+    return 0;
+#ifdef CDS_SCAN_X86
+  if (cds_scan_simd_size(keySize)) {
+    switch (cds_scan_isa()) {
+    case CDS_SCAN_AVX2:
+      return cds_scan_find_avx2(p, count, keySize, key);
+    case CDS_SCAN_SSE2:
+      return cds_scan_find_sse2(p, count, keySize, key);
+    default:
+      break;
+    }
+  }
+#endif
+  return cds_scan_find_scalar(p, count, keySize, key);
+}
+
+/**
+ * @brief Counts the keys equal to key in an array of keys.
+ * @param base count keys of keySize bytes, packed back to back.
+ * @return Number of matches.
+ */
+static inline size_t cds_scan_count(const void *base, size_t count,
+                                    size_t keySize, const void *key) {
+  const unsigned char *p = (const unsigned char *)base;
+  if (keySize == 0)
+    return count;
+#ifdef CDS_SCAN_X86
+  if (cds_scan_simd_size(keySize)) {
+    switch (cds_scan_isa()) {
+    case CDS_SCAN_AVX2:
+      return cds_scan_count_avx2(p, count, keySize, key);
+    case CDS_SCAN_SSE2:
+      return cds_scan_count_sse2(p, count, keySize, key);
+    default:
+      break;
+    }
+  }
+#endif
+  return cds_scan_count_scalar(p, count, keySize, key);
+}
+
+#endif // SIMDSCAN_H
@@ -0,0 +1,498 @@
+#ifndef SOALIST_H
+#define SOALIST_H
+
+#include "generics.h"
+#include "simdscan.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file soalist.h
+ * @brief Struct-of-arrays doubly linked list of fixed-size records (`soa_*`).
+ *
+ * Instead of one heap node per element, the list keeps three parallel
+ * arrays: a payload slab of `elemSize`-byte records and `uint32_t` next/prev
+ * link arrays. An element is identified by its slot index (an SOAIndex),
+ * which stays valid until the element is removed, even when the arrays grow.
+ * Free slots are chained through `next` so insertion and removal are O(1)
+ * given a handle.
+ *
+ * Per element this costs elemSize + 8 bytes, against sizeof(DLNode) plus a
+ * separate payload block for the classic lists, and everything sits in three
+ * contiguous blocks. soa_compact() renumbers slots into list order so a
+ * traversal becomes a sequential sweep.
+ */
+
+/** @brief Slot index used as an element handle. */
+typedef uint32_t SOAIndex;
+
+/** @brief "No element" handle (end of list, failed insert). */
+#define SOA_NIL ((SOAIndex)UINT32_MAX)
+
+/** @brief prev[] marker of a slot on the free list. */
+#define SOA_FREE ((SOAIndex)(UINT32_MAX - 1))
+
+/** @brief Largest number of slots a list can hold. */
+#define SOA_MAX_CAPACITY ((uint32_t)(UINT32_MAX - 2))
+
+/**
+ * @struct SOAList
+ * @brief Handle of a struct-of-arrays list.
+ */
+typedef struct SOAList {
+    unsigned char *slab;       /**< capacity * elemSize payload bytes */
+    SOAIndex *next;            /**< Next slot in the list (or free list) */
+    SOAIndex *prev;            /**< Previous slot, SOA_FREE if unused */
+    SOAIndex head;             /**< First element, SOA_NIL when empty */
+    SOAIndex tail;             /**< Last element, SOA_NIL when empty */
+    SOAIndex freeHead;         /**< First unused slot, SOA_NIL if none */
+    uint32_t size;             /**< Number of elements */
+    uint32_t capacity;         /**< Number of slots */
+    uint32_t used;             /**< Slots below this were written at least once */
+    size_t elemSize;           /**< Size of one record in bytes */
+    const CDSAllocator *alloc; /**< Allocator for the three arrays */
+} SOAList;
+
+/**
+ * @brief Grows the list to hold at least capacity elements.
+ * @return CDS_OK, or CDS_ERR_NO_MEMORY (the list is left unchanged).
+ * @note Existing handles stay valid; pointers from soa_at() do not.
+ */
+static inline CDSStatus soa_reserve(SOAList *list, uint32_t capacity) {
+  unsigned char *slab;
+  SOAIndex *next, *prev;
+  if (capacity <= list->capacity)
+    return CDS_OK;
+  if (capacity > SOA_MAX_CAPACITY)
+    return CDS_ERR_NO_MEMORY;
+  slab = (unsigned char *)cds_realloc(list->alloc, list->slab,
+                                      (size_t)capacity * list->elemSize);
+  if (slab == NULL)
+    return CDS_ERR_NO_MEMORY;
+  list->slab = slab;
+  next = (SOAIndex *)cds_realloc(list->alloc, list->next,
+                                 (size_t)capacity * sizeof(SOAIndex));
+  if (next == NULL)
+    return CDS_ERR_NO_MEMORY;
+  list->next = next;
+  prev = (SOAIndex *)cds_realloc(list->alloc, list->prev,
+                                 (size_t)capacity * sizeof(SOAIndex));
+  if (prev == NULL)
+    return CDS_ERR_NO_MEMORY;
+  list->prev = prev;
+
+  // chain the new slots in ascending order in front of the free list
+  for (uint32_t i = capacity; i-- > list->capacity;) {
+    list->next[i] = list->freeHead;
+    list->prev[i] = SOA_FREE;
+    list->freeHead = i;
+  }
+  list->capacity = capacity;
+  return CDS_OK;
+}
+
+/**
+ * @brief Initializes an empty list.
+ * @param list List handle.
+ * @param elemSize Size of every record in bytes (> 0).
+ * @param capacity Number of slots to preallocate (may be 0).
+ * @param alloc Allocator for the arrays, NULL for the default one.
+ * @return CDS_OK, CDS_ERR_NULL for a zero elemSize, or CDS_ERR_NO_MEMORY.
+ */
+static inline CDSStatus soa_init(SOAList *list, size_t elemSize,
+                                 uint32_t capacity,
+                                 const CDSAllocator *alloc) {
+  memset(list, 0, sizeof(*list));
+  list->head = list->tail = list->freeHead = SOA_NIL;
+  list->elemSize = elemSize;
+  list->alloc = alloc ? alloc : cds_default_allocator();
+  if (elemSize == 0)
+    return CDS_ERR_NULL;
+  return soa_reserve(list, capacity);
+}
+
+/**
+ * @brief Releases the arrays. The list stays usable (empty, no slots).
+ */
+static inline void soa_free_list(SOAList *list) {
+  cds_free(list->alloc, list->slab);
+  cds_free(list->alloc, list->next);
+  cds_free(list->alloc, list->prev);
+  list->slab = NULL;
+  list->next = list->prev = NULL;
+  list->head = list->tail = list->freeHead = SOA_NIL;
+  list->size = list->capacity = list->used = 0;
+}
+
+/**
+ * @brief Removes every element but keeps the allocated slots.
+ */
+static inline void soa_clear(SOAList *list) {
+  list->head = list->tail = list->freeHead = SOA_NIL;
+  for (uint32_t i = list->capacity; i-- > 0;) {
+    list->next[i] = list->freeHead;
+    list->prev[i] = SOA_FREE;
+    list->freeHead = i;
+  }
+  list->size = list->used = 0;
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+static inline uint32_t soa_size(const SOAList *list) { return list->size; }
+
+/**
+ * @brief Returns true if idx is the handle of a live element.
+ */
+static inline bool soa_is_live(const SOAList *list, SOAIndex idx) {
+  return idx < list->capacity && list->prev[idx] != SOA_FREE;
+}
+
+/**
+ * @brief Returns a pointer to the record of an element.
+ * @note idx must be live. The pointer is invalidated by growth and
+ * soa_compact().
+ */
+static inline void *soa_at(const SOAList *list, SOAIndex idx) {
+  return list->slab + (size_t)idx * list->elemSize;
+}
+
+/** @brief First element, or SOA_NIL. */
+static inline SOAIndex soa_first(const SOAList *list) { return list->head; }
+
+/** @brief Last element, or SOA_NIL. */
+static inline SOAIndex soa_last(const SOAList *list) { return list->tail; }
+
+/** @brief Element after idx, or SOA_NIL. */
+static inline SOAIndex soa_next(const SOAList *list, SOAIndex idx) {
+  return list->next[idx];
+}
+
+/** @brief Element before idx, or SOA_NIL. */
+static inline SOAIndex soa_prev(const SOAList *list, SOAIndex idx) {
+  return list->prev[idx];
+}
+
+static inline SOAIndex soa_take_slot(SOAList *list, const void *elem) {
+  SOAIndex slot;
+  if (list->freeHead == SOA_NIL) {
+    uint32_t cap = list->capacity == 0                   ? 8
+                   : list->capacity > SOA_MAX_CAPACITY / 2 ? SOA_MAX_CAPACITY
+                                                           : list->capacity * 2;
+    // elem may be a record of this list (soa_push_back(l, soa_at(l, i))):
+    // keep its offset so it can be found again in the regrown slab
+    uintptr_t at = (uintptr_t)elem, base = (uintptr_t)list->slab;
+    bool inSlab = elem && list->slab && at >= base &&
+                  at - base < (uintptr_t)list->capacity * list->elemSize;
+    if (cap == list->capacity || soa_reserve(list, cap) != CDS_OK)
+      return SOA_NIL;
+    if (inSlab)
+      elem = list->slab + (at - base);
+  }
+  slot = list->freeHead;
+  list->freeHead = list->next[slot];
+  if (slot >= list->used)
+    list->used = slot + 1;
+  if (elem)
+    memcpy(soa_at(list, slot), elem, list->elemSize);
+  list->size++;
+  return slot;
+}
+
+/**
+ * @brief Copies a record in before the element at pos.
+ * @param pos Live handle, or SOA_NIL to append.
+ * @param elem Record to copy (elemSize bytes), or NULL to leave it
+ * uninitialized for the caller to fill through soa_at(). It may point at
+ * a record of this list; the copy is taken after any growth.
+ * @return Handle of the new element, or SOA_NIL if out of memory.
+ */
+static inline SOAIndex soa_insert_before(SOAList *list, SOAIndex pos,
+                                         const void *elem) {
+  SOAIndex slot = soa_take_slot(list, elem);
+  SOAIndex before;
+  if (slot == SOA_NIL)
+    return SOA_NIL;
+  before = pos == SOA_NIL ? list->tail : list->prev[pos];
+  list->next[slot] = pos;
+  list->prev[slot] = before;
+  if (before == SOA_NIL)
+    list->head = slot;
+  else
+    list->next[before] = slot;
+  if (pos == SOA_NIL)
+    list->tail = slot;
+  else
+    list->prev[pos] = slot;
+  return slot;
+}
+
+/**
+ * @brief Copies a record in after the element at pos.
+ * @param pos Live handle, or SOA_NIL to prepend.
+ * @return Handle of the new element, or SOA_NIL if out of memory.
+ */
+static inline SOAIndex soa_insert_after(SOAList *list, SOAIndex pos,
+                                        const void *elem) {
+  return soa_insert_before(list, pos == SOA_NIL ? list->head : list->next[pos],
+                           elem);
+}
+
+/**
+ * @brief Appends a copy of a record.
+ * @return Handle of the new element, or SOA_NIL if out of memory.
+ */
+static inline SOAIndex soa_push_back(SOAList *list, const void *elem) {
+  return soa_insert_before(list, SOA_NIL, elem);
+}
+
+/**
+ * @brief Prepends a copy of a record.
+ * @return Handle of the new element, or SOA_NIL if out of memory.
+ */
+static inline SOAIndex soa_push_front(SOAList *list, const void *elem) {
+  return soa_insert_before(list, list->head, elem);
+}
+
+/**
+ * @brief Unlinks an element in O(1) and returns its slot to the free list.
+ * @param idx Live handle.
+ * @return The element that followed it, or SOA_NIL.
+ */
+static inline SOAIndex soa_remove(SOAList *list, SOAIndex idx) {
+  SOAIndex next = list->next[idx];
+  SOAIndex prev = list->prev[idx];
+  if (prev == SOA_NIL)
+    list->head = next;
+  else
+    list->next[prev] = next;
+  if (next == SOA_NIL)
+    list->tail = prev;
+  else
+    list->prev[next] = prev;
+  list->next[idx] = list->freeHead;
+  list->prev[idx] = SOA_FREE;
+  list->freeHead = idx;
+  list->size--;
+  return next;
+}
+
+/**
+ * @brief Removes the first element, copying it to out.
+ * @param out Receives the record (may be NULL).
+ * @return false if the list is empty.
+ */
+static inline bool soa_pop_front(SOAList *list, void *out) {
+  if (list->head == SOA_NIL)
+    return false;
+  if (out)
+    memcpy(out, soa_at(list, list->head), list->elemSize);
+  soa_remove(list, list->head);
+  return true;
+}
+
+/**
+ * @brief Removes the last element, copying it to out.
+ * @param out Receives the record (may be NULL).
+ * @return false if the list is empty.
+ */
+static inline bool soa_pop_back(SOAList *list, void *out) {
+  if (list->tail == SOA_NIL)
+    return false;
+  if (out)
+    memcpy(out, soa_at(list, list->tail), list->elemSize);
+  soa_remove(list, list->tail);
+  return true;
+}
+
+/**
+ * @brief Returns the first element (in list order) equal to a record.
+ * @return Its handle, or SOA_NIL.
+ */
+static inline SOAIndex soa_find(const SOAList *list, const void *elem) {
+  for (SOAIndex i = list->head; i != SOA_NIL; i = list->next[i])
+    if (memcmp(soa_at(list, i), elem, list->elemSize) == 0)
+      return i;
+  return SOA_NIL;
+}
+
+/**
+ * @brief Returns some element equal to a record, scanning the slab in memory
+ * order.
+ *
+ * Faster than soa_find() on large lists because the scan is sequential and
+ * runs on cds_scan_find(), which compares a vector of 4-, 8- or 16-byte
+ * records at a time. When there are duplicates it returns the one in the
+ * lowest slot rather than the first in list order.
+ * @return Its handle, or SOA_NIL.
+ */
+static inline SOAIndex soa_find_any(const SOAList *list, const void *elem) {
+  uint32_t i = 0;
+  // only slots below the high-water mark were ever written; free ones among
+  // them still hold old records, so every hit is checked
+  while (i < list->used) {
+    i += (uint32_t)cds_scan_find(soa_at(list, i), list->used - i,
+                                 list->elemSize, elem);
+    if (i >= list->used)
+      break;
+    if (list->prev[i] != SOA_FREE)
+      return i;
+    i++;
+  }
+  return SOA_NIL;
+}
+
+/**
+ * @brief Collects the elements equal to a record, in slot order.
+ * @param out Receives up to maxOut handles (may be NULL when maxOut is 0).
+ * @param maxOut Capacity of out.
+ * @return Total number of matches, which may exceed maxOut.
+ */
+static inline uint32_t soa_find_all(const SOAList *list, const void *elem,
+                                    SOAIndex *out, uint32_t maxOut) {
+  uint32_t i = 0, n = 0;
+  while (i < list->used) {
+    i += (uint32_t)cds_scan_find(soa_at(list, i), list->used - i,
+                                 list->elemSize, elem);
+    if (i >= list->used)
+      break;
+    if (list->prev[i] != SOA_FREE) {
+      if (n < maxOut)
+        out[n] = i;
+      n++;
+    }
+    i++;
+  }
+  return n;
+}
+
+/**
+ * @brief Counts the elements equal to a record.
+ *
+ * When no slot below the high-water mark is free the count is a single
+ * cds_scan_count() pass; otherwise the hits are checked against the free
+ * slots one by one.
+ */
+static inline uint32_t soa_count_value(const SOAList *list, const void *elem) {
+  size_t total = cds_scan_count(list->slab, list->used, list->elemSize, elem);
+  if (total == 0 || list->size == list->used)
+    return (uint32_t)total;
+  return soa_find_all(list, elem, NULL, 0);
+}
+
+/**
+ * @brief Checks if a record exists in the list.
+ */
+static inline bool soa_contains(const SOAList *list, const void *elem) {
+  return soa_find_any(list, elem) != SOA_NIL;
+}
+
+/**
+ * @brief Removes the first element (in list order) equal to a record.
+ * @return true if an element was removed.
+ */
+static inline bool soa_delete_by_value(SOAList *list, const void *elem) {
+  SOAIndex i = soa_find(list, elem);
+  if (i == SOA_NIL)
+    return false;
+  soa_remove(list, i);
+  return true;
+}
+
+/**
+ * @brief Looks up the element at a position without printing.
+ * @param out Receives the handle, or SOA_NIL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus soa_try_get_by_index(const SOAList *list,
+                                             uint32_t position,
+                                             SOAIndex *out) {
+  SOAIndex i;
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = SOA_NIL;
+  if (position >= list->size)
+    return CDS_ERR_OUT_OF_BOUNDS;
+  if (position < list->size / 2) {
+    for (i = list->head; position > 0; position--)
+      i = list->next[i];
+  } else {
+    for (i = list->tail; position < list->size - 1; position++)
+      i = list->prev[i];
+  }
+  *out = i;
+  return CDS_OK;
+}
+
+/**
+ * @brief Returns the record at a position in list order.
+ * @return Pointer to the record, or NULL if out of bounds.
+ * @note Failures go through CDS_DIAGNOSTIC.
+ */
+static inline void *soa_get_at_index(const SOAList *list, uint32_t position) {
+  SOAIndex i;
+  CDSStatus status = soa_try_get_by_index(list, position, &i);
+  if (status != CDS_OK) {
+    CDS_DIAGNOSTIC(status, "Error: Index out of bounds.\n");
+    return NULL;
+  }
+  return soa_at(list, i);
+}
+
+/**
+ * @brief Renumbers the slots so list order equals memory order.
+ *
+ * Afterwards element k of the list lives in slot k, so traversals become
+ * sequential sweeps of the slab.
+ * @param shrink If true, also release the unused slots.
+ * @return CDS_OK or CDS_ERR_NO_MEMORY (the list is left unchanged).
+ * @note Invalidates every handle and soa_at() pointer.
+ */
+static inline CDSStatus soa_compact(SOAList *list, bool shrink) {
+  uint32_t cap = shrink ? list->size : list->capacity;
+  unsigned char *slab;
+  SOAIndex *next, *prev;
+  uint32_t k = 0;
+  if (cap == 0) {
+    if (shrink)
+      soa_free_list(list);
+    return CDS_OK;
+  }
+  slab = (unsigned char *)cds_alloc(list->alloc, (size_t)cap * list->elemSize);
+  next = (SOAIndex *)cds_alloc(list->alloc, (size_t)cap * sizeof(SOAIndex));
+  prev = (SOAIndex *)cds_alloc(list->alloc, (size_t)cap * sizeof(SOAIndex));
+  if (slab == NULL || next == NULL || prev == NULL) {
+    cds_free(list->alloc, slab);
+    cds_free(list->alloc, next);
+    cds_free(list->alloc, prev);
+    return CDS_ERR_NO_MEMORY;
+  }
+  for (SOAIndex i = list->head; i != SOA_NIL; i = list->next[i], k++) {
+    memcpy(slab + (size_t)k * list->elemSize, soa_at(list, i), list->elemSize);
+    next[k] = k + 1 < list->size ? k + 1 : SOA_NIL;
+    prev[k] = k ? k - 1 : SOA_NIL;
+  }
+  cds_free(list->alloc, list->slab);
+  cds_free(list->alloc, list->next);
+  cds_free(list->alloc, list->prev);
+  list->slab = slab;
+  list->next = next;
+  list->prev = prev;
+  list->capacity = cap;
+  list->used = list->size;
+  list->head = list->size ? 0 : SOA_NIL;
+  list->tail = list->size ? list->size - 1 : SOA_NIL;
+  list->freeHead = SOA_NIL;
+  for (uint32_t i = cap; i-- > list->size;) {
+    list->next[i] = list->freeHead;
+    list->prev[i] = SOA_FREE;
+    list->freeHead = i;
+  }
+  return CDS_OK;
+}
+
+#endif // SOALIST_H
@@ -0,0 +1,340 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "generics.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file timerwheel.h
+ * @brief Hashed hierarchical timer wheel (`tw_*`).
+ *
+ * Four levels of 256 slots cover delays of up to 2^32 ticks; longer delays
+ * are parked in the last level and re-placed when it cascades. Every slot is
+ * a circular doubly linked ring of DLNode headed by a sentinel, so:
+ *
+ * - tw_schedule() and tw_cancel() are O(1): a timer unlinks itself through
+ *   its own `previous` link, with no cl_delete_by_value() style scan;
+ * - a due slot is detached in O(1) as a whole batch;
+ * - tw_advance() is amortized O(1) per tick, plus one re-placement per
+ *   timer and level it cascades through.
+ *
+ * Timers are caller-owned (usually embedded in the connection they guard),
+ * so scheduling never allocates and a handle stays valid after it fires.
+ */
+
+#define TW_LEVELS 4
+#define TW_SLOT_BITS 8
+#define TW_SLOTS (1u << TW_SLOT_BITS)
+#define TW_SLOT_MASK (TW_SLOTS - 1)
+
+struct TWTimer;
+
+/**
+ * @brief Expiry callback. data is the pointer given to tw_timer_init().
+ * @note The callback may reschedule or cancel any timer, including this one.
+ */
+typedef void (*TWCallback)(struct TWTimer *timer, void *data);
+
+/**
+ * @enum TWState
+ * @brief Where a timer currently is.
+ */
+typedef enum TWState {
+    TW_IDLE = 0, /**< Not scheduled */
+    TW_PENDING,  /**< Linked into a wheel slot */
+    TW_EXPIRED   /**< Due, waiting in a TWBatch */
+} TWState;
+
+/**
+ * @struct TWTimer
+ * @brief A timer. The node must stay the first member.
+ */
+typedef struct TWTimer {
+    DLNode node;      /**< Slot ring links; node.data is the user data */
+    uint64_t expires; /**< Tick at which the timer fires */
+    TWCallback fn;    /**< Callback run by tw_advance() */
+    TWState state;    /**< Current state */
+} TWTimer;
+
+/**
+ * @struct TWBatch
+ * @brief Ring of expired timers collected by tw_collect_expired().
+ */
+typedef struct TWBatch {
+    DLNode ring; /**< Sentinel */
+} TWBatch;
+
+/**
+ * @struct TimerWheel
+ * @brief Handle of a timer wheel.
+ */
+typedef struct TimerWheel {
+    DLNode slots[TW_LEVELS][TW_SLOTS]; /**< Sentinels of the slot rings */
+    uint64_t now;                      /**< Next tick to be processed */
+    size_t pending;                    /**< Number of scheduled timers */
+} TimerWheel;
+
+static inline void tw_ring_init(DLNode *sentinel) {
+  sentinel->next = sentinel->previous = sentinel;
+  sentinel->data = NULL;
+  sentinel->dataSize = 0;
+}
+
+static inline bool tw_ring_empty(const DLNode *sentinel) {
+  return sentinel->next == sentinel;
+}
+
+static inline void tw_ring_append(DLNode *sentinel, DLNode *n) {
+  n->next = sentinel;
+  n->previous = sentinel->previous;
+  sentinel->previous->next = n;
+  sentinel->previous = n;
+}
+
+static inline void tw_ring_unlink(DLNode *n) {
+  n->previous->next = n->next;
+  n->next->previous = n->previous;
+  n->next = n->previous = NULL;
+}
+
+// moves every node of src to the end of dst in O(1)
+static inline void tw_ring_splice(DLNode *dst, DLNode *src) {
+  if (tw_ring_empty(src))
+    return;
+  src->next->previous = dst->previous;
+  dst->previous->next = src->next;
+  src->previous->next = dst;
+  dst->previous = src->previous;
+  tw_ring_init(src);
+}
+
+/**
+ * @brief Initializes an empty wheel.
+ * @param wheel Wheel handle.
+ * @param now Tick the wheel starts at.
+ */
+static inline void tw_init(TimerWheel *wheel, uint64_t now) {
+  for (int l = 0; l < TW_LEVELS; l++)
+    for (unsigned s = 0; s < TW_SLOTS; s++)
+      tw_ring_init(&wheel->slots[l][s]);
+  wheel->now = now;
+  wheel->pending = 0;
+}
+
+/**
+ * @brief Prepares a timer before its first tw_schedule().
+ * @param timer Timer to initialize.
+ * @param fn Callback run when it fires (may be NULL with tw_collect_expired()).
+ * @param data User data, stored in timer->node.data.
+ */
+static inline void tw_timer_init(TWTimer *timer, TWCallback fn, void *data) {
+  timer->node.data = data;
+  timer->node.dataSize = 0;
+  timer->node.next = timer->node.previous = NULL;
+  timer->expires = 0;
+  timer->fn = fn;
+  timer->state = TW_IDLE;
+}
+
+/**
+ * @brief Returns the number of scheduled timers.
+ */
+static inline size_t tw_pending(const TimerWheel *wheel) {
+  return wheel->pending;
+}
+
+/**
+ * @brief Returns the next tick the wheel will process.
+ */
+static inline uint64_t tw_now(const TimerWheel *wheel) { return wheel->now; }
+
+/**
+ * @brief Returns true if the timer is waiting in a wheel.
+ */
+static inline bool tw_is_pending(const TWTimer *timer) {
+  return timer->state == TW_PENDING;
+}
+
+static inline void tw_place(TimerWheel *wheel, TWTimer *timer) {
+  uint64_t expires = timer->expires;
+  uint64_t delta = expires > wheel->now ? expires - wheel->now : 0;
+  DLNode *slot;
+  if (delta < (1ull << TW_SLOT_BITS)) {
+    slot = &wheel->slots[0][(expires < wheel->now ? wheel->now : expires) &
+                            TW_SLOT_MASK];
+  } else if (delta < (1ull << (2 * TW_SLOT_BITS))) {
+    slot = &wheel->slots[1][(expires >> TW_SLOT_BITS) & TW_SLOT_MASK];
+  } else if (delta < (1ull << (3 * TW_SLOT_BITS))) {
+    slot = &wheel->slots[2][(expires >> (2 * TW_SLOT_BITS)) & TW_SLOT_MASK];
+  } else {
+    // delays past the top level wait in its furthest slot and are re-placed
+    if (delta > 0xffffffffull)
+      expires = wheel->now + 0xffffffffull;
+    slot = &wheel->slots[3][(expires >> (3 * TW_SLOT_BITS)) & TW_SLOT_MASK];
+  }
+  tw_ring_append(slot, &timer->node);
+}
+
+/**
+ * @brief Cancels a timer in O(1).
+ *
+ * Works on pending timers and on expired timers still sitting in a TWBatch,
+ * which are then skipped by tw_batch_pop().
+ * @return true if the timer was pending or expired, false if it was idle.
+ */
+static inline bool tw_cancel(TimerWheel *wheel, TWTimer *timer) {
+  if (timer->state == TW_IDLE)
+    return false;
+  if (timer->state == TW_PENDING)
+    wheel->pending--;
+  tw_ring_unlink(&timer->node);
+  timer->state = TW_IDLE;
+  return true;
+}
+
+/**
+ * @brief Schedules (or reschedules) a timer delay ticks from now in O(1).
+ * @param delay Number of ticks; 0 fires on the next processed tick.
+ */
+static inline void tw_schedule(TimerWheel *wheel, TWTimer *timer,
+                               uint64_t delay) {
+  tw_cancel(wheel, timer);
+  timer->expires = wheel->now + delay;
+  timer->state = TW_PENDING;
+  tw_place(wheel, timer);
+  wheel->pending++;
+}
+
+/**
+ * @brief Schedules (or reschedules) a timer at an absolute tick.
+ * @note Ticks already passed fire on the next processed tick.
+ */
+static inline void tw_schedule_at(TimerWheel *wheel, TWTimer *timer,
+                                  uint64_t tick) {
+  tw_schedule(wheel, timer, tick > wheel->now ? tick - wheel->now : 0);
+  timer->expires = tick;
+}
+
+static inline void tw_cascade(TimerWheel *wheel, int level, unsigned index) {
+  DLNode batch;
+  tw_ring_init(&batch);
+  tw_ring_splice(&batch, &wheel->slots[level][index]);
+  while (!tw_ring_empty(&batch)) {
+    DLNode *n = batch.next;
+    tw_ring_unlink(n);
+    tw_place(wheel, (TWTimer *)n);
+  }
+}
+
+// moves the timers due at wheel->now into out and advances one tick
+static inline void tw_step(TimerWheel *wheel, DLNode *out) {
+  unsigned index = (unsigned)(wheel->now & TW_SLOT_MASK);
+  if (index == 0) {
+    for (int level = 1; level < TW_LEVELS; level++) {
+      unsigned upper =
+          (unsigned)((wheel->now >> (level * TW_SLOT_BITS)) & TW_SLOT_MASK);
+      tw_cascade(wheel, level, upper);
+      if (upper != 0)
+        break;
+    }
+  }
+  tw_ring_splice(out, &wheel->slots[0][index]);
+  wheel->now++;
+}
+
+/**
+ * @brief Initializes an empty batch.
+ */
+static inline void tw_batch_init(TWBatch *batch) { tw_ring_init(&batch->ring); }
+
+/**
+ * @brief Removes and returns the next timer of a batch.
+ * @return The timer (now idle), or NULL when the batch is empty.
+ */
+static inline TWTimer *tw_batch_pop(TWBatch *batch) {
+  TWTimer *timer;
+  if (tw_ring_empty(&batch->ring))
+    return NULL;
+  timer = (TWTimer *)batch->ring.next;
+  tw_ring_unlink(&timer->node);
+  timer->state = TW_IDLE;
+  return timer;
+}
+
+static inline size_t tw_mark_expired(DLNode *ring) {
+  size_t n = 0;
+  for (DLNode *c = ring->next; c != ring; c = c->next, n++)
+    ((TWTimer *)c)->state = TW_EXPIRED;
+  return n;
+}
+
+/**
+ * @brief Advances the wheel and hands over the due timers without running
+ * them.
+ *
+ * Each due slot is detached and appended to the batch in O(1).
+ * @param ticks Number of ticks to advance.
+ * @param out Initialized batch receiving the expired timers in firing order.
+ * @return Number of timers moved to the batch.
+ */
+static inline size_t tw_collect_expired(TimerWheel *wheel, uint64_t ticks,
+                                        TWBatch *out) {
+  DLNode due;
+  size_t n;
+  tw_ring_init(&due);
+  while (ticks-- > 0)
+    tw_step(wheel, &due);
+  n = tw_mark_expired(&due);
+  wheel->pending -= n;
+  tw_ring_splice(&out->ring, &due);
+  return n;
+}
+
+/**
+ * @brief Advances the wheel tick by tick, running the callback of every due
+ * timer.
+ * @param ticks Number of ticks to advance.
+ * @return Number of callbacks run.
+ * @note Callbacks see tw_now() already past their tick, so rescheduling with
+ * a delay of 0 fires on the next tick.
+ */
+static inline size_t tw_advance(TimerWheel *wheel, uint64_t ticks) {
+  size_t fired = 0;
+  TWBatch batch;
+  TWTimer *timer;
+  tw_batch_init(&batch);
+  while (ticks-- > 0) {
+    DLNode due;
+    tw_ring_init(&due);
+    tw_step(wheel, &due);
+    wheel->pending -= tw_mark_expired(&due);
+    tw_ring_splice(&batch.ring, &due);
+    while ((timer = tw_batch_pop(&batch)) != NULL) {
+      fired++;
+      if (timer->fn)
+        timer->fn(timer, timer->node.data);
+    }
+  }
+  return fired;
+}
+
+/**
+ * @brief Cancels every pending timer.
+ */
+static inline void tw_clear(TimerWheel *wheel) {
+  for (int l = 0; l < TW_LEVELS; l++) {
+    for (unsigned s = 0; s < TW_SLOTS; s++) {
+      DLNode *slot = &wheel->slots[l][s];
+      while (!tw_ring_empty(slot)) {
+        TWTimer *timer = (TWTimer *)slot->next;
+        tw_ring_unlink(&timer->node);
+        timer->state = TW_IDLE;
+      }
+    }
+  }
+  wheel->pending = 0;
+}
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,661 @@
+#ifndef XORLINKEDLIST_H
+#define XORLINKEDLIST_H
+
+#include "generics.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file xorlinkedlist.h
+ * @brief Memory-compact doubly linked list (`xdl_*`).
+ *
+ * Each node stores `next ^ previous` in a single `link` word instead of two
+ * pointers, so an XDLNode is one pointer smaller than a DLNode while the list
+ * can still be walked in both directions. Walking needs the address of the
+ * node you came from, which is why traversal, insertion and deletion go
+ * through an XDLCursor holding the (previous, current) pair. The XDLList
+ * handle keeps both ends so the list can be entered from either side, and
+ * index lookups start from whichever end is closer.
+ *
+ * Nodes cannot be navigated on their own: a node pointer returned by a lookup
+ * is only good for reading its data.
+ */
+
+/**
+ * @struct XDLNode
+ * @brief Node of an XOR-linked list.
+ */
+typedef struct XDLNode {
+    void *data;     /**< Pointer to stored data */
+    size_t dataSize; /**< Size of the data in bytes */
+    uintptr_t link; /**< Address of next XOR address of previous */
+} XDLNode;
+
+/**
+ * @struct XDLList
+ * @brief Handle of an XOR-linked list.
+ */
+typedef struct XDLList {
+    XDLNode *head;             /**< First node, NULL when empty */
+    XDLNode *tail;             /**< Last node, NULL when empty */
+    size_t size;               /**< Number of nodes */
+    const CDSAllocator *alloc; /**< Allocator for nodes and payloads */
+} XDLList;
+
+/**
+ * @struct XDLCursor
+ * @brief Position inside an XOR-linked list.
+ *
+ * `node` is the current node (NULL past the end) and `prev` the node before
+ * it (NULL on the first node). Any change made to the list through another
+ * cursor or an xdl_* call invalidates the cursor.
+ */
+typedef struct XDLCursor {
+    XDLList *list;  /**< List the cursor walks */
+    XDLNode *prev;  /**< Node before the current one */
+    XDLNode *node;  /**< Current node, NULL past the end */
+    size_t index;   /**< Index of the current node */
+} XDLCursor;
+
+static inline XDLNode *xdl_step(XDLNode *from, XDLNode *node) {
+  return (XDLNode *)(node->link ^ (uintptr_t)from);
+}
+
+static inline void xdl_relink(XDLNode *node, XDLNode *oldNeighbour,
+                              XDLNode *newNeighbour) {
+  node->link ^= (uintptr_t)oldNeighbour ^ (uintptr_t)newNeighbour;
+}
+
+static inline bool xdl_matches(XDLNode *node, void *data, size_t dataSize) {
+  return node->data && data && node->dataSize == dataSize &&
+         memcmp(node->data, data, dataSize) == 0;
+}
+
+/**
+ * @brief Initializes an empty list.
+ * @param list List handle.
+ * @param alloc Allocator for nodes and payloads, NULL for the default one.
+ */
+static inline void xdl_init(XDLList *list, const CDSAllocator *alloc) {
+  list->head = NULL;
+  list->tail = NULL;
+  list->size = 0;
+  list->alloc = alloc ? alloc : cds_default_allocator();
+}
+
+/**
+ * @brief Returns the number of nodes.
+ */
+static inline size_t xdl_size(const XDLList *list) { return list->size; }
+
+static inline XDLNode *xdl_alloc_node(XDLList *list, void *data,
+                                      size_t dataSize) {
+  XDLNode *n = (XDLNode *)cds_alloc(list->alloc, sizeof(XDLNode));
+  n->data = data;
+  n->dataSize = dataSize;
+  n->link = 0;
+  return n;
+}
+
+static inline void *xdl_dup(XDLList *list, void *data, size_t dataSize) {
+  void *copy;
+  if (data == NULL || dataSize == 0)
+    return NULL;
+  copy = cds_alloc(list->alloc, dataSize);
+  memmove(copy, data, dataSize);
+  return copy;
+}
+
+/**
+ * @brief Releases a node and its data with the list's allocator.
+ * @note The node must already be unlinked.
+ */
+static inline void xdl_destroy_node(XDLList *list, XDLNode *node) {
+  if (node == NULL)
+    return;
+  cds_free(list->alloc, node->data);
+  cds_free(list->alloc, node);
+}
+
+/**
+ * @brief Places a cursor on the first node of a list.
+ */
+static inline void xdl_cursor_init(XDLCursor *cur, XDLList *list) {
+  cur->list = list;
+  cur->prev = NULL;
+  cur->node = list->head;
+  cur->index = 0;
+}
+
+/**
+ * @brief Places a cursor on the last node of a list.
+ * @note On an empty list the cursor is past the end, like xdl_cursor_init().
+ */
+static inline void xdl_cursor_init_back(XDLCursor *cur, XDLList *list) {
+  cur->list = list;
+  cur->node = list->tail;
+  cur->prev = list->tail ? xdl_step(NULL, list->tail) : NULL;
+  cur->index = list->size ? list->size - 1 : 0;
+}
+
+/**
+ * @brief Places a cursor past the last node (insert_before appends there).
+ */
+static inline void xdl_cursor_init_end(XDLCursor *cur, XDLList *list) {
+  cur->list = list;
+  cur->prev = list->tail;
+  cur->node = NULL;
+  cur->index = list->size;
+}
+
+/**
+ * @brief Returns true if the cursor is on a node (not past the end).
+ */
+static inline bool xdl_cursor_valid(const XDLCursor *cur) {
+  return cur->node != NULL;
+}
+
+/**
+ * @brief Returns the current node, or NULL past the end.
+ */
+static inline XDLNode *xdl_cursor_node(const XDLCursor *cur) {
+  return cur->node;
+}
+
+/**
+ * @brief Returns the data of the current node, or NULL past the end.
+ */
+static inline void *xdl_cursor_get(const XDLCursor *cur) {
+  return cur->node ? cur->node->data : NULL;
+}
+
+/**
+ * @brief Returns the data of the node after the current one without moving.
+ */
+static inline void *xdl_cursor_peek(const XDLCursor *cur) {
+  XDLNode *next;
+  if (cur->node == NULL)
+    return NULL;
+  next = xdl_step(cur->prev, cur->node);
+  return next ? next->data : NULL;
+}
+
+/**
+ * @brief Moves to the next node.
+ * @return true if the cursor moved, false if it was already past the end.
+ */
+static inline bool xdl_cursor_next(XDLCursor *cur) {
+  XDLNode *next;
+  if (cur->node == NULL)
+    return false;
+  next = xdl_step(cur->prev, cur->node);
+  cur->prev = cur->node;
+  cur->node = next;
+  cur->index++;
+  return true;
+}
+
+/**
+ * @brief Moves to the previous node.
+ * @return true if the cursor moved, false if it was on the first node.
+ */
+static inline bool xdl_cursor_prev(XDLCursor *cur) {
+  XDLNode *before;
+  if (cur->prev == NULL)
+    return false;
+  before = xdl_step(cur->node, cur->prev);
+  cur->node = cur->prev;
+  cur->prev = before;
+  cur->index--;
+  return true;
+}
+
+/**
+ * @brief Moves the cursor to an absolute index.
+ *
+ * Walks from the current position, the head or the tail, whichever is
+ * closest. idx == size leaves the cursor past the end.
+ * @return true if there is a node at idx.
+ */
+static inline bool xdl_cursor_seek(XDLCursor *cur, size_t idx) {
+  size_t size = cur->list->size;
+  size_t fromCur = idx > cur->index ? idx - cur->index : cur->index - idx;
+  if (idx >= size) {
+    xdl_cursor_init_end(cur, cur->list);
+    return false;
+  }
+  if (idx < fromCur)
+    xdl_cursor_init(cur, cur->list);
+  else if (size - 1 - idx < fromCur)
+    xdl_cursor_init_back(cur, cur->list);
+  while (cur->index > idx && xdl_cursor_prev(cur))
+    ;
+  while (cur->index < idx && xdl_cursor_next(cur))
+    ;
+  return cur->node != NULL;
+}
+
+/**
+ * @brief Deletes the current node and moves to the following one.
+ * @return true if a node was deleted.
+ */
+static inline bool xdl_cursor_erase(XDLCursor *cur) {
+  XDLList *list = cur->list;
+  XDLNode *victim = cur->node;
+  XDLNode *next;
+  if (victim == NULL)
+    return false;
+  next = xdl_step(cur->prev, victim);
+  if (cur->prev)
+    xdl_relink(cur->prev, victim, next);
+  else
+    list->head = next;
+  if (next)
+    xdl_relink(next, victim, cur->prev);
+  else
+    list->tail = cur->prev;
+  cur->node = next;
+  list->size--;
+  xdl_destroy_node(list, victim);
+  return true;
+}
+
+/**
+ * @brief Links a node before the current one (or at the end when past it).
+ * @note The cursor stays on the same node; its index grows by one.
+ */
+static inline void xdl_cursor_insert_before_node(XDLCursor *cur,
+                                                 XDLNode *node) {
+  XDLList *list = cur->list;
+  node->link = (uintptr_t)cur->prev ^ (uintptr_t)cur->node;
+  if (cur->prev)
+    xdl_relink(cur->prev, cur->node, node);
+  else
+    list->head = node;
+  if (cur->node)
+    xdl_relink(cur->node, cur->prev, node);
+  else
+    list->tail = node;
+  cur->prev = node;
+  cur->index++;
+  list->size++;
+}
+
+/**
+ * @brief Links a node after the current one.
+ * @return false (and leaves the node alone) if the cursor is past the end.
+ */
+static inline bool xdl_cursor_insert_after_node(XDLCursor *cur,
+                                                XDLNode *node) {
+  XDLList *list = cur->list;
+  XDLNode *next;
+  if (cur->node == NULL)
+    return false;
+  next = xdl_step(cur->prev, cur->node);
+  node->link = (uintptr_t)cur->node ^ (uintptr_t)next;
+  xdl_relink(cur->node, next, node);
+  if (next)
+    xdl_relink(next, cur->node, node);
+  else
+    list->tail = node;
+  list->size++;
+  return true;
+}
+
+/**
+ * @brief Inserts data before the current node (move semantics).
+ * @note The data must come from the list's allocator.
+ */
+static inline void xdl_cursor_insert_before_mv_data(XDLCursor *cur,
+                                                    void **data,
+                                                    size_t dataSize) {
+  xdl_cursor_insert_before_node(
+      cur, xdl_alloc_node(cur->list, move(data), dataSize));
+}
+
+/**
+ * @brief Inserts data before the current node (shallow copy).
+ * @note The list frees the data when the node is deleted.
+ */
+static inline void xdl_cursor_insert_before_cp_data(XDLCursor *cur,
+                                                    void *data,
+                                                    size_t dataSize) {
+  xdl_cursor_insert_before_node(cur, xdl_alloc_node(cur->list, data, dataSize));
+}
+
+/**
+ * @brief Inserts data before the current node (deep copy).
+ */
+static inline void xdl_cursor_insert_before_deep_cp_data(XDLCursor *cur,
+                                                         void *data,
+                                                         size_t dataSize) {
+  xdl_cursor_insert_before_node(
+      cur,
+      xdl_alloc_node(cur->list, xdl_dup(cur->list, data, dataSize), dataSize));
+}
+
+/**
+ * @brief Inserts data after the current node (move semantics).
+ * @return false if the cursor is past the end; the data stays with the caller.
+ */
+static inline bool xdl_cursor_insert_after_mv_data(XDLCursor *cur, void **data,
+                                                   size_t dataSize) {
+  if (cur->node == NULL)
+    return false;
+  return xdl_cursor_insert_after_node(
+      cur, xdl_alloc_node(cur->list, move(data), dataSize));
+}
+
+/**
+ * @brief Inserts data after the current node (shallow copy).
+ * @return false if the cursor is past the end.
+ */
+static inline bool xdl_cursor_insert_after_cp_data(XDLCursor *cur, void *data,
+                                                   size_t dataSize) {
+  if (cur->node == NULL)
+    return false;
+  return xdl_cursor_insert_after_node(
+      cur, xdl_alloc_node(cur->list, data, dataSize));
+}
+
+/**
+ * @brief Inserts data after the current node (deep copy).
+ * @return false if the cursor is past the end.
+ */
+static inline bool xdl_cursor_insert_after_deep_cp_data(XDLCursor *cur,
+                                                        void *data,
+                                                        size_t dataSize) {
+  if (cur->node == NULL)
+    return false;
+  return xdl_cursor_insert_after_node(
+      cur,
+      xdl_alloc_node(cur->list, xdl_dup(cur->list, data, dataSize), dataSize));
+}
+
+static inline void xdl_push_front_node(XDLList *list, XDLNode *node) {
+  XDLCursor cur;
+  xdl_cursor_init(&cur, list);
+  xdl_cursor_insert_before_node(&cur, node);
+}
+
+static inline void xdl_push_back_node(XDLList *list, XDLNode *node) {
+  XDLCursor cur;
+  xdl_cursor_init_end(&cur, list);
+  xdl_cursor_insert_before_node(&cur, node);
+}
+
+/**
+ * @brief Appends data at the end of the list (move semantics).
+ * @param list List handle.
+ * @param data Pointer to the pointer of data (ownership transferred).
+ * @param dataSize Size of the data in bytes.
+ * @note The data must come from the list's allocator.
+ */
+static inline void xdl_push_back_mv_data(XDLList *list, void **data,
+                                         size_t dataSize) {
+  xdl_push_back_node(list, xdl_alloc_node(list, move(data), dataSize));
+}
+
+/**
+ * @brief Appends data at the end of the list (shallow copy).
+ * @note The list frees the data when the node is deleted.
+ */
+static inline void xdl_push_back_cp_data(XDLList *list, void *data,
+                                         size_t dataSize) {
+  xdl_push_back_node(list, xdl_alloc_node(list, data, dataSize));
+}
+
+/**
+ * @brief Appends data at the end of the list (deep copy).
+ */
+static inline void xdl_push_back_deep_cp_data(XDLList *list, void *data,
+                                              size_t dataSize) {
+  xdl_push_back_node(
+      list, xdl_alloc_node(list, xdl_dup(list, data, dataSize), dataSize));
+}
+
+/**
+ * @brief Prepends data at the beginning of the list (move semantics).
+ * @note The data must come from the list's allocator.
+ */
+static inline void xdl_push_front_mv_data(XDLList *list, void **data,
+                                          size_t dataSize) {
+  xdl_push_front_node(list, xdl_alloc_node(list, move(data), dataSize));
+}
+
+/**
+ * @brief Prepends data at the beginning of the list (shallow copy).
+ * @note The list frees the data when the node is deleted.
+ */
+static inline void xdl_push_front_cp_data(XDLList *list, void *data,
+                                          size_t dataSize) {
+  xdl_push_front_node(list, xdl_alloc_node(list, data, dataSize));
+}
+
+/**
+ * @brief Prepends data at the beginning of the list (deep copy).
+ */
+static inline void xdl_push_front_deep_cp_data(XDLList *list, void *data,
+                                               size_t dataSize) {
+  xdl_push_front_node(
+      list, xdl_alloc_node(list, xdl_dup(list, data, dataSize), dataSize));
+}
+
+static inline void *xdl_take(XDLCursor *cur, size_t *dataSize) {
+  void *data;
+  if (cur->node == NULL) {
+    if (dataSize)
+      *dataSize = 0;
+    return NULL;
+  }
+  data = cur->node->data;
+  if (dataSize)
+    *dataSize = cur->node->dataSize;
+  cur->node->data = NULL;
+  xdl_cursor_erase(cur);
+  return data;
+}
+
+/**
+ * @brief Removes the first node and hands its data to the caller.
+ * @param list List handle.
+ * @param dataSize Receives the size of the data (may be NULL).
+ * @return The data, or NULL if the list is empty. Release it with the list's
+ * allocator.
+ */
+static inline void *xdl_pop_front(XDLList *list, size_t *dataSize) {
+  XDLCursor cur;
+  xdl_cursor_init(&cur, list);
+  return xdl_take(&cur, dataSize);
+}
+
+/**
+ * @brief Removes the last node and hands its data to the caller.
+ * @param list List handle.
+ * @param dataSize Receives the size of the data (may be NULL).
+ * @return The data, or NULL if the list is empty. Release it with the list's
+ * allocator.
+ */
+static inline void *xdl_pop_back(XDLList *list, size_t *dataSize) {
+  XDLCursor cur;
+  xdl_cursor_init_back(&cur, list);
+  return xdl_take(&cur, dataSize);
+}
+
+/**
+ * @brief Inserts a node at the specified index.
+ * @return true if inserted, false if idx > size (the node stays with the
+ * caller).
+ */
+static inline bool xdl_insert_at_index_node(XDLList *list, XDLNode *node,
+                                            size_t idx) {
+  XDLCursor cur;
+  if (idx > list->size)
+    return false;
+  xdl_cursor_init(&cur, list);
+  xdl_cursor_seek(&cur, idx);
+  xdl_cursor_insert_before_node(&cur, node);
+  return true;
+}
+
+/**
+ * @brief Inserts data at the specified index (move semantics).
+ * @return false if idx > size; the data stays with the caller.
+ */
+static inline bool xdl_insert_at_index_mv_data(XDLList *list, void **data,
+                                               size_t dataSize, size_t idx) {
+  if (idx > list->size)
+    return false;
+  return xdl_insert_at_index_node(
+      list, xdl_alloc_node(list, move(data), dataSize), idx);
+}
+
+/**
+ * @brief Inserts data at the specified index (shallow copy).
+ * @return false if idx > size.
+ */
+static inline bool xdl_insert_at_index_cp_data(XDLList *list, void *data,
+                                               size_t dataSize, size_t idx) {
+  if (idx > list->size)
+    return false;
+  return xdl_insert_at_index_node(list, xdl_alloc_node(list, data, dataSize),
+                                  idx);
+}
+
+/**
+ * @brief Inserts data at the specified index (deep copy).
+ * @return false if idx > size.
+ */
+static inline bool xdl_insert_at_index_deep_cp_data(XDLList *list, void *data,
+                                                    size_t dataSize,
+                                                    size_t idx) {
+  if (idx > list->size)
+    return false;
+  return xdl_insert_at_index_node(
+      list, xdl_alloc_node(list, xdl_dup(list, data, dataSize), dataSize),
+      idx);
+}
+
+/**
+ * @brief Deletes the node at the specified index.
+ * @return true if a node was deleted.
+ */
+static inline bool xdl_delete_at_index(XDLList *list, size_t idx) {
+  XDLCursor cur;
+  xdl_cursor_init(&cur, list);
+  return xdl_cursor_seek(&cur, idx) && xdl_cursor_erase(&cur);
+}
+
+/**
+ * @brief Positions a cursor on the first node matching a value.
+ * @return true if found; otherwise the cursor is past the end.
+ */
+static inline bool xdl_cursor_find(XDLCursor *cur, void *data,
+                                   size_t dataSize) {
+  while (cur->node && !xdl_matches(cur->node, data, dataSize))
+    xdl_cursor_next(cur);
+  return cur->node != NULL;
+}
+
+/**
+ * @brief Deletes the first node whose data matches a value.
+ * @return true if a node was deleted.
+ */
+static inline bool xdl_delete_by_value(XDLList *list, void *data,
+                                       size_t dataSize) {
+  XDLCursor cur;
+  xdl_cursor_init(&cur, list);
+  return xdl_cursor_find(&cur, data, dataSize) && xdl_cursor_erase(&cur);
+}
+
+/**
+ * @brief Checks if a value exists in the list.
+ */
+static inline bool xdl_contains(XDLList *list, void *data, size_t dataSize) {
+  XDLCursor cur;
+  xdl_cursor_init(&cur, list);
+  return xdl_cursor_find(&cur, data, dataSize);
+}
+
+/**
+ * @brief Looks up the first node whose data matches a value without printing.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_NOT_FOUND.
+ */
+static inline CDSStatus xdl_try_get_by_value(XDLList *list, void *data,
+                                             size_t dataSize, XDLNode **out) {
+  XDLCursor cur;
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  *out = NULL;
+  if (data == NULL)
+    return CDS_ERR_NULL;
+  xdl_cursor_init(&cur, list);
+  if (!xdl_cursor_find(&cur, data, dataSize))
+    return CDS_ERR_NOT_FOUND;
+  *out = cur.node;
+  return CDS_OK;
+}
+
+/**
+ * @brief Looks up the node at the specified index without printing.
+ * @param out Receives the node, or NULL on failure.
+ * @return CDS_OK, CDS_ERR_NULL or CDS_ERR_OUT_OF_BOUNDS.
+ */
+static inline CDSStatus xdl_try_get_by_index(XDLList *list, size_t idx,
+                                             XDLNode **out) {
+  XDLCursor cur;
+  if (out == NULL)
+    return CDS_ERR_NULL;
+  xdl_cursor_init(&cur, list);
+  xdl_cursor_seek(&cur, idx);
+  *out = cur.node;
+  return cur.node ? CDS_OK : CDS_ERR_OUT_OF_BOUNDS;
+}
+
+/**
+ * @brief Returns the first node whose data matches the given value.
+ * @return Pointer to the node, or NULL if not found.
+ */
+static inline XDLNode *xdl_get_by_value(XDLList *list, void *data,
+                                        size_t dataSize) {
+  XDLNode *n;
+  xdl_try_get_by_value(list, data, dataSize, &n);
+  return n;
+}
+
+/**
+ * @brief Returns the data at the specified index.
+ * @return Pointer to data or NULL if out of bounds.
+ * @note Failures go through CDS_DIAGNOSTIC; use xdl_try_get_by_index() on
+ * hot paths.
+ */
+static inline void *xdl_get_at_index(XDLList *list, size_t idx) {
+  XDLNode *n;
+  CDSStatus status = xdl_try_get_by_index(list, idx, &n);
+  if (status != CDS_OK)
+    CDS_DIAGNOSTIC(status, "Error: Index out of bounds.\n");
+  return n ? n->data : NULL;
+}
+
+/**
+ * @brief Frees the entire list. The handle stays usable (empty).
+ */
+static inline void xdl_free_list(XDLList *list) {
+  XDLNode *prev = NULL;
+  XDLNode *c = list->head;
+  while (c != NULL) {
+    XDLNode *next = xdl_step(prev, c);
+    prev = c;
+    xdl_destroy_node(list, c);
+    c = next;
+  }
+  list->head = NULL;
+  list->tail = NULL;
+  list->size = 0;
+}
+
+#endif // XORLINKEDLIST_H